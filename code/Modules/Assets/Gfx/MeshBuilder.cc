@@ -48,6 +48,7 @@ MeshBuilder::Begin() {
 SetupAndData<MeshSetup>
 MeshBuilder::Build() {
     o_assert(this->inBegin);
+    o_memory_tag(MemoryTag::Assets);
 
     this->inBegin = false;
 
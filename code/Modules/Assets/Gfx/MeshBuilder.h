@@ -37,6 +37,7 @@
     @see VertexWriter, ShapeBuilder
 */
 #include "Core/Types.h"
+#include "Core/Containers/SmallArray.h"
 #include "Gfx/GfxTypes.h"
 #include "Assets/Gfx/VertexWriter.h"
 #include "Resource/SetupAndData.h"
@@ -54,7 +55,7 @@ public:
     /// read/write access to vertex layout
     class VertexLayout Layout;
     /// primitive groups (at least one must be defined)
-    Array<PrimitiveGroup> PrimitiveGroups;
+    SmallArray<PrimitiveGroup, 4> PrimitiveGroups;
     /// vertex data usage
     Usage::Code VertexUsage = Usage::Immutable;
     /// index data usage
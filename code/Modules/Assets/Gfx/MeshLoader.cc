@@ -39,6 +39,7 @@ MeshLoader::Cancel() {
 //------------------------------------------------------------------------------
 Id
 MeshLoader::Start() {
+    o_memory_tag(MemoryTag::Assets);
     this->resId = Gfx::resource()->prepareAsync(this->setup);
     this->ioRequest = IO::LoadFile(setup.Locator.Location());
     return this->resId;
@@ -49,6 +50,7 @@ ResourceState::Code
 MeshLoader::Continue() {
     o_assert_dbg(this->resId.IsValid());
     o_assert_dbg(this->ioRequest.isValid());
+    o_memory_tag(MemoryTag::Assets);
     
     ResourceState::Code result = ResourceState::Pending;
     
@@ -57,7 +59,7 @@ MeshLoader::Continue() {
             // async loading has finished, use OmshParser to
             // create a MeshSetup object from the loaded data
             const void* data = this->ioRequest->Data.Data();
-            const int numBytes = this->ioRequest->Data.Size();
+            const int numBytes = int(this->ioRequest->Data.Size());
 
             MeshSetup meshSetup = MeshSetup::FromData(this->setup);
             if (OmshParser::Parse(data, numBytes, meshSetup)) {
@@ -207,6 +207,7 @@ ShapeBuilder::UpdateNumElements(ShapeData& shape) {
 SetupAndData<MeshSetup>
 ShapeBuilder::Build() {
     o_assert(!this->shapes.Empty());
+    o_memory_tag(MemoryTag::Assets);
     
     // build a final primitive group?
     if (this->curPrimGroupNumElements > 0) {
@@ -40,6 +40,7 @@ TextureLoader::Cancel() {
 //------------------------------------------------------------------------------
 Id
 TextureLoader::Start() {
+    o_memory_tag(MemoryTag::Assets);
     this->resId = Gfx::resource()->prepareAsync(this->setup);
     this->ioRequest = IO::LoadFile(setup.Locator.Location());
     return this->resId;
@@ -50,6 +51,7 @@ ResourceState::Code
 TextureLoader::Continue() {
     o_assert_dbg(this->resId.IsValid());
     o_assert_dbg(this->ioRequest.isValid());
+    o_memory_tag(MemoryTag::Assets);
     
     ResourceState::Code result = ResourceState::Pending;
     
@@ -58,7 +60,7 @@ TextureLoader::Continue() {
             // yeah, IO is done, let gliml parse the texture data
             // and create the texture resource
             const uint8_t* data = this->ioRequest->Data.Data();
-            const int numBytes = this->ioRequest->Data.Size();
+            const int numBytes = int(this->ioRequest->Data.Size());
             
             gliml::context ctx;
             ctx.enable_dxt(true);
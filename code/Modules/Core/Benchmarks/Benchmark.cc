@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//  Benchmark.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Benchmark.h"
+#include "Core/Log.h"
+#include "Core/String/StringBuilder.h"
+#include <stdio.h>
+
+using namespace Oryol;
+
+Benchmark::Options Benchmark::options;
+Array<Benchmark::Result> Benchmark::results;
+volatile int64_t Benchmark::sink = 0;
+
+//------------------------------------------------------------------------------
+void
+Benchmark::Setup(const Options& options_) {
+    o_assert(options_.NumRuns > 0);
+    options = options_;
+    results.Clear();
+}
+
+//------------------------------------------------------------------------------
+bool
+Benchmark::Enabled(const char* group, const char* container, const char* op) {
+    if (options.Filter.Empty()) {
+        return true;
+    }
+    StringBuilder name;
+    name.Format(256, "%s/%s/%s", group, container, op);
+    return InvalidIndex != name.FindSubString(0, EndOfString, options.Filter.AsCStr());
+}
+
+//------------------------------------------------------------------------------
+const Array<Benchmark::Result>&
+Benchmark::Results() {
+    return results;
+}
+
+//------------------------------------------------------------------------------
+void
+Benchmark::addResult(const char* group, const char* container, const char* op, const char* type, int numItems, int numIters, Array<double>& samples) {
+    o_assert(!samples.Empty());
+    samples.Sort();
+    const int num = samples.Size();
+    Result res;
+    res.Group = group;
+    res.Container = container;
+    res.Op = op;
+    res.Type = type;
+    res.NumItems = numItems;
+    res.NumIters = numIters;
+    res.MinNs = samples[0];
+    // nearest-rank percentiles
+    res.P10Ns = samples[(num - 1) / 10];
+    res.MedianNs = (num & 1) ? samples[num / 2] : 0.5 * (samples[num / 2 - 1] + samples[num / 2]);
+    res.P90Ns = samples[(num - 1) - (num - 1) / 10];
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+    }
+    res.MeanNs = sum / num;
+    Log::Info("%-14s %-22s %-12s %-7s n=%-8d median %12.1f ns (%8.2f ns/item) p10 %12.1f p90 %12.1f\n",
+        group, container, op, type, numItems,
+        res.MedianNs, res.MedianNs / numItems, res.P10Ns, res.P90Ns);
+    results.Add(res);
+}
+
+//------------------------------------------------------------------------------
+bool
+Benchmark::WriteJSON(const char* path) {
+    StringBuilder json;
+    json.Append("{\n");
+    json.AppendFormat(256, "  \"warmup\": %d,\n  \"runs\": %d,\n  \"min_sample_us\": %.1f,\n",
+        options.NumWarmup, options.NumRuns, options.MinSampleTime);
+    json.Append("  \"results\": [\n");
+    for (int i = 0; i < results.Size(); i++) {
+        const Result& res = results[i];
+        json.AppendFormat(1024,
+            "    { \"group\": \"%s\", \"container\": \"%s\", \"op\": \"%s\", \"type\": \"%s\", "
+            "\"n\": %d, \"iters\": %d, \"min_ns\": %.1f, \"p10_ns\": %.1f, \"median_ns\": %.1f, "
+            "\"p90_ns\": %.1f, \"mean_ns\": %.1f }%s\n",
+            res.Group.AsCStr(), res.Container.AsCStr(), res.Op.AsCStr(), res.Type.AsCStr(),
+            res.NumItems, res.NumIters, res.MinNs, res.P10Ns, res.MedianNs, res.P90Ns, res.MeanNs,
+            (i + 1) < results.Size() ? "," : "");
+    }
+    json.Append("  ]\n}\n");
+
+    if ((nullptr == path) || (0 == path[0])) {
+        fputs(json.AsCStr(), stdout);
+        return true;
+    }
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        Log::Warn("Benchmark: failed to open '%s' for writing!\n", path);
+        return false;
+    }
+    fwrite(json.AsCStr(), 1, json.Length(), fp);
+    fclose(fp);
+    Log::Info("Benchmark: wrote %d results to '%s'\n", results.Size(), path);
+    return true;
+}
@@ -0,0 +1,160 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Benchmark
+    @brief micro-benchmark harness of the CoreBenchmarks app
+
+    Benchmark::Measure() times a function with warmup runs and a number
+    of repetitions, and records the minimum, median, 10th/90th percentile
+    and mean of the per-call times in a result list, which can be
+    written as JSON (to diff the numbers of two builds with a script).
+
+    The setup function is called before each call of the body function
+    and is not timed (e.g. to create a fresh unsorted array for a sort
+    benchmark). Very fast body functions are called several times per
+    sample, so that each sample takes at least MinSampleTime.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/String/String.h"
+#include "Core/Time/Clock.h"
+
+class Benchmark {
+public:
+    /// max number of body calls per sample
+    static const int MaxIters = 1 << 20;
+    /// benchmark settings
+    struct Options {
+        /// number of samples which are thrown away
+        int NumWarmup = 3;
+        /// number of recorded samples
+        int NumRuns = 11;
+        /// minimum duration of one sample in microseconds
+        double MinSampleTime = 200.0;
+        /// only run benchmarks whose name contains this string
+        Oryol::String Filter;
+    };
+    /// the result of one benchmark
+    struct Result {
+        /// benchmark group, e.g. "Array"
+        Oryol::String Group;
+        /// container name, e.g. "Array" or "std::vector"
+        Oryol::String Container;
+        /// operation, e.g. "insert"
+        Oryol::String Op;
+        /// element type, e.g. "int"
+        Oryol::String Type;
+        /// number of items per call
+        int NumItems = 0;
+        /// number of body calls per sample
+        int NumIters = 0;
+        /// per-call times in nanoseconds
+        double MinNs = 0.0;
+        double P10Ns = 0.0;
+        double MedianNs = 0.0;
+        double P90Ns = 0.0;
+        double MeanNs = 0.0;
+    };
+
+    /// setup with options
+    static void Setup(const Options& options);
+    /// return true if a benchmark should run (see Options::Filter)
+    static bool Enabled(const char* group, const char* container, const char* op);
+    /// time a body function, setup is called untimed before each body call
+    template<class SETUP, class BODY> static void Measure(const char* group, const char* container, const char* op, const char* type, int numItems, SETUP setup, BODY body);
+    /// time a body function without setup
+    template<class BODY> static void Measure(const char* group, const char* container, const char* op, const char* type, int numItems, BODY body);
+    /// get all results
+    static const Oryol::Array<Result>& Results();
+    /// write results as JSON to a file, or stdout if path is empty
+    static bool WriteJSON(const char* path);
+
+    /// use this to keep the optimizer from throwing away benchmark results
+    static void Consume(int64_t val) {
+        sink += val;
+    };
+
+private:
+    /// compute the statistics of a sample array and add a result
+    static void addResult(const char* group, const char* container, const char* op, const char* type, int numItems, int numIters, Oryol::Array<double>& samples);
+
+    static Options options;
+    static Oryol::Array<Result> results;
+    static volatile int64_t sink;
+};
+
+//------------------------------------------------------------------------------
+template<class SETUP, class BODY> void
+Benchmark::Measure(const char* group, const char* container, const char* op, const char* type, int numItems, SETUP setup, BODY body) {
+    using namespace Oryol;
+    if (!Enabled(group, container, op)) {
+        return;
+    }
+    // calibrate the number of body calls per sample
+    int numIters = 1;
+    TimePoint start;
+    for (;;) {
+        double sampleTime = 0.0;
+        for (int iter = 0; iter < numIters; iter++) {
+            setup();
+            start = Clock::Now();
+            body();
+            sampleTime += Clock::Since(start).AsMicroSeconds();
+        }
+        if ((sampleTime >= options.MinSampleTime) || (numIters >= MaxIters)) {
+            break;
+        }
+        numIters *= 2;
+    }
+    Array<double> samples;
+    samples.Reserve(options.NumRuns);
+    for (int run = 0; run < (options.NumWarmup + options.NumRuns); run++) {
+        double sampleTime = 0.0;
+        for (int iter = 0; iter < numIters; iter++) {
+            setup();
+            start = Clock::Now();
+            body();
+            sampleTime += Clock::Since(start).AsMicroSeconds();
+        }
+        if (run >= options.NumWarmup) {
+            samples.Add((sampleTime * 1000.0) / numIters);
+        }
+    }
+    addResult(group, container, op, type, numItems, numIters, samples);
+}
+
+//------------------------------------------------------------------------------
+template<class BODY> void
+Benchmark::Measure(const char* group, const char* container, const char* op, const char* type, int numItems, BODY body) {
+    using namespace Oryol;
+    if (!Enabled(group, container, op)) {
+        return;
+    }
+    // calibrate the number of body calls per sample, without setup
+    // a whole sample can be timed at once
+    int numIters = 1;
+    TimePoint start;
+    for (;;) {
+        start = Clock::Now();
+        for (int iter = 0; iter < numIters; iter++) {
+            body();
+        }
+        if ((Clock::Since(start).AsMicroSeconds() >= options.MinSampleTime) || (numIters >= MaxIters)) {
+            break;
+        }
+        numIters *= 2;
+    }
+    Array<double> samples;
+    samples.Reserve(options.NumRuns);
+    for (int run = 0; run < (options.NumWarmup + options.NumRuns); run++) {
+        start = Clock::Now();
+        for (int iter = 0; iter < numIters; iter++) {
+            body();
+        }
+        const double sampleTime = Clock::Since(start).AsMicroSeconds();
+        if (run >= options.NumWarmup) {
+            samples.Add((sampleTime * 1000.0) / numIters);
+        }
+    }
+    addResult(group, container, op, type, numItems, numIters, samples);
+}
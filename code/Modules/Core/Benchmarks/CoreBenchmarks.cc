@@ -0,0 +1,1328 @@
+//------------------------------------------------------------------------------
+//  CoreBenchmarks.cc
+//
+//  Times insert, lookup, erase, iterate and sort operations of the Oryol
+//  containers against their std equivalents, and the other Core hot
+//  paths which have a faster and a slower alternative, over several
+//  data sizes and element types, and writes the results as JSON.
+//
+//  Command line args:
+//      -out [path]     JSON output file (default: CoreBenchmarks.json)
+//      -filter [str]   only run benchmarks with 'str' in 'group/container/op'
+//      -warmup [num]   number of warmup samples (default: 3)
+//      -runs [num]     number of recorded samples (default: 11)
+//      -maxn [num]     max number of items (default: 100000)
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Main.h"
+#include "Core/Log.h"
+#include "Core/Hash.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/SmallArray.h"
+#include "Core/Containers/BitSet.h"
+#include "Core/Containers/BufferChain.h"
+#include "Core/Containers/SoaArray.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/ArrayMap.h"
+#include "Core/Containers/Set.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/HashSet.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Containers/SpscQueue.h"
+#include "Core/Containers/MpmcQueue.h"
+#include "Core/Containers/FlatLookupMap.h"
+#include "Core/Containers/Sort.h"
+#include "Core/Containers/elementBuffer.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/String/StringConverter.h"
+#include "Core/String/StringAtom.h"
+#include "Benchmark.h"
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <atomic>
+#endif
+
+using namespace Oryol;
+
+extern Args OryolArgs;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// element types, each has an Oryol and a std flavour which are created
+// from the same (shuffled) integer sequence
+struct intType {
+    typedef int oryolType;
+    typedef int stdType;
+    static const char* Name() { return "int"; }
+    static int MakeOryol(int i) { return i; }
+    static int MakeStd(int i) { return i; }
+    static int64_t Value(int i) { return i; }
+};
+struct stringType {
+    typedef String oryolType;
+    typedef std::string stdType;
+    static const char* Name() { return "string"; }
+    static String MakeOryol(int i) {
+        StringBuilder sb;
+        sb.Format(32, "key_%08d", i);
+        return sb.GetString();
+    }
+    static std::string MakeStd(int i) {
+        return std::string(MakeOryol(i).AsCStr());
+    }
+    static int64_t Value(const String& s) { return s.Length(); }
+    static int64_t Value(const std::string& s) { return int64_t(s.length()); }
+};
+
+//------------------------------------------------------------------------------
+// a shuffled sequence 0..num-1 (xorshift, same sequence in each run)
+Array<int>
+shuffled(int num) {
+    Array<int> seq;
+    seq.Reserve(num);
+    for (int i = 0; i < num; i++) {
+        seq.Add(i);
+    }
+    uint32_t x = 2463534242;
+    for (int i = num - 1; i > 0; i--) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        const int j = int(x % uint32_t(i + 1));
+        std::swap(seq[i], seq[j]);
+    }
+    return seq;
+}
+
+//------------------------------------------------------------------------------
+template<class T> struct testData {
+    Array<typename T::oryolType> oryol;
+    std::vector<typename T::stdType> std;
+    testData(int num) {
+        Array<int> seq = shuffled(num);
+        for (int i : seq) {
+            this->oryol.Add(T::MakeOryol(i));
+            this->std.push_back(T::MakeStd(i));
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchArray(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+    Array<int> indices = shuffled(num);
+
+    Benchmark::Measure("Array", "Array", "insert", type, num, [&] {
+        Array<otype> a;
+        for (const auto& v : data.oryol) {
+            a.Add(v);
+        }
+        Benchmark::Consume(a.Size());
+    });
+    Benchmark::Measure("Array", "std::vector", "insert", type, num, [&] {
+        std::vector<stype> v;
+        for (const auto& s : data.std) {
+            v.push_back(s);
+        }
+        Benchmark::Consume(v.size());
+    });
+
+    Benchmark::Measure("Array", "Array", "bulk_insert", type, num, [&] {
+        Array<otype> a;
+        a.AddBulk(data.oryol.MakeSlice());
+        Benchmark::Consume(a.Size());
+    });
+    Benchmark::Measure("Array", "std::vector", "bulk_insert", type, num, [&] {
+        std::vector<stype> v;
+        v.insert(v.end(), data.std.begin(), data.std.end());
+        Benchmark::Consume(v.size());
+    });
+
+    Benchmark::Measure("Array", "Array", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (int i : indices) {
+            sum += T::Value(data.oryol[i]);
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Array", "std::vector", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (int i : indices) {
+            sum += T::Value(data.std[i]);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    Benchmark::Measure("Array", "Array", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.oryol) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Array", "std::vector", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.std) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    // erase at random positions, swapping in the last element
+    Array<otype> oa;
+    std::vector<stype> sv;
+    Benchmark::Measure("Array", "Array", "erase", type, num,
+        [&] { oa = data.oryol; },
+        [&] {
+            for (int i = num - 1; i >= 0; i--) {
+                oa.EraseSwapBack(indices[i] % (i + 1));
+            }
+        });
+    Benchmark::Measure("Array", "std::vector", "erase", type, num,
+        [&] { sv = data.std; },
+        [&] {
+            for (int i = num - 1; i >= 0; i--) {
+                const int index = indices[i] % (i + 1);
+                std::swap(sv[index], sv.back());
+                sv.pop_back();
+            }
+        });
+
+    Benchmark::Measure("Array", "Array", "sort", type, num,
+        [&] { oa = data.oryol; },
+        [&] { oa.Sort(); });
+    Benchmark::Measure("Array", "std::vector", "sort", type, num,
+        [&] { sv = data.std; },
+        [&] { std::sort(sv.begin(), sv.end()); });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchMap(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+
+    // Map insertion is O(n) per element, only time it for small maps
+    if (num <= 10000) {
+        Benchmark::Measure("Map", "Map", "insert", type, num, [&] {
+            Map<otype, int> m;
+            for (int i = 0; i < num; i++) {
+                m.Add(data.oryol[i], i);
+            }
+            Benchmark::Consume(m.Size());
+        });
+    }
+    Benchmark::Measure("Map", "Map", "bulk_insert", type, num, [&] {
+        Map<otype, int> m;
+        m.BeginBulk();
+        for (int i = 0; i < num; i++) {
+            m.AddBulk(data.oryol[i], i);
+        }
+        m.EndBulk();
+        Benchmark::Consume(m.Size());
+    });
+    Benchmark::Measure("Map", "std::map", "insert", type, num, [&] {
+        std::map<stype, int> m;
+        for (int i = 0; i < num; i++) {
+            m.insert(std::make_pair(data.std[i], i));
+        }
+        Benchmark::Consume(m.size());
+    });
+
+    Map<otype, int> om;
+    std::map<stype, int> sm;
+    FlatLookupMap<otype, int> fm;
+    for (int i = 0; i < num; i++) {
+        om.Add(data.oryol[i], i);
+        sm.insert(std::make_pair(data.std[i], i));
+    }
+    fm.Build(om);
+
+    Benchmark::Measure("Map", "Map", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& key : data.oryol) {
+            sum += om[key];
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Map", "FlatLookupMap", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& key : data.oryol) {
+            sum += fm[key];
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Map", "std::map", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& key : data.std) {
+            sum += sm.find(key)->second;
+        }
+        Benchmark::Consume(sum);
+    });
+
+    Benchmark::Measure("Map", "Map", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& kvp : om) {
+            sum += kvp.Value();
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Map", "std::map", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& kvp : sm) {
+            sum += kvp.second;
+        }
+        Benchmark::Consume(sum);
+    });
+
+    if (num <= 10000) {
+        Map<otype, int> m;
+        Benchmark::Measure("Map", "Map", "erase", type, num,
+            [&] { m = om; },
+            [&] {
+                for (const auto& key : data.oryol) {
+                    m.Erase(key);
+                }
+            });
+    }
+
+    // ArrayMap insertion and erasing is O(n) per element
+    if (num <= 10000) {
+        Benchmark::Measure("Map", "ArrayMap", "insert", type, num, [&] {
+            ArrayMap<otype, int> m;
+            for (int i = 0; i < num; i++) {
+                m.Add(data.oryol[i], i);
+            }
+            Benchmark::Consume(m.Size());
+        });
+        ArrayMap<otype, int> am;
+        for (int i = 0; i < num; i++) {
+            am.Add(data.oryol[i], i);
+        }
+        Benchmark::Measure("Map", "ArrayMap", "lookup", type, num, [&] {
+            int64_t sum = 0;
+            for (const auto& key : data.oryol) {
+                sum += am[key];
+            }
+            Benchmark::Consume(sum);
+        });
+        ArrayMap<otype, int> m;
+        Benchmark::Measure("Map", "ArrayMap", "erase", type, num,
+            [&] { m = am; },
+            [&] {
+                for (const auto& key : data.oryol) {
+                    m.EraseSwap(key);
+                }
+            });
+    }
+    std::map<stype, int> m;
+    Benchmark::Measure("Map", "std::map", "erase", type, num,
+        [&] { m = sm; },
+        [&] {
+            for (const auto& key : data.std) {
+                m.erase(key);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+void
+benchFindIndex(int num) {
+    // random FindIndex() calls where 2 out of 3 keys are missing
+    Map<int, int> map;
+    map.BeginBulk();
+    for (int i = 0; i < num; i++) {
+        map.AddBulk(i * 3, i);
+    }
+    map.EndBulk();
+    FlatLookupMap<int, int> flat;
+    flat.Build(map);
+    Array<int> keys = shuffled(num * 3);
+    keys.EraseRange(num, keys.Size() - num);
+    Benchmark::Measure("Map", "Map", "find_index", "int", num, [&] {
+        int64_t sum = 0;
+        for (int key : keys) {
+            const int index = map.FindIndex(key);
+            if (InvalidIndex != index) {
+                sum += map.ValueAtIndex(index);
+            }
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Map", "FlatLookupMap", "find_index", "int", num, [&] {
+        int64_t sum = 0;
+        for (int key : keys) {
+            const int index = flat.FindIndex(key);
+            if (InvalidIndex != index) {
+                sum += flat.ValueAtIndex(index);
+            }
+        }
+        Benchmark::Consume(sum);
+    });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchHashMap(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+
+    Benchmark::Measure("HashMap", "HashMap", "insert", type, num, [&] {
+        HashMap<otype, int> m;
+        for (int i = 0; i < num; i++) {
+            m.Add(data.oryol[i], i);
+        }
+        Benchmark::Consume(m.Size());
+    });
+    Benchmark::Measure("HashMap", "std::unordered_map", "insert", type, num, [&] {
+        std::unordered_map<stype, int> m;
+        for (int i = 0; i < num; i++) {
+            m.insert(std::make_pair(data.std[i], i));
+        }
+        Benchmark::Consume(m.size());
+    });
+
+    HashMap<otype, int> om;
+    std::unordered_map<stype, int> sm;
+    for (int i = 0; i < num; i++) {
+        om.Add(data.oryol[i], i);
+        sm.insert(std::make_pair(data.std[i], i));
+    }
+
+    Benchmark::Measure("HashMap", "HashMap", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& key : data.oryol) {
+            sum += om[key];
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("HashMap", "std::unordered_map", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& key : data.std) {
+            sum += sm.find(key)->second;
+        }
+        Benchmark::Consume(sum);
+    });
+
+    Benchmark::Measure("HashMap", "HashMap", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& kvp : om) {
+            sum += kvp.Value();
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("HashMap", "std::unordered_map", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& kvp : sm) {
+            sum += kvp.second;
+        }
+        Benchmark::Consume(sum);
+    });
+
+    HashMap<otype, int> m0;
+    Benchmark::Measure("HashMap", "HashMap", "erase", type, num,
+        [&] { m0 = om; },
+        [&] {
+            for (const auto& key : data.oryol) {
+                m0.Erase(key);
+            }
+        });
+    std::unordered_map<stype, int> m1;
+    Benchmark::Measure("HashMap", "std::unordered_map", "erase", type, num,
+        [&] { m1 = sm; },
+        [&] {
+            for (const auto& key : data.std) {
+                m1.erase(key);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchSet(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+
+    if (num <= 10000) {
+        Benchmark::Measure("Set", "Set", "insert", type, num, [&] {
+            Set<otype> s;
+            for (const auto& v : data.oryol) {
+                s.Add(v);
+            }
+            Benchmark::Consume(s.Size());
+        });
+    }
+    Benchmark::Measure("Set", "Set", "bulk_insert", type, num, [&] {
+        Set<otype> s;
+        s.BeginBulk();
+        for (const auto& v : data.oryol) {
+            s.AddBulk(v);
+        }
+        s.EndBulk();
+        Benchmark::Consume(s.Size());
+    });
+    Benchmark::Measure("Set", "std::set", "insert", type, num, [&] {
+        std::set<stype> s;
+        for (const auto& v : data.std) {
+            s.insert(v);
+        }
+        Benchmark::Consume(s.size());
+    });
+
+    Set<otype> os;
+    std::set<stype> ss;
+    os.BeginBulk();
+    for (int i = 0; i < num; i++) {
+        os.AddBulk(data.oryol[i]);
+        ss.insert(data.std[i]);
+    }
+    os.EndBulk();
+
+    Benchmark::Measure("Set", "Set", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.oryol) {
+            sum += os.Contains(v) ? 1 : 0;
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Set", "std::set", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.std) {
+            sum += ss.count(v);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    Benchmark::Measure("Set", "Set", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : os) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("Set", "std::set", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : ss) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    if (num <= 10000) {
+        Set<otype> s;
+        Benchmark::Measure("Set", "Set", "erase", type, num,
+            [&] { s = os; },
+            [&] {
+                for (const auto& v : data.oryol) {
+                    s.Erase(v);
+                }
+            });
+    }
+    std::set<stype> s;
+    Benchmark::Measure("Set", "std::set", "erase", type, num,
+        [&] { s = ss; },
+        [&] {
+            for (const auto& v : data.std) {
+                s.erase(v);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchHashSet(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+
+    Benchmark::Measure("HashSet", "HashSet", "insert", type, num, [&] {
+        HashSet<otype> s;
+        for (const auto& v : data.oryol) {
+            s.Add(v);
+        }
+        Benchmark::Consume(s.Size());
+    });
+    Benchmark::Measure("HashSet", "std::unordered_set", "insert", type, num, [&] {
+        std::unordered_set<stype> s;
+        for (const auto& v : data.std) {
+            s.insert(v);
+        }
+        Benchmark::Consume(s.size());
+    });
+
+    HashSet<otype> os;
+    std::unordered_set<stype> ss;
+    for (int i = 0; i < num; i++) {
+        os.Add(data.oryol[i]);
+        ss.insert(data.std[i]);
+    }
+
+    Benchmark::Measure("HashSet", "HashSet", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.oryol) {
+            sum += os.Contains(v) ? 1 : 0;
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("HashSet", "std::unordered_set", "lookup", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : data.std) {
+            sum += ss.count(v);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    Benchmark::Measure("HashSet", "HashSet", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : os) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("HashSet", "std::unordered_set", "iterate", type, num, [&] {
+        int64_t sum = 0;
+        for (const auto& v : ss) {
+            sum += T::Value(v);
+        }
+        Benchmark::Consume(sum);
+    });
+
+    HashSet<otype> s0;
+    Benchmark::Measure("HashSet", "HashSet", "erase", type, num,
+        [&] { s0 = os; },
+        [&] {
+            for (const auto& v : data.oryol) {
+                s0.Erase(v);
+            }
+        });
+    std::unordered_set<stype> s1;
+    Benchmark::Measure("HashSet", "std::unordered_set", "erase", type, num,
+        [&] { s1 = ss; },
+        [&] {
+            for (const auto& v : data.std) {
+                s1.erase(v);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchQueue(int num) {
+    typedef typename T::oryolType otype;
+    typedef typename T::stdType stype;
+    const char* type = T::Name();
+    testData<T> data(num);
+
+    Benchmark::Measure("Queue", "Queue", "insert", type, num, [&] {
+        Queue<otype> q;
+        for (const auto& v : data.oryol) {
+            q.Enqueue(v);
+        }
+        Benchmark::Consume(q.Size());
+    });
+    Benchmark::Measure("Queue", "std::deque", "insert", type, num, [&] {
+        std::deque<stype> q;
+        for (const auto& v : data.std) {
+            q.push_back(v);
+        }
+        Benchmark::Consume(q.size());
+    });
+
+    Queue<otype> oq;
+    std::deque<stype> sq;
+    Benchmark::Measure("Queue", "Queue", "erase", type, num,
+        [&] {
+            for (const auto& v : data.oryol) {
+                oq.Enqueue(v);
+            }
+        },
+        [&] {
+            int64_t sum = 0;
+            while (!oq.Empty()) {
+                sum += T::Value(oq.Dequeue());
+            }
+            Benchmark::Consume(sum);
+        });
+    Benchmark::Measure("Queue", "std::deque", "erase", type, num,
+        [&] {
+            for (const auto& v : data.std) {
+                sq.push_back(v);
+            }
+        },
+        [&] {
+            int64_t sum = 0;
+            while (!sq.empty()) {
+                sum += T::Value(sq.front());
+                sq.pop_front();
+            }
+            Benchmark::Consume(sum);
+        });
+}
+
+//------------------------------------------------------------------------------
+void
+benchBufferChain(int num) {
+    // accumulate a download which arrives in num 4 KByte pieces,
+    // only up to 40 MBytes
+    if (num > 10000) {
+        return;
+    }
+    const int pieceSize = 4096;
+    uint8_t piece[pieceSize];
+    Memory::Fill(piece, pieceSize, 0x11);
+    Benchmark::Measure("BufferChain", "Buffer", "accumulate", "4k_piece", num, [&] {
+        Buffer buf;
+        for (int i = 0; i < num; i++) {
+            buf.Add(piece, pieceSize);
+        }
+        Benchmark::Consume(buf.Size());
+    });
+    Benchmark::Measure("BufferChain", "BufferChain", "accumulate", "4k_piece", num, [&] {
+        BufferChain chain;
+        for (int i = 0; i < num; i++) {
+            chain.Add(piece, pieceSize);
+        }
+        Buffer flat = chain.Flatten();
+        Benchmark::Consume(flat.Size());
+    });
+    BufferChain::ReleasePool();
+}
+
+//------------------------------------------------------------------------------
+void
+benchBitSet(int num) {
+    // iterate over the few occupied slots of a big pool,
+    // bool array scan vs BitSet scan
+    Array<bool> flags;
+    BitSet bits(num);
+    for (int i = 0; i < num; i++) {
+        const bool used = 0 == (i % 97);
+        flags.Add(used);
+        if (used) {
+            bits.Set(i);
+        }
+    }
+    Benchmark::Measure("BitSet", "Array<bool>", "iterate", "bool", num, [&] {
+        int64_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            if (flags[i]) {
+                sum += i;
+            }
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("BitSet", "BitSet", "iterate", "bool", num, [&] {
+        int64_t sum = 0;
+        for (int i = bits.FindFirstSet(); InvalidIndex != i; i = bits.FindFirstSet(i + 1)) {
+            sum += i;
+        }
+        Benchmark::Consume(sum);
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchSmallArray(int num) {
+    // build many short-lived arrays with a handful of elements,
+    // this is where SmallArray avoids the heap allocation
+    Benchmark::Measure("SmallArray", "Array", "temp_array", "int", num, [&] {
+        int64_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            Array<int> arr;
+            for (int j = 0; j < 4; j++) {
+                arr.Add(i + j);
+            }
+            sum += arr.Back();
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("SmallArray", "SmallArray", "temp_array", "int", num, [&] {
+        int64_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            SmallArray<int, 8> arr;
+            for (int j = 0; j < 4; j++) {
+                arr.Add(i + j);
+            }
+            sum += arr.Back();
+        }
+        Benchmark::Consume(sum);
+    });
+}
+
+//------------------------------------------------------------------------------
+struct float3 {
+    float x, y, z;
+};
+struct particle {
+    float3 pos;
+    float3 vel;
+    float color[4];
+    float transform[16];
+    int flags;
+};
+
+//------------------------------------------------------------------------------
+void
+benchSoaArray(int num) {
+    // a transform-update loop which only touches position and velocity
+    const float dt = 1.0f / 60.0f;
+    Array<particle> aos;
+    aos.Reserve(num);
+    for (int i = 0; i < num; i++) {
+        particle p = { };
+        p.vel.x = float(i);
+        aos.Add(p);
+    }
+    Benchmark::Measure("SoaArray", "Array<struct>", "update", "particle", num, [&] {
+        for (particle& p : aos) {
+            p.pos.x += p.vel.x * dt;
+            p.pos.y += p.vel.y * dt;
+            p.pos.z += p.vel.z * dt;
+        }
+        Benchmark::Consume(int64_t(aos.Back().pos.x));
+    });
+    SoaArray<float3, float3, float3, int> soa;
+    soa.Reserve(num);
+    for (int i = 0; i < num; i++) {
+        float3 pos = { }, vel = { }, color = { };
+        vel.x = float(i);
+        soa.Add(pos, vel, color, 0);
+    }
+    Benchmark::Measure("SoaArray", "SoaArray", "update", "particle", num, [&] {
+        float3* pos = soa.Data<0>();
+        const float3* vel = soa.Data<1>();
+        const int size = soa.Size();
+        for (int i = 0; i < size; i++) {
+            pos[i].x += vel[i].x * dt;
+            pos[i].y += vel[i].y * dt;
+            pos[i].z += vel[i].z * dt;
+        }
+        Benchmark::Consume(int64_t(pos[size - 1].x));
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchQueueChurn(int num) {
+    // steady-state dequeue/enqueue on a half-full fixed-capacity queue,
+    // like the free-slot queue of a resource pool
+    const int capacity = 1024;
+    Queue<int> queue;
+    queue.SetFixedCapacity(capacity);
+    for (int i = 0; i < capacity / 2; i++) {
+        queue.Enqueue(i);
+    }
+    Benchmark::Measure("Queue", "Queue", "churn", "int", num, [&] {
+        uint32_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            sum += queue.Dequeue();
+            queue.Enqueue(i);
+        }
+        Benchmark::Consume(sum);
+    });
+    std::deque<int> deque;
+    for (int i = 0; i < capacity / 2; i++) {
+        deque.push_back(i);
+    }
+    Benchmark::Measure("Queue", "std::deque", "churn", "int", num, [&] {
+        uint32_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            sum += deque.front();
+            deque.pop_front();
+            deque.push_back(i);
+        }
+        Benchmark::Consume(sum);
+    });
+}
+
+//------------------------------------------------------------------------------
+template<class T> void
+benchAll(int num) {
+    benchArray<T>(num);
+    benchMap<T>(num);
+    benchHashMap<T>(num);
+    benchSet<T>(num);
+    benchHashSet<T>(num);
+    benchQueue<T>(num);
+}
+
+//------------------------------------------------------------------------------
+// same layout, but the first one is trivially relocatable and the second isn't
+struct vec4 {
+    float x, y, z, w;
+};
+struct vec4Slow {
+    vec4Slow() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) { };
+    vec4Slow(const vec4Slow& rhs) : x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w) { };
+    vec4Slow(vec4Slow&& rhs) : x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w) { };
+    void operator=(const vec4Slow& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; w = rhs.w; };
+    void operator=(vec4Slow&& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; w = rhs.w; };
+    float x, y, z, w;
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+benchElementBuffer(int num, const char* type) {
+    Benchmark::Measure("elementBuffer", "elementBuffer", "grow", type, num, [&] {
+        _priv::elementBuffer<TYPE> buf;
+        buf.alloc(16, 0);
+        for (int i = 0; i < num; i++) {
+            if (0 == buf.backSpare()) {
+                buf.alloc(buf.capacity() * 2, 0);
+            }
+            buf.pushBack(TYPE());
+        }
+        Benchmark::Consume(buf.size());
+    });
+    // insert and erase in the middle is O(n^2), only time it for small buffers
+    if (num <= 10000) {
+        Benchmark::Measure("elementBuffer", "elementBuffer", "insert_erase", type, num, [&] {
+            _priv::elementBuffer<TYPE> buf;
+            buf.alloc(num * 2, num / 2);
+            for (int i = 0; i < num; i++) {
+                buf.insert(buf.size() / 2, TYPE());
+            }
+            for (int i = 0; i < num; i++) {
+                buf.erase(buf.size() / 2);
+            }
+            Benchmark::Consume(buf.size());
+        });
+    }
+}
+
+//------------------------------------------------------------------------------
+// pass items from producer to consumer threads, a mutex-protected
+// Queue vs the lock-free SpscQueue and MpmcQueue
+#if ORYOL_HAS_THREADS
+void
+benchThreadQueues(int num) {
+    Benchmark::Measure("SpscQueue", "Queue+mutex", "transfer", "int", num, [&] {
+        Queue<int> queue;
+        std::mutex mutex;
+        std::thread consumer([&]() {
+            int numDequeued = 0;
+            while (numDequeued < num) {
+                std::lock_guard<std::mutex> lock(mutex);
+                while (!queue.Empty()) {
+                    queue.Dequeue();
+                    numDequeued++;
+                }
+            }
+        });
+        for (int i = 0; i < num; i++) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.Enqueue(i);
+        }
+        consumer.join();
+    });
+    Benchmark::Measure("SpscQueue", "SpscQueue", "transfer", "int", num, [&] {
+        SpscQueue<int> queue(1024);
+        std::thread consumer([&]() {
+            int val = 0;
+            for (int i = 0; i < num; i++) {
+                while (!queue.TryDequeue(val)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (int i = 0; i < num; i++) {
+            while (!queue.TryEnqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+        consumer.join();
+    });
+
+    const int numProducers = 4;
+    const int numConsumers = 4;
+    const int numPerProducer = num / numProducers;
+    const int numTotal = numProducers * numPerProducer;
+    std::thread producers[numProducers];
+    std::thread consumers[numConsumers];
+    Benchmark::Measure("MpmcQueue", "Queue+mutex", "transfer", "int", numTotal, [&] {
+        Queue<int> queue;
+        std::mutex mutex;
+        std::atomic<int> numDequeued(0);
+        for (int c = 0; c < numConsumers; c++) {
+            consumers[c] = std::thread([&]() {
+                while (numDequeued.load() < numTotal) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!queue.Empty()) {
+                        queue.Dequeue();
+                        numDequeued++;
+                    }
+                }
+            });
+        }
+        for (int p = 0; p < numProducers; p++) {
+            producers[p] = std::thread([&]() {
+                for (int i = 0; i < numPerProducer; i++) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.Enqueue(i);
+                }
+            });
+        }
+        for (int p = 0; p < numProducers; p++) {
+            producers[p].join();
+        }
+        for (int c = 0; c < numConsumers; c++) {
+            consumers[c].join();
+        }
+    });
+    Benchmark::Measure("MpmcQueue", "MpmcQueue", "transfer", "int", numTotal, [&] {
+        MpmcQueue<int> queue(1024);
+        std::atomic<int> numDequeued(0);
+        for (int c = 0; c < numConsumers; c++) {
+            consumers[c] = std::thread([&]() {
+                int val = 0;
+                while (numDequeued.load() < numTotal) {
+                    if (queue.TryDequeue(val)) {
+                        numDequeued++;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int p = 0; p < numProducers; p++) {
+            producers[p] = std::thread([&]() {
+                for (int i = 0; i < numPerProducer; i++) {
+                    while (!queue.TryEnqueue(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int p = 0; p < numProducers; p++) {
+            producers[p].join();
+        }
+        for (int c = 0; c < numConsumers; c++) {
+            consumers[c].join();
+        }
+    });
+}
+#endif
+
+//------------------------------------------------------------------------------
+// the previous StringAtom hash (one-at-a-time), for comparison
+uint32_t
+oneAtATime(const char* str, int len) {
+    uint32_t h = 0;
+    for (int i = 0; i < len; i++) {
+        h += uint32_t(str[i]);
+        h += (h << 10);
+        h ^= (h >> 6);
+    }
+    h += (h << 3);
+    h ^= (h >> 11);
+    h += (h << 15);
+    return h;
+}
+
+//------------------------------------------------------------------------------
+// the previous container hash (FNV-1a), for comparison
+uint32_t
+fnv1a(const char* str, int len) {
+    uint32_t h = 2166136261U;
+    for (int i = 0; i < len; i++) {
+        h ^= uint8_t(str[i]);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+//------------------------------------------------------------------------------
+void
+benchHash(int num) {
+    // hash asset-path-like strings
+    static const char* dirs[] = {
+        "res:textures/", "tex:characters/", "data:levels/level_01/props/",
+        "http://floooh.github.io/oryol/data/"
+    };
+    Array<String> paths;
+    paths.Reserve(num);
+    char buf[256];
+    for (int i = 0; i < num; i++) {
+        std::snprintf(buf, sizeof(buf), "%s%d/lok_dxt%d.dds", dirs[i & 3], i, i % 5);
+        paths.Add(buf);
+    }
+    Benchmark::Measure("Hash", "HashBytes64", "hash", "path", num, [&] {
+        uint64_t sum = 0;
+        for (const String& path : paths) {
+            sum += HashBytes64(path.AsCStr(), path.Length());
+        }
+        Benchmark::Consume(int64_t(sum));
+    });
+    Benchmark::Measure("Hash", "one-at-a-time", "hash", "path", num, [&] {
+        uint64_t sum = 0;
+        for (const String& path : paths) {
+            sum += oneAtATime(path.AsCStr(), path.Length());
+        }
+        Benchmark::Consume(int64_t(sum));
+    });
+    Benchmark::Measure("Hash", "FNV-1a", "hash", "path", num, [&] {
+        uint64_t sum = 0;
+        for (const String& path : paths) {
+            sum += fnv1a(path.AsCStr(), path.Length());
+        }
+        Benchmark::Consume(int64_t(sum));
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchStringFormat(int num) {
+    // format short log message fields into strings
+    const char* names[] = { "frame", "draw calls", "triangles", "tex binds" };
+    StringBuilder builder;
+    Benchmark::Measure("String", "String", "format", "string", num, [&] {
+        int64_t len = 0;
+        for (int i = 0; i < num; i++) {
+            builder.Format(64, "%s: %d", names[i & 3], i);
+            String field = builder.GetString();
+            String copy = field;
+            String name(names[i & 3]);
+            len += copy.Length() + name.Length();
+        }
+        Benchmark::Consume(len);
+    });
+    Benchmark::Measure("String", "std::string", "format", "string", num, [&] {
+        char buf[64];
+        int64_t len = 0;
+        for (int i = 0; i < num; i++) {
+            std::snprintf(buf, sizeof(buf), "%s: %d", names[i & 3], i);
+            std::string field(buf);
+            std::string copy = field;
+            std::string name(names[i & 3]);
+            len += int64_t(copy.length() + name.length());
+        }
+        Benchmark::Consume(len);
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchNumbers(int num) {
+    // parse a typical config/asset file mix of ints and floats
+    const int numStrs = 1024;
+    static char strs[numStrs][32];
+    for (int i = 0; i < numStrs; i++) {
+        if (i & 1) {
+            std::snprintf(strs[i], sizeof(strs[i]), "%d", i * 7919 - 100000);
+        }
+        else {
+            std::snprintf(strs[i], sizeof(strs[i]), "%.*f", i % 7, float(i) * 0.731f - 50.0f);
+        }
+    }
+    Benchmark::Measure("String", "StringConverter", "parse_number", "string", num, [&] {
+        double sum = 0.0;
+        for (int i = 0; i < num; i += 2) {
+            sum += StringConverter::FromString<float>(strs[i & (numStrs - 1)]);
+            sum += StringConverter::FromString<int>(strs[(i + 1) & (numStrs - 1)]);
+        }
+        Benchmark::Consume(int64_t(sum));
+    });
+    Benchmark::Measure("String", "atof/atoi", "parse_number", "string", num, [&] {
+        double sum = 0.0;
+        for (int i = 0; i < num; i += 2) {
+            sum += float(std::atof(strs[i & (numStrs - 1)]));
+            sum += std::atoi(strs[(i + 1) & (numStrs - 1)]);
+        }
+        Benchmark::Consume(int64_t(sum));
+    });
+
+    // build HUD-style lines of numbers
+    StringBuilder builder;
+    Benchmark::Measure("String", "AppendInt/AppendFloat", "format_number", "string", num, [&] {
+        int64_t len = 0;
+        for (int i = 0; i < num; i++) {
+            builder.Set("frame: ");
+            builder.AppendInt(i);
+            builder.Append(" time: ");
+            builder.AppendFloat(float(i) * 0.016f, 3);
+            builder.Append(" pos: ");
+            builder.AppendFloat(float(i) * 0.37f);
+            len += builder.Length();
+        }
+        Benchmark::Consume(len);
+    });
+    Benchmark::Measure("String", "Format", "format_number", "string", num, [&] {
+        int64_t len = 0;
+        for (int i = 0; i < num; i++) {
+            builder.Format(128, "frame: %d time: %.3f pos: %.9g", i, float(i) * 0.016f, float(i) * 0.37f);
+            len += builder.Length();
+        }
+        Benchmark::Consume(len);
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchStringAtom(int num) {
+    // each call interns new strings, so that the atom table lookup misses
+    static int uniqueCounter = 0;
+
+    // creating unique atoms shouldn't slow down with the number of atoms
+    Benchmark::Measure("StringAtom", "StringAtom", "intern_unique", "string", num, [&] {
+        char str[32];
+        for (int i = 0; i < num; i++) {
+            std::snprintf(str, sizeof(str), "unique_%d", uniqueCounter++);
+            StringAtom atom(str);
+        }
+    });
+
+    // literal atoms vs constructing atoms from C strings
+    const StringAtom& literal = o_atom("literal_atom");
+    Benchmark::Measure("StringAtom", "StringAtom", "from_cstr", "string", num, [&] {
+        int64_t numEqual = 0;
+        for (int i = 0; i < num; i++) {
+            StringAtom atom("literal_atom");
+            numEqual += atom == literal ? 1 : 0;
+        }
+        Benchmark::Consume(numEqual);
+    });
+    Benchmark::Measure("StringAtom", "o_atom", "from_cstr", "string", num, [&] {
+        int64_t numEqual = 0;
+        for (int i = 0; i < num; i++) {
+            numEqual += o_atom("literal_atom") == literal ? 1 : 0;
+        }
+        Benchmark::Consume(numEqual);
+    });
+
+    #if ORYOL_HAS_THREADS
+    // 4 threads intern the same new strings in a different order
+    const int numThreads = 4;
+    std::thread threads[numThreads];
+    Benchmark::Measure("StringAtom", "StringAtom", "intern_threads", "string", num, [&] {
+        const int base = uniqueCounter;
+        uniqueCounter += num;
+        for (int t = 0; t < numThreads; t++) {
+            const int offset = t * (num / numThreads);
+            threads[t] = std::thread([num, base, offset] {
+                char str[32];
+                for (int i = 0; i < num; i++) {
+                    const int index = (i + offset) % num;
+                    std::snprintf(str, sizeof(str), "intern_%d", base + index);
+                    StringAtom atom(str);
+                }
+            });
+        }
+        for (int t = 0; t < numThreads; t++) {
+            threads[t].join();
+        }
+    });
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+benchFrameArena(int num) {
+    // per-frame temporary arrays on the heap vs the frame arena
+    Benchmark::Measure("FrameArena", "heap", "temp_array", "int", num, [&] {
+        int64_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            Array<int> arr;
+            arr.Reserve(64);
+            arr.Add(i);
+            sum += arr.Size();
+        }
+        Benchmark::Consume(sum);
+    });
+    Benchmark::Measure("FrameArena", "FrameArena", "temp_array", "int", num, [&] {
+        int64_t sum = 0;
+        for (int i = 0; i < num; i++) {
+            Array<int> arr;
+            arr.UseFrameArena();
+            arr.Reserve(64);
+            arr.Add(i);
+            sum += arr.Size();
+        }
+        FrameArena::Reset();
+        Benchmark::Consume(sum);
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+benchSort(int num) {
+    Array<uint32_t> src;
+    src.Reserve(num);
+    uint32_t x = 2463534242;
+    for (int i = 0; i < num; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        src.Add(x);
+    }
+    Array<uint32_t> arr;
+    Benchmark::Measure("Sort", "std::sort", "sort", "uint32", num,
+        [&] { arr = src; },
+        [&] { std::sort(arr.begin(), arr.end()); });
+    Benchmark::Measure("Sort", "Sort::Radix", "sort", "uint32", num,
+        [&] { arr = src; },
+        [&] { Sort::Radix(arr.begin(), arr.end()); });
+    Benchmark::Measure("Sort", "Sort::Parallel", "sort", "uint32", num,
+        [&] { arr = src; },
+        [&] { Sort::Parallel(arr.begin(), arr.end()); });
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+class CoreBenchmarksApp : public App {
+public:
+    AppState::Code OnRunning() {
+        Benchmark::Options options;
+        options.NumWarmup = OryolArgs.GetInt("-warmup", options.NumWarmup);
+        options.NumRuns = OryolArgs.GetInt("-runs", options.NumRuns);
+        options.Filter = OryolArgs.GetString("-filter");
+        Benchmark::Setup(options);
+        const int maxNum = OryolArgs.GetInt("-maxn", 100000);
+        for (int num = 100; num <= maxNum; num *= 10) {
+            benchAll<intType>(num);
+            benchAll<stringType>(num);
+            benchFindIndex(num);
+            benchBufferChain(num);
+            benchBitSet(num);
+            benchSmallArray(num);
+            benchSoaArray(num);
+            benchQueueChurn(num);
+            benchElementBuffer<vec4>(num, "vec4");
+            benchElementBuffer<vec4Slow>(num, "vec4Slow");
+            #if ORYOL_HAS_THREADS
+            benchThreadQueues(num);
+            #endif
+            benchHash(num);
+            benchStringFormat(num);
+            benchNumbers(num);
+            benchStringAtom(num);
+            benchFrameArena(num);
+            benchSort(num);
+        }
+        Benchmark::WriteJSON(OryolArgs.GetString("-out", "CoreBenchmarks.json").AsCStr());
+        this->requestQuit();
+        return App::OnRunning();
+    }
+};
+OryolMain(CoreBenchmarksApp);
@@ -5,6 +5,7 @@
     @brief Oryol class annotation macros
 */
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
 
 /// declare an Oryol class without pool allocator (located inside class declaration)
 #define OryolBaseClassDecl(TYPE) \
@@ -28,6 +29,17 @@ template<typename... ARGS> static Oryol::Ptr<TYPE> Create(ARGS&&... args) {\
     return Oryol::Ptr<TYPE>(Oryol::Memory::New<TYPE>(std::forward<ARGS>(args)...));\
 };
 
+/// declare an Oryol class with pool allocator, NUM objects are allocated at once (located inside class declaration)
+#define OryolClassPoolAllocDecl(TYPE, NUM) \
+protected:\
+virtual void destroy() override {\
+    Oryol::PoolAllocator::Delete(this);\
+};\
+public:\
+template<typename... ARGS> static Oryol::Ptr<TYPE> Create(ARGS&&... args) {\
+    return Oryol::Ptr<TYPE>(Oryol::PoolAllocator::New<TYPE,NUM>(std::forward<ARGS>(args)...));\
+};
+
 /// add simple RTTI system to a class, inspired by turbobadger's RTTI system
 namespace Oryol {
     typedef void* TypeId;
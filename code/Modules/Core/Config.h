@@ -39,6 +39,16 @@
 #define ORYOL_MAX_PLATFORM_ALIGN (16)
 #endif
 
+/// size of a CPU cache line, used to keep data apart which is written by different threads
+#define ORYOL_CACHE_LINE_SIZE (64)
+
+/// prefetch memory into the cache (a hint, does nothing if the compiler has no prefetch builtin)
+#if defined(__GNUC__)
+#define ORYOL_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define ORYOL_PREFETCH(addr)
+#endif
+
 /// memory debug fill pattern (byte)
 #define ORYOL_MEMORY_DEBUG_BYTE (0xBB)
 /// memory debug fill pattern (short)
@@ -51,6 +61,11 @@
 /// maximum grow size for dynamic container classes (num elements)
 #define ORYOL_CONTAINER_DEFAULT_MAX_GROW (1<<16)
 
+/// default initial capacity of the per-thread frame arena (bytes)
+#ifndef ORYOL_FRAME_ARENA_SIZE
+#define ORYOL_FRAME_ARENA_SIZE (64 * 1024)
+#endif
+
 #ifndef __GNUC__
 #define __attribute__(x)
 #endif
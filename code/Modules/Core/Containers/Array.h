@@ -25,23 +25,49 @@
     
     NOTE: An array growth operation will truncate any spare room
     at the front.
+
+    Call UseFrameArena() on an empty array to allocate its memory from
+    the thread's FrameArena (for transient per-frame arrays), the array
+    must not be accessed after the end of the frame. A copy of such an
+    array is allocated from the heap.
+
+    Call SetAlignment() on an empty array to align the element storage
+    to more than ORYOL_MAX_PLATFORM_ALIGN (e.g. 32 bytes for AVX loads
+    and stores, or 64 bytes for cache-line aligned data). Over-aligned
+    arrays keep begin() aligned: they have no spare room at the front,
+    so erasing at the front moves the remaining elements down. With the
+    default alignment only the storage start is aligned, begin() moves
+    forward when elements are erased at the front.
+
+    The optional ALLOCATOR template parameter is an allocator policy
+    (see HeapAllocator), to keep the array's memory in a dedicated
+    heap, e.g. a LinearArena with the ArenaAllocator policy. Copies
+    and moves take over the allocator object of the source array.
     
-    For sorting, iterating and sorted insertion, use the standard 
-    algorithm stuff!
+    AddBulk() and InsertBulk() add a whole range of elements (e.g.
+    from a Slice into another Array, or from raw memory), the array grows
+    at most once, and trivially copyable elements are copied with memcpy.
+
+    Sort() sorts the elements in place with Sort::Auto() (radix sort
+    for arithmetic types, std::sort() otherwise). For
+    iterating and sorted insertion, use the standard algorithm stuff!
     
     @see ArrayMap, Map, Set, HashSet
 */
 #include "Core/Config.h"
 #include "Core/Containers/elementBuffer.h"
 #include "Core/Containers/Slice.h"
+#include "Core/Containers/Sort.h"
 #include <initializer_list>
 
 namespace Oryol {
 
-template<class TYPE> class Array {
+template<class TYPE, class ALLOCATOR=HeapAllocator> class Array {
 public:
     /// default constructor
     Array();
+    /// construct with allocator object
+    explicit Array(const ALLOCATOR& allocator);
     /// copy constructor (truncates to actual size)
     Array(const Array& rhs);
     /// move constructor (same capacity and size)
@@ -60,6 +86,18 @@ public:
     void SetAllocStrategy(int minGrow_, int maxGrow_=ORYOL_CONTAINER_DEFAULT_MAX_GROW);
     /// initialize the array to a fixed capacity (guarantees that no re-allocs happen)
     void SetFixedCapacity(int fixedCapacity);
+    /// allocate from the thread's FrameArena (array must not have been allocated yet)
+    void UseFrameArena();
+    /// return true if the array allocates from the FrameArena
+    bool IsFrameArena() const;
+    /// set alignment of element storage (power of 2, array must not have been allocated yet)
+    void SetAlignment(int alignment);
+    /// get alignment of element storage
+    int GetAlignment() const;
+    /// set allocator object (array must not have been allocated yet)
+    void SetAllocator(const ALLOCATOR& allocator);
+    /// get allocator object
+    const ALLOCATOR& GetAllocator() const;
     /// get min grow value
     int GetMinGrow() const;
     /// get max grow value
@@ -105,6 +143,10 @@ public:
     void Insert(int index, const TYPE& elm);
     /// move-insert element at index, keep array order
     void Insert(int index, TYPE&& elm);
+    /// copy-add a range of elements to back of array
+    void AddBulk(const Slice<const TYPE>& elms);
+    /// copy-insert a range of elements at index, keep array order
+    void InsertBulk(int index, const Slice<const TYPE>& elms);
 
     /// pop the last element
     TYPE PopBack();
@@ -123,6 +165,8 @@ public:
     
     /// find element index with slow linear search, return InvalidIndex if not found
     int FindIndexLinear(const TYPE& elm, int startIndex=0, int endIndex=InvalidIndex) const;
+    /// sort elements in ascending order (see Sort::Auto())
+    void Sort();
     
     /// C++ conform begin
     TYPE* begin();
@@ -144,52 +188,62 @@ private:
     void adjustCapacity(int newCapacity);
     /// grow to make room
     void grow();
+    /// make room for num elements at the back, grows at most once
+    void growBulk(int num);
     
-    _priv::elementBuffer<TYPE> buffer;
+    _priv::elementBuffer<TYPE, ALLOCATOR> buffer;
     int minGrow;
     int maxGrow;
 };
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Array<TYPE>::Array() :
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::Array() :
 minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
 maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
     // empty
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Array<TYPE>::Array(const Array& rhs) {
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::Array(const ALLOCATOR& allocator) :
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+    this->buffer.allocator = allocator;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::Array(const Array& rhs) {
     this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Array<TYPE>::Array(Array&& rhs) {
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::Array(Array&& rhs) {
     this->move(std::move(rhs));
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Array<TYPE>::Array(std::initializer_list<TYPE> l) :
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::Array(std::initializer_list<TYPE> l) :
 minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
 maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
-    this->Reserve(int(l.size()));
-    for (const auto& elm : l) {
-        this->Add(elm);
+    if (l.size() > 0) {
+        this->Reserve(int(l.size()));
+        this->AddBulk(Slice<const TYPE>(l.begin(), int(l.size())));
     }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Array<TYPE>::~Array() {
+template<class TYPE, class ALLOCATOR>
+Array<TYPE, ALLOCATOR>::~Array() {
     this->destroy();
 };
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::operator=(const Array<TYPE>& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::operator=(const Array<TYPE, ALLOCATOR>& rhs) {
     /// @todo: this should be optimized when rhs.size() < this->capacity()!
     if (&rhs != this) {
         this->destroy();
@@ -198,8 +252,8 @@ Array<TYPE>::operator=(const Array<TYPE>& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::operator=(Array<TYPE>&& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::operator=(Array<TYPE, ALLOCATOR>&& rhs) {
     /// @todo: this should be optimized when rhs.size() < this->capacity()!
     if (&rhs != this) {
         this->destroy();
@@ -208,15 +262,15 @@ Array<TYPE>::operator=(Array<TYPE>&& rhs) {
 }
     
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::SetAllocStrategy(int minGrow_, int maxGrow_) {
     this->minGrow = minGrow_;
     this->maxGrow = maxGrow_;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::SetFixedCapacity(int fixedCapacity) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::SetFixedCapacity(int fixedCapacity) {
     this->minGrow = 0;
     this->maxGrow = 0;
     if (fixedCapacity > this->buffer.capacity()) {
@@ -225,80 +279,121 @@ Array<TYPE>::SetFixedCapacity(int fixedCapacity) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::GetMinGrow() const {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::UseFrameArena() {
+    o_assert_dbg(0 == this->buffer.capacity());
+    o_assert_dbg(FrameArena::IsValid());
+    this->buffer.frameArena = true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> bool
+Array<TYPE, ALLOCATOR>::IsFrameArena() const {
+    return this->buffer.frameArena;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::SetAlignment(int alignment) {
+    o_assert_dbg(0 == this->buffer.capacity());
+    o_assert_dbg((alignment > 0) && (alignment <= (1<<15)) && (0 == (alignment & (alignment - 1))));
+    this->buffer.alignment = alignment;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::GetAlignment() const {
+    return this->buffer.alignment;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::SetAllocator(const ALLOCATOR& allocator) {
+    o_assert_dbg(0 == this->buffer.capacity());
+    this->buffer.allocator = allocator;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> const ALLOCATOR&
+Array<TYPE, ALLOCATOR>::GetAllocator() const {
+    return this->buffer.allocator;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::GetMinGrow() const {
         return this->minGrow;
     }
     
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::GetMaxGrow() const {
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::GetMaxGrow() const {
     return this->maxGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::Size() const {
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::Size() const {
     return this->buffer.size();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> bool
-Array<TYPE>::Empty() const {
+template<class TYPE, class ALLOCATOR> bool
+Array<TYPE, ALLOCATOR>::Empty() const {
     return this->buffer.size() == 0;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::Capacity() const {
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::Capacity() const {
     return this->buffer.capacity();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::Spare() const {
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::Spare() const {
     return this->buffer.backSpare();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Array<TYPE>::operator[](int index) {
+template<class TYPE, class ALLOCATOR> TYPE&
+Array<TYPE, ALLOCATOR>::operator[](int index) {
     return this->buffer[index];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-Array<TYPE>::operator[](int index) const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+Array<TYPE, ALLOCATOR>::operator[](int index) const {
     return this->buffer[index];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Array<TYPE>::Front() {
+template<class TYPE, class ALLOCATOR> TYPE&
+Array<TYPE, ALLOCATOR>::Front() {
     return this->buffer.front();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-Array<TYPE>::Front() const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+Array<TYPE, ALLOCATOR>::Front() const {
     return this->buffer.front();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Array<TYPE>::Back() {
+template<class TYPE, class ALLOCATOR> TYPE&
+Array<TYPE, ALLOCATOR>::Back() {
     return this->buffer.back();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-Array<TYPE>::Back() const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+Array<TYPE, ALLOCATOR>::Back() const {
     return this->buffer.back();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> Slice<TYPE>
-Array<TYPE>::MakeSlice(int offset, int numItems) {
+template<class TYPE, class ALLOCATOR> Slice<TYPE>
+Array<TYPE, ALLOCATOR>::MakeSlice(int offset, int numItems) {
     if (numItems == EndOfRange) {
         numItems = this->buffer.size() - offset;
     }
@@ -306,8 +401,8 @@ Array<TYPE>::MakeSlice(int offset, int numItems) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Reserve(int numElements) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Reserve(int numElements) {
     int newCapacity = this->buffer.size() + numElements;
     if (newCapacity > this->buffer.capacity()) {
         this->adjustCapacity(newCapacity);
@@ -315,8 +410,8 @@ Array<TYPE>::Reserve(int numElements) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Trim() {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Trim() {
     const int curSize = this->buffer.size();
     if (curSize < this->buffer.capacity()) {
         this->adjustCapacity(curSize);
@@ -324,14 +419,14 @@ Array<TYPE>::Trim() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Clear() {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Clear() {
     this->buffer.clear();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Array<TYPE>::Add(const TYPE& elm) {
+template<class TYPE, class ALLOCATOR> TYPE&
+Array<TYPE, ALLOCATOR>::Add(const TYPE& elm) {
     if (this->buffer.backSpare() == 0) {
         this->grow();
     }
@@ -340,8 +435,8 @@ Array<TYPE>::Add(const TYPE& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Array<TYPE>::Add(TYPE&& elm) {
+template<class TYPE, class ALLOCATOR> TYPE&
+Array<TYPE, ALLOCATOR>::Add(TYPE&& elm) {
     if (this->buffer.backSpare() == 0) {
         this->grow();
     }
@@ -350,8 +445,8 @@ Array<TYPE>::Add(TYPE&& elm) {
 }
     
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Insert(int index, const TYPE& elm) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Insert(int index, const TYPE& elm) {
     if (this->buffer.spare() == 0) {
         this->grow();
     }
@@ -359,8 +454,8 @@ Array<TYPE>::Insert(int index, const TYPE& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Insert(int index, TYPE&& elm) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Insert(int index, TYPE&& elm) {
     if (this->buffer.spare() == 0) {
         this->grow();
     }
@@ -369,8 +464,47 @@ Array<TYPE>::Insert(int index, TYPE&& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> template<class... ARGS> TYPE&
-Array<TYPE>::Add(ARGS&&... args) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::AddBulk(const Slice<const TYPE>& elms) {
+    const int num = elms.Size();
+    if (num > 0) {
+        if (this->buffer.backSpare() < num) {
+            if (this->buffer.overlaps(this->buffer.buf, elms.begin(), this->buffer.cap)) {
+                // elms is a slice of this array, growing frees the old storage
+                const int index = int(elms.begin() - this->buffer._begin());
+                this->growBulk(num);
+                this->buffer.pushBackRange(this->buffer._begin() + index, num);
+                return;
+            }
+            this->growBulk(num);
+        }
+        this->buffer.pushBackRange(elms.begin(), num);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::InsertBulk(int index, const Slice<const TYPE>& elms) {
+    o_assert_dbg((index >= 0) && (index <= this->buffer.size()));
+    const int num = elms.Size();
+    if (num > 0) {
+        if (this->buffer.overlaps(this->buffer.buf, elms.begin(), this->buffer.cap)) {
+            // elms is a slice of this array, which is shifted by the insertion
+            Array<TYPE, ALLOCATOR> copy(this->buffer.allocator);
+            copy.AddBulk(elms);
+            this->InsertBulk(index, copy.MakeSlice());
+            return;
+        }
+        if (this->buffer.backSpare() < num) {
+            this->growBulk(num);
+        }
+        this->buffer.insertRange(index, elms.begin(), num);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> template<class... ARGS> TYPE&
+Array<TYPE, ALLOCATOR>::Add(ARGS&&... args) {
     if (this->buffer.backSpare() == 0) {
         this->grow();
     }
@@ -379,50 +513,50 @@ Array<TYPE>::Add(ARGS&&... args) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE
-Array<TYPE>::PopBack() {
+template<class TYPE, class ALLOCATOR> TYPE
+Array<TYPE, ALLOCATOR>::PopBack() {
     return this->buffer.popBack();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE
-Array<TYPE>::PopFront() {
+template<class TYPE, class ALLOCATOR> TYPE
+Array<TYPE, ALLOCATOR>::PopFront() {
     return this->buffer.popFront();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::Erase(int index) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Erase(int index) {
     this->buffer.erase(index);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::EraseSwap(int index) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::EraseSwap(int index) {
     this->buffer.eraseSwap(index);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::EraseSwapBack(int index) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::EraseSwapBack(int index) {
     this->buffer.eraseSwapBack(index);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::EraseSwapFront(int index) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::EraseSwapFront(int index) {
     this->buffer.eraseSwapFront(index);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::EraseRange(int index, int num) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::EraseRange(int index, int num) {
     this->buffer.eraseRange(index, num);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Array<TYPE>::FindIndexLinear(const TYPE& elm, int startIndex, int endIndex) const {
+template<class TYPE, class ALLOCATOR> int
+Array<TYPE, ALLOCATOR>::FindIndexLinear(const TYPE& elm, int startIndex, int endIndex) const {
     const int size = this->buffer.size();
     if (size > 0) {
         o_assert_dbg(startIndex < size);
@@ -444,50 +578,58 @@ Array<TYPE>::FindIndexLinear(const TYPE& elm, int startIndex, int endIndex) cons
     // fallthrough: not found
     return InvalidIndex;
 }
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::Sort() {
+    if (this->buffer.size() > 1) {
+        Oryol::Sort::Auto(this->buffer._begin(), this->buffer._end());
+    }
+}
     
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-Array<TYPE>::begin() {
+template<class TYPE, class ALLOCATOR> TYPE*
+Array<TYPE, ALLOCATOR>::begin() {
     return this->buffer._begin();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE*
-Array<TYPE>::begin() const {
+template<class TYPE, class ALLOCATOR> const TYPE*
+Array<TYPE, ALLOCATOR>::begin() const {
     return this->buffer._begin();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-Array<TYPE>::end() {
+template<class TYPE, class ALLOCATOR> TYPE*
+Array<TYPE, ALLOCATOR>::end() {
     return this->buffer._end();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE*
-Array<TYPE>::end() const {
+template<class TYPE, class ALLOCATOR> const TYPE*
+Array<TYPE, ALLOCATOR>::end() const {
     return this->buffer._end();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::destroy() {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::destroy() {
     this->minGrow = 0;
     this->maxGrow = 0;
     this->buffer.destroy();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::copy(const Array& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::copy(const Array& rhs) {
     this->minGrow = rhs.minGrow;
     this->maxGrow = rhs.maxGrow;
     this->buffer = rhs.buffer;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::move(Array&& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::move(Array&& rhs) {
     this->minGrow = rhs.minGrow;
     this->maxGrow = rhs.maxGrow;
     this->buffer  = std::move(rhs.buffer);
@@ -495,14 +637,30 @@ Array<TYPE>::move(Array&& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::adjustCapacity(int newCapacity) {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::adjustCapacity(int newCapacity) {
     this->buffer.alloc(newCapacity, 0);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Array<TYPE>::grow() {
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::grow() {
+    const int curCapacity = this->buffer.capacity();
+    int growBy = curCapacity >> 1;
+    if (growBy < minGrow) {
+        growBy = minGrow;
+    }
+    else if (growBy > maxGrow) {
+        growBy = maxGrow;
+    }
+    o_assert_dbg(growBy > 0);
+    int newCapacity = curCapacity + growBy;
+    this->adjustCapacity(newCapacity);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Array<TYPE, ALLOCATOR>::growBulk(int num) {
     const int curCapacity = this->buffer.capacity();
     int growBy = curCapacity >> 1;
     if (growBy < minGrow) {
@@ -513,6 +671,9 @@ Array<TYPE>::grow() {
     }
     o_assert_dbg(growBy > 0);
     int newCapacity = curCapacity + growBy;
+    if (newCapacity < (this->buffer.size() + num)) {
+        newCapacity = this->buffer.size() + num;
+    }
     this->adjustCapacity(newCapacity);
 }
 
@@ -0,0 +1,326 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::BitSet
+    @ingroup Core
+    @brief dynamic array of bits with fast set-bit scanning
+
+    A BitSet is a resizable array of bits, stored in 64-bit words.
+    Besides setting, resetting and testing single bits it offers
+    range operations and counting, and it can search for the next set
+    or cleared bit starting at any position. All of these work on
+    whole words with compiler intrinsics (count-trailing-zeros and
+    popcount), so they are O(words) instead of O(bits), this makes
+    the BitSet a good fit for tracking occupied slots in pools or
+    dirty flags.
+
+    Iterate over all set bits like this:
+
+    @code
+    for (int i = bits.FindFirstSet(); InvalidIndex != i; i = bits.FindFirstSet(i + 1)) {
+        ...
+    }
+    @endcode
+*/
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include "Core/Containers/Array.h"
+#if defined(_MSC_VER) && defined(_WIN64)
+#include <intrin.h>
+#endif
+
+namespace Oryol {
+
+namespace _priv {
+
+/// bit scanning helpers for 64-bit words
+struct bitScan {
+    /// index of lowest set bit, word must not be 0
+    static int countTrailingZeros(uint64_t word) {
+        #if defined(__GNUC__)
+        return __builtin_ctzll(word);
+        #elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return int(index);
+        #else
+        int index = 0;
+        while (0 == (word & 1)) {
+            word >>= 1;
+            index++;
+        }
+        return index;
+        #endif
+    };
+    /// index of highest set bit, word must not be 0
+    static int highestBit(uint64_t word) {
+        #if defined(__GNUC__)
+        return 63 - __builtin_clzll(word);
+        #elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return int(index);
+        #else
+        int index = 0;
+        while (word >>= 1) {
+            index++;
+        }
+        return index;
+        #endif
+    };
+    /// number of set bits
+    static int popCount(uint64_t word) {
+        #if defined(__GNUC__)
+        return __builtin_popcountll(word);
+        #else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return int((word * 0x0101010101010101ULL) >> 56);
+        #endif
+    };
+};
+
+} // namespace _priv
+
+class BitSet {
+public:
+    /// default constructor
+    BitSet() : numBits(0) { };
+    /// construct with number of bits (all cleared)
+    explicit BitSet(int numBits) : numBits(0) {
+        this->Resize(numBits);
+    };
+
+    /// resize to number of bits, new bits are cleared
+    void Resize(int numBits);
+    /// get number of bits
+    int Size() const;
+    /// return true if size is 0
+    bool Empty() const;
+
+    /// set a bit
+    void Set(int index);
+    /// clear a bit
+    void Reset(int index);
+    /// flip a bit
+    void Flip(int index);
+    /// test a bit
+    bool Test(int index) const;
+    /// set a range of bits
+    void SetRange(int index, int num);
+    /// clear a range of bits
+    void ResetRange(int index, int num);
+    /// set all bits
+    void SetAll();
+    /// clear all bits
+    void ResetAll();
+
+    /// count the set bits
+    int Count() const;
+    /// return true if any bit is set
+    bool Any() const;
+    /// find the first set bit at or after startIndex, or InvalidIndex
+    int FindFirstSet(int startIndex=0) const;
+    /// find the first cleared bit at or after startIndex, or InvalidIndex
+    int FindFirstClear(int startIndex=0) const;
+    /// find the last set bit, or InvalidIndex
+    int FindLastSet() const;
+
+private:
+    /// apply a bit mask to a range of bits, either setting or clearing
+    void maskRange(int index, int num, bool set);
+    /// number of words for a number of bits
+    static int numWords(int numBits) {
+        return (numBits + 63) >> 6;
+    };
+
+    int numBits;
+    Array<uint64_t> words;  // unused bits in the last word are always 0
+};
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::Resize(int newNumBits) {
+    o_assert_dbg(newNumBits >= 0);
+    const int newNumWords = numWords(newNumBits);
+    if (newNumWords > this->words.Size()) {
+        this->words.Reserve(newNumWords - this->words.Size());
+        while (this->words.Size() < newNumWords) {
+            this->words.Add(0);
+        }
+    }
+    else {
+        while (this->words.Size() > newNumWords) {
+            this->words.PopBack();
+        }
+    }
+    this->numBits = newNumBits;
+    // clear the bits beyond the end in the last word
+    if ((newNumBits & 63) != 0) {
+        this->words.Back() &= (uint64_t(1) << (newNumBits & 63)) - 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int
+BitSet::Size() const {
+    return this->numBits;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+BitSet::Empty() const {
+    return 0 == this->numBits;
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::Set(int index) {
+    o_assert_dbg((index >= 0) && (index < this->numBits));
+    this->words[index >> 6] |= uint64_t(1) << (index & 63);
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::Reset(int index) {
+    o_assert_dbg((index >= 0) && (index < this->numBits));
+    this->words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::Flip(int index) {
+    o_assert_dbg((index >= 0) && (index < this->numBits));
+    this->words[index >> 6] ^= uint64_t(1) << (index & 63);
+}
+
+//------------------------------------------------------------------------------
+inline bool
+BitSet::Test(int index) const {
+    o_assert_dbg((index >= 0) && (index < this->numBits));
+    return 0 != (this->words[index >> 6] & (uint64_t(1) << (index & 63)));
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::maskRange(int index, int num, bool set) {
+    o_assert_dbg((index >= 0) && (num >= 0) && ((index + num) <= this->numBits));
+    int bit = index;
+    const int end = index + num;
+    while (bit < end) {
+        const int wordIndex = bit >> 6;
+        const int first = bit & 63;
+        const int last = ((end - (wordIndex << 6)) < 64) ? (end & 63) : 64;
+        const uint64_t mask = ((last < 64) ? ((uint64_t(1) << last) - 1) : ~uint64_t(0)) & ~((uint64_t(1) << first) - 1);
+        if (set) {
+            this->words[wordIndex] |= mask;
+        }
+        else {
+            this->words[wordIndex] &= ~mask;
+        }
+        bit = (wordIndex + 1) << 6;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::SetRange(int index, int num) {
+    this->maskRange(index, num, true);
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::ResetRange(int index, int num) {
+    this->maskRange(index, num, false);
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::SetAll() {
+    this->maskRange(0, this->numBits, true);
+}
+
+//------------------------------------------------------------------------------
+inline void
+BitSet::ResetAll() {
+    for (uint64_t& word : this->words) {
+        word = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int
+BitSet::Count() const {
+    int count = 0;
+    for (uint64_t word : this->words) {
+        count += _priv::bitScan::popCount(word);
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+BitSet::Any() const {
+    for (uint64_t word : this->words) {
+        if (0 != word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+inline int
+BitSet::FindFirstSet(int startIndex) const {
+    o_assert_dbg(startIndex >= 0);
+    if (startIndex >= this->numBits) {
+        return InvalidIndex;
+    }
+    int wordIndex = startIndex >> 6;
+    // mask off the bits before startIndex in the first word
+    uint64_t word = this->words[wordIndex] & (~uint64_t(0) << (startIndex & 63));
+    const int numWords = this->words.Size();
+    while (0 == word) {
+        if (++wordIndex == numWords) {
+            return InvalidIndex;
+        }
+        word = this->words[wordIndex];
+    }
+    return (wordIndex << 6) + _priv::bitScan::countTrailingZeros(word);
+}
+
+//------------------------------------------------------------------------------
+inline int
+BitSet::FindFirstClear(int startIndex) const {
+    o_assert_dbg(startIndex >= 0);
+    if (startIndex >= this->numBits) {
+        return InvalidIndex;
+    }
+    int wordIndex = startIndex >> 6;
+    uint64_t word = ~this->words[wordIndex] & (~uint64_t(0) << (startIndex & 63));
+    const int numWords = this->words.Size();
+    while (0 == word) {
+        if (++wordIndex == numWords) {
+            return InvalidIndex;
+        }
+        word = ~this->words[wordIndex];
+    }
+    // the unused bits in the last word are 0, so this may point past the end
+    const int index = (wordIndex << 6) + _priv::bitScan::countTrailingZeros(word);
+    return (index < this->numBits) ? index : InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+inline int
+BitSet::FindLastSet() const {
+    for (int wordIndex = this->words.Size() - 1; wordIndex >= 0; wordIndex--) {
+        const uint64_t word = this->words[wordIndex];
+        if (0 != word) {
+            return (wordIndex << 6) + _priv::bitScan::highestBit(word);
+        }
+    }
+    return InvalidIndex;
+}
+
+} // namespace Oryol
@@ -4,116 +4,210 @@
     @class Oryol::Buffer
     @ingroup Core
     @brief growable memory buffer for raw data
+
+    Call UseFrameArena() on an empty buffer to allocate its memory
+    from the thread's FrameArena (for transient per-frame data), the
+    buffer must not be accessed after the end of the frame.
+
+    Call SetAlignment() on an empty buffer to align the buffer start
+    to more than ORYOL_MAX_PLATFORM_ALIGN (e.g. for SIMD processing).
+
+    Sizes and offsets are 64-bit, so a Buffer can hold more than 2 GByte
+    (e.g. for streaming from big asset packs).
+
+    Buffer is a typedef for BasicBuffer<HeapAllocator>, use BasicBuffer
+    with a different allocator policy (see HeapAllocator) to keep the
+    buffer memory in a dedicated heap, the allocator object is handed
+    over when the buffer is moved.
+
+    AddBulk() appends the raw bytes of a Slice of trivially copyable
+    items (e.g. vertex or index data), InsertBulk() inserts bytes at
+    an offset, both reserve room once and copy with memcpy.
 */
 #include "Core/Types.h"
 #include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Containers/Slice.h"
 
 namespace Oryol {
 
-class Buffer {
+template<class ALLOCATOR=HeapAllocator> class BasicBuffer {
 public:
     /// default constructor
-    Buffer();
+    BasicBuffer();
+    /// construct with allocator object
+    explicit BasicBuffer(const ALLOCATOR& allocator);
     /// move constructor
-    Buffer(Buffer&& rhs);
+    BasicBuffer(BasicBuffer&& rhs);
     /// destructor
-    ~Buffer();
+    ~BasicBuffer();
 
     /// always force move-construct
-    Buffer(const Buffer& rhs) = delete;
+    BasicBuffer(const BasicBuffer& rhs) = delete;
     /// always force move-assign
-    void operator=(const Buffer& rhs) = delete;
+    void operator=(const BasicBuffer& rhs) = delete;
 
     /// move-assignment
-    void operator=(Buffer&& rhs);
+    void operator=(BasicBuffer&& rhs);
 
     /// get number of bytes in buffer
-    int Size() const;
+    int64_t Size() const;
     /// return true if empty
     bool Empty() const;
     /// get capacity in bytes of buffer
-    int Capacity() const;
+    int64_t Capacity() const;
     /// get number of free bytes at back
-    int Spare() const;
+    int64_t Spare() const;
 
     /// make room for N more bytes
-    void Reserve(int numBytes);
+    void Reserve(int64_t numBytes);
     /// add bytes to buffer
-    void Add(const uint8_t* data, int numBytes);
+    void Add(const uint8_t* data, int64_t numBytes);
     /// add uninitialized bytes to buffer, return pointer to start
-    uint8_t* Add(int numBytes);
+    uint8_t* Add(int64_t numBytes);
+    /// add the bytes of a range of trivially copyable items
+    template<class TYPE> void AddBulk(const Slice<const TYPE>& items);
+    /// insert bytes at offset, moves the following content back
+    void InsertBulk(int64_t offset, const uint8_t* data, int64_t numBytes);
     /// remove a chunk of data from the buffer, return number of bytes removed
-    int Remove(int offset, int numBytes);
+    int64_t Remove(int64_t offset, int64_t numBytes);
     /// clear the buffer (deletes content, keeps capacity)
     void Clear();
     /// get read-only pointer to content (throws assert if would return nullptr)
     const uint8_t* Data() const;
     /// get read/write pointer to content (throws assert if would return nullptr)
     uint8_t* Data();
+    /// allocate from the thread's FrameArena (buffer must not have been allocated yet)
+    void UseFrameArena();
+    /// return true if the buffer allocates from the FrameArena
+    bool IsFrameArena() const;
+    /// set alignment of buffer start (power of 2, buffer must not have been allocated yet)
+    void SetAlignment(int alignment);
+    /// get alignment of buffer start
+    int GetAlignment() const;
+    /// set allocator object (buffer must not have been allocated yet)
+    void SetAllocator(const ALLOCATOR& allocator);
+    /// get allocator object
+    const ALLOCATOR& GetAllocator() const;
 
 private:
     /// (re-)allocate buffer
-    void alloc(int newCapacity);
+    void alloc(int64_t newCapacity);
+    /// allocate raw memory (from allocator or frame arena)
+    uint8_t* allocBuffer(int64_t numBytes);
+    /// free raw memory (no-op for frame arena memory)
+    void freeBuffer(uint8_t* ptr, int64_t numBytes);
     /// destroy buffer
     void destroy();
     /// append-copy content into currently allocated buffer, bump size
-    void copy(const uint8_t* ptr, int numBytes);
+    void copy(const uint8_t* ptr, int64_t numBytes);
 
-    int size;
-    int capacity;
+    int64_t size;
+    int64_t capacity;
     uint8_t* data;
+    bool frameArena;
+    uint16_t alignment;
+    ALLOCATOR allocator;
 };
 
+/// the default Buffer type
+typedef BasicBuffer<HeapAllocator> Buffer;
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR>
+BasicBuffer<ALLOCATOR>::BasicBuffer() :
+size(0),
+capacity(0),
+data(nullptr),
+frameArena(false),
+alignment(ORYOL_MAX_PLATFORM_ALIGN) {
+    // empty
+}
+
 //------------------------------------------------------------------------------
-inline
-Buffer::Buffer() :
+template<class ALLOCATOR>
+BasicBuffer<ALLOCATOR>::BasicBuffer(const ALLOCATOR& allocator_) :
 size(0),
 capacity(0),
-data(nullptr) {
+data(nullptr),
+frameArena(false),
+alignment(ORYOL_MAX_PLATFORM_ALIGN),
+allocator(allocator_) {
     // empty
 }
 
 //------------------------------------------------------------------------------
-inline
-Buffer::Buffer(Buffer&& rhs) :
+template<class ALLOCATOR>
+BasicBuffer<ALLOCATOR>::BasicBuffer(BasicBuffer&& rhs) :
 size(rhs.size),
 capacity(rhs.capacity),
-data(rhs.data) {
+data(rhs.data),
+frameArena(rhs.frameArena),
+alignment(rhs.alignment),
+allocator(rhs.allocator) {
     rhs.size = 0;
     rhs.capacity = 0;
     rhs.data = nullptr;
+    rhs.frameArena = false;
+    rhs.alignment = ORYOL_MAX_PLATFORM_ALIGN;
 }
 
 //------------------------------------------------------------------------------
-inline
-Buffer::~Buffer() {
+template<class ALLOCATOR>
+BasicBuffer<ALLOCATOR>::~BasicBuffer() {
     this->destroy();
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::alloc(int newCapacity) {
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::alloc(int64_t newCapacity) {
     o_assert_dbg(newCapacity > this->capacity);
     o_assert_dbg(newCapacity > this->size);
 
-    uint8_t* newBuf = (uint8_t*) Memory::Alloc(newCapacity);
+    if (this->data && !this->frameArena && this->allocator.CanReAlloc(this->alignment)) {
+        this->data = (uint8_t*) this->allocator.ReAlloc(this->data, this->capacity, newCapacity, this->alignment);
+        this->capacity = newCapacity;
+        return;
+    }
+    uint8_t* newBuf = this->allocBuffer(newCapacity);
     if (this->size > 0) {
         o_assert_dbg(this->data);
         Memory::Copy(this->data, newBuf, this->size);
     }
     if (this->data) {
-        Memory::Free(this->data);
+        this->freeBuffer(this->data, this->capacity);
     }
     this->data = newBuf;
     this->capacity = newCapacity;
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::destroy() {
+template<class ALLOCATOR> uint8_t*
+BasicBuffer<ALLOCATOR>::allocBuffer(int64_t numBytes) {
+    if (this->frameArena) {
+        o_assert(numBytes <= 0x7FFFFFFF);
+        return (uint8_t*) FrameArena::Alloc(int(numBytes), this->alignment);
+    }
+    else {
+        return (uint8_t*) this->allocator.Alloc(numBytes, this->alignment);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::freeBuffer(uint8_t* ptr, int64_t numBytes) {
+    if (!this->frameArena) {
+        this->allocator.Free(ptr, numBytes, this->alignment);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::destroy() {
     if (this->data) {
-        Memory::Free(this->data);
+        this->freeBuffer(this->data, this->capacity);
     }
     this->data = nullptr;
     this->size = 0;
@@ -121,8 +215,8 @@ Buffer::destroy() {
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::copy(const uint8_t* ptr, int numBytes) {
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::copy(const uint8_t* ptr, int64_t numBytes) {
     // NOTE: it is valid to call copy with numBytes==0
     o_assert_dbg(this->data);
     o_assert_dbg((this->size + numBytes) <= this->capacity);
@@ -131,61 +225,74 @@ Buffer::copy(const uint8_t* ptr, int numBytes) {
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::operator=(Buffer&& rhs) {
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::operator=(BasicBuffer&& rhs) {
     this->destroy();
     this->size = rhs.size;
     this->capacity = rhs.capacity;
     this->data = rhs.data;
+    this->frameArena = rhs.frameArena;
+    this->alignment = rhs.alignment;
+    this->allocator = rhs.allocator;
     rhs.size = 0;
     rhs.capacity = 0;
     rhs.data = nullptr;
+    rhs.frameArena = false;
+    rhs.alignment = ORYOL_MAX_PLATFORM_ALIGN;
 }
 
 //------------------------------------------------------------------------------
-inline int
-Buffer::Size() const {
+template<class ALLOCATOR> int64_t
+BasicBuffer<ALLOCATOR>::Size() const {
     return this->size;
 }
 
 //------------------------------------------------------------------------------
-inline bool
-Buffer::Empty() const {
+template<class ALLOCATOR> bool
+BasicBuffer<ALLOCATOR>::Empty() const {
     return 0 == this->size;
 }
 
 //------------------------------------------------------------------------------
-inline int
-Buffer::Capacity() const {
+template<class ALLOCATOR> int64_t
+BasicBuffer<ALLOCATOR>::Capacity() const {
     return this->capacity;
 }
 
 //------------------------------------------------------------------------------
-inline int
-Buffer::Spare() const {
+template<class ALLOCATOR> int64_t
+BasicBuffer<ALLOCATOR>::Spare() const {
     return this->capacity - this->size;
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::Reserve(int numBytes) {
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::Reserve(int64_t numBytes) {
     // need to grow?
     if ((this->size + numBytes) > this->capacity) {
-        const int newCapacity = this->size + numBytes;
+        const int64_t newCapacity = this->size + numBytes;
         this->alloc(newCapacity);
     }
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::Add(const uint8_t* data, int numBytes) {
-    this->Reserve(numBytes);
-    this->copy(data, numBytes);
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::Add(const uint8_t* data, int64_t numBytes) {
+    if (this->data && (data >= this->data) && (data < (this->data + this->size))) {
+        // data is in this buffer, Reserve() may free it
+        const int64_t offset = data - this->data;
+        this->Reserve(numBytes);
+        this->copy(this->data + offset, numBytes);
+    }
+    else {
+        this->Reserve(numBytes);
+        this->copy(data, numBytes);
+    }
 }
 
 //------------------------------------------------------------------------------
-inline uint8_t*
-Buffer::Add(int numBytes) {
+template<class ALLOCATOR> uint8_t*
+BasicBuffer<ALLOCATOR>::Add(int64_t numBytes) {
     this->Reserve(numBytes);
     uint8_t* ptr = this->data + this->size;
     this->size += numBytes;
@@ -193,14 +300,41 @@ Buffer::Add(int numBytes) {
 }
 
 //------------------------------------------------------------------------------
-inline void
-Buffer::Clear() {
+template<class ALLOCATOR> template<class TYPE> void
+BasicBuffer<ALLOCATOR>::AddBulk(const Slice<const TYPE>& items) {
+    static_assert(std::is_trivially_copyable<TYPE>::value, "Buffer::AddBulk(): items must be trivially copyable");
+    if (items.Size() > 0) {
+        this->Add((const uint8_t*) items.begin(), int64_t(items.Size()) * int64_t(sizeof(TYPE)));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::InsertBulk(int64_t offset, const uint8_t* data, int64_t numBytes) {
+    o_assert_dbg((offset >= 0) && (offset <= this->size));
+    o_assert_dbg(data && (numBytes >= 0));
+    if (numBytes > 0) {
+        // data must not point into this buffer, Reserve() may free it
+        o_assert_dbg((data < this->data) || (data >= (this->data + this->capacity)));
+        this->Reserve(numBytes);
+        const int64_t bytesToMove = this->size - offset;
+        if (bytesToMove > 0) {
+            Memory::Move(this->data + offset, this->data + offset + numBytes, bytesToMove);
+        }
+        Memory::Copy(data, this->data + offset, numBytes);
+        this->size += numBytes;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::Clear() {
     this->size = 0;
 }
 
 //------------------------------------------------------------------------------
-inline int
-Buffer::Remove(int offset, int numBytes) {
+template<class ALLOCATOR> int64_t
+BasicBuffer<ALLOCATOR>::Remove(int64_t offset, int64_t numBytes) {
     o_assert_dbg(offset >= 0);
     o_assert_dbg(numBytes >= 0);
     if (offset >= this->size) {
@@ -212,7 +346,7 @@ Buffer::Remove(int offset, int numBytes) {
     o_assert_dbg((offset + numBytes) <= this->size);
     o_assert_dbg(numBytes >= 0);
     if (numBytes > 0) {
-        int bytesToMove = this->size - (offset + numBytes);
+        int64_t bytesToMove = this->size - (offset + numBytes);
         if (bytesToMove > 0) {
             Memory::Move(this->data + offset + numBytes, this->data + offset, bytesToMove);
         }
@@ -223,17 +357,58 @@ Buffer::Remove(int offset, int numBytes) {
 }
 
 //------------------------------------------------------------------------------
-inline const uint8_t*
-Buffer::Data() const {
+template<class ALLOCATOR> const uint8_t*
+BasicBuffer<ALLOCATOR>::Data() const {
     o_assert(this->data);
     return this->data;
 }
 
 //------------------------------------------------------------------------------
-inline uint8_t*
-Buffer::Data() {
+template<class ALLOCATOR> uint8_t*
+BasicBuffer<ALLOCATOR>::Data() {
     o_assert(this->data);
     return this->data;
 }
 
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::UseFrameArena() {
+    o_assert_dbg(nullptr == this->data);
+    o_assert_dbg(FrameArena::IsValid());
+    this->frameArena = true;
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> bool
+BasicBuffer<ALLOCATOR>::IsFrameArena() const {
+    return this->frameArena;
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::SetAlignment(int alignment_) {
+    o_assert_dbg(nullptr == this->data);
+    o_assert_dbg((alignment_ > 0) && (alignment_ <= (1<<15)) && (0 == (alignment_ & (alignment_ - 1))));
+    this->alignment = alignment_;
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> int
+BasicBuffer<ALLOCATOR>::GetAlignment() const {
+    return this->alignment;
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> void
+BasicBuffer<ALLOCATOR>::SetAllocator(const ALLOCATOR& allocator_) {
+    o_assert_dbg(nullptr == this->data);
+    this->allocator = allocator_;
+}
+
+//------------------------------------------------------------------------------
+template<class ALLOCATOR> const ALLOCATOR&
+BasicBuffer<ALLOCATOR>::GetAllocator() const {
+    return this->allocator;
+}
+
 } // namespace Oryol
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+//  BufferChain.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "BufferChain.h"
+#include "Core/Memory/Memory.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
+
+namespace Oryol {
+
+namespace {
+
+// the shared pool of free segments, the first bytes of a free
+// segment are used as link to the next free segment
+struct node {
+    node* next;
+};
+#if ORYOL_HAS_THREADS
+std::mutex poolLock;
+#define SCOPED_LOCK std::lock_guard<std::mutex> lock(poolLock)
+#else
+#define SCOPED_LOCK
+#endif
+node* freeList = nullptr;
+int numFree = 0;
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+uint8_t*
+BufferChain::allocSegment() {
+    {
+        SCOPED_LOCK;
+        if (freeList) {
+            node* n = freeList;
+            freeList = n->next;
+            numFree--;
+            return (uint8_t*) n;
+        }
+    }
+    o_memory_tag(MemoryTag::Core);
+    return (uint8_t*) Memory::Alloc(SegmentCapacity);
+}
+
+//------------------------------------------------------------------------------
+void
+BufferChain::freeSegment(uint8_t* segment) {
+    o_assert_dbg(segment);
+    {
+        SCOPED_LOCK;
+        if (numFree < MaxPooledSegments) {
+            node* n = (node*) segment;
+            n->next = freeList;
+            freeList = n;
+            numFree++;
+            return;
+        }
+    }
+    Memory::Free(segment);
+}
+
+//------------------------------------------------------------------------------
+void
+BufferChain::ReleasePool() {
+    node* n;
+    {
+        SCOPED_LOCK;
+        n = freeList;
+        freeList = nullptr;
+        numFree = 0;
+    }
+    while (n) {
+        node* next = n->next;
+        Memory::Free(n);
+        n = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+BufferChain::NumPooledSegments() {
+    SCOPED_LOCK;
+    return numFree;
+}
+
+//------------------------------------------------------------------------------
+uint8_t*
+BufferChain::AddSpace(int maxBytes, int& outNumBytes) {
+    o_assert_dbg(maxBytes > 0);
+    const int used = int(this->size % SegmentCapacity);
+    if (this->size == (int64_t(this->segments.Size()) * SegmentCapacity)) {
+        // all segments are full (or there are none), start a new one
+        this->segments.Add(allocSegment());
+    }
+    uint8_t* ptr = this->segments.Back() + used;
+    outNumBytes = ((SegmentCapacity - used) < maxBytes) ? (SegmentCapacity - used) : maxBytes;
+    this->size += outNumBytes;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+BufferChain::Add(const uint8_t* data, int64_t numBytes) {
+    o_assert_dbg(data || (0 == numBytes));
+    while (numBytes > 0) {
+        int num = 0;
+        uint8_t* dst = this->AddSpace(numBytes < SegmentCapacity ? int(numBytes) : SegmentCapacity, num);
+        Memory::Copy(data, dst, num);
+        data += num;
+        numBytes -= num;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+BufferChain::Trim(int64_t numBytes) {
+    o_assert_dbg((numBytes >= 0) && (numBytes <= this->size));
+    this->size -= numBytes;
+    // free the segments which became empty
+    const int numSegments = int((this->size + SegmentCapacity - 1) / SegmentCapacity);
+    while (this->segments.Size() > numSegments) {
+        freeSegment(this->segments.PopBack());
+    }
+}
+
+//------------------------------------------------------------------------------
+int64_t
+BufferChain::CopyTo(int64_t offset, uint8_t* dst, int64_t numBytes) const {
+    o_assert_dbg((offset >= 0) && (numBytes >= 0));
+    if (offset >= this->size) {
+        return 0;
+    }
+    if ((offset + numBytes) > this->size) {
+        numBytes = this->size - offset;
+    }
+    int64_t bytesCopied = 0;
+    while (bytesCopied < numBytes) {
+        const int segIndex = int(offset / SegmentCapacity);
+        const int segOffset = int(offset % SegmentCapacity);
+        int num = SegmentCapacity - segOffset;
+        if (num > (numBytes - bytesCopied)) {
+            num = int(numBytes - bytesCopied);
+        }
+        Memory::Copy(this->segments[segIndex] + segOffset, dst + bytesCopied, num);
+        offset += num;
+        bytesCopied += num;
+    }
+    return bytesCopied;
+}
+
+//------------------------------------------------------------------------------
+Buffer
+BufferChain::Flatten() {
+    Buffer buf;
+    if (this->size > 0) {
+        uint8_t* dst = buf.Add(this->size);
+        this->CopyTo(0, dst, this->size);
+    }
+    this->Clear();
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+void
+BufferChain::Clear() {
+    for (uint8_t* segment : this->segments) {
+        freeSegment(segment);
+    }
+    this->segments.Clear();
+    this->size = 0;
+}
+
+} // namespace Oryol
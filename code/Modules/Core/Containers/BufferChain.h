@@ -0,0 +1,162 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::BufferChain
+    @ingroup Core
+    @brief growable byte stream made of fixed-size segments
+
+    A BufferChain accumulates data in a chain of fixed-size segments
+    (BufferChain::SegmentCapacity bytes). Unlike a Buffer, growing never
+    reallocates or copies the data that has already been added, which
+    makes it a good fit for streamed data of unknown size (e.g. HTTP
+    downloads which arrive in small pieces).
+
+    The segments are recycled through a shared pool, so short-lived
+    chains don't hit the heap for every segment. Call
+    BufferChain::ReleasePool() to free the pooled segments (this
+    happens in Core::Discard()).
+
+    Access the content segment by segment with SegmentData() and
+    SegmentSize() (every segment except the last is full), copy out
+    a range of bytes with CopyTo(), or flatten the whole chain into
+    a single Buffer with Flatten().
+
+    To read data directly into the chain without an intermediate
+    buffer, call AddSpace() in a loop, which returns a pointer to
+    the uninitialized space at the end of the chain.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Buffer.h"
+
+namespace Oryol {
+
+class BufferChain {
+public:
+    /// capacity of one segment in bytes
+    static const int SegmentCapacity = 64 * 1024;
+    /// max number of free segments kept in the shared pool
+    static const int MaxPooledSegments = 32;
+
+    /// default constructor
+    BufferChain();
+    /// move constructor
+    BufferChain(BufferChain&& rhs);
+    /// destructor
+    ~BufferChain();
+
+    /// always force move-construct
+    BufferChain(const BufferChain& rhs) = delete;
+    /// always force move-assign
+    void operator=(const BufferChain& rhs) = delete;
+    /// move-assignment
+    void operator=(BufferChain&& rhs);
+
+    /// get number of bytes in the chain
+    int64_t Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get number of segments
+    int NumSegments() const;
+    /// get read-only pointer to segment data
+    const uint8_t* SegmentData(int segmentIndex) const;
+    /// get number of bytes in a segment
+    int SegmentSize(int segmentIndex) const;
+
+    /// append bytes (copies the new bytes, never the existing content)
+    void Add(const uint8_t* data, int64_t numBytes);
+    /// append up to maxBytes uninitialized bytes, returns pointer and number of bytes added
+    uint8_t* AddSpace(int maxBytes, int& outNumBytes);
+    /// remove bytes from the end (e.g. unused space from AddSpace())
+    void Trim(int64_t numBytes);
+    /// copy a range of bytes into a contiguous destination, return number of bytes copied
+    int64_t CopyTo(int64_t offset, uint8_t* dst, int64_t numBytes) const;
+    /// move the content into a single Buffer, the chain is empty afterwards
+    Buffer Flatten();
+    /// remove all content, segments go back to the pool
+    void Clear();
+
+    /// free the segments in the shared pool
+    static void ReleasePool();
+    /// get number of segments in the shared pool
+    static int NumPooledSegments();
+
+private:
+    /// get a segment from the pool or the heap
+    static uint8_t* allocSegment();
+    /// give a segment back to the pool (or the heap if the pool is full)
+    static void freeSegment(uint8_t* segment);
+
+    Array<uint8_t*> segments;
+    int64_t size;
+};
+
+//------------------------------------------------------------------------------
+inline
+BufferChain::BufferChain() :
+size(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline
+BufferChain::BufferChain(BufferChain&& rhs) :
+segments(std::move(rhs.segments)),
+size(rhs.size) {
+    rhs.size = 0;
+}
+
+//------------------------------------------------------------------------------
+inline
+BufferChain::~BufferChain() {
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------
+inline void
+BufferChain::operator=(BufferChain&& rhs) {
+    if (&rhs != this) {
+        this->Clear();
+        this->segments = std::move(rhs.segments);
+        this->size = rhs.size;
+        rhs.size = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int64_t
+BufferChain::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+BufferChain::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+inline int
+BufferChain::NumSegments() const {
+    return this->segments.Size();
+}
+
+//------------------------------------------------------------------------------
+inline const uint8_t*
+BufferChain::SegmentData(int segmentIndex) const {
+    return this->segments[segmentIndex];
+}
+
+//------------------------------------------------------------------------------
+inline int
+BufferChain::SegmentSize(int segmentIndex) const {
+    o_assert_dbg((segmentIndex >= 0) && (segmentIndex < this->segments.Size()));
+    if (segmentIndex < (this->segments.Size() - 1)) {
+        return BufferChain::SegmentCapacity;
+    }
+    else {
+        return int(this->size - int64_t(segmentIndex) * BufferChain::SegmentCapacity);
+    }
+}
+
+} // namespace Oryol
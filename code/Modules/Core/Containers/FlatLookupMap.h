@@ -0,0 +1,248 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::FlatLookupMap
+    @ingroup Core
+    @brief read-optimized, immutable key/value map with Eytzinger layout
+
+    A FlatLookupMap is built once (from a Map, or in bulk mode) and
+    after that only supports lookups. Instead of keeping the keys in
+    a sorted array (like Map) where every binary search step is a likely
+    cache miss on big maps, the keys are rearranged into the Eytzinger
+    (BFS-order) layout of an implicit binary search tree: the children
+    of the key at position k are at positions 2k and 2k+1. The first
+    levels of the tree are packed into the same few cache lines, the
+    search loop has no data-dependent branches (the comparison result
+    is added to the next position), and the key block several levels
+    below the current position is prefetched ahead of time.
+
+    Use this for read-mostly tables which are built at startup and
+    looked up very often. For tables which change frequently, use
+    Map or HashMap instead.
+
+    The KEY type must have operator< and operator==, KEY and VALUE
+    must be default-constructible. Indices returned by FindIndex() are
+    positions in the Eytzinger layout, not in sorted key order.
+
+    @see Map, HashMap
+*/
+#include "Core/Config.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/KeyValuePair.h"
+#include "Core/Containers/Sort.h"
+
+namespace Oryol {
+
+template<class KEY, class VALUE> class FlatLookupMap {
+public:
+    /// default constructor
+    FlatLookupMap();
+
+    /// build from a Map (discards previous content)
+    void Build(const Map<KEY, VALUE>& map);
+    /// begin bulk-mode (discards previous content)
+    void BeginBulk();
+    /// add element in bulk-mode
+    void AddBulk(const KEY& key, const VALUE& value);
+    /// end bulk-mode, builds the lookup layout (duplicate keys are an error)
+    void EndBulk();
+    /// clear the map
+    void Clear();
+
+    /// get number of elements
+    int Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// test if an element exists
+    bool Contains(const KEY& key) const;
+    /// find an element, returns index, or InvalidIndex
+    int FindIndex(const KEY& key) const;
+    /// get pointer to value, or nullptr if not exists
+    const VALUE* Find(const KEY& key) const;
+    /// read-only access to value by key (fatal error if not exists)
+    const VALUE& operator[](const KEY& key) const;
+    /// get key at index
+    const KEY& KeyAtIndex(int index) const;
+    /// get value at index
+    const VALUE& ValueAtIndex(int index) const;
+
+private:
+    /// build the Eytzinger layout from sorted key/value pairs
+    void build(const KeyValuePair<KEY, VALUE>* sorted, int num);
+    /// recursively fill the layout with an in-order traversal, return next sorted index
+    int fill(const KeyValuePair<KEY, VALUE>* sorted, int sortedIndex, int k);
+
+    /// number of keys in a cache line, used as prefetch stride
+    static const int keysPerCacheLine = (sizeof(KEY) < ORYOL_CACHE_LINE_SIZE) ? int(ORYOL_CACHE_LINE_SIZE / sizeof(KEY)) : 1;
+
+    Array<KEY> keys;                                // Eytzinger layout, 1-based (index 0 is unused)
+    Array<VALUE> values;                            // values in same layout as keys
+    Array<KeyValuePair<KEY, VALUE>> bulkElements;   // unsorted elements in bulk mode
+    bool inBulkMode;
+};
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE>
+FlatLookupMap<KEY, VALUE>::FlatLookupMap() :
+inBulkMode(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::Clear() {
+    o_assert_dbg(!this->inBulkMode);
+    this->keys.Clear();
+    this->values.Clear();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::Build(const Map<KEY, VALUE>& map) {
+    o_assert_dbg(!this->inBulkMode);
+    this->build(map.begin(), map.Size());
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::BeginBulk() {
+    o_assert(!this->inBulkMode);
+    this->inBulkMode = true;
+    this->bulkElements.Clear();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::AddBulk(const KEY& key, const VALUE& value) {
+    o_assert(this->inBulkMode);
+    this->bulkElements.Add(KeyValuePair<KEY, VALUE>(key, value));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::EndBulk() {
+    o_assert(this->inBulkMode);
+    this->inBulkMode = false;
+    this->bulkElements.Sort();
+    for (int i = 1; i < this->bulkElements.Size(); i++) {
+        if (this->bulkElements[i - 1].Key() == this->bulkElements[i].Key()) {
+            o_error("FlatLookupMap::EndBulk(): duplicate key!\n");
+        }
+    }
+    this->build(this->bulkElements.begin(), this->bulkElements.Size());
+    this->bulkElements = Array<KeyValuePair<KEY, VALUE>>();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> void
+FlatLookupMap<KEY, VALUE>::build(const KeyValuePair<KEY, VALUE>* sorted, int num) {
+    this->keys = Array<KEY>();
+    this->values = Array<VALUE>();
+    if (num > 0) {
+        // align the keys so that each prefetched key block is a cache line
+        this->keys.SetAlignment(ORYOL_CACHE_LINE_SIZE);
+        this->keys.SetFixedCapacity(num + 1);
+        this->values.SetFixedCapacity(num + 1);
+        for (int i = 0; i <= num; i++) {
+            this->keys.Add();
+            this->values.Add();
+        }
+        const int next = this->fill(sorted, 0, 1);
+        o_assert_dbg(next == num);
+        (void)next;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> int
+FlatLookupMap<KEY, VALUE>::fill(const KeyValuePair<KEY, VALUE>* sorted, int sortedIndex, int k) {
+    if (k < this->keys.Size()) {
+        sortedIndex = this->fill(sorted, sortedIndex, 2 * k);
+        this->keys[k] = sorted[sortedIndex].Key();
+        this->values[k] = sorted[sortedIndex].Value();
+        sortedIndex++;
+        sortedIndex = this->fill(sorted, sortedIndex, 2 * k + 1);
+    }
+    return sortedIndex;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> int
+FlatLookupMap<KEY, VALUE>::Size() const {
+    const int size = this->keys.Size();
+    return size > 0 ? size - 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> bool
+FlatLookupMap<KEY, VALUE>::Empty() const {
+    return this->keys.Size() < 2;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> int
+FlatLookupMap<KEY, VALUE>::FindIndex(const KEY& key) const {
+    o_assert_dbg(!this->inBulkMode);
+    const int num = this->keys.Size();
+    if (num < 2) {
+        return InvalidIndex;
+    }
+    const KEY* k = this->keys.begin();
+    int i = 1;
+    while (i < num) {
+        ORYOL_PREFETCH(k + keysPerCacheLine * i);
+        i = 2 * i + int(k[i] < key);
+    }
+    // i encodes the path taken, remove the trailing right turns plus
+    // the final left turn to get the position of the lower bound
+    #if defined(__GNUC__)
+    i >>= __builtin_ffs(~i);
+    #else
+    while (i & 1) {
+        i >>= 1;
+    }
+    i >>= 1;
+    #endif
+    if ((i > 0) && (k[i] == key)) {
+        return i - 1;
+    }
+    else {
+        return InvalidIndex;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> bool
+FlatLookupMap<KEY, VALUE>::Contains(const KEY& key) const {
+    return InvalidIndex != this->FindIndex(key);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> const VALUE*
+FlatLookupMap<KEY, VALUE>::Find(const KEY& key) const {
+    const int index = this->FindIndex(key);
+    return (InvalidIndex != index) ? &this->values[index + 1] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> const VALUE&
+FlatLookupMap<KEY, VALUE>::operator[](const KEY& key) const {
+    const int index = this->FindIndex(key);
+    o_assert(InvalidIndex != index);
+    return this->values[index + 1];
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> const KEY&
+FlatLookupMap<KEY, VALUE>::KeyAtIndex(int index) const {
+    return this->keys[index + 1];
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE> const VALUE&
+FlatLookupMap<KEY, VALUE>::ValueAtIndex(int index) const {
+    return this->values[index + 1];
+}
+
+} // namespace Oryol
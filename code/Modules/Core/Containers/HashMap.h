@@ -0,0 +1,423 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HashMap
+    @ingroup Core
+    @brief key-value map with hashed lookup, similar to std::unordered_map
+
+    A key-value container with O(1) lookup, insertion and removal,
+    which follows the same conventions as Map:
+
+    - trying to access a non-existing element with operator[] will
+      trigger an assertion instead of adding it
+    - Add() asserts that the key doesn't exist yet, use AddUnique()
+      to check for existing keys
+
+    Unlike Map, keys must be unique, and elements are not sorted.
+    The key-value-pairs live densely packed in an element buffer in the
+    order they were added (so they can be iterated and accessed by
+    index like a Map), erasing an element moves the last element into
+    the hole. A separate open-addressing hash table with robin-hood
+    probing maps key hashes to element indices (see _priv::hashTable),
+    the table grows by doubling its size when it is 7/8 full.
+
+    The hash function is a template parameter, by default Oryol::Hash<KEY>
+    is used (see Core/Hash.h), it must return a uint32_t.
+
+    Use HashMap instead of Map for big maps with frequent insertion and
+    removal, or for lookup-heavy maps, Map is still preferable for
+    small maps or if sorted iteration is needed.
+
+    @see Map, ArrayMap, Hash
+*/
+#include <initializer_list>
+#include "Core/Config.h"
+#include "Core/Hash.h"
+#include "Core/Containers/elementBuffer.h"
+#include "Core/Containers/hashTable.h"
+#include "Core/Containers/KeyValuePair.h"
+
+namespace Oryol {
+
+template<class KEY, class VALUE, class HASHER=Hash<KEY>> class HashMap {
+public:
+    /// default constructor
+    HashMap();
+    /// copy constructor
+    HashMap(const HashMap& rhs);
+    /// move constructor
+    HashMap(HashMap&& rhs);
+    /// construct from initializer list
+    HashMap(std::initializer_list<KeyValuePair<KEY,VALUE>> rhs);
+    /// destructor
+    ~HashMap();
+
+    /// copy-assignment operator
+    void operator=(const HashMap& rhs);
+    /// move-assignment operator
+    void operator=(HashMap&& rhs);
+
+    /// get number of elements in map
+    int Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get number of elements which fit into the map without rehashing
+    int Capacity() const;
+
+    /// read/write access single element
+    VALUE& operator[](const KEY& key);
+    /// read-only access single element
+    const VALUE& operator[](const KEY& key) const;
+
+    /// increase capacity to hold at least numElements more elements
+    void Reserve(int numElements);
+    /// clear the map (deletes elements, keeps capacity)
+    void Clear();
+
+    /// test if an element exists
+    bool Contains(const KEY& key) const;
+    /// find value by key, return nullptr if not found
+    VALUE* Find(const KEY& key);
+    /// find value by key, return nullptr if not found
+    const VALUE* Find(const KEY& key) const;
+    /// add new element, key must not exist
+    void Add(const KeyValuePair<KEY, VALUE>& kvp);
+    /// add new element with move-semantics, key must not exist
+    void Add(KeyValuePair<KEY, VALUE>&& kvp);
+    /// add new element, key must not exist
+    void Add(const KEY& key, const VALUE& value);
+    /// add new element, return false if element with key already existed
+    bool AddUnique(const KeyValuePair<KEY, VALUE>& kvp);
+    /// add new element with move-semantics, return false if element with key already existed
+    bool AddUnique(KeyValuePair<KEY, VALUE>&& kvp);
+    /// add new element, return false if element with key already existed
+    bool AddUnique(const KEY& key, const VALUE& value);
+    /// erase element by key, does nothing if key not contained
+    void Erase(const KEY& key);
+
+    /// find an element, returns index, or InvalidIndex
+    int FindIndex(const KEY& key) const;
+    /// erase element at index (moves the last element to index)
+    void EraseIndex(int index);
+    /// get key at index
+    const KEY& KeyAtIndex(int index) const;
+    /// get value at index (read-only)
+    const VALUE& ValueAtIndex(int index) const;
+    /// get value at index (read/write)
+    VALUE& ValueAtIndex(int index);
+
+    /// C++ conform begin, MAY RETURN nullptr!
+    KeyValuePair<KEY, VALUE>* begin();
+    /// C++ conform begin, MAY RETURN nullptr!
+    const KeyValuePair<KEY, VALUE>* begin() const;
+    /// C++ conform end,  MAY RETURN nullptr!
+    KeyValuePair<KEY, VALUE>* end();
+    /// C++ conform end, MAY RETURN nullptr!
+    const KeyValuePair<KEY, VALUE>* end() const;
+
+private:
+    /// copy content
+    void copy(const HashMap& rhs);
+    /// find element index of a key, or InvalidIndex
+    int find(const KEY& key, uint32_t hash) const;
+    /// erase element at index
+    void erase(int index, uint32_t hash);
+    /// add a new element (must not exist)
+    template<class KVP> void add(uint32_t hash, KVP&& kvp);
+
+    _priv::elementBuffer<KeyValuePair<KEY,VALUE>> buffer;
+    _priv::hashTable table;
+};
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap(const HashMap& rhs) {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap(HashMap&& rhs) :
+buffer(std::move(rhs.buffer)),
+table(std::move(rhs.table)) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap(std::initializer_list<KeyValuePair<KEY,VALUE>> rhs) {
+    this->Reserve(int(rhs.size()));
+    for (const KeyValuePair<KEY,VALUE>& kvp : rhs) {
+        this->Add(kvp);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::~HashMap() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::operator=(const HashMap& rhs) {
+    if (&rhs != this) {
+        this->buffer.destroy();
+        this->copy(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::operator=(HashMap&& rhs) {
+    if (&rhs != this) {
+        this->buffer = std::move(rhs.buffer);
+        this->table = std::move(rhs.table);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int
+HashMap<KEY, VALUE, HASHER>::Size() const {
+    return this->buffer.size();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::Empty() const {
+    return this->buffer.size() == 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int
+HashMap<KEY, VALUE, HASHER>::Capacity() const {
+    return this->table.capacity();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> VALUE&
+HashMap<KEY, VALUE, HASHER>::operator[](const KEY& key) {
+    const int index = this->find(key, HASHER()(key));
+    o_assert(InvalidIndex != index);    // not found if this triggers
+    return this->buffer[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const VALUE&
+HashMap<KEY, VALUE, HASHER>::operator[](const KEY& key) const {
+    const int index = this->find(key, HASHER()(key));
+    o_assert_dbg(InvalidIndex != index);    // not found if this triggers
+    return this->buffer[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Reserve(int numElements) {
+    this->table.reserve(this->buffer.size() + numElements);
+    if (this->table.capacity() > this->buffer.capacity()) {
+        this->buffer.alloc(this->table.capacity(), 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Clear() {
+    this->buffer.clear();
+    this->table.clear();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::Contains(const KEY& key) const {
+    return InvalidIndex != this->find(key, HASHER()(key));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> VALUE*
+HashMap<KEY, VALUE, HASHER>::Find(const KEY& key) {
+    const int index = this->find(key, HASHER()(key));
+    if (InvalidIndex != index) {
+        return &(this->buffer[index].value);
+    }
+    else {
+        return nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const VALUE*
+HashMap<KEY, VALUE, HASHER>::Find(const KEY& key) const {
+    const int index = this->find(key, HASHER()(key));
+    if (InvalidIndex != index) {
+        return &(this->buffer[index].value);
+    }
+    else {
+        return nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(const KeyValuePair<KEY, VALUE>& kvp) {
+    const uint32_t hash = HASHER()(kvp.key);
+    o_assert_dbg(InvalidIndex == this->find(kvp.key, hash));    // key already exists if this triggers
+    this->add(hash, kvp);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(KeyValuePair<KEY, VALUE>&& kvp) {
+    const uint32_t hash = HASHER()(kvp.key);
+    o_assert_dbg(InvalidIndex == this->find(kvp.key, hash));    // key already exists if this triggers
+    this->add(hash, std::move(kvp));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(const KEY& key, const VALUE& value) {
+    this->Add(KeyValuePair<KEY, VALUE>(key, value));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(const KeyValuePair<KEY, VALUE>& kvp) {
+    const uint32_t hash = HASHER()(kvp.key);
+    if (InvalidIndex != this->find(kvp.key, hash)) {
+        return false;
+    }
+    this->add(hash, kvp);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(KeyValuePair<KEY, VALUE>&& kvp) {
+    const uint32_t hash = HASHER()(kvp.key);
+    if (InvalidIndex != this->find(kvp.key, hash)) {
+        return false;
+    }
+    this->add(hash, std::move(kvp));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(const KEY& key, const VALUE& value) {
+    return this->AddUnique(KeyValuePair<KEY, VALUE>(key, value));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Erase(const KEY& key) {
+    const uint32_t hash = HASHER()(key);
+    const int index = this->find(key, hash);
+    if (InvalidIndex != index) {
+        this->erase(index, hash);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int
+HashMap<KEY, VALUE, HASHER>::FindIndex(const KEY& key) const {
+    return this->find(key, HASHER()(key));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::EraseIndex(int index) {
+    this->erase(index, HASHER()(this->buffer[index].key));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KEY&
+HashMap<KEY, VALUE, HASHER>::KeyAtIndex(int index) const {
+    return this->buffer[index].key;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const VALUE&
+HashMap<KEY, VALUE, HASHER>::ValueAtIndex(int index) const {
+    return this->buffer[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> VALUE&
+HashMap<KEY, VALUE, HASHER>::ValueAtIndex(int index) {
+    return this->buffer[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::begin() {
+    return this->buffer._begin();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::begin() const {
+    return this->buffer._begin();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::end() {
+    return this->buffer._end();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::end() const {
+    return this->buffer._end();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::copy(const HashMap& rhs) {
+    // keep the element buffer capacity in sync with the hash table
+    this->table = rhs.table;
+    if (this->table.capacity() > 0) {
+        this->buffer.alloc(this->table.capacity(), 0);
+        for (int i = 0; i < rhs.buffer.size(); i++) {
+            this->buffer.pushBack(rhs.buffer[i]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int
+HashMap<KEY, VALUE, HASHER>::find(const KEY& key, uint32_t hash) const {
+    return this->table.find(hash, [this, &key](int index) {
+        return key == this->buffer[index].key;
+    });
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::erase(int index, uint32_t hash) {
+    this->table.erase(hash, index);
+    const int lastIndex = this->buffer.size() - 1;
+    if (index != lastIndex) {
+        // the last element will be moved into the hole
+        this->table.reindex(HASHER()(this->buffer[lastIndex].key), lastIndex, index);
+    }
+    this->buffer.eraseSwapBack(index);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> template<class KVP> void
+HashMap<KEY, VALUE, HASHER>::add(uint32_t hash, KVP&& kvp) {
+    if (this->buffer.size() == this->table.capacity()) {
+        this->table.grow();
+        this->buffer.alloc(this->table.capacity(), 0);
+    }
+    this->table.insert(hash, this->buffer.size());
+    this->buffer.pushBack(std::forward<KVP>(kvp));
+}
+
+} // namespace Oryol
@@ -4,18 +4,31 @@
     @class Oryol::HashSet
     @ingroup Core
     @brief a Set using hashing for fast access
-    
-    Implements a hash set with a fixed number of buckets, each
-    bucket is a binary-sorted set.
-    
-    @see Array, ArrayMap, Map, Set
+
+    Implements a dynamically growing hash set. The values live densely
+    packed in an element buffer, and an open-addressing hash table
+    (see _priv::hashTable) maps value hashes to element indices.
+    The hash table grows by doubling its size when it is 7/8 full,
+    INITIALCAPACITY is the number of elements to make room for
+    when the first element is added.
+
+    The hash function is a template parameter, by default Oryol::Hash
+    is used (see Core/Hash.h), it must return a 32-bit value.
+
+    Trying to add a value twice results in a fatal runtime error.
+    Erasing a value moves the last value into the hole, so the
+    order of values in the set changes.
+
+    @see Array, ArrayMap, Map, HashMap, Set
 */
 #include "Core/Config.h"
-#include "Core/Containers/Set.h"
+#include "Core/Hash.h"
+#include "Core/Containers/elementBuffer.h"
+#include "Core/Containers/hashTable.h"
 
 namespace Oryol {
 
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> class HashSet {
+template<class VALUETYPE, class HASHER=Hash<VALUETYPE>, int INITIALCAPACITY=0> class HashSet {
 public:
     /// default constructor
     HashSet();
@@ -27,8 +40,8 @@ public:
     void operator=(const HashSet& rhs);
     /// move-assignment operator (same capacity and size)
     void operator=(HashSet&& rhs);
-    
-    /// set allocation strategy
+
+    /// set allocation strategy (only kept for compatibility, HashSet grows by doubling)
     void SetAllocStrategy(int minGrow, int maxGrow=ORYOL_CONTAINER_DEFAULT_MAX_GROW);
     /// get min grow value
     int GetMinGrow() const;
@@ -38,148 +51,223 @@ public:
     int Size() const;
     /// return true if empty
     bool Empty() const;
-    
+    /// get number of elements which fit into the set without rehashing
+    int Capacity() const;
+    /// increase capacity to hold at least numElements more elements
+    void Reserve(int numElements);
+    /// clear the set (deletes elements, keeps capacity)
+    void Clear();
+
     /// test if an element exists
     bool Contains(const VALUETYPE& val) const;
     /// find element
     const VALUETYPE* Find(const VALUETYPE& val) const;
     /// add element
     void Add(const VALUETYPE& val);
-    /// erase element
+    /// erase element, does nothing if the element doesn't exist
     void Erase(const VALUETYPE& val);
-    
+
+    /// C++ conform begin, MAY RETURN nullptr!
+    const VALUETYPE* begin() const;
+    /// C++ conform end, MAY RETURN nullptr!
+    const VALUETYPE* end() const;
+
 private:
-    /// get the bucket for a value
-    const Set<VALUETYPE>& findBucket(const VALUETYPE& val) const;
-    /// get the bucket for a value
-    Set<VALUETYPE>& findBucket(const VALUETYPE& val);
+    /// copy content
+    void copy(const HashSet& rhs);
+    /// find element index of a value, or InvalidIndex
+    int find(const VALUETYPE& val, uint32_t hash) const;
 
-    int size;
-    Set<VALUETYPE> buckets[NUMBUCKETS];
+    _priv::elementBuffer<VALUETYPE> buffer;
+    _priv::hashTable table;
+    int minGrow;
+    int maxGrow;
 };
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS>
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::HashSet() :
-size(0) {
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY>
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::HashSet() :
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
     // empty
 };
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS>
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::HashSet(const HashSet& rhs) :
-size(rhs.size) {
-    for (int i = 0; i < NUMBUCKETS; i++) {
-        this->buckets[i] = rhs.buckets[i];
-    };
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY>
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::HashSet(const HashSet& rhs) {
+    this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS>
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::HashSet(HashSet&& rhs) :
-size(rhs.size) {
-    for (int i = 0; i < NUMBUCKETS; i++) {
-        this->buckets[i] = std::move(rhs.buckets[i]);
-    }
-    rhs.size = 0;
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY>
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::HashSet(HashSet&& rhs) :
+buffer(std::move(rhs.buffer)),
+table(std::move(rhs.table)),
+minGrow(rhs.minGrow),
+maxGrow(rhs.maxGrow) {
+    // empty
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> void
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::operator=(const HashSet& rhs) {
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::operator=(const HashSet& rhs) {
     if (&rhs != this) {
-        this->size = rhs.size;
-        for (int i = 0; i < NUMBUCKETS; i++) {
-            this->buckets[i] = rhs.buckets[i];
-        }
+        this->buffer.destroy();
+        this->copy(rhs);
     }
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> void
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::operator=(HashSet&& rhs) {
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::operator=(HashSet&& rhs) {
     if (&rhs != this) {
-        this->size = rhs.size;
-        for (int i = 0; i < NUMBUCKETS; i++) {
-            this->buckets[i] = std::move(rhs.buckets[i]);
-        }
-        rhs.size = 0;
+        this->buffer = std::move(rhs.buffer);
+        this->table = std::move(rhs.table);
+        this->minGrow = rhs.minGrow;
+        this->maxGrow = rhs.maxGrow;
     }
 }
-    
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> void
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::SetAllocStrategy(int minGrow, int maxGrow) {
-    for (int i = 0; i < NUMBUCKETS; i++) {
-        this->buckets[i].SetAllocStrategy(minGrow, maxGrow);
-    }
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+    this->minGrow = minGrow_;
+    this->maxGrow = maxGrow_;
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> int
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::GetMinGrow() const {
-    return this->buckets[0].GetMinGrow();
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> int
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::GetMinGrow() const {
+    return this->minGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> int
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::GetMaxGrow() const {
-    return this->buckets[0].GetMaxGrow();
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> int
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::GetMaxGrow() const {
+    return this->maxGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> int
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Size() const {
-    return this->size;
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> int
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Size() const {
+    return this->buffer.size();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> bool
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Empty() const {
-    return (0 == this->size);
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> bool
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Empty() const {
+    return (0 == this->buffer.size());
 }
-    
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> bool
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Contains(const VALUETYPE& val) const {
-    const auto& bucket = this->findBucket(val);
-    return bucket.Contains(val);
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> int
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Capacity() const {
+    return this->table.capacity();
 }
-    
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> const VALUETYPE*
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Find(const VALUETYPE& val) const {
-    const auto& bucket = this->findBucket(val);
-    return bucket.Find(val);
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Reserve(int numElements) {
+    this->table.reserve(this->buffer.size() + numElements);
+    if (this->table.capacity() > this->buffer.capacity()) {
+        this->buffer.alloc(this->table.capacity(), 0);
+    }
 }
-    
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> void
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Add(const VALUETYPE& val) {
-    this->size++;
-    auto& bucket = this->findBucket(val);
-    bucket.Add(val);
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Clear() {
+    this->buffer.clear();
+    this->table.clear();
 }
-    
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> void
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::Erase(const VALUETYPE& val) {
-    o_assert_dbg(this->size > 0);
-    this->size--;
-    auto& bucket = this->findBucket(val);
-    bucket.Erase(val);
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> bool
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Contains(const VALUETYPE& val) const {
+    return InvalidIndex != this->find(val, HASHER()(val));
+}
+
+//------------------------------------------------------------------------------
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> const VALUETYPE*
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Find(const VALUETYPE& val) const {
+    const int index = this->find(val, HASHER()(val));
+    if (InvalidIndex != index) {
+        return &(this->buffer[index]);
+    }
+    else {
+        return nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Add(const VALUETYPE& val) {
+    const uint32_t hash = HASHER()(val);
+    if (InvalidIndex != this->find(val, hash)) {
+        o_error("Trying to insert duplicate element!\n");
+    }
+    if (this->buffer.size() == this->table.capacity()) {
+        if ((0 == this->table.capacity()) && (INITIALCAPACITY > 0)) {
+            this->table.reserve(INITIALCAPACITY);
+        }
+        else {
+            this->table.grow();
+        }
+        this->buffer.alloc(this->table.capacity(), 0);
+    }
+    this->table.insert(hash, this->buffer.size());
+    this->buffer.pushBack(val);
+}
+
+//------------------------------------------------------------------------------
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::Erase(const VALUETYPE& val) {
+    const uint32_t hash = HASHER()(val);
+    const int index = this->find(val, hash);
+    if (InvalidIndex != index) {
+        this->table.erase(hash, index);
+        const int lastIndex = this->buffer.size() - 1;
+        if (index != lastIndex) {
+            // the last element will be moved into the hole
+            this->table.reindex(HASHER()(this->buffer[lastIndex]), lastIndex, index);
+        }
+        this->buffer.eraseSwapBack(index);
+    }
 };
-    
+
+//------------------------------------------------------------------------------
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> const VALUETYPE*
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::begin() const {
+    return this->buffer._begin();
+}
+
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> const Set<VALUETYPE>&
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::findBucket(const VALUETYPE& val) const {
-    return this->buckets[uint32_t(HASHER()(val)) % NUMBUCKETS];
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> const VALUETYPE*
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::end() const {
+    return this->buffer._end();
+}
+
+//------------------------------------------------------------------------------
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> void
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::copy(const HashSet& rhs) {
+    // keep the element buffer capacity in sync with the hash table
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    this->table = rhs.table;
+    if (this->table.capacity() > 0) {
+        this->buffer.alloc(this->table.capacity(), 0);
+        for (int i = 0; i < rhs.buffer.size(); i++) {
+            this->buffer.pushBack(rhs.buffer[i]);
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
-template<class VALUETYPE, class HASHER, int NUMBUCKETS> Set<VALUETYPE>&
-HashSet<VALUETYPE, HASHER, NUMBUCKETS>::findBucket(const VALUETYPE& val) {
-    return this->buckets[uint32_t(HASHER()(val)) % NUMBUCKETS];
+template<class VALUETYPE, class HASHER, int INITIALCAPACITY> int
+HashSet<VALUETYPE, HASHER, INITIALCAPACITY>::find(const VALUETYPE& val, uint32_t hash) const {
+    return this->table.find(hash, [this, &val](int index) {
+        return val == this->buffer[index];
+    });
 }
 
-} // namespace Oryol
\ No newline at end of file
+} // namespace Oryol
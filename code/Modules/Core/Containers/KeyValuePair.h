@@ -11,6 +11,7 @@
     @see Map
 */
 #include "Core/Config.h"
+#include "Core/TypeTraits.h"
 
 namespace Oryol {
 
@@ -56,6 +57,10 @@ public:
     VALUE value;
 };
 
+/// a KeyValuePair is trivially relocatable if both key and value are
+template<class KEY, class VALUE> struct IsTriviallyRelocatable<KeyValuePair<KEY, VALUE>> :
+    std::integral_constant<bool, IsTriviallyRelocatable<KEY>::value && IsTriviallyRelocatable<VALUE>::value> { };
+
 //------------------------------------------------------------------------------
 template<class KEY, class VALUE>
 KeyValuePair<KEY, VALUE>::KeyValuePair() {
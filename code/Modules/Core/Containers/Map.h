@@ -24,11 +24,19 @@
     When adding large numbers of elements, consider using the 
     bulk methods, these destroy the sorted order when inserting,
     and sorting will happen inside EndBulk().
+
+    To add a whole range of elements at once (e.g. from two parallel
+    key and value arrays), use AddBulk() with Slices, this works inside
+    and outside of bulk mode. Outside of bulk mode the new elements
+    are sorted on their own and merged once into the existing elements.
     
     The Map uses a double-ended element buffer internally which
     initially has spare room at the front and end. When inserting elements,
     movement happens towards the end which would create less move operations
     (so inserting at the front is just as fast as inserting at the end).
+
+    The optional ALLOCATOR template parameter is an allocator policy
+    for the element buffer (see HeapAllocator).
     
     @see KeyValuePair, Set
 */
@@ -37,13 +45,17 @@
 #include "Core/Config.h"
 #include "Core/Containers/elementBuffer.h"
 #include "Core/Containers/KeyValuePair.h"
+#include "Core/Containers/Slice.h"
+#include "Core/Containers/Sort.h"
 
 namespace Oryol {
 
-template<class KEY, class VALUE> class Map {
+template<class KEY, class VALUE, class ALLOCATOR=HeapAllocator> class Map {
 public:
     /// default constructor
     Map();
+    /// construct with allocator object
+    explicit Map(const ALLOCATOR& allocator);
     /// copy constructor (truncates to actual size)
     Map(const Map& rhs);
     /// move constructor (same capacity and size)
@@ -64,6 +76,10 @@ public:
     int GetMinGrow() const;
     /// get max grow value
     int GetMaxGrow() const;
+    /// set allocator object (map must not have been allocated yet)
+    void SetAllocator(const ALLOCATOR& allocator);
+    /// get allocator object
+    const ALLOCATOR& GetAllocator() const;
     /// get number of elements in array
     int Size() const;
     /// return true if empty
@@ -110,6 +126,10 @@ public:
     void AddBulk(const KEY& key, const VALUE& value);
     /// end bulk-mode (sorting happens here)
     void EndBulk();
+    /// add a range of elements (sort and merge once if not in bulk-mode)
+    void AddBulk(const Slice<const KeyValuePair<KEY, VALUE>>& kvps);
+    /// add a range of elements from keys and values of same size (sort and merge once if not in bulk-mode)
+    void AddBulk(const Slice<const KEY>& keys, const Slice<const VALUE>& values);
     /// find the first duplicate element, or InvalidIndex if not found, this is O(N)!
     int FindDuplicate(int startIndex) const;
     /// find an element, returns index, or InvalidIndex
@@ -143,24 +163,37 @@ private:
     void adjustCapacity(int newCapacity);
     /// grow to make room
     void grow();
+    /// make room for num elements at the back, grows at most once
+    void growBulk(int num);
+    /// sort and merge the elements appended after oldSize (if not in bulk-mode)
+    void mergeBulk(int oldSize);
     
-    _priv::elementBuffer<KeyValuePair<KEY,VALUE>> buffer;
+    _priv::elementBuffer<KeyValuePair<KEY,VALUE>, ALLOCATOR> buffer;
     int minGrow;
     int maxGrow;
     bool inBulkMode;
 };
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE>
-Map<KEY, VALUE>::Map() :
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::Map() :
 minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
 maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW),
 inBulkMode(false) {
     // empty
 }
 
-template<class KEY, class VALUE>
-Map<KEY, VALUE>::Map(std::initializer_list<KeyValuePair<KEY,VALUE>> rhs) :
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::Map(const ALLOCATOR& allocator) :
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW),
+inBulkMode(false) {
+    this->buffer.allocator = allocator;
+}
+
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::Map(std::initializer_list<KeyValuePair<KEY,VALUE>> rhs) :
 minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
 maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW),
 inBulkMode(false) {
@@ -172,26 +205,26 @@ inBulkMode(false) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE>
-Map<KEY, VALUE>::Map(const Map& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::Map(const Map& rhs) {
     this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE>
-Map<KEY, VALUE>::Map(Map&& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::Map(Map&& rhs) {
     this->move(std::move(rhs));
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE>
-Map<KEY, VALUE>::~Map() {
+template<class KEY, class VALUE, class ALLOCATOR>
+Map<KEY, VALUE, ALLOCATOR>::~Map() {
     this->destroy();
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::operator=(const Map& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::operator=(const Map& rhs) {
     /// @todo: this should be optimized when rhs.size() < this->capacity()!
     if (&rhs != this) {
         this->destroy();
@@ -200,8 +233,8 @@ Map<KEY, VALUE>::operator=(const Map& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::operator=(Map&& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::operator=(Map&& rhs) {
     /// @todo: this should be optimized when rhs.size() < this->capacity()!
     if (&rhs != this) {
         this->destroy();
@@ -210,52 +243,65 @@ Map<KEY, VALUE>::operator=(Map&& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::SetAllocStrategy(int minGrow_, int maxGrow_) {
     this->minGrow = minGrow_;
     this->maxGrow = maxGrow_;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::GetMinGrow() const {
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::GetMinGrow() const {
     return this->minGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::GetMaxGrow() const {
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::GetMaxGrow() const {
     return this->maxGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::Size() const {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::SetAllocator(const ALLOCATOR& allocator) {
+    o_assert_dbg(0 == this->buffer.capacity());
+    this->buffer.allocator = allocator;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> const ALLOCATOR&
+Map<KEY, VALUE, ALLOCATOR>::GetAllocator() const {
+    return this->buffer.allocator;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::Size() const {
     return this->buffer.size();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> bool
-Map<KEY, VALUE>::Empty() const {
+template<class KEY, class VALUE, class ALLOCATOR> bool
+Map<KEY, VALUE, ALLOCATOR>::Empty() const {
     return this->buffer.size() == 0;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::Capacity() const {
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::Capacity() const {
     return this->buffer.capacity();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> bool
-Map<KEY, VALUE>::Contains(const KEY& key) const {
+template<class KEY, class VALUE, class ALLOCATOR> bool
+Map<KEY, VALUE, ALLOCATOR>::Contains(const KEY& key) const {
     o_assert_dbg(!this->inBulkMode);
     return std::binary_search(this->buffer._begin(), this->buffer._end(), key);
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> VALUE&
-Map<KEY, VALUE>::operator[](const KEY& key) {
+template<class KEY, class VALUE, class ALLOCATOR> VALUE&
+Map<KEY, VALUE, ALLOCATOR>::operator[](const KEY& key) {
     o_assert_dbg(!this->inBulkMode);
     o_assert_dbg(this->buffer.buf);
     auto kvp = std::lower_bound(this->buffer._begin(), this->buffer._end(), key);
@@ -264,8 +310,8 @@ Map<KEY, VALUE>::operator[](const KEY& key) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> const VALUE&
-Map<KEY, VALUE>::operator[](const KEY& key) const {
+template<class KEY, class VALUE, class ALLOCATOR> const VALUE&
+Map<KEY, VALUE, ALLOCATOR>::operator[](const KEY& key) const {
     o_assert_dbg(!this->inBulkMode);
     o_assert_dbg(this->buffer.buf);
     auto kvp = std::lower_bound(this->buffer._begin(), this->buffer._end(), key);
@@ -274,8 +320,8 @@ Map<KEY, VALUE>::operator[](const KEY& key) const {
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Reserve(int numElements) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Reserve(int numElements) {
     int newCapacity = this->buffer.size() + numElements;
     if (newCapacity > this->buffer.capacity()) {
         this->adjustCapacity(newCapacity);
@@ -283,8 +329,8 @@ Map<KEY, VALUE>::Reserve(int numElements) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Trim() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Trim() {
     const int curSize = this->buffer.size();
     if (curSize < this->buffer.capacity()) {
         this->adjustCapacity(curSize);
@@ -292,14 +338,14 @@ Map<KEY, VALUE>::Trim() {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Clear() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Clear() {
     this->buffer.clear();
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Add(const KeyValuePair<KEY, VALUE>& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Add(const KeyValuePair<KEY, VALUE>& kvp) {
     o_assert_dbg(!this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -310,8 +356,8 @@ Map<KEY, VALUE>::Add(const KeyValuePair<KEY, VALUE>& kvp) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Add(KeyValuePair<KEY, VALUE>&& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Add(KeyValuePair<KEY, VALUE>&& kvp) {
     o_assert_dbg(!this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -322,14 +368,14 @@ Map<KEY, VALUE>::Add(KeyValuePair<KEY, VALUE>&& kvp) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Add(const KEY& key, const VALUE& value) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Add(const KEY& key, const VALUE& value) {
     this->Add(KeyValuePair<KEY, VALUE>(key, value));
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> bool
-Map<KEY, VALUE>::AddUnique(const KeyValuePair<KEY, VALUE>& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> bool
+Map<KEY, VALUE, ALLOCATOR>::AddUnique(const KeyValuePair<KEY, VALUE>& kvp) {
     o_assert(!this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -346,8 +392,8 @@ Map<KEY, VALUE>::AddUnique(const KeyValuePair<KEY, VALUE>& kvp) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> bool
-Map<KEY, VALUE>::AddUnique(KeyValuePair<KEY, VALUE>&& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> bool
+Map<KEY, VALUE, ALLOCATOR>::AddUnique(KeyValuePair<KEY, VALUE>&& kvp) {
     o_assert(!this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -364,14 +410,14 @@ Map<KEY, VALUE>::AddUnique(KeyValuePair<KEY, VALUE>&& kvp) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> bool
-Map<KEY, VALUE>::AddUnique(const KEY& key, const VALUE& value) {
+template<class KEY, class VALUE, class ALLOCATOR> bool
+Map<KEY, VALUE, ALLOCATOR>::AddUnique(const KEY& key, const VALUE& value) {
     return this->AddUnique(KeyValuePair<KEY, VALUE>(key, value));
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::Erase(const KEY& key) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::Erase(const KEY& key) {
     auto ptr = std::lower_bound(this->buffer._begin(), this->buffer._end(), key);
     if (ptr != this->buffer._end()) {
         const int index = int(ptr - this->buffer._begin());
@@ -382,15 +428,15 @@ Map<KEY, VALUE>::Erase(const KEY& key) {
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::BeginBulk() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::BeginBulk() {
     o_assert(!this->inBulkMode);
     this->inBulkMode = true;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::AddBulk(const KeyValuePair<KEY, VALUE>& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::AddBulk(const KeyValuePair<KEY, VALUE>& kvp) {
     o_assert(this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -407,8 +453,8 @@ Map<KEY, VALUE>::AddBulk(const KeyValuePair<KEY, VALUE>& kvp) {
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::AddBulk(KeyValuePair<KEY, VALUE>&& kvp) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::AddBulk(KeyValuePair<KEY, VALUE>&& kvp) {
     o_assert(this->inBulkMode);
     if (this->buffer.spare() == 0) {
         this->grow();
@@ -425,22 +471,57 @@ Map<KEY, VALUE>::AddBulk(KeyValuePair<KEY, VALUE>&& kvp) {
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::AddBulk(const KEY& key, const VALUE& value) {
-    this->Insert(KeyValuePair<KEY, VALUE>(key, value));
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::AddBulk(const KEY& key, const VALUE& value) {
+    this->AddBulk(KeyValuePair<KEY, VALUE>(key, value));
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::EndBulk() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::EndBulk() {
     o_assert(this->inBulkMode);
     this->inBulkMode = false;
-    std::sort(this->buffer._begin(), this->buffer._end());
+    if (this->buffer.size() > 1) {
+        Sort::Auto(this->buffer._begin(), this->buffer._end());
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::AddBulk(const Slice<const KeyValuePair<KEY, VALUE>>& kvps) {
+    const int num = kvps.Size();
+    if (num > 0) {
+        if (this->buffer.backSpare() < num) {
+            this->growBulk(num);
+        }
+        const int oldSize = this->buffer.size();
+        this->buffer.pushBackRange(kvps.begin(), num);
+        this->mergeBulk(oldSize);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::AddBulk(const Slice<const KEY>& keys, const Slice<const VALUE>& values) {
+    o_assert(keys.Size() == values.Size());
+    const int num = keys.Size();
+    if (num > 0) {
+        if (this->buffer.backSpare() < num) {
+            this->growBulk(num);
+        }
+        const int oldSize = this->buffer.size();
+        const KEY* key = keys.begin();
+        const VALUE* value = values.begin();
+        for (int i = 0; i < num; i++) {
+            this->buffer.emplaceBack(*key++, *value++);
+        }
+        this->mergeBulk(oldSize);
+    }
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::FindDuplicate(int startIndex) const {
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::FindDuplicate(int startIndex) const {
     o_assert(!this->inBulkMode);
     const int size = this->buffer.size();
     if (startIndex < size) {
@@ -454,8 +535,8 @@ Map<KEY, VALUE>::FindDuplicate(int startIndex) const {
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> int
-Map<KEY, VALUE>::FindIndex(const KEY& key) const {
+template<class KEY, class VALUE, class ALLOCATOR> int
+Map<KEY, VALUE, ALLOCATOR>::FindIndex(const KEY& key) const {
     o_assert(!this->inBulkMode);
     auto ptr = std::lower_bound(this->buffer._begin(), this->buffer._end(), key);
     if ((ptr != this->buffer._end()) && (key == ptr->key)) {
@@ -467,64 +548,64 @@ Map<KEY, VALUE>::FindIndex(const KEY& key) const {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::EraseIndex(int index) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::EraseIndex(int index) {
     this->buffer.erase(index);
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> const KEY&
-Map<KEY, VALUE>::KeyAtIndex(int index) const {
+template<class KEY, class VALUE, class ALLOCATOR> const KEY&
+Map<KEY, VALUE, ALLOCATOR>::KeyAtIndex(int index) const {
     return this->buffer[index].key;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> const VALUE&
-Map<KEY, VALUE>::ValueAtIndex(int index) const {
+template<class KEY, class VALUE, class ALLOCATOR> const VALUE&
+Map<KEY, VALUE, ALLOCATOR>::ValueAtIndex(int index) const {
     return this->buffer[index].value;
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> VALUE&
-Map<KEY, VALUE>::ValueAtIndex(int index) {
+template<class KEY, class VALUE, class ALLOCATOR> VALUE&
+Map<KEY, VALUE, ALLOCATOR>::ValueAtIndex(int index) {
     return this->buffer[index].value;
 }
     
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> KeyValuePair<KEY, VALUE>*
-Map<KEY, VALUE>::begin() {
+template<class KEY, class VALUE, class ALLOCATOR> KeyValuePair<KEY, VALUE>*
+Map<KEY, VALUE, ALLOCATOR>::begin() {
     return this->buffer._begin();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> const KeyValuePair<KEY, VALUE>*
-Map<KEY, VALUE>::begin() const {
+template<class KEY, class VALUE, class ALLOCATOR> const KeyValuePair<KEY, VALUE>*
+Map<KEY, VALUE, ALLOCATOR>::begin() const {
     return this->buffer._begin();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> KeyValuePair<KEY, VALUE>*
-Map<KEY, VALUE>::end() {
+template<class KEY, class VALUE, class ALLOCATOR> KeyValuePair<KEY, VALUE>*
+Map<KEY, VALUE, ALLOCATOR>::end() {
     return this->buffer._end();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> const KeyValuePair<KEY, VALUE>*
-Map<KEY, VALUE>::end() const {
+template<class KEY, class VALUE, class ALLOCATOR> const KeyValuePair<KEY, VALUE>*
+Map<KEY, VALUE, ALLOCATOR>::end() const {
     return this->buffer._end();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::destroy() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::destroy() {
     this->minGrow = 0;
     this->maxGrow = 0;
     this->buffer.destroy();
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::copy(const Map& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::copy(const Map& rhs) {
     this->minGrow    = rhs.minGrow;
     this->maxGrow    = rhs.maxGrow;
     this->inBulkMode = rhs.inBulkMode;
@@ -532,8 +613,8 @@ Map<KEY, VALUE>::copy(const Map& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::move(Map&& rhs) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::move(Map&& rhs) {
     o_assert_dbg(!rhs.inBulkMode);
     this->minGrow    = rhs.minGrow;
     this->maxGrow    = rhs.maxGrow;
@@ -543,8 +624,8 @@ Map<KEY, VALUE>::move(Map&& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::adjustCapacity(int newCapacity) {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::adjustCapacity(int newCapacity) {
     // have a balanced front and back spare
     int frontSpare = (newCapacity - this->buffer.size()) >> 1;
     o_assert_dbg(frontSpare >= 0);
@@ -552,8 +633,8 @@ Map<KEY, VALUE>::adjustCapacity(int newCapacity) {
 }
 
 //------------------------------------------------------------------------------
-template<class KEY, class VALUE> void
-Map<KEY, VALUE>::grow() {
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::grow() {
     const int curCapacity = this->buffer.capacity();
     int growBy = curCapacity >> 1;
     if (growBy < minGrow) {
@@ -567,4 +648,41 @@ Map<KEY, VALUE>::grow() {
     this->adjustCapacity(newCapacity);
 }
 
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::growBulk(int num) {
+    const int curCapacity = this->buffer.capacity();
+    int growBy = curCapacity >> 1;
+    if (growBy < minGrow) {
+        growBy = minGrow;
+    }
+    else if (growBy > maxGrow) {
+        growBy = maxGrow;
+    }
+    o_assert_dbg(growBy > 0);
+    const int newSize = this->buffer.size() + num;
+    int newCapacity = curCapacity + growBy;
+    if (newCapacity < newSize) {
+        newCapacity = newSize;
+    }
+    // balance the remaining spare room between front and back
+    this->buffer.alloc(newCapacity, (newCapacity - newSize) >> 1);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class ALLOCATOR> void
+Map<KEY, VALUE, ALLOCATOR>::mergeBulk(int oldSize) {
+    if (!this->inBulkMode) {
+        KeyValuePair<KEY, VALUE>* first = this->buffer._begin();
+        KeyValuePair<KEY, VALUE>* mid = first + oldSize;
+        KeyValuePair<KEY, VALUE>* last = this->buffer._end();
+        if ((last - mid) > 1) {
+            Sort::Auto(mid, last);
+        }
+        if ((oldSize > 0) && (*mid < *(mid - 1))) {
+            std::inplace_merge(first, mid, last);
+        }
+    }
+}
+
 } // namespace Oryol
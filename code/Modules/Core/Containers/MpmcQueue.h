@@ -0,0 +1,237 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MpmcQueue
+    @ingroup Core
+    @brief bounded lock-free multi-producer/multi-consumer FIFO queue
+
+    A fixed-capacity ring buffer which can be written and read by any
+    number of threads without locking (based on Dmitry Vyukov's bounded
+    MPMC queue). The capacity is rounded up to the next power of 2.
+
+    Each slot has a sequence number which tells producers and consumers
+    whether the slot is free or filled for the current round, so
+    that producers (and consumers) only compete on a single atomic
+    index, which lives on its own cache line.
+
+    TryEnqueue() and TryDequeue() never block and return false if the
+    queue is full or empty. WaitEnqueue() and WaitDequeue() put the
+    calling thread to sleep until the operation succeeds.
+
+    @see SpscQueue, Queue
+*/
+#include "Core/Config.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/queueWaiter.h"
+#include <atomic>
+
+namespace Oryol {
+
+template<class TYPE> class MpmcQueue {
+public:
+    /// construct with capacity (rounded up to power of 2)
+    explicit MpmcQueue(int capacity);
+    /// destructor
+    ~MpmcQueue();
+
+    /// get the max number of elements in the queue
+    int Capacity() const;
+    /// get approximate number of elements in the queue
+    int Size() const;
+    /// return true if queue is (approximately) empty
+    bool Empty() const;
+
+    /// copy-enqueue an element, return false if queue is full
+    bool TryEnqueue(const TYPE& elm);
+    /// move-enqueue an element, return false if queue is full
+    bool TryEnqueue(TYPE&& elm);
+    /// dequeue an element, return false if queue is empty
+    bool TryDequeue(TYPE& outElm);
+    /// move-enqueue an element, block until there is room
+    void WaitEnqueue(TYPE&& elm);
+    /// dequeue an element, block until the queue isn't empty
+    void WaitDequeue(TYPE& outElm);
+
+private:
+    MpmcQueue(const MpmcQueue& rhs) = delete;
+    void operator=(const MpmcQueue& rhs) = delete;
+
+    /// enqueue without notifying waiting threads
+    template<class T> bool enqueue(T&& elm);
+    /// dequeue without notifying waiting threads
+    bool dequeue(TYPE& outElm);
+
+    struct cell {
+        std::atomic<uint32_t> sequence;
+        TYPE elm;
+    };
+
+    // read-only after construction
+    cell* cells;
+    uint32_t mask;
+    uint8_t pad0[ORYOL_CACHE_LINE_SIZE];
+    std::atomic<uint32_t> enqueuePos;
+    uint8_t pad1[ORYOL_CACHE_LINE_SIZE];
+    std::atomic<uint32_t> dequeuePos;
+    uint8_t pad2[ORYOL_CACHE_LINE_SIZE];
+    _priv::queueWaiter waiter;
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+MpmcQueue<TYPE>::MpmcQueue(int capacity) :
+enqueuePos(0),
+dequeuePos(0) {
+    o_assert((capacity > 0) && (capacity <= (1<<30)));
+    uint32_t cap = 2;
+    while (cap < uint32_t(capacity)) {
+        cap <<= 1;
+    }
+    this->mask = cap - 1;
+    // NOTE: the element objects are only constructed when enqueued
+    this->cells = (cell*) Memory::Alloc(cap * sizeof(cell));
+    for (uint32_t i = 0; i < cap; i++) {
+        new(&this->cells[i].sequence) std::atomic<uint32_t>(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+MpmcQueue<TYPE>::~MpmcQueue() {
+    const uint32_t end = this->enqueuePos.load(std::memory_order_acquire);
+    for (uint32_t pos = this->dequeuePos.load(std::memory_order_acquire); pos != end; pos++) {
+        this->cells[pos & this->mask].elm.~TYPE();
+    }
+    Memory::Free(this->cells);
+    this->cells = nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+MpmcQueue<TYPE>::Capacity() const {
+    return int(this->mask + 1);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+MpmcQueue<TYPE>::Size() const {
+    const uint32_t d = this->dequeuePos.load(std::memory_order_acquire);
+    const uint32_t e = this->enqueuePos.load(std::memory_order_acquire);
+    const int size = int(int32_t(e - d));
+    return size > 0 ? size : 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+MpmcQueue<TYPE>::Empty() const {
+    return 0 == this->Size();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> template<class T> bool
+MpmcQueue<TYPE>::enqueue(T&& elm) {
+    cell* c;
+    uint32_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        c = &this->cells[pos & this->mask];
+        const uint32_t seq = c->sequence.load(std::memory_order_acquire);
+        const int32_t diff = int32_t(seq - pos);
+        if (0 == diff) {
+            // slot is free for this round, try to claim it
+            if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // slot still filled from the previous round: queue is full
+            return false;
+        }
+        else {
+            // another producer was faster
+            pos = this->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    new(&c->elm) TYPE(std::forward<T>(elm));
+    c->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+MpmcQueue<TYPE>::dequeue(TYPE& outElm) {
+    cell* c;
+    uint32_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        c = &this->cells[pos & this->mask];
+        const uint32_t seq = c->sequence.load(std::memory_order_acquire);
+        const int32_t diff = int32_t(seq - (pos + 1));
+        if (0 == diff) {
+            // slot is filled for this round, try to claim it
+            if (this->dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // slot not filled yet: queue is empty
+            return false;
+        }
+        else {
+            // another consumer was faster
+            pos = this->dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    outElm = std::move(c->elm);
+    c->elm.~TYPE();
+    c->sequence.store(pos + this->mask + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+MpmcQueue<TYPE>::TryEnqueue(const TYPE& elm) {
+    if (this->enqueue(elm)) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+MpmcQueue<TYPE>::TryEnqueue(TYPE&& elm) {
+    if (this->enqueue(std::move(elm))) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+MpmcQueue<TYPE>::TryDequeue(TYPE& outElm) {
+    if (this->dequeue(outElm)) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+MpmcQueue<TYPE>::WaitEnqueue(TYPE&& elm) {
+    this->waiter.wait([this, &elm]() {
+        return this->enqueue(std::move(elm));
+    });
+    this->waiter.notify();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+MpmcQueue<TYPE>::WaitDequeue(TYPE& outElm) {
+    this->waiter.wait([this, &outElm]() {
+        return this->dequeue(outElm);
+    });
+    this->waiter.notify();
+}
+
+} // namespace Oryol
@@ -4,28 +4,43 @@
     @class Oryol::Queue
     @ingroup Core
     @brief a FIFO queue
+
+    The Queue is a circular buffer with a power-of-2 capacity, element
+    positions are computed by masking a running index. Enqueueing and
+    dequeueing never move existing elements, the buffer only needs to
+    be reallocated when the queue is full. With SetFixedCapacity()
+    each operation is O(1), no matter how many elements have been
+    pushed through the queue before.
+
+    Capacities are always rounded up to the next power of 2.
+
+    The optional ALLOCATOR template parameter is an allocator policy
+    for the ring buffer (see HeapAllocator).
 */
 #include "Core/Config.h"
+#include "Core/TypeTraits.h"
 #include "Core/Containers/elementBuffer.h"
 
 namespace Oryol {
 
-template<class TYPE> class Queue {
+template<class TYPE, class ALLOCATOR=HeapAllocator> class Queue {
 public:
     /// default constructor
     Queue();
+    /// construct with allocator object
+    explicit Queue(const ALLOCATOR& allocator);
     /// copy constructor
     Queue(const Queue& rhs);
     /// move constructor
     Queue(Queue&& rhs);
     /// destructor
     ~Queue();
-    
+
     /// copy-assignment
     void operator=(const Queue& rhs);
     /// move-assignment
     void operator=(Queue&& rhs);
-    
+
     /// set allocation strategy
     void SetAllocStrategy(int minGrow, int maxGrow);
     /// initialize to a fixed capacity (guarantees that no re-allocs happen)
@@ -34,22 +49,26 @@ public:
     int GetMinGrow() const;
     /// get max-grow value
     int GetMaxGrow() const;
+    /// set allocator object (queue must not have been allocated yet)
+    void SetAllocator(const ALLOCATOR& allocator);
+    /// get allocator object
+    const ALLOCATOR& GetAllocator() const;
     /// get number of elements in array
     int Size() const;
     /// return true if empty
     bool Empty() const;
     /// get capacity of queue
     int Capacity() const;
-    /// get number of free slots at dequeue-side
+    /// get number of free slots in front of the first element
     int SpareDequeue() const;
-    /// get number of free slots at enqueue-side
+    /// get number of elements which can be enqueued without growing
     int SpareEnqueue() const;
-    
+
     /// increase capacity to hold at least numElements more elements
     void Reserve(int numElements);
     /// clear the queue
     void Clear();
-    
+
     /// read/write access to first element
     TYPE& Front();
     /// read-only access to first element
@@ -58,7 +77,7 @@ public:
     TYPE& Back();
     /// read-only access to first element
     const TYPE& Back() const;
-    
+
     /// copy-enqueue an element
     void Enqueue(const TYPE& elm);
     /// move-enqueue an element
@@ -70,7 +89,7 @@ public:
     TYPE Dequeue();
     /// dequeue into existing element
     void Dequeue(TYPE& outElm);
-    
+
 private:
     /// destroy contained resource
     void destroy();
@@ -78,55 +97,128 @@ private:
     void copy(const Queue& rhs);
     /// move from other queue
     void move(Queue&& rhs);
-    /// reallocate with new capacity
+    /// reallocate with new capacity (rounded up to power of 2)
     void adjustCapacity(int newCapacity);
     /// grow to make room
     void grow();
-    /// move elements to the front
-    void moveToFront();
-    /// common checks before enqueuing
-    void checkEnqueue();
-    
-    _priv::elementBuffer<TYPE> buffer;
+    /// common checks before enqueuing, returns slot to construct new element in
+    TYPE* checkEnqueue();
+    /// round capacity up to next power of 2
+    static int roundCapacity(int capacity);
+
+    TYPE* buf;      // buffer start
+    int cap;        // buffer capacity, always 0 or a power of 2
+    int head;       // buffer index of the first element
+    int num;        // number of elements
     int minGrow;
     int maxGrow;
+    ALLOCATOR allocator;
 };
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::destroy() {
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::roundCapacity(int capacity) {
+    o_assert_dbg((capacity >= 0) && (capacity <= (1<<30)));
+    int roundedCapacity = 0;
+    if (capacity > 0) {
+        roundedCapacity = 1;
+        while (roundedCapacity < capacity) {
+            roundedCapacity <<= 1;
+        }
+    }
+    return roundedCapacity;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::destroy() {
+    this->Clear();
+    if (this->buf) {
+        this->allocator.Free(this->buf, this->cap * sizeof(TYPE), ORYOL_MAX_PLATFORM_ALIGN);
+        this->buf = nullptr;
+    }
+    this->cap = 0;
     this->minGrow = 0;
     this->maxGrow = 0;
-    this->buffer.destroy();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::copy(const Queue<TYPE>& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::copy(const Queue<TYPE, ALLOCATOR>& rhs) {
     this->minGrow = rhs.minGrow;
     this->maxGrow = rhs.maxGrow;
-    this->buffer = rhs.buffer;
+    this->allocator = rhs.allocator;
+    this->buf = nullptr;
+    this->cap = 0;
+    this->head = 0;
+    this->num = 0;
+    if (rhs.num > 0) {
+        this->cap = roundCapacity(rhs.num);
+        this->buf = (TYPE*) this->allocator.Alloc(this->cap * sizeof(TYPE), ORYOL_MAX_PLATFORM_ALIGN);
+        // the source elements may wrap around
+        const int num0 = (rhs.head + rhs.num) > rhs.cap ? (rhs.cap - rhs.head) : rhs.num;
+        _priv::elementBuffer<TYPE>::copyConstruct(&rhs.buf[rhs.head], this->buf, num0);
+        _priv::elementBuffer<TYPE>::copyConstruct(rhs.buf, &this->buf[num0], rhs.num - num0);
+        this->num = rhs.num;
+    }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::move(Queue&& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::move(Queue&& rhs) {
     this->minGrow = rhs.minGrow;
     this->maxGrow = rhs.maxGrow;
-    this->buffer  = std::move(rhs.buffer);
+    this->allocator = rhs.allocator;
+    this->buf  = rhs.buf;
+    this->cap  = rhs.cap;
+    this->head = rhs.head;
+    this->num  = rhs.num;
+    rhs.buf  = nullptr;
+    rhs.cap  = 0;
+    rhs.head = 0;
+    rhs.num  = 0;
     // NOTE: don't reset minGrow/maxGrow, rhs is empty, but still a valid object!
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::adjustCapacity(int newCapacity) {
-    this->buffer.alloc(newCapacity, 0);
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::adjustCapacity(int newCapacity) {
+    newCapacity = roundCapacity(newCapacity);
+    o_assert_dbg(newCapacity >= this->num);
+    if (newCapacity == this->cap) {
+        return;
+    }
+    TYPE* newBuf = (TYPE*) this->allocator.Alloc(newCapacity * sizeof(TYPE), ORYOL_MAX_PLATFORM_ALIGN);
+    if (this->num > 0) {
+        // unwrap the elements into the new buffer
+        const int num0 = (this->head + this->num) > this->cap ? (this->cap - this->head) : this->num;
+        const int num1 = this->num - num0;
+        if (IsTriviallyRelocatable<TYPE>::value) {
+            Memory::Copy(&this->buf[this->head], newBuf, num0 * sizeof(TYPE));
+            if (num1 > 0) {
+                Memory::Copy(this->buf, &newBuf[num0], num1 * sizeof(TYPE));
+            }
+        }
+        else {
+            for (int i = 0; i < this->num; i++) {
+                TYPE* from = &this->buf[(this->head + i) & (this->cap - 1)];
+                new(&newBuf[i]) TYPE(std::move(*from));
+                from->~TYPE();
+            }
+        }
+    }
+    if (this->buf) {
+        this->allocator.Free(this->buf, this->cap * sizeof(TYPE), ORYOL_MAX_PLATFORM_ALIGN);
+    }
+    this->buf = newBuf;
+    this->cap = newCapacity;
+    this->head = 0;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::grow() {
-    const int curCapacity = this->buffer.capacity();
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::grow() {
+    const int curCapacity = this->cap;
     int growBy = curCapacity >> 1;
     if (growBy < minGrow) {
         growBy = minGrow;
@@ -140,53 +232,51 @@ Queue<TYPE>::grow() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::moveToFront() {
-    const int num = this->buffer.size();
-    if (num > 0) {
-        o_assert_dbg(this->buffer.buf);
-        const TYPE* from = this->buffer._begin();
-        TYPE* to = this->buffer.buf;
-        for (int i = 0; i < num; i++) {
-            new(to) TYPE(std::move(*from));
-            from->~TYPE();
-            to++;
-            from++;
-        }
-    }
-    this->buffer.start = 0;
-    this->buffer.end = this->buffer.start + num;
+template<class TYPE, class ALLOCATOR>
+Queue<TYPE, ALLOCATOR>::Queue() :
+buf(nullptr),
+cap(0),
+head(0),
+num(0),
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+    // empty
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Queue<TYPE>::Queue() :
+template<class TYPE, class ALLOCATOR>
+Queue<TYPE, ALLOCATOR>::Queue(const ALLOCATOR& allocator_) :
+buf(nullptr),
+cap(0),
+head(0),
+num(0),
 minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
-maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW),
+allocator(allocator_) {
     // empty
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Queue<TYPE>::Queue(const Queue& rhs) {
+template<class TYPE, class ALLOCATOR>
+Queue<TYPE, ALLOCATOR>::Queue(const Queue& rhs) {
     this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Queue<TYPE>::Queue(Queue&& rhs) {
+template<class TYPE, class ALLOCATOR>
+Queue<TYPE, ALLOCATOR>::Queue(Queue&& rhs) {
     this->move(std::move(rhs));
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-Queue<TYPE>::~Queue() {
+template<class TYPE, class ALLOCATOR>
+Queue<TYPE, ALLOCATOR>::~Queue() {
     this->destroy();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::operator=(const Queue& rhs) {
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::operator=(const Queue& rhs) {
     /// @todo: this should be optimized when rhs.size() < this->capacity()!
     if (&rhs != this) {
         this->destroy();
@@ -195,9 +285,8 @@ Queue<TYPE>::operator=(const Queue& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::operator=(Queue&& rhs) {
-    /// @todo: this should be optimized when rhs.size() < this->capacity()!
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::operator=(Queue&& rhs) {
     if (&rhs != this) {
         this->destroy();
         this->move(std::move(rhs));
@@ -205,157 +294,187 @@ Queue<TYPE>::operator=(Queue&& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::SetAllocStrategy(int minGrow_, int maxGrow_) {
     this->minGrow = minGrow_;
     this->maxGrow = maxGrow_;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::SetFixedCapacity(int fixedCapacity) {
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::SetFixedCapacity(int fixedCapacity) {
     this->minGrow = 0;
     this->maxGrow = 0;
-    if (fixedCapacity > this->buffer.capacity()) {
+    if (fixedCapacity > this->cap) {
         this->adjustCapacity(fixedCapacity);
     }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::GetMinGrow() const {
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::GetMinGrow() const {
     return this->minGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::GetMaxGrow() const {
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::GetMaxGrow() const {
     return this->maxGrow;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::Size() const {
-    return this->buffer.size();
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::SetAllocator(const ALLOCATOR& allocator_) {
+    o_assert_dbg(0 == this->cap);
+    this->allocator = allocator_;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::Capacity() const {
-    return this->buffer.capacity();
+template<class TYPE, class ALLOCATOR> const ALLOCATOR&
+Queue<TYPE, ALLOCATOR>::GetAllocator() const {
+    return this->allocator;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> bool
-Queue<TYPE>::Empty() const {
-    return this->buffer.size() == 0;
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::Size() const {
+    return this->num;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::SpareDequeue() const {
-    return this->buffer.frontSpare();
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::Capacity() const {
+    return this->cap;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-Queue<TYPE>::SpareEnqueue() const {
-    return this->buffer.backSpare();
+template<class TYPE, class ALLOCATOR> bool
+Queue<TYPE, ALLOCATOR>::Empty() const {
+    return this->num == 0;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::Reserve(int numElements) {
-    int newCapacity = this->buffer.size() + numElements;
-    if (newCapacity > this->buffer.capacity()) {
-        this->adjustCapacity(newCapacity);
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::SpareDequeue() const {
+    // if the elements wrap around, all free slots are in front of the head
+    if ((this->head + this->num) > this->cap) {
+        return this->cap - this->num;
+    }
+    else {
+        return this->head;
     }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::Clear() {
-    this->buffer.clear();
+template<class TYPE, class ALLOCATOR> int
+Queue<TYPE, ALLOCATOR>::SpareEnqueue() const {
+    return this->cap - this->num;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::checkEnqueue() {
-    // if there are currently no elements in the queue,
-    // then this is a good time to move the start
-    // to the front
-    if (0 == this->buffer.size()) {
-        this->moveToFront();
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::Reserve(int numElements) {
+    int newCapacity = this->num + numElements;
+    if (newCapacity > this->cap) {
+        this->adjustCapacity(newCapacity);
     }
-    if (this->buffer.backSpare() == 0) {
-        // no space at back, if there's front-space, move elements to front
-        if (this->buffer.frontSpare() > 0) {
-            this->moveToFront();
-        }
-        else {
-            // no space at front either, need to grow
-            this->grow();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::Clear() {
+    if (!std::is_trivially_destructible<TYPE>::value) {
+        for (int i = 0; i < this->num; i++) {
+            this->buf[(this->head + i) & (this->cap - 1)].~TYPE();
         }
     }
+    this->head = 0;
+    this->num = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> TYPE*
+Queue<TYPE, ALLOCATOR>::checkEnqueue() {
+    if (this->num == this->cap) {
+        this->grow();
+    }
+    TYPE* slot = &this->buf[(this->head + this->num) & (this->cap - 1)];
+    this->num++;
+    return slot;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::Enqueue(const TYPE& elm) {
-    this->checkEnqueue();
-    this->buffer.pushBack(elm);
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::Enqueue(const TYPE& elm) {
+    new(this->checkEnqueue()) TYPE(elm);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::Enqueue(TYPE&& elm) {
-    this->checkEnqueue();
-    this->buffer.pushBack(std::move(elm));
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::Enqueue(TYPE&& elm) {
+    new(this->checkEnqueue()) TYPE(std::move(elm));
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> template<class... ARGS> void
-Queue<TYPE>::Enqueue(ARGS&&... args) {
-    this->checkEnqueue();
-    this->buffer.emplaceBack(std::forward<ARGS>(args)...);
+template<class TYPE, class ALLOCATOR> template<class... ARGS> void
+Queue<TYPE, ALLOCATOR>::Enqueue(ARGS&&... args) {
+    new(this->checkEnqueue()) TYPE(std::forward<ARGS>(args)...);
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE
-Queue<TYPE>::Dequeue() {
-    o_assert_dbg(this->buffer.size() > 0);
-    return std::move(this->buffer.popFront());
+template<class TYPE, class ALLOCATOR> TYPE
+Queue<TYPE, ALLOCATOR>::Dequeue() {
+    o_assert_dbg(this->num > 0);
+    TYPE* elmPtr = &this->buf[this->head];
+    TYPE elm(std::move(*elmPtr));
+    elmPtr->~TYPE();
+    this->head = (this->head + 1) & (this->cap - 1);
+    if (0 == --this->num) {
+        // nothing in the queue, start over at the front
+        this->head = 0;
+    }
+    return elm;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-Queue<TYPE>::Dequeue(TYPE& outElm) {
-    o_assert_dbg(this->buffer.size() > 0);
-    outElm = std::move(this->buffer.popFront());
+template<class TYPE, class ALLOCATOR> void
+Queue<TYPE, ALLOCATOR>::Dequeue(TYPE& outElm) {
+    o_assert_dbg(this->num > 0);
+    TYPE* elmPtr = &this->buf[this->head];
+    outElm = std::move(*elmPtr);
+    elmPtr->~TYPE();
+    this->head = (this->head + 1) & (this->cap - 1);
+    if (0 == --this->num) {
+        this->head = 0;
+    }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Queue<TYPE>::Front() {
-    return this->buffer.front();
+template<class TYPE, class ALLOCATOR> TYPE&
+Queue<TYPE, ALLOCATOR>::Front() {
+    o_assert(this->num > 0);
+    return this->buf[this->head];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-Queue<TYPE>::Front() const {
-    return this->buffer.front();
+template<class TYPE, class ALLOCATOR> const TYPE&
+Queue<TYPE, ALLOCATOR>::Front() const {
+    o_assert(this->num > 0);
+    return this->buf[this->head];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-Queue<TYPE>::Back() {
-    return this->buffer.back();
+template<class TYPE, class ALLOCATOR> TYPE&
+Queue<TYPE, ALLOCATOR>::Back() {
+    o_assert(this->num > 0);
+    return this->buf[(this->head + this->num - 1) & (this->cap - 1)];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-Queue<TYPE>::Back() const {
-    return this->buffer.back();
+template<class TYPE, class ALLOCATOR> const TYPE&
+Queue<TYPE, ALLOCATOR>::Back() const {
+    o_assert(this->num > 0);
+    return this->buf[(this->head + this->num - 1) & (this->cap - 1)];
 }
 
 } // namespace Oryol
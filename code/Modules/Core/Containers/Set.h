@@ -7,18 +7,31 @@
 
     The Set class provides a dynamic array of binary-sorted values similar
     to the std::set class. 
+
+    When adding large numbers of elements, use the bulk methods,
+    the elements are appended unsorted and sorted once inside EndBulk()
+    with Sort::Auto(), which is much faster than sorted insertion.
+    To add a whole range of values at once, use AddBulk() with a Slice,
+    outside of bulk mode the new values are sorted on their own and
+    merged once into the existing values.
+
+    The optional ALLOCATOR template parameter is an allocator policy
+    for the value array (see HeapAllocator).
      
     @see Array, ArrayMap, Map
 */
 #include <algorithm>
 #include "Core/Containers/Array.h"
+#include "Core/Containers/Sort.h"
 
 namespace Oryol {
 
-template<class VALUE> class Set {
+template<class VALUE, class ALLOCATOR=HeapAllocator> class Set {
 public:
     /// default constructor
     Set();
+    /// construct with allocator object
+    explicit Set(const ALLOCATOR& allocator);
     /// copy constructor (truncates to actual size)
     Set(const Set& rhs);
     /// move constructor (same capacity and size)
@@ -35,6 +48,10 @@ public:
     int GetMinGrow() const;
     /// get max grow value
     int GetMaxGrow() const;
+    /// set allocator object (set must not have been allocated yet)
+    void SetAllocator(const ALLOCATOR& allocator);
+    /// get allocator object
+    const ALLOCATOR& GetAllocator() const;
     /// get number of elements in array
     int Size() const;
     /// return true if empty
@@ -51,6 +68,14 @@ public:
     void Add(const VALUE& val);
     /// erase element
     void Erase(const VALUE& val);
+    /// begin bulk-mode
+    void BeginBulk();
+    /// add element in bulk-mode (destroys sorting order)
+    void AddBulk(const VALUE& val);
+    /// end bulk-mode (sorting happens here, duplicates are an error)
+    void EndBulk();
+    /// add a range of values (sort and merge once if not in bulk-mode, duplicates are an error)
+    void AddBulk(const Slice<const VALUE>& vals);
     /// get value at index
     const VALUE& ValueAtIndex(int index) const;
     
@@ -64,96 +89,124 @@ public:
     const VALUE* end() const;
     
 private:
-    Array<VALUE> valueArray;
+    Array<VALUE, ALLOCATOR> valueArray;
+    bool inBulkMode;
 };
 
 //------------------------------------------------------------------------------
-template<class VALUE>
-Set<VALUE>::Set() {
+template<class VALUE, class ALLOCATOR>
+Set<VALUE, ALLOCATOR>::Set() :
+inBulkMode(false) {
     // empty
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE>
-Set<VALUE>::Set(const Set& rhs) :
-valueArray(rhs.valueArray) {
+template<class VALUE, class ALLOCATOR>
+Set<VALUE, ALLOCATOR>::Set(const ALLOCATOR& allocator) :
+valueArray(allocator),
+inBulkMode(false) {
     // empty
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE>
-Set<VALUE>::Set(Set&& rhs) :
-valueArray(std::move(rhs.valueArray)) {
+template<class VALUE, class ALLOCATOR>
+Set<VALUE, ALLOCATOR>::Set(const Set& rhs) :
+valueArray(rhs.valueArray),
+inBulkMode(false) {
+    o_assert_dbg(!rhs.inBulkMode);
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR>
+Set<VALUE, ALLOCATOR>::Set(Set&& rhs) :
+valueArray(std::move(rhs.valueArray)),
+inBulkMode(false) {
+    o_assert_dbg(!rhs.inBulkMode);
     // empty
 }
     
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::operator=(const Set& rhs) {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::operator=(const Set& rhs) {
     if (&rhs != this) {
         this->valueArray = rhs.valueArray;
     }
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::operator=(Set&& rhs) {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::operator=(Set&& rhs) {
     if (&rhs != this) {
         this->valueArray = std::move(rhs.valueArray);
     }
 }
     
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::SetAllocStrategy(int minGrow, int maxGrow) {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::SetAllocStrategy(int minGrow, int maxGrow) {
     this->valueArray.SetAllocStrategy(minGrow, maxGrow);
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> int
-Set<VALUE>::GetMinGrow() const {
+template<class VALUE, class ALLOCATOR> int
+Set<VALUE, ALLOCATOR>::GetMinGrow() const {
     return this->valueArray.GetMinGrow();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> int
-Set<VALUE>::GetMaxGrow() const {
+template<class VALUE, class ALLOCATOR> int
+Set<VALUE, ALLOCATOR>::GetMaxGrow() const {
     return this->valueArray.GetMaxGrow();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> int
-Set<VALUE>::Size() const {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::SetAllocator(const ALLOCATOR& allocator) {
+    this->valueArray.SetAllocator(allocator);
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> const ALLOCATOR&
+Set<VALUE, ALLOCATOR>::GetAllocator() const {
+    return this->valueArray.GetAllocator();
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> int
+Set<VALUE, ALLOCATOR>::Size() const {
     return this->valueArray.Size();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> bool
-Set<VALUE>::Empty() const {
+template<class VALUE, class ALLOCATOR> bool
+Set<VALUE, ALLOCATOR>::Empty() const {
     return this->valueArray.Empty();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> int
-Set<VALUE>::Capacity() const {
+template<class VALUE, class ALLOCATOR> int
+Set<VALUE, ALLOCATOR>::Capacity() const {
     return this->valueArray.Capacity();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::Clear() {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::Clear() {
     this->valueArray.Clear();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> bool
-Set<VALUE>::Contains(const VALUE& val) const {
+template<class VALUE, class ALLOCATOR> bool
+Set<VALUE, ALLOCATOR>::Contains(const VALUE& val) const {
+    o_assert_dbg(!this->inBulkMode);
     return std::binary_search(this->valueArray.begin(), this->valueArray.end(), val);
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> const VALUE*
-Set<VALUE>::Find(const VALUE& val) const {
+template<class VALUE, class ALLOCATOR> const VALUE*
+Set<VALUE, ALLOCATOR>::Find(const VALUE& val) const {
+    o_assert_dbg(!this->inBulkMode);
     const VALUE* ptr = std::lower_bound(this->valueArray.begin(), this->valueArray.end(), val);
     if (ptr != this->valueArray.end() && val == *ptr) {
         return ptr;
@@ -164,8 +217,9 @@ Set<VALUE>::Find(const VALUE& val) const {
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::Add(const VALUE& val) {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::Add(const VALUE& val) {
+    o_assert_dbg(!this->inBulkMode);
     const VALUE* begin = this->valueArray.begin();
     const VALUE* end = this->valueArray.end();
     const VALUE* ptr = std::lower_bound(begin, end, val);
@@ -179,8 +233,9 @@ Set<VALUE>::Add(const VALUE& val) {
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> void
-Set<VALUE>::Erase(const VALUE& val) {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::Erase(const VALUE& val) {
+    o_assert_dbg(!this->inBulkMode);
     const VALUE* begin = this->valueArray.begin();
     const VALUE* end = this->valueArray.end();
     const VALUE* ptr = std::lower_bound(begin, end, val);
@@ -191,32 +246,82 @@ Set<VALUE>::Erase(const VALUE& val) {
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> const VALUE&
-Set<VALUE>::ValueAtIndex(int index) const {
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::BeginBulk() {
+    o_assert(!this->inBulkMode);
+    this->inBulkMode = true;
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::AddBulk(const VALUE& val) {
+    o_assert(this->inBulkMode);
+    this->valueArray.Add(val);
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::EndBulk() {
+    o_assert(this->inBulkMode);
+    this->inBulkMode = false;
+    this->valueArray.Sort();
+    for (int i = 1; i < this->valueArray.Size(); i++) {
+        if (this->valueArray[i - 1] == this->valueArray[i]) {
+            o_error("Set::EndBulk(): duplicate element!\n");
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> void
+Set<VALUE, ALLOCATOR>::AddBulk(const Slice<const VALUE>& vals) {
+    const int oldSize = this->valueArray.Size();
+    this->valueArray.AddBulk(vals);
+    if (!this->inBulkMode && (vals.Size() > 0)) {
+        VALUE* first = this->valueArray.begin();
+        VALUE* mid = first + oldSize;
+        VALUE* last = this->valueArray.end();
+        if ((last - mid) > 1) {
+            Sort::Auto(mid, last);
+        }
+        if ((oldSize > 0) && (*mid < *(mid - 1))) {
+            std::inplace_merge(first, mid, last);
+        }
+        for (int i = 1; i < this->valueArray.Size(); i++) {
+            if (this->valueArray[i - 1] == this->valueArray[i]) {
+                o_error("Set::AddBulk(): duplicate element!\n");
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class VALUE, class ALLOCATOR> const VALUE&
+Set<VALUE, ALLOCATOR>::ValueAtIndex(int index) const {
     return this->valueArray[index];
 };
     
 //------------------------------------------------------------------------------
-template<class VALUE> VALUE*
-Set<VALUE>::begin() {
+template<class VALUE, class ALLOCATOR> VALUE*
+Set<VALUE, ALLOCATOR>::begin() {
     return this->valueArray.begin();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> const VALUE*
-Set<VALUE>::begin() const {
+template<class VALUE, class ALLOCATOR> const VALUE*
+Set<VALUE, ALLOCATOR>::begin() const {
     return this->valueArray.begin();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> VALUE*
-Set<VALUE>::end() {
+template<class VALUE, class ALLOCATOR> VALUE*
+Set<VALUE, ALLOCATOR>::end() {
     return this->valueArray.end();
 }
 
 //------------------------------------------------------------------------------
-template<class VALUE> const VALUE*
-Set<VALUE>::end() const {
+template<class VALUE, class ALLOCATOR> const VALUE*
+Set<VALUE, ALLOCATOR>::end() const {
     return this->valueArray.end();
 }
 
@@ -12,6 +12,7 @@
 */
 #include "Core/Config.h"
 #include "Core/Assertion.h"
+#include <type_traits>
 
 namespace Oryol {
 
@@ -23,6 +24,8 @@ public:
     Slice(TYPE* base, int numBaseItems, int sliceOffset=0, int numSliceItems=EndOfRange);
     /// copy constructor
     Slice(const Slice& rhs);
+    /// construct a read-only slice from a read/write slice
+    template<typename OTHER> Slice(const Slice<OTHER>& rhs);
     /// copy-assignment
     void operator=(const Slice& rhs);
     /// read/write access to indexed item
@@ -59,6 +62,8 @@ public:
     const TYPE* end() const;
 
 private:
+    template<typename OTHER> friend class Slice;
+
     TYPE* basePtr = nullptr;
     int baseSize = 0;
     int offset = 0;
@@ -89,6 +94,13 @@ basePtr(rhs.basePtr), baseSize(rhs.baseSize), offset(rhs.offset), num(rhs.num) {
     // empty
 }
 
+//------------------------------------------------------------------------------
+template<typename TYPE> template<typename OTHER>
+Slice<TYPE>::Slice(const Slice<OTHER>& rhs):
+basePtr(rhs.basePtr), baseSize(rhs.baseSize), offset(rhs.offset), num(rhs.num) {
+    static_assert(std::is_same<TYPE, const OTHER>::value, "Slice: can only convert Slice<T> to Slice<const T>");
+}
+
 //------------------------------------------------------------------------------
 template<typename TYPE> void
 Slice<TYPE>::operator=(const Slice& rhs) {
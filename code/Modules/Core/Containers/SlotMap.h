@@ -0,0 +1,354 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SlotMap
+    @ingroup Core
+    @brief dense container addressed through generational handles
+
+    A SlotMap<TYPE> hands out a SlotHandle for each added element, which
+    consists of a 32-bit slot index and a 32-bit generation counter.
+    When an element is erased, the slot's generation is bumped, so that
+    stale handles are detected instead of silently accessing a new
+    element which has been added into the same slot.
+
+    Add, Erase and lookup by handle are O(1). The elements themselves
+    are kept densely packed in an Array (erasing swaps in the last
+    element), so iterating over all live elements is as fast as
+    iterating over an Array. The slot table grows on demand, and
+    growing never invalidates handles (but it may move the elements
+    in memory, so don't keep pointers into the SlotMap around).
+
+    This is the general-purpose version of the Id/ResourcePool pair
+    in the Resource module, for subsystems which need safe handles
+    without going through resource management.
+
+    @see SlotHandle, Array
+*/
+#include "Core/Config.h"
+#include "Core/Hash.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SlotHandle
+    @ingroup Core
+    @brief 32/32 bit slot-index/generation handle into a SlotMap
+*/
+class SlotHandle {
+public:
+    /// default constructor, creates an invalid handle
+    SlotHandle() : Index(0), Generation(0) { };
+    /// construct from slot index and generation
+    SlotHandle(uint32_t index, uint32_t generation) : Index(index), Generation(generation) { };
+
+    /// return true if the handle is valid (doesn't mean that it is contained in a SlotMap)
+    bool IsValid() const {
+        return 0 != this->Generation;
+    };
+    /// invalidate the handle
+    void Invalidate() {
+        this->Index = 0;
+        this->Generation = 0;
+    };
+    /// get the handle as a combined 64-bit value
+    uint64_t Value() const {
+        return (uint64_t(this->Generation) << 32) | this->Index;
+    };
+    /// equality operator
+    bool operator==(const SlotHandle& rhs) const {
+        return (this->Index == rhs.Index) && (this->Generation == rhs.Generation);
+    };
+    /// inequality operator
+    bool operator!=(const SlotHandle& rhs) const {
+        return !(*this == rhs);
+    };
+    /// less-then operator
+    bool operator<(const SlotHandle& rhs) const {
+        return this->Value() < rhs.Value();
+    };
+
+    /// slot index
+    uint32_t Index;
+    /// generation counter of the slot, 0 is never a valid generation
+    uint32_t Generation;
+};
+
+//------------------------------------------------------------------------------
+template<> struct Hash<SlotHandle> {
+    uint32_t operator()(const SlotHandle& h) const {
+        return HashInt(h.Value());
+    };
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE> class SlotMap {
+public:
+    /// default constructor
+    SlotMap();
+
+    /// get number of live elements
+    int Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get number of slots (live and free)
+    int NumSlots() const;
+    /// reserve room for numElements more elements
+    void Reserve(int numElements);
+    /// erase all elements (invalidates all handles)
+    void Clear();
+
+    /// copy-add an element, return handle
+    SlotHandle Add(const TYPE& elm);
+    /// move-add an element, return handle
+    SlotHandle Add(TYPE&& elm);
+    /// erase element by handle, does nothing if the handle is stale
+    void Erase(const SlotHandle& handle);
+    /// return true if handle refers to a live element
+    bool Contains(const SlotHandle& handle) const;
+    /// get pointer to element, or nullptr if the handle is stale
+    TYPE* Lookup(const SlotHandle& handle);
+    /// get read-only pointer to element, or nullptr if the handle is stale
+    const TYPE* Lookup(const SlotHandle& handle) const;
+    /// read/write access to element by handle (handle must be live!)
+    TYPE& operator[](const SlotHandle& handle);
+    /// read-only access to element by handle (handle must be live!)
+    const TYPE& operator[](const SlotHandle& handle) const;
+
+    /// get handle of element at dense index
+    SlotHandle HandleAtIndex(int index) const;
+    /// read/write access to element at dense index
+    TYPE& ValueAtIndex(int index);
+    /// read-only access to element at dense index
+    const TYPE& ValueAtIndex(int index) const;
+
+    /// C++ begin, iterates over the densely packed live elements
+    TYPE* begin();
+    /// C++ begin
+    const TYPE* begin() const;
+    /// C++ end
+    TYPE* end();
+    /// C++ end
+    const TYPE* end() const;
+
+private:
+    /// allocate a slot for a new element at the end of the dense array
+    SlotHandle allocSlot();
+    /// get dense index for handle, or InvalidIndex
+    int denseIndex(const SlotHandle& handle) const;
+
+    static const uint32_t FreeSlot = 0xFFFFFFFF;
+    struct slot {
+        uint32_t dense;         // index into values, or FreeSlot
+        uint32_t generation;    // bumped when the element is erased
+    };
+    Array<TYPE> values;         // densely packed elements
+    Array<uint32_t> valueSlots; // slot index of each element
+    Array<slot> slots;
+    Queue<uint32_t> freeSlots;  // FIFO to spread generation bumps over slots
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+SlotMap<TYPE>::SlotMap() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+SlotMap<TYPE>::Size() const {
+    return this->values.Size();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SlotMap<TYPE>::Empty() const {
+    return this->values.Empty();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+SlotMap<TYPE>::NumSlots() const {
+    return this->slots.Size();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+SlotMap<TYPE>::Reserve(int numElements) {
+    this->values.Reserve(numElements);
+    this->valueSlots.Reserve(numElements);
+    const int numNewSlots = numElements - this->freeSlots.Size();
+    if (numNewSlots > 0) {
+        this->slots.Reserve(numNewSlots);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+SlotMap<TYPE>::Clear() {
+    for (int i = 0; i < this->valueSlots.Size(); i++) {
+        slot& s = this->slots[this->valueSlots[i]];
+        s.dense = FreeSlot;
+        if (0 == ++s.generation) {
+            s.generation = 1;
+        }
+        this->freeSlots.Enqueue(this->valueSlots[i]);
+    }
+    this->values.Clear();
+    this->valueSlots.Clear();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> SlotHandle
+SlotMap<TYPE>::allocSlot() {
+    uint32_t slotIndex;
+    if (this->freeSlots.Empty()) {
+        slotIndex = uint32_t(this->slots.Size());
+        slot newSlot;
+        newSlot.dense = FreeSlot;
+        newSlot.generation = 1;
+        this->slots.Add(newSlot);
+    }
+    else {
+        slotIndex = this->freeSlots.Dequeue();
+    }
+    slot& s = this->slots[slotIndex];
+    o_assert_dbg(FreeSlot == s.dense);
+    s.dense = uint32_t(this->values.Size());
+    this->valueSlots.Add(slotIndex);
+    return SlotHandle(slotIndex, s.generation);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> SlotHandle
+SlotMap<TYPE>::Add(const TYPE& elm) {
+    SlotHandle handle = this->allocSlot();
+    this->values.Add(elm);
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> SlotHandle
+SlotMap<TYPE>::Add(TYPE&& elm) {
+    SlotHandle handle = this->allocSlot();
+    this->values.Add(std::move(elm));
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+SlotMap<TYPE>::denseIndex(const SlotHandle& handle) const {
+    if (handle.Index < uint32_t(this->slots.Size())) {
+        const slot& s = this->slots[handle.Index];
+        if ((s.generation == handle.Generation) && (FreeSlot != s.dense)) {
+            return int(s.dense);
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+SlotMap<TYPE>::Erase(const SlotHandle& handle) {
+    const int index = this->denseIndex(handle);
+    if (InvalidIndex == index) {
+        return;
+    }
+    // the last element is swapped into the hole, fix its slot
+    const int last = this->values.Size() - 1;
+    if (index != last) {
+        this->slots[this->valueSlots[last]].dense = uint32_t(index);
+    }
+    this->values.EraseSwapBack(index);
+    this->valueSlots.EraseSwapBack(index);
+
+    slot& s = this->slots[handle.Index];
+    s.dense = FreeSlot;
+    if (0 == ++s.generation) {
+        s.generation = 1;
+    }
+    this->freeSlots.Enqueue(handle.Index);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SlotMap<TYPE>::Contains(const SlotHandle& handle) const {
+    return InvalidIndex != this->denseIndex(handle);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+SlotMap<TYPE>::Lookup(const SlotHandle& handle) {
+    const int index = this->denseIndex(handle);
+    return (InvalidIndex != index) ? &this->values[index] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE*
+SlotMap<TYPE>::Lookup(const SlotHandle& handle) const {
+    const int index = this->denseIndex(handle);
+    return (InvalidIndex != index) ? &this->values[index] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE&
+SlotMap<TYPE>::operator[](const SlotHandle& handle) {
+    const int index = this->denseIndex(handle);
+    o_assert(InvalidIndex != index);
+    return this->values[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE&
+SlotMap<TYPE>::operator[](const SlotHandle& handle) const {
+    const int index = this->denseIndex(handle);
+    o_assert(InvalidIndex != index);
+    return this->values[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> SlotHandle
+SlotMap<TYPE>::HandleAtIndex(int index) const {
+    const uint32_t slotIndex = this->valueSlots[index];
+    return SlotHandle(slotIndex, this->slots[slotIndex].generation);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE&
+SlotMap<TYPE>::ValueAtIndex(int index) {
+    return this->values[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE&
+SlotMap<TYPE>::ValueAtIndex(int index) const {
+    return this->values[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+SlotMap<TYPE>::begin() {
+    return this->values.begin();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE*
+SlotMap<TYPE>::begin() const {
+    return this->values.begin();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+SlotMap<TYPE>::end() {
+    return this->values.end();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE*
+SlotMap<TYPE>::end() const {
+    return this->values.end();
+}
+
+} // namespace Oryol
@@ -0,0 +1,654 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SmallArray
+    @ingroup Core
+    @brief dynamic array with inline storage for N elements
+
+    A SmallArray has the same interface as Array, but keeps up to N
+    elements inline in the object itself. Only when more than N elements
+    are added, the elements are transparently moved to heap storage.
+    This avoids the heap allocation for the common case where only a
+    handful of elements are stored (e.g. short lists returned from
+    functions or kept in per-item bookkeeping structs).
+
+    Unlike Array, the elements always start at the front of the
+    storage, so PopFront() and EraseSwapFront() involve moving elements.
+
+    A *move* operation only steals the heap buffer, inline elements
+    are moved one by one. A *copy* stays inline if the elements fit.
+
+    Since the inline capacity is part of the type, SmallArrays can only
+    be copied and moved between SmallArrays of the same N.
+
+    @see Array, InlineArray
+*/
+#include "Core/Config.h"
+#include "Core/TypeTraits.h"
+#include "Core/Containers/elementBuffer.h"
+#include "Core/Containers/Slice.h"
+#include <initializer_list>
+
+namespace Oryol {
+
+template<class TYPE, int N> class SmallArray {
+    static_assert(N > 0, "SmallArray: N must be > 0");
+public:
+    /// default constructor
+    SmallArray();
+    /// copy constructor
+    SmallArray(const SmallArray& rhs);
+    /// move constructor
+    SmallArray(SmallArray&& rhs);
+    /// setup from initializer list
+    SmallArray(std::initializer_list<TYPE> l);
+    /// destructor
+    ~SmallArray();
+
+    /// copy-assignment
+    void operator=(const SmallArray& rhs);
+    /// move-assignment
+    void operator=(SmallArray&& rhs);
+
+    /// set allocation strategy (used once the array lives on the heap)
+    void SetAllocStrategy(int minGrow_, int maxGrow_=ORYOL_CONTAINER_DEFAULT_MAX_GROW);
+    /// initialize to a fixed capacity (guarantees that no re-allocs happen)
+    void SetFixedCapacity(int fixedCapacity);
+    /// get min-grow value
+    int GetMinGrow() const;
+    /// get max-grow value
+    int GetMaxGrow() const;
+    /// get number of elements in array
+    int Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get capacity of array
+    int Capacity() const;
+    /// get number of free slots at back of array
+    int Spare() const;
+    /// return true if the elements are stored inline
+    bool IsInline() const;
+
+    /// read/write access single element
+    TYPE& operator[](int index);
+    /// read-only access single element
+    const TYPE& operator[](int index) const;
+    /// read/write access to first element
+    TYPE& Front();
+    /// read-only access to first element
+    const TYPE& Front() const;
+    /// read/write access to last element
+    TYPE& Back();
+    /// read-only access to last element
+    const TYPE& Back() const;
+    /// create a slice
+    Slice<TYPE> MakeSlice(int offset=0, int numItems=EndOfRange);
+
+    /// increase capacity to hold at least numElements more elements
+    void Reserve(int numElements);
+    /// trim capacity to size (moves back into inline storage if possible)
+    void Trim();
+    /// clear the array (deletes elements, keeps capacity)
+    void Clear();
+
+    /// copy-add element to back of array
+    TYPE& Add(const TYPE& elm);
+    /// move-add element to back of array
+    TYPE& Add(TYPE&& elm);
+    /// construct-add new element at back of array
+    template<class... ARGS> TYPE& Add(ARGS&&... args);
+    /// copy-insert element at index, keep array order
+    void Insert(int index, const TYPE& elm);
+    /// move-insert element at index, keep array order
+    void Insert(int index, TYPE&& elm);
+    /// pop the last element
+    TYPE PopBack();
+    /// pop the first element
+    TYPE PopFront();
+    /// erase element at index, keep element order
+    void Erase(int index);
+    /// erase element at index, swap-in front or back element (destroys element ordering)
+    void EraseSwap(int index);
+    /// erase element at index, always swap-in from back (destroys element ordering)
+    void EraseSwapBack(int index);
+    /// erase element at index, always swap-in from front (destroys element ordering)
+    void EraseSwapFront(int index);
+    /// erase a range of elements, keep element order
+    void EraseRange(int index, int num);
+
+    /// find element index with slow linear search, return InvalidIndex if not found
+    int FindIndexLinear(const TYPE& elm, int startIndex=0, int endIndex=InvalidIndex) const;
+
+    /// C++ conform begin
+    TYPE* begin();
+    /// C++ conform begin
+    const TYPE* begin() const;
+    /// C++ conform end
+    TYPE* end();
+    /// C++ conform end
+    const TYPE* end() const;
+
+private:
+    /// get pointer to inline storage
+    TYPE* inlineBuf();
+    /// destroy elements and free heap buffer
+    void destroy();
+    /// copy from other array
+    void copy(const SmallArray& rhs);
+    /// move from other array
+    void move(SmallArray&& rhs);
+    /// move elements to a new buffer (inline storage if newCapacity <= N)
+    void adjustCapacity(int newCapacity);
+    /// grow to make room
+    void grow();
+    /// move num elements to uninitialized memory
+    static void moveElements(TYPE* from, TYPE* to, int num);
+    /// shift elements [index, size) one slot towards the back
+    void moveInsert(int index);
+
+    TYPE* buf;      // points to inline storage or heap buffer
+    int size;
+    int cap;
+    int minGrow;
+    int maxGrow;
+    alignas(TYPE) uint8_t storage[N * sizeof(TYPE)];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE*
+SmallArray<TYPE,N>::inlineBuf() {
+    return reinterpret_cast<TYPE*>(this->storage);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::moveElements(TYPE* from, TYPE* to, int num) {
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        _priv::elementBuffer<TYPE>::relocate(from, to, num);
+    }
+    else {
+        for (int i = 0; i < num; i++) {
+            new(to + i) TYPE(std::move(from[i]));
+            from[i].~TYPE();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N>
+SmallArray<TYPE,N>::SmallArray() :
+buf(inlineBuf()),
+size(0),
+cap(N),
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N>
+SmallArray<TYPE,N>::SmallArray(const SmallArray& rhs) :
+buf(inlineBuf()),
+size(0),
+cap(N) {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N>
+SmallArray<TYPE,N>::SmallArray(SmallArray&& rhs) :
+buf(inlineBuf()),
+size(0),
+cap(N) {
+    this->move(std::move(rhs));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N>
+SmallArray<TYPE,N>::SmallArray(std::initializer_list<TYPE> l) :
+buf(inlineBuf()),
+size(0),
+cap(N),
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+    this->Reserve(int(l.size()));
+    for (const auto& elm : l) {
+        this->Add(elm);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N>
+SmallArray<TYPE,N>::~SmallArray() {
+    this->destroy();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::operator=(const SmallArray& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->copy(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::operator=(SmallArray&& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->move(std::move(rhs));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::destroy() {
+    this->Clear();
+    if (this->buf != inlineBuf()) {
+        Memory::Free(this->buf);
+        this->buf = inlineBuf();
+        this->cap = N;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::copy(const SmallArray& rhs) {
+    o_assert_dbg((this->buf == inlineBuf()) && (0 == this->size));
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    if (rhs.size > N) {
+        this->buf = (TYPE*) Memory::Alloc(rhs.size * sizeof(TYPE));
+        this->cap = rhs.size;
+    }
+    _priv::elementBuffer<TYPE>::copyConstruct(rhs.buf, this->buf, rhs.size);
+    this->size = rhs.size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::move(SmallArray&& rhs) {
+    o_assert_dbg((this->buf == inlineBuf()) && (0 == this->size));
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    if (rhs.buf == rhs.inlineBuf()) {
+        moveElements(rhs.buf, this->buf, rhs.size);
+    }
+    else {
+        // steal the heap buffer
+        this->buf = rhs.buf;
+        this->cap = rhs.cap;
+        rhs.buf = rhs.inlineBuf();
+        rhs.cap = N;
+    }
+    this->size = rhs.size;
+    rhs.size = 0;
+    // NOTE: don't reset minGrow/maxGrow, rhs is empty, but still a valid object!
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::adjustCapacity(int newCapacity) {
+    o_assert_dbg(newCapacity >= this->size);
+    TYPE* newBuf;
+    if (newCapacity <= N) {
+        if (this->buf == inlineBuf()) {
+            // already inline, nothing to do
+            return;
+        }
+        newBuf = inlineBuf();
+        newCapacity = N;
+    }
+    else {
+        newBuf = (TYPE*) Memory::Alloc(newCapacity * sizeof(TYPE));
+    }
+    moveElements(this->buf, newBuf, this->size);
+    if (this->buf != inlineBuf()) {
+        Memory::Free(this->buf);
+    }
+    this->buf = newBuf;
+    this->cap = newCapacity;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::grow() {
+    const int curCapacity = this->cap;
+    int growBy = curCapacity >> 1;
+    if (growBy < minGrow) {
+        growBy = minGrow;
+    }
+    else if (growBy > maxGrow) {
+        growBy = maxGrow;
+    }
+    o_assert_dbg(growBy > 0);
+    this->adjustCapacity(curCapacity + growBy);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+    this->minGrow = minGrow_;
+    this->maxGrow = maxGrow_;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::SetFixedCapacity(int fixedCapacity) {
+    this->minGrow = 0;
+    this->maxGrow = 0;
+    if (fixedCapacity > this->cap) {
+        this->adjustCapacity(fixedCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::GetMinGrow() const {
+    return this->minGrow;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::GetMaxGrow() const {
+    return this->maxGrow;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> bool
+SmallArray<TYPE,N>::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::Capacity() const {
+    return this->cap;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::Spare() const {
+    return this->cap - this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> bool
+SmallArray<TYPE,N>::IsInline() const {
+    return this->buf == reinterpret_cast<const TYPE*>(this->storage);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE&
+SmallArray<TYPE,N>::operator[](int index) {
+    o_assert_range_dbg(index, this->size);
+    return this->buf[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> const TYPE&
+SmallArray<TYPE,N>::operator[](int index) const {
+    o_assert_range_dbg(index, this->size);
+    return this->buf[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE&
+SmallArray<TYPE,N>::Front() {
+    o_assert(this->size > 0);
+    return this->buf[0];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> const TYPE&
+SmallArray<TYPE,N>::Front() const {
+    o_assert(this->size > 0);
+    return this->buf[0];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE&
+SmallArray<TYPE,N>::Back() {
+    o_assert(this->size > 0);
+    return this->buf[this->size - 1];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> const TYPE&
+SmallArray<TYPE,N>::Back() const {
+    o_assert(this->size > 0);
+    return this->buf[this->size - 1];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> Slice<TYPE>
+SmallArray<TYPE,N>::MakeSlice(int offset, int numItems) {
+    if (numItems == EndOfRange) {
+        numItems = this->size - offset;
+    }
+    return Slice<TYPE>(this->buf, this->size, offset, numItems);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Reserve(int numElements) {
+    const int newCapacity = this->size + numElements;
+    if (newCapacity > this->cap) {
+        this->adjustCapacity(newCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Trim() {
+    if (this->size < this->cap) {
+        this->adjustCapacity(this->size);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Clear() {
+    if (!std::is_trivially_destructible<TYPE>::value) {
+        for (int i = 0; i < this->size; i++) {
+            this->buf[i].~TYPE();
+        }
+    }
+    this->size = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE&
+SmallArray<TYPE,N>::Add(const TYPE& elm) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    new(&this->buf[this->size]) TYPE(elm);
+    return this->buf[this->size++];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE&
+SmallArray<TYPE,N>::Add(TYPE&& elm) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    new(&this->buf[this->size]) TYPE(std::move(elm));
+    return this->buf[this->size++];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> template<class... ARGS> TYPE&
+SmallArray<TYPE,N>::Add(ARGS&&... args) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    new(&this->buf[this->size]) TYPE(std::forward<ARGS>(args)...);
+    return this->buf[this->size++];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::moveInsert(int index) {
+    o_assert_dbg((index >= 0) && (index <= this->size) && (this->size < this->cap));
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        _priv::elementBuffer<TYPE>::relocate(&this->buf[index], &this->buf[index + 1], this->size - index);
+    }
+    else {
+        for (int i = this->size; i > index; i--) {
+            new(&this->buf[i]) TYPE(std::move(this->buf[i - 1]));
+            this->buf[i - 1].~TYPE();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Insert(int index, const TYPE& elm) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    this->moveInsert(index);
+    new(&this->buf[index]) TYPE(elm);
+    this->size++;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Insert(int index, TYPE&& elm) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    this->moveInsert(index);
+    new(&this->buf[index]) TYPE(std::move(elm));
+    this->size++;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE
+SmallArray<TYPE,N>::PopBack() {
+    o_assert(this->size > 0);
+    TYPE* ptr = &this->buf[--this->size];
+    TYPE elm(std::move(*ptr));
+    ptr->~TYPE();
+    return elm;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE
+SmallArray<TYPE,N>::PopFront() {
+    o_assert(this->size > 0);
+    TYPE elm(std::move(this->buf[0]));
+    this->Erase(0);
+    return elm;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::Erase(int index) {
+    this->EraseRange(index, 1);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::EraseSwap(int index) {
+    this->EraseSwapBack(index);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::EraseSwapBack(int index) {
+    o_assert_range_dbg(index, this->size);
+    const int last = this->size - 1;
+    if (index != last) {
+        this->buf[index] = std::move(this->buf[last]);
+    }
+    this->buf[last].~TYPE();
+    this->size--;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::EraseSwapFront(int index) {
+    o_assert_range_dbg(index, this->size);
+    if (index != 0) {
+        this->buf[index] = std::move(this->buf[0]);
+    }
+    this->Erase(0);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> void
+SmallArray<TYPE,N>::EraseRange(int index, int num) {
+    o_assert_dbg((index >= 0) && (num >= 0) && ((index + num) <= this->size));
+    for (int i = index; i < (index + num); i++) {
+        this->buf[i].~TYPE();
+    }
+    const int numMove = this->size - (index + num);
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        _priv::elementBuffer<TYPE>::relocate(&this->buf[index + num], &this->buf[index], numMove);
+    }
+    else {
+        for (int i = 0; i < numMove; i++) {
+            TYPE* from = &this->buf[index + num + i];
+            new(&this->buf[index + i]) TYPE(std::move(*from));
+            from->~TYPE();
+        }
+    }
+    this->size -= num;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> int
+SmallArray<TYPE,N>::FindIndexLinear(const TYPE& elm, int startIndex, int endIndex) const {
+    if (this->size > 0) {
+        o_assert_dbg(startIndex < this->size);
+        if (InvalidIndex == endIndex) {
+            endIndex = this->size;
+        }
+        else {
+            o_assert_dbg(endIndex <= this->size);
+        }
+        o_assert_dbg(startIndex <= endIndex);
+        for (int i = startIndex; i < endIndex; i++) {
+            if (elm == this->buf[i]) {
+                return i;
+            }
+        }
+    }
+    // fallthrough: not found
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE*
+SmallArray<TYPE,N>::begin() {
+    return this->buf;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> const TYPE*
+SmallArray<TYPE,N>::begin() const {
+    return this->buf;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> TYPE*
+SmallArray<TYPE,N>::end() {
+    return this->buf + this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int N> const TYPE*
+SmallArray<TYPE,N>::end() const {
+    return this->buf + this->size;
+}
+
+} // namespace Oryol
@@ -0,0 +1,500 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SoaArray
+    @ingroup Core
+    @brief dynamic structure-of-arrays container
+
+    A SoaArray<T0, T1, ...> stores one contiguous column per element
+    type instead of an array of structs, so that loops which only
+    touch a few fields don't drag unrelated data through the cache.
+    All columns live in a single allocation, and each column starts
+    at an ORYOL_CACHE_LINE_SIZE aligned address, which also makes
+    the columns suitable for aligned SIMD loads and stores.
+
+    Rows are added with Add(v0, v1, ...) and removed with Erase() or
+    EraseSwap(). Use Get<COLUMN>(index) to access a single value,
+    and Column<COLUMN>() to get a Slice over a whole column:
+
+    @code
+    SoaArray<glm::vec3, glm::vec3, float> particles;
+    particles.Add(pos, vel, 1.0f);
+    Slice<glm::vec3> pos = particles.Column<0>();
+    Slice<glm::vec3> vel = particles.Column<1>();
+    for (int i = 0; i < particles.Size(); i++) {
+        pos[i] += vel[i];
+    }
+    @endcode
+
+    Like Array, growing reallocates all columns, so pointers and
+    slices into the columns are invalidated by adding rows.
+
+    @see Array, Slice
+*/
+#include "Core/Config.h"
+#include "Core/TypeTraits.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/Slice.h"
+#include <tuple>
+
+namespace Oryol {
+
+template<class... TYPES> class SoaArray {
+public:
+    /// number of columns
+    static const int NumColumns = sizeof...(TYPES);
+    static_assert(NumColumns > 0, "SoaArray: need at least one column");
+    /// element type of a column
+    template<int COLUMN> using ColumnType = typename std::tuple_element<COLUMN, std::tuple<TYPES...>>::type;
+
+    /// default constructor
+    SoaArray();
+    /// copy constructor
+    SoaArray(const SoaArray& rhs);
+    /// move constructor
+    SoaArray(SoaArray&& rhs);
+    /// destructor
+    ~SoaArray();
+
+    /// copy-assignment
+    void operator=(const SoaArray& rhs);
+    /// move-assignment
+    void operator=(SoaArray&& rhs);
+
+    /// set allocation strategy
+    void SetAllocStrategy(int minGrow_, int maxGrow_=ORYOL_CONTAINER_DEFAULT_MAX_GROW);
+    /// initialize to a fixed capacity (guarantees that no re-allocs happen)
+    void SetFixedCapacity(int fixedCapacity);
+    /// get number of rows
+    int Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get capacity in number of rows
+    int Capacity() const;
+
+    /// increase capacity to hold at least numRows more rows
+    void Reserve(int numRows);
+    /// clear the array (deletes elements, keeps capacity)
+    void Clear();
+
+    /// copy-add a new row, return the row index
+    int Add(const TYPES&... values);
+    /// add a row of default-constructed values, return the row index
+    int AddDefault();
+    /// erase a row, keep row order
+    void Erase(int index);
+    /// erase a row, swap in the last row (destroys row order)
+    void EraseSwap(int index);
+
+    /// read/write access to a single value
+    template<int COLUMN> ColumnType<COLUMN>& Get(int index);
+    /// read-only access to a single value
+    template<int COLUMN> const ColumnType<COLUMN>& Get(int index) const;
+    /// get a slice over all values of a column (empty slice if array is empty)
+    template<int COLUMN> Slice<ColumnType<COLUMN>> Column();
+    /// get raw pointer to the start of a column (aligned to ORYOL_CACHE_LINE_SIZE)
+    template<int COLUMN> ColumnType<COLUMN>* Data();
+    /// get raw read-only pointer to the start of a column
+    template<int COLUMN> const ColumnType<COLUMN>* Data() const;
+
+private:
+    /// get the byte size of a column with ORYOL_CACHE_LINE_SIZE padding
+    template<class TYPE> static int columnSize(int capacity);
+    /// compute column pointers (if columns is not null), return buffer size
+    template<int COLUMN> static typename std::enable_if<(COLUMN < NumColumns), int>::type
+    setupColumns(void** columns, uint8_t* base, int offset, int capacity);
+    template<int COLUMN> static typename std::enable_if<(COLUMN == NumColumns), int>::type
+    setupColumns(void** columns, uint8_t* base, int offset, int capacity) { return offset; };
+    /// move rows to other column pointers
+    template<int COLUMN> typename std::enable_if<(COLUMN < NumColumns)>::type
+    moveRows(void** toColumns, int fromIndex, int toIndex, int num);
+    template<int COLUMN> typename std::enable_if<(COLUMN == NumColumns)>::type
+    moveRows(void** toColumns, int fromIndex, int toIndex, int num) { };
+    /// copy-construct rows from other array
+    template<int COLUMN> typename std::enable_if<(COLUMN < NumColumns)>::type
+    copyRows(const SoaArray& rhs);
+    template<int COLUMN> typename std::enable_if<(COLUMN == NumColumns)>::type
+    copyRows(const SoaArray& rhs) { };
+    /// destroy a range of rows
+    template<int COLUMN> typename std::enable_if<(COLUMN < NumColumns)>::type
+    destroyRows(int index, int num);
+    template<int COLUMN> typename std::enable_if<(COLUMN == NumColumns)>::type
+    destroyRows(int index, int num) { };
+    /// construct a row from values
+    template<int COLUMN, class TYPE, class... REST> void constructRow(int index, const TYPE& value, const REST&... rest);
+    template<int COLUMN> void constructRow(int index) { };
+    /// default-construct a row
+    template<int COLUMN> typename std::enable_if<(COLUMN < NumColumns)>::type
+    constructDefaultRow(int index);
+    template<int COLUMN> typename std::enable_if<(COLUMN == NumColumns)>::type
+    constructDefaultRow(int index) { };
+    /// destroy content and free buffer
+    void destroy();
+    /// copy from other array
+    void copy(const SoaArray& rhs);
+    /// move from other array
+    void move(SoaArray&& rhs);
+    /// reallocate with new capacity
+    void adjustCapacity(int newCapacity);
+    /// make room for one more row
+    void grow();
+
+    uint8_t* buffer;
+    void* columns[NumColumns];
+    int size;
+    int cap;
+    int minGrow;
+    int maxGrow;
+};
+
+//------------------------------------------------------------------------------
+template<class... TYPES>
+SoaArray<TYPES...>::SoaArray() :
+buffer(nullptr),
+size(0),
+cap(0),
+minGrow(ORYOL_CONTAINER_DEFAULT_MIN_GROW),
+maxGrow(ORYOL_CONTAINER_DEFAULT_MAX_GROW) {
+    for (int i = 0; i < NumColumns; i++) {
+        this->columns[i] = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES>
+SoaArray<TYPES...>::SoaArray(const SoaArray& rhs) : SoaArray() {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES>
+SoaArray<TYPES...>::SoaArray(SoaArray&& rhs) : SoaArray() {
+    this->move(std::move(rhs));
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES>
+SoaArray<TYPES...>::~SoaArray() {
+    this->destroy();
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::operator=(const SoaArray& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->copy(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::operator=(SoaArray&& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->move(std::move(rhs));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<class TYPE> int
+SoaArray<TYPES...>::columnSize(int capacity) {
+    return Memory::RoundUp(capacity * int(sizeof(TYPE)), ORYOL_CACHE_LINE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename std::enable_if<(COLUMN < SoaArray<TYPES...>::NumColumns), int>::type
+SoaArray<TYPES...>::setupColumns(void** columns, uint8_t* base, int offset, int capacity) {
+    if (columns) {
+        columns[COLUMN] = base + offset;
+    }
+    return setupColumns<COLUMN+1>(columns, base, offset + columnSize<ColumnType<COLUMN>>(capacity), capacity);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename std::enable_if<(COLUMN < SoaArray<TYPES...>::NumColumns)>::type
+SoaArray<TYPES...>::moveRows(void** toColumns, int fromIndex, int toIndex, int num) {
+    typedef ColumnType<COLUMN> TYPE;
+    TYPE* from = (TYPE*)this->columns[COLUMN] + fromIndex;
+    TYPE* to = (TYPE*)toColumns[COLUMN] + toIndex;
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        if ((from != to) && (num > 0)) {
+            Memory::Move(from, to, num * int(sizeof(TYPE)));
+        }
+    }
+    else if (to <= from) {
+        for (int i = 0; i < num; i++) {
+            new(to + i) TYPE(std::move(from[i]));
+            from[i].~TYPE();
+        }
+    }
+    else {
+        for (int i = num - 1; i >= 0; i--) {
+            new(to + i) TYPE(std::move(from[i]));
+            from[i].~TYPE();
+        }
+    }
+    this->moveRows<COLUMN+1>(toColumns, fromIndex, toIndex, num);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename std::enable_if<(COLUMN < SoaArray<TYPES...>::NumColumns)>::type
+SoaArray<TYPES...>::copyRows(const SoaArray& rhs) {
+    typedef ColumnType<COLUMN> TYPE;
+    const TYPE* from = (const TYPE*)rhs.columns[COLUMN];
+    TYPE* to = (TYPE*)this->columns[COLUMN];
+    if (std::is_trivially_copyable<TYPE>::value) {
+        Memory::Copy(from, to, rhs.size * int(sizeof(TYPE)));
+    }
+    else {
+        for (int i = 0; i < rhs.size; i++) {
+            new(to + i) TYPE(from[i]);
+        }
+    }
+    this->copyRows<COLUMN+1>(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename std::enable_if<(COLUMN < SoaArray<TYPES...>::NumColumns)>::type
+SoaArray<TYPES...>::destroyRows(int index, int num) {
+    typedef ColumnType<COLUMN> TYPE;
+    if (!std::is_trivially_destructible<TYPE>::value) {
+        TYPE* ptr = (TYPE*)this->columns[COLUMN] + index;
+        for (int i = 0; i < num; i++) {
+            ptr[i].~TYPE();
+        }
+    }
+    this->destroyRows<COLUMN+1>(index, num);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN, class TYPE, class... REST> void
+SoaArray<TYPES...>::constructRow(int index, const TYPE& value, const REST&... rest) {
+    new((TYPE*)this->columns[COLUMN] + index) TYPE(value);
+    this->constructRow<COLUMN+1>(index, rest...);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename std::enable_if<(COLUMN < SoaArray<TYPES...>::NumColumns)>::type
+SoaArray<TYPES...>::constructDefaultRow(int index) {
+    typedef ColumnType<COLUMN> TYPE;
+    new((TYPE*)this->columns[COLUMN] + index) TYPE();
+    this->constructDefaultRow<COLUMN+1>(index);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::destroy() {
+    this->Clear();
+    if (this->buffer) {
+        Memory::FreeAligned(this->buffer);
+        this->buffer = nullptr;
+    }
+    for (int i = 0; i < NumColumns; i++) {
+        this->columns[i] = nullptr;
+    }
+    this->cap = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::copy(const SoaArray& rhs) {
+    o_assert_dbg((nullptr == this->buffer) && (0 == this->size));
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    if (rhs.size > 0) {
+        this->adjustCapacity(rhs.size);
+        this->copyRows<0>(rhs);
+        this->size = rhs.size;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::move(SoaArray&& rhs) {
+    o_assert_dbg((nullptr == this->buffer) && (0 == this->size));
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    this->buffer = rhs.buffer;
+    this->size = rhs.size;
+    this->cap = rhs.cap;
+    for (int i = 0; i < NumColumns; i++) {
+        this->columns[i] = rhs.columns[i];
+        rhs.columns[i] = nullptr;
+    }
+    rhs.buffer = nullptr;
+    rhs.size = 0;
+    rhs.cap = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::adjustCapacity(int newCapacity) {
+    o_assert_dbg(newCapacity >= this->size);
+    uint8_t* newBuffer = nullptr;
+    void* newColumns[NumColumns] = { };
+    if (newCapacity > 0) {
+        const int numBytes = setupColumns<0>(nullptr, nullptr, 0, newCapacity);
+        newBuffer = (uint8_t*) Memory::AllocAligned(numBytes, ORYOL_CACHE_LINE_SIZE);
+        setupColumns<0>(newColumns, newBuffer, 0, newCapacity);
+    }
+    if (this->size > 0) {
+        this->moveRows<0>(newColumns, 0, 0, this->size);
+    }
+    if (this->buffer) {
+        Memory::FreeAligned(this->buffer);
+    }
+    this->buffer = newBuffer;
+    for (int i = 0; i < NumColumns; i++) {
+        this->columns[i] = newColumns[i];
+    }
+    this->cap = newCapacity;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::grow() {
+    const int curCapacity = this->cap;
+    int growBy = curCapacity >> 1;
+    if (growBy < minGrow) {
+        growBy = minGrow;
+    }
+    else if (growBy > maxGrow) {
+        growBy = maxGrow;
+    }
+    o_assert_dbg(growBy > 0);
+    this->adjustCapacity(curCapacity + growBy);
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::SetAllocStrategy(int minGrow_, int maxGrow_) {
+    this->minGrow = minGrow_;
+    this->maxGrow = maxGrow_;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::SetFixedCapacity(int fixedCapacity) {
+    this->minGrow = 0;
+    this->maxGrow = 0;
+    if (fixedCapacity > this->cap) {
+        this->adjustCapacity(fixedCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> int
+SoaArray<TYPES...>::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> bool
+SoaArray<TYPES...>::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> int
+SoaArray<TYPES...>::Capacity() const {
+    return this->cap;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::Reserve(int numRows) {
+    const int newCapacity = this->size + numRows;
+    if (newCapacity > this->cap) {
+        this->adjustCapacity(newCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::Clear() {
+    if (this->size > 0) {
+        this->destroyRows<0>(0, this->size);
+        this->size = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> int
+SoaArray<TYPES...>::Add(const TYPES&... values) {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    this->constructRow<0>(this->size, values...);
+    return this->size++;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> int
+SoaArray<TYPES...>::AddDefault() {
+    if (this->size == this->cap) {
+        this->grow();
+    }
+    this->constructDefaultRow<0>(this->size);
+    return this->size++;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::Erase(int index) {
+    o_assert_range_dbg(index, this->size);
+    this->destroyRows<0>(index, 1);
+    this->moveRows<0>(this->columns, index + 1, index, this->size - (index + 1));
+    this->size--;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> void
+SoaArray<TYPES...>::EraseSwap(int index) {
+    o_assert_range_dbg(index, this->size);
+    this->destroyRows<0>(index, 1);
+    const int last = this->size - 1;
+    if (index != last) {
+        this->moveRows<0>(this->columns, last, index, 1);
+    }
+    this->size--;
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename SoaArray<TYPES...>::template ColumnType<COLUMN>&
+SoaArray<TYPES...>::Get(int index) {
+    o_assert_range_dbg(index, this->size);
+    return ((ColumnType<COLUMN>*)this->columns[COLUMN])[index];
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> const typename SoaArray<TYPES...>::template ColumnType<COLUMN>&
+SoaArray<TYPES...>::Get(int index) const {
+    o_assert_range_dbg(index, this->size);
+    return ((const ColumnType<COLUMN>*)this->columns[COLUMN])[index];
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> Slice<typename SoaArray<TYPES...>::template ColumnType<COLUMN>>
+SoaArray<TYPES...>::Column() {
+    if (this->size > 0) {
+        return Slice<ColumnType<COLUMN>>((ColumnType<COLUMN>*)this->columns[COLUMN], this->size);
+    }
+    else {
+        return Slice<ColumnType<COLUMN>>();
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> typename SoaArray<TYPES...>::template ColumnType<COLUMN>*
+SoaArray<TYPES...>::Data() {
+    return (ColumnType<COLUMN>*)this->columns[COLUMN];
+}
+
+//------------------------------------------------------------------------------
+template<class... TYPES> template<int COLUMN> const typename SoaArray<TYPES...>::template ColumnType<COLUMN>*
+SoaArray<TYPES...>::Data() const {
+    return (const ColumnType<COLUMN>*)this->columns[COLUMN];
+}
+
+} // namespace Oryol
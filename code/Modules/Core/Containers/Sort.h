@@ -0,0 +1,260 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Sort
+    @ingroup Core
+    @brief sorting utilities for the container classes
+
+    Sort::Radix() and Sort::RadixByKey() implement a stable LSD radix
+    sort (8 bits per pass) for integer and floating point keys, or for
+    items which have such a key (e.g. key/index pairs). Passes where
+    all keys have the same digit are skipped, so small key ranges
+    are sorted in fewer passes. The items must be trivially relocatable,
+    since they are shuffled around with plain memory copies.
+
+    Sort::Parallel() is a multi-threaded merge sort: the range is split
+    into chunks which are sorted on separate threads, and the sorted
+    chunks are then merged pairwise (again in parallel). On platforms
+    without threads this falls back to std::sort(). Parallel() must
+    be called explicitly, since it creates std::threads.
+
+    Sort::Auto() picks the best single-threaded algorithm for the item
+    type and number of items: radix sort for arithmetic types and
+    KeyValuePairs with arithmetic keys above RadixThreshold items, and
+    std::sort() otherwise. This is used by Array::Sort(), Map::EndBulk()
+    and Set::EndBulk().
+*/
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include "Core/TypeTraits.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/KeyValuePair.h"
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+namespace Oryol {
+
+namespace _priv {
+
+/// map an arithmetic key to an unsigned integer with the same sort order
+template<class KEY, class ENABLE=void> struct radixKey;
+template<class KEY> struct radixKey<KEY, typename std::enable_if<std::is_integral<KEY>::value && std::is_unsigned<KEY>::value>::type> {
+    typedef KEY type;
+    static type get(KEY key) {
+        return key;
+    };
+};
+template<class KEY> struct radixKey<KEY, typename std::enable_if<std::is_integral<KEY>::value && std::is_signed<KEY>::value>::type> {
+    typedef typename std::make_unsigned<KEY>::type type;
+    static type get(KEY key) {
+        // flip the sign bit so that negative values come first
+        return type(key) ^ (type(1) << (sizeof(type) * 8 - 1));
+    };
+};
+template<> struct radixKey<float> {
+    typedef uint32_t type;
+    static type get(float key) {
+        uint32_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        // negative: flip all bits, positive: flip the sign bit
+        return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+    };
+};
+template<> struct radixKey<double> {
+    typedef uint64_t type;
+    static type get(double key) {
+        uint64_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+    };
+};
+
+/// describes whether and how items can be radix sorted
+template<class TYPE> struct sortTraits {
+    static const bool radix = std::is_arithmetic<TYPE>::value && !std::is_same<TYPE, bool>::value;
+    struct getKey {
+        const TYPE& operator()(const TYPE& item) const {
+            return item;
+        };
+    };
+};
+template<class KEY, class VALUE> struct sortTraits<KeyValuePair<KEY, VALUE>> {
+    static const bool radix = std::is_arithmetic<KEY>::value && !std::is_same<KEY, bool>::value &&
+        IsTriviallyRelocatable<KeyValuePair<KEY, VALUE>>::value;
+    struct getKey {
+        const KEY& operator()(const KeyValuePair<KEY, VALUE>& kvp) const {
+            return kvp.Key();
+        };
+    };
+};
+
+} // namespace _priv
+
+class Sort {
+public:
+    /// Auto() uses radix sort for radix-sortable types at or above this number of items
+    static const int RadixThreshold = 256;
+
+    /// sort items with the best single-threaded algorithm for the item type and number of items
+    template<class TYPE> static void Auto(TYPE* begin, TYPE* end);
+    /// stable radix sort of arithmetic values
+    template<class TYPE> static void Radix(TYPE* begin, TYPE* end);
+    /// stable radix sort of items by an arithmetic key, scratch must have room for (end - begin) items
+    template<class TYPE, class GETKEY> static void RadixByKey(TYPE* begin, TYPE* end, TYPE* scratch, const GETKEY& getKey);
+    /// multi-threaded merge sort (numThreads=0 means number of hardware threads)
+    template<class TYPE, class LESS=std::less<TYPE>> static void Parallel(TYPE* begin, TYPE* end, const LESS& less=LESS(), int numThreads=0);
+
+private:
+    /// select radix sort or fallback at compile time
+    template<class TYPE> static typename std::enable_if<_priv::sortTraits<TYPE>::radix>::type autoRadix(TYPE* begin, TYPE* end);
+    template<class TYPE> static typename std::enable_if<!_priv::sortTraits<TYPE>::radix>::type autoRadix(TYPE* begin, TYPE* end);
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE, class GETKEY> void
+Sort::RadixByKey(TYPE* begin, TYPE* end, TYPE* scratch, const GETKEY& getKey) {
+    static_assert(IsTriviallyRelocatable<TYPE>::value, "Sort::RadixByKey: items must be trivially relocatable");
+    typedef typename std::decay<decltype(getKey(*begin))>::type keyType;
+    typedef _priv::radixKey<keyType> radixKey;
+    typedef typename radixKey::type uintType;
+    const int numPasses = int(sizeof(uintType));
+    const int num = int(end - begin);
+    if (num < 2) {
+        return;
+    }
+    o_assert_dbg(scratch);
+
+    // build the histograms for all passes at once
+    int counts[sizeof(uintType)][256];
+    Memory::Clear(counts, sizeof(counts));
+    for (int i = 0; i < num; i++) {
+        uintType key = radixKey::get(getKey(begin[i]));
+        for (int pass = 0; pass < numPasses; pass++) {
+            counts[pass][key & 0xFF]++;
+            key >>= 8;
+        }
+    }
+
+    TYPE* from = begin;
+    TYPE* to = scratch;
+    for (int pass = 0; pass < numPasses; pass++) {
+        int* count = counts[pass];
+        // skip the pass if all keys have the same digit
+        const uintType firstKey = radixKey::get(getKey(from[0]));
+        if (count[(firstKey >> (pass * 8)) & 0xFF] == num) {
+            continue;
+        }
+        // turn counts into start offsets
+        int offset = 0;
+        for (int i = 0; i < 256; i++) {
+            const int c = count[i];
+            count[i] = offset;
+            offset += c;
+        }
+        // scatter (a plain memory copy, since items are trivially relocatable)
+        for (int i = 0; i < num; i++) {
+            const int digit = int((radixKey::get(getKey(from[i])) >> (pass * 8)) & 0xFF);
+            std::memcpy((void*)&to[count[digit]++], (const void*)&from[i], sizeof(TYPE));
+        }
+        std::swap(from, to);
+    }
+    if (from != begin) {
+        Memory::Copy(from, begin, num * int(sizeof(TYPE)));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+Sort::Radix(TYPE* begin, TYPE* end) {
+    const int num = int(end - begin);
+    if (num < 2) {
+        return;
+    }
+    TYPE* scratch = (TYPE*) Memory::Alloc(num * int(sizeof(TYPE)));
+    RadixByKey(begin, end, scratch, typename _priv::sortTraits<TYPE>::getKey());
+    Memory::Free(scratch);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class LESS> void
+Sort::Parallel(TYPE* begin, TYPE* end, const LESS& less, int numThreads) {
+    const int num = int(end - begin);
+    #if ORYOL_HAS_THREADS
+    if (0 == numThreads) {
+        numThreads = int(std::thread::hardware_concurrency());
+    }
+    // use a power-of-2 number of chunks (at most 64) with at least 4k items each
+    int numChunks = 1;
+    while (((numChunks * 2) <= numThreads) && ((numChunks * 2) <= 64) && ((num / (numChunks * 2)) >= 4096)) {
+        numChunks *= 2;
+    }
+    if (numChunks > 1) {
+        TYPE* bounds[65];
+        o_assert(numChunks <= 64);
+        for (int i = 0; i < numChunks; i++) {
+            bounds[i] = begin + (int64_t(num) * i) / numChunks;
+        }
+        bounds[numChunks] = end;
+
+        // sort the chunks, the calling thread sorts the last chunk
+        std::thread threads[64];
+        for (int i = 0; i < (numChunks - 1); i++) {
+            threads[i] = std::thread([&bounds, &less, i]() {
+                std::sort(bounds[i], bounds[i + 1], less);
+            });
+        }
+        std::sort(bounds[numChunks - 1], end, less);
+        for (int i = 0; i < (numChunks - 1); i++) {
+            threads[i].join();
+        }
+
+        // merge pairs of neighbouring chunks until one chunk is left
+        for (int width = 1; width < numChunks; width *= 2) {
+            const int numMerges = numChunks / (width * 2);
+            for (int i = 0; i < (numMerges - 1); i++) {
+                const int first = i * width * 2;
+                threads[i] = std::thread([&bounds, &less, first, width]() {
+                    std::inplace_merge(bounds[first], bounds[first + width], bounds[first + width * 2], less);
+                });
+            }
+            const int first = (numMerges - 1) * width * 2;
+            std::inplace_merge(bounds[first], bounds[first + width], bounds[first + width * 2], less);
+            for (int i = 0; i < (numMerges - 1); i++) {
+                threads[i].join();
+            }
+        }
+        return;
+    }
+    #endif
+    std::sort(begin, begin + num, less);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> typename std::enable_if<_priv::sortTraits<TYPE>::radix>::type
+Sort::autoRadix(TYPE* begin, TYPE* end) {
+    Radix(begin, end);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> typename std::enable_if<!_priv::sortTraits<TYPE>::radix>::type
+Sort::autoRadix(TYPE* begin, TYPE* end) {
+    o_error("Sort::autoRadix(): type is not radix-sortable!\n");
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+Sort::Auto(TYPE* begin, TYPE* end) {
+    const int num = int(end - begin);
+    if (_priv::sortTraits<TYPE>::radix && (num >= RadixThreshold)) {
+        autoRadix(begin, end);
+    }
+    else {
+        std::sort(begin, end);
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,207 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SpscQueue
+    @ingroup Core
+    @brief bounded lock-free single-producer/single-consumer FIFO queue
+
+    A fixed-capacity ring buffer which can be used to hand elements
+    from exactly one producer thread to exactly one consumer thread
+    without locking. The capacity is rounded up to the next power of 2.
+
+    The producer and consumer indices live on separate cache lines,
+    and each side caches the other side's index, so that the shared
+    indices are only read when the queue looks full or empty.
+
+    TryEnqueue() and TryDequeue() never block and return false if the
+    queue is full or empty. WaitEnqueue() and WaitDequeue() put the
+    calling thread to sleep until the operation succeeds.
+
+    @see MpmcQueue, Queue
+*/
+#include "Core/Config.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/queueWaiter.h"
+#include <atomic>
+
+namespace Oryol {
+
+template<class TYPE> class SpscQueue {
+public:
+    /// construct with capacity (rounded up to power of 2)
+    explicit SpscQueue(int capacity);
+    /// destructor
+    ~SpscQueue();
+
+    /// get the max number of elements in the queue
+    int Capacity() const;
+    /// get number of elements in the queue (only exact if called from the producer or consumer thread)
+    int Size() const;
+    /// return true if queue is empty (only exact if called from the consumer thread)
+    bool Empty() const;
+
+    /// copy-enqueue an element, return false if queue is full (producer thread only)
+    bool TryEnqueue(const TYPE& elm);
+    /// move-enqueue an element, return false if queue is full (producer thread only)
+    bool TryEnqueue(TYPE&& elm);
+    /// dequeue an element, return false if queue is empty (consumer thread only)
+    bool TryDequeue(TYPE& outElm);
+    /// move-enqueue an element, block until there is room (producer thread only)
+    void WaitEnqueue(TYPE&& elm);
+    /// dequeue an element, block until the queue isn't empty (consumer thread only)
+    void WaitDequeue(TYPE& outElm);
+
+private:
+    SpscQueue(const SpscQueue& rhs) = delete;
+    void operator=(const SpscQueue& rhs) = delete;
+
+    /// enqueue without notifying waiting threads
+    template<class T> bool enqueue(T&& elm);
+    /// dequeue without notifying waiting threads
+    bool dequeue(TYPE& outElm);
+
+    // read-only after construction
+    TYPE* buf;
+    uint32_t mask;
+    uint8_t pad0[ORYOL_CACHE_LINE_SIZE];
+    // written by the producer thread
+    std::atomic<uint32_t> tail;
+    uint32_t cachedHead;
+    uint8_t pad1[ORYOL_CACHE_LINE_SIZE];
+    // written by the consumer thread
+    std::atomic<uint32_t> head;
+    uint32_t cachedTail;
+    uint8_t pad2[ORYOL_CACHE_LINE_SIZE];
+    _priv::queueWaiter waiter;
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+SpscQueue<TYPE>::SpscQueue(int capacity) :
+tail(0),
+cachedHead(0),
+head(0),
+cachedTail(0) {
+    o_assert((capacity > 0) && (capacity <= (1<<30)));
+    uint32_t cap = 1;
+    while (cap < uint32_t(capacity)) {
+        cap <<= 1;
+    }
+    this->mask = cap - 1;
+    this->buf = (TYPE*) Memory::Alloc(cap * sizeof(TYPE));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+SpscQueue<TYPE>::~SpscQueue() {
+    const uint32_t t = this->tail.load(std::memory_order_acquire);
+    for (uint32_t h = this->head.load(std::memory_order_acquire); h != t; h++) {
+        this->buf[h & this->mask].~TYPE();
+    }
+    Memory::Free(this->buf);
+    this->buf = nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+SpscQueue<TYPE>::Capacity() const {
+    return int(this->mask + 1);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int
+SpscQueue<TYPE>::Size() const {
+    const uint32_t h = this->head.load(std::memory_order_acquire);
+    const uint32_t t = this->tail.load(std::memory_order_acquire);
+    return int(t - h);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SpscQueue<TYPE>::Empty() const {
+    return 0 == this->Size();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> template<class T> bool
+SpscQueue<TYPE>::enqueue(T&& elm) {
+    const uint32_t t = this->tail.load(std::memory_order_relaxed);
+    if ((t - this->cachedHead) > this->mask) {
+        // looks full, get the real consumer position
+        this->cachedHead = this->head.load(std::memory_order_acquire);
+        if ((t - this->cachedHead) > this->mask) {
+            return false;
+        }
+    }
+    new(&this->buf[t & this->mask]) TYPE(std::forward<T>(elm));
+    this->tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SpscQueue<TYPE>::dequeue(TYPE& outElm) {
+    const uint32_t h = this->head.load(std::memory_order_relaxed);
+    if (h == this->cachedTail) {
+        // looks empty, get the real producer position
+        this->cachedTail = this->tail.load(std::memory_order_acquire);
+        if (h == this->cachedTail) {
+            return false;
+        }
+    }
+    TYPE* elm = &this->buf[h & this->mask];
+    outElm = std::move(*elm);
+    elm->~TYPE();
+    this->head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SpscQueue<TYPE>::TryEnqueue(const TYPE& elm) {
+    if (this->enqueue(elm)) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SpscQueue<TYPE>::TryEnqueue(TYPE&& elm) {
+    if (this->enqueue(std::move(elm))) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+SpscQueue<TYPE>::TryDequeue(TYPE& outElm) {
+    if (this->dequeue(outElm)) {
+        this->waiter.notify();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+SpscQueue<TYPE>::WaitEnqueue(TYPE&& elm) {
+    this->waiter.wait([this, &elm]() {
+        return this->enqueue(std::move(elm));
+    });
+    this->waiter.notify();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+SpscQueue<TYPE>::WaitDequeue(TYPE& outElm) {
+    this->waiter.wait([this, &outElm]() {
+        return this->dequeue(outElm);
+    });
+    this->waiter.notify();
+}
+
+} // namespace Oryol
@@ -18,16 +18,38 @@
     
     '----' - empty memory slot (guaranteed to be destructed)
     'XXXX' - valid element (guaranteed to be constructed)
+
+    If the frameArena flag is set, the buffer is allocated from the
+    current thread's FrameArena and is never freed.
+
+    The alignment member defines the alignment of the buffer start,
+    alignments bigger than ORYOL_MAX_PLATFORM_ALIGN go through
+    Memory::AllocAligned(). The alignment is carried over into copies.
+    Over-aligned buffers never have spare room at the front, so that
+    the first element is always at the aligned buffer start (erasing
+    at the front moves the remaining elements down).
+
+    All other memory goes through the ALLOCATOR policy object (see
+    HeapAllocator for the interface), which is carried over into
+    copies and moves like the alignment.
+
+    For trivially relocatable element types (see Core/TypeTraits.h),
+    growing, insert-shifting and erasing use realloc/memmove instead of
+    move-constructing and destroying elements one by one, and
+    trivially copyable types are copy-constructed with memcpy.
 */
 #include "Core/Types.h"
+#include "Core/TypeTraits.h"
 #include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Memory/HeapAllocator.h"
 
 //------------------------------------------------------------------------------
 namespace Oryol {
 namespace _priv {
 
-template<class TYPE> class elementBuffer {
+template<class TYPE, class ALLOCATOR=HeapAllocator> class elementBuffer {
 public:
     /// default constructor
     elementBuffer();
@@ -69,6 +91,14 @@ public:
     
     /// allocate, grow or shrink the elementBuffer
     void alloc(int capacity, int frontSpare);
+    /// allocate raw buffer memory (from allocator or frame arena)
+    TYPE* allocBuffer(int numBytes);
+    /// free raw buffer memory (no-op for frame arena memory)
+    void freeBuffer(TYPE* ptr, int numBytes);
+    /// return true if the buffer can be resized with the allocator's ReAlloc
+    bool canReAlloc() const;
+    /// relocate num elements with memmove (only for trivially relocatable types)
+    static void relocate(TYPE* from, TYPE* to, int num);
     /// destroy all
     void destroy();
     /// destroy element at pointer
@@ -91,6 +121,8 @@ public:
     template<class... ARGS> void emplaceBack(ARGS&&... args);
     /// pop back element
     TYPE popBack();
+    /// copy-construct a range of elements at back (backSpare must be >= num!)
+    void pushBackRange(const TYPE* elms, int num);
 
     /// push element at front (frontSpare must be > 0!)
     void pushFront(const TYPE& elm);
@@ -107,6 +139,8 @@ public:
     void insert(int index, const TYPE& elm);
     /// move-insert element at position, keep other elements in their previous order
     void insert(int index, TYPE&& elm);
+    /// copy-insert a range of elements at position, keep order (backSpare must be >= num!)
+    void insertRange(int index, const TYPE* elms, int num);
 
     /// erase element at index, keeps array ordering
     void erase(int index);
@@ -127,6 +161,10 @@ public:
     void moveEraseFront(int index);
     /// erase element by moving elements from back
     void moveEraseBack(int index);
+    /// return true if the buffer is over-aligned (no spare room at front)
+    bool overAligned() const;
+    /// move elements down to the buffer start if over-aligned
+    void alignFront();
 
     /// C++ begin
     TYPE* _begin();
@@ -141,26 +179,34 @@ public:
     int cap;            // buffer capacity (num elements)
     int start;          // index of first valid element in buffer
     int end;            // index of one-past-last valid element in buffer
+    bool frameArena;    // allocate from the thread's FrameArena
+    uint16_t alignment; // buffer alignment in bytes
+    ALLOCATOR allocator;
 };
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-elementBuffer<TYPE>::elementBuffer() :
+template<class TYPE, class ALLOCATOR>
+elementBuffer<TYPE, ALLOCATOR>::elementBuffer() :
 buf(nullptr),
 cap(0),
 start(0),
-end(0)
+end(0),
+frameArena(false),
+alignment(ORYOL_MAX_PLATFORM_ALIGN)
 {
     // empty
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-elementBuffer<TYPE>::elementBuffer(const elementBuffer& rhs) :
+template<class TYPE, class ALLOCATOR>
+elementBuffer<TYPE, ALLOCATOR>::elementBuffer(const elementBuffer& rhs) :
 buf(nullptr),
 cap(0),
 start(0),
-end(0)
+end(0),
+frameArena(false),
+alignment(rhs.alignment),
+allocator(rhs.allocator)
 {
     if (rhs.buf) {
         this->alloc(rhs.size(), 0);
@@ -175,31 +221,38 @@ end(0)
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-elementBuffer<TYPE>::elementBuffer(elementBuffer&& rhs) :
+template<class TYPE, class ALLOCATOR>
+elementBuffer<TYPE, ALLOCATOR>::elementBuffer(elementBuffer&& rhs) :
 buf(rhs.buf),
 cap(rhs.cap),
 start(rhs.start),
-end(rhs.end)
+end(rhs.end),
+frameArena(rhs.frameArena),
+alignment(rhs.alignment),
+allocator(rhs.allocator)
 {
     // reset rhs to default-constructed state
     rhs.buf = nullptr;
     rhs.cap = 0;
     rhs.start = 0;
     rhs.end = 0;
+    rhs.frameArena = false;
+    rhs.alignment = ORYOL_MAX_PLATFORM_ALIGN;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE>
-elementBuffer<TYPE>::~elementBuffer() {
+template<class TYPE, class ALLOCATOR>
+elementBuffer<TYPE, ALLOCATOR>::~elementBuffer() {
     this->destroy();
 }
     
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::operator=(const elementBuffer<TYPE>& rhs) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::operator=(const elementBuffer<TYPE, ALLOCATOR>& rhs) {
     if (&rhs != this) {
         this->destroy();
+        this->alignment = rhs.alignment;
+        this->allocator = rhs.allocator;
         const int newSize = rhs.size();
         if (newSize > 0)
         {
@@ -216,54 +269,59 @@ elementBuffer<TYPE>::operator=(const elementBuffer<TYPE>& rhs) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::operator=(elementBuffer<TYPE>&& rhs) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::operator=(elementBuffer<TYPE, ALLOCATOR>&& rhs) {
     if (&rhs != this) {
         this->destroy();
         this->buf   = rhs.buf;
         this->cap   = rhs.cap;
         this->start = rhs.start;
         this->end   = rhs.end;
+        this->frameArena = rhs.frameArena;
+        this->alignment = rhs.alignment;
+        this->allocator = rhs.allocator;
         rhs.buf   = nullptr;
         rhs.cap   = 0;
         rhs.start = 0;
         rhs.end   = 0;
+        rhs.frameArena = false;
+        rhs.alignment = ORYOL_MAX_PLATFORM_ALIGN;
     }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-elementBuffer<TYPE>::frontSpare() const {
+template<class TYPE, class ALLOCATOR> int
+elementBuffer<TYPE, ALLOCATOR>::frontSpare() const {
     return this->start;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-elementBuffer<TYPE>::backSpare() const {
+template<class TYPE, class ALLOCATOR> int
+elementBuffer<TYPE, ALLOCATOR>::backSpare() const {
     return this->cap - this->end;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-elementBuffer<TYPE>::spare() const {
+template<class TYPE, class ALLOCATOR> int
+elementBuffer<TYPE, ALLOCATOR>::spare() const {
     return this->cap - this->size();
 }
     
 //------------------------------------------------------------------------------
-template<class TYPE> int
-elementBuffer<TYPE>::size() const {
+template<class TYPE, class ALLOCATOR> int
+elementBuffer<TYPE, ALLOCATOR>::size() const {
     return this->end-this->start;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> int
-elementBuffer<TYPE>::capacity() const {
+template<class TYPE, class ALLOCATOR> int
+elementBuffer<TYPE, ALLOCATOR>::capacity() const {
     return this->cap;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-elementBuffer<TYPE>::operator[](int index) {
+template<class TYPE, class ALLOCATOR> TYPE&
+elementBuffer<TYPE, ALLOCATOR>::operator[](int index) {
     o_assert_dbg((index >= 0) && (index < this->size()));
     o_assert_dbg(this->buf);
     o_assert_range_dbg(this->start+index, this->cap);
@@ -271,8 +329,8 @@ elementBuffer<TYPE>::operator[](int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-elementBuffer<TYPE>::operator[](int index) const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+elementBuffer<TYPE, ALLOCATOR>::operator[](int index) const {
     o_assert_dbg((index >= 0) && (index < this->size()));
     o_assert_dbg(this->buf);
     o_assert_range_dbg(this->start+index, this->cap);
@@ -280,50 +338,69 @@ elementBuffer<TYPE>::operator[](int index) const {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-elementBuffer<TYPE>::front() {
+template<class TYPE, class ALLOCATOR> TYPE&
+elementBuffer<TYPE, ALLOCATOR>::front() {
     o_assert((this->start != this->end) && this->buf);
     o_assert_range_dbg(this->start, this->cap);
     return this->buf[this->start];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-elementBuffer<TYPE>::front() const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+elementBuffer<TYPE, ALLOCATOR>::front() const {
     o_assert((this->start != this->end) && this->buf);
     o_assert_range_dbg(this->start, this->cap);
     return this->buf[this->start];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE&
-elementBuffer<TYPE>::back() {
+template<class TYPE, class ALLOCATOR> TYPE&
+elementBuffer<TYPE, ALLOCATOR>::back() {
     o_assert((this->start != this->end) && this->buf);
     o_assert_range_dbg(this->end-1, this->cap);
     return this->buf[this->end - 1];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE&
-elementBuffer<TYPE>::back() const {
+template<class TYPE, class ALLOCATOR> const TYPE&
+elementBuffer<TYPE, ALLOCATOR>::back() const {
     o_assert((this->start != this->end) && this->buf);
     o_assert_range_dbg(this->end-1, this->cap);
     return this->buf[this->end - 1];
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::alloc(int newCapacity, int newStart) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::alloc(int newCapacity, int newStart) {
     o_assert_dbg(newCapacity > 0);
     if (this->cap == newCapacity) {
         return;
     }
     const int curSize = this->size();
     o_assert_dbg((newStart + curSize) <= newCapacity);
+    const int newBufSize = newCapacity * sizeof(TYPE);
+
+    // fast path for trivially relocatable types: realloc and memmove
+    if (IsTriviallyRelocatable<TYPE>::value && this->buf && this->canReAlloc()) {
+        const int curBufSize = this->cap * sizeof(TYPE);
+        if (newCapacity < this->cap) {
+            // shrink: move elements into place before truncating the buffer
+            relocate(&this->buf[this->start], &this->buf[newStart], curSize);
+            this->buf = (TYPE*) this->allocator.ReAlloc(this->buf, curBufSize, newBufSize, this->alignment);
+        }
+        else {
+            // grow: move elements into place after growing the buffer
+            this->buf = (TYPE*) this->allocator.ReAlloc(this->buf, curBufSize, newBufSize, this->alignment);
+            relocate(&this->buf[this->start], &this->buf[newStart], curSize);
+        }
+        this->cap   = newCapacity;
+        this->start = newStart;
+        this->end   = newStart + curSize;
+        return;
+    }
 
     // allocate new buffer
-    const int newBufSize = newCapacity * sizeof(TYPE);
-    TYPE* newBuffer = (TYPE*) Memory::Alloc(newBufSize);
+    TYPE* newBuffer = this->allocBuffer(newBufSize);
     TYPE* newElmStart = newBuffer + newStart;
     
     // need to move any elements?
@@ -333,16 +410,21 @@ elementBuffer<TYPE>::alloc(int newCapacity, int newStart) {
         o_assert_range_dbg(this->start, this->cap);
         TYPE* src = &this->buf[this->start];
         TYPE* dst = newElmStart;
-        for (int i = 0; i < curSize; i++) {
-            new(dst++) TYPE(std::move(*src));
-            // must still call destructor on move-source
-            src++->~TYPE();
+        if (IsTriviallyRelocatable<TYPE>::value) {
+            Memory::Copy(src, dst, curSize * sizeof(TYPE));
+        }
+        else {
+            for (int i = 0; i < curSize; i++) {
+                new(dst++) TYPE(std::move(*src));
+                // must still call destructor on move-source
+                src++->~TYPE();
+            }
         }
     }
     
     // need to free old buffer?
     if (nullptr != this->buf) {
-        Memory::Free(this->buf);
+        this->freeBuffer(this->buf, this->cap * sizeof(TYPE));
     }
     
     // replace pointers
@@ -353,15 +435,49 @@ elementBuffer<TYPE>::alloc(int newCapacity, int newStart) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::destroy() {
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::allocBuffer(int numBytes) {
+    if (this->frameArena) {
+        return (TYPE*) FrameArena::Alloc(numBytes, this->alignment);
+    }
+    else {
+        return (TYPE*) this->allocator.Alloc(numBytes, this->alignment);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::freeBuffer(TYPE* ptr, int numBytes) {
+    if (!this->frameArena) {
+        this->allocator.Free(ptr, numBytes, this->alignment);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> bool
+elementBuffer<TYPE, ALLOCATOR>::canReAlloc() const {
+    // frame arena memory can't be resized
+    return !this->frameArena && this->allocator.CanReAlloc(this->alignment);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::relocate(TYPE* from, TYPE* to, int num) {
+    if ((from != to) && (num > 0)) {
+        Memory::Move(from, to, num * sizeof(TYPE));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::destroy() {
     // destroy elements and free buffer
     if (this->buf) {
         for (int i = this->start; i < this->end; i++) {
             o_assert_range_dbg(i, this->cap);
             this->buf[i].~TYPE();
         }
-        Memory::Free(this->buf);
+        this->freeBuffer(this->buf, this->cap * sizeof(TYPE));
     }
     this->buf = nullptr;
     this->cap = 0;
@@ -370,14 +486,14 @@ elementBuffer<TYPE>::destroy() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::destroyElement(TYPE* elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::destroyElement(TYPE* elm) {
     elm->~TYPE();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::clear() {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::clear() {
     if (this->buf) {
         for (int i = this->start; i < this->end; i++) {
             o_assert_range_dbg(i, this->cap);
@@ -388,23 +504,28 @@ elementBuffer<TYPE>::clear() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> bool
-elementBuffer<TYPE>::overlaps(const TYPE* from, const TYPE* to, int num) {
+template<class TYPE, class ALLOCATOR> bool
+elementBuffer<TYPE, ALLOCATOR>::overlaps(const TYPE* from, const TYPE* to, int num) {
     return (to >= from) && (to < (from + num));
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::copyConstruct(const TYPE* from, TYPE* to, int num) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::copyConstruct(const TYPE* from, TYPE* to, int num) {
     o_assert_dbg(!overlaps(from, to, num));
-    for (int i = 0; i < num; i++) {
-        new(to++) TYPE(*from++);
+    if (std::is_trivially_copyable<TYPE>::value) {
+        Memory::Copy(from, to, num * sizeof(TYPE));
+    }
+    else {
+        for (int i = 0; i < num; i++) {
+            new(to++) TYPE(*from++);
+        }
     }
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::copyAssign(const TYPE* from, TYPE* to, int num) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::copyAssign(const TYPE* from, TYPE* to, int num) {
     o_assert_dbg(!overlaps(from, to, num));
     for (int i = 0; i < num; i++) {
         *to++ = *from++;
@@ -412,8 +533,8 @@ elementBuffer<TYPE>::copyAssign(const TYPE* from, TYPE* to, int num) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::pushBack(const TYPE& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::pushBack(const TYPE& elm) {
     // NOTE: this will fail if there is no spare space at the back,
     // use insert(size(), elm) which will move towards front if possible
     o_assert_dbg(this->buf);
@@ -422,8 +543,8 @@ elementBuffer<TYPE>::pushBack(const TYPE& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::pushBack(TYPE&& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::pushBack(TYPE&& elm) {
     // NOTE: this will fail if there is no spare space at the back,
     // use insert(size(), elm) which will move towards front if possible
     o_assert_dbg(this->buf);
@@ -432,8 +553,8 @@ elementBuffer<TYPE>::pushBack(TYPE&& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> template<class... ARGS> void
-elementBuffer<TYPE>::emplaceBack(ARGS&&... args) {
+template<class TYPE, class ALLOCATOR> template<class... ARGS> void
+elementBuffer<TYPE, ALLOCATOR>::emplaceBack(ARGS&&... args) {
     // NOTE: this will fail if there is no spare space at the back,
     // use insert(size(), elm) which will move towards front if possible
     o_assert_dbg(this->buf);
@@ -442,8 +563,22 @@ elementBuffer<TYPE>::emplaceBack(ARGS&&... args) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::pushFront(const TYPE& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::pushBackRange(const TYPE* elms, int num) {
+    o_assert_dbg((num >= 0) && (num <= this->backSpare()));
+    if (num > 0) {
+        o_assert_dbg(this->buf && elms);
+        // elms may come from the valid elements, but not from the spare slots
+        o_assert_dbg(!overlaps(this->buf, elms, this->cap) ||
+            ((elms >= &this->buf[this->start]) && ((elms + num) <= &this->buf[this->end])));
+        copyConstruct(elms, &this->buf[this->end], num);
+        this->end += num;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::pushFront(const TYPE& elm) {
     // NOTE: this will fail if there is no spare space at the front,
     // use insert(0, elm) which will move towards back if possible
     o_assert_dbg(this->buf && (this->start > 0) && (this->start <= this->cap));
@@ -451,8 +586,8 @@ elementBuffer<TYPE>::pushFront(const TYPE& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::pushFront(TYPE&& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::pushFront(TYPE&& elm) {
     // NOTE: this will fail if there is no spare space at the front,
     // use insert(0, elm) which will move towards back if possible
     o_assert_dbg(this->buf && (this->start > 0) && (this->start <= this->cap));
@@ -460,8 +595,8 @@ elementBuffer<TYPE>::pushFront(TYPE&& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> template<class... ARGS> void
-elementBuffer<TYPE>::emplaceFront(ARGS&&... args) {
+template<class TYPE, class ALLOCATOR> template<class... ARGS> void
+elementBuffer<TYPE, ALLOCATOR>::emplaceFront(ARGS&&... args) {
     // NOTE: this will fail if there is no spare space at the front,
     // use insert(0, elm) which will move towards back if possible
     o_assert_dbg(this->buf && (this->start > 0) && (this->start <= this->cap));
@@ -469,8 +604,8 @@ elementBuffer<TYPE>::emplaceFront(ARGS&&... args) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-elementBuffer<TYPE>::moveInsertFront(int index) {
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::moveInsertFront(int index) {
     // free a slot for insertion by moving the elements
     // at and before it towards the front
     // the freed slot will NOT be deconstructed!
@@ -478,10 +613,17 @@ elementBuffer<TYPE>::moveInsertFront(int index) {
     o_assert_dbg((index >= 0) && (index <= this->size()));
     
     o_assert_dbg((this->start > 0) && (this->start < this->cap));
-    new(&this->buf[this->start-1]) TYPE(std::move(this->buf[start]));
-    for (int i = this->start; i < (this->start + index - 1); i++) {
-        o_assert_dbg((i >= 0) && ((i+1) < this->cap));
-        this->buf[i] = std::move(this->buf[i+1]);
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        // NOTE: the freed slot is a bitwise duplicate, the caller
+        // must treat it as destructed (see prepareInsert())
+        relocate(&this->buf[this->start], &this->buf[this->start-1], index);
+    }
+    else {
+        new(&this->buf[this->start-1]) TYPE(std::move(this->buf[start]));
+        for (int i = this->start; i < (this->start + index - 1); i++) {
+            o_assert_dbg((i >= 0) && ((i+1) < this->cap));
+            this->buf[i] = std::move(this->buf[i+1]);
+        }
     }
     this->start--;
     o_assert_range_dbg(this->start+index, this->cap);
@@ -489,8 +631,8 @@ elementBuffer<TYPE>::moveInsertFront(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-elementBuffer<TYPE>::moveInsertBack(int index) {
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::moveInsertBack(int index) {
     // free a slot for insertion by moving the elements
     // after it towards the back
     // the freed slot will NOT be deconstructed!
@@ -498,10 +640,18 @@ elementBuffer<TYPE>::moveInsertBack(int index) {
     o_assert_dbg((index >= 0) && (index < this->size()));
 
     o_assert_dbg((this->end > 0) && (this->end < this->cap));
-    new(&this->buf[this->end]) TYPE(std::move(this->buf[this->end-1]));
-    for (int i = this->end - 1; i > (this->start + index); i--) {
-        o_assert_dbg(((i-1) >= 0) && (i < this->cap));
-        this->buf[i] = std::move(this->buf[i-1]);
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        // NOTE: the freed slot is a bitwise duplicate, the caller
+        // must treat it as destructed (see prepareInsert())
+        const int i = this->start + index;
+        relocate(&this->buf[i], &this->buf[i+1], this->end - i);
+    }
+    else {
+        new(&this->buf[this->end]) TYPE(std::move(this->buf[this->end-1]));
+        for (int i = this->end - 1; i > (this->start + index); i--) {
+            o_assert_dbg(((i-1) >= 0) && (i < this->cap));
+            this->buf[i] = std::move(this->buf[i-1]);
+        }
     }
     this->end++;
     o_assert_range_dbg(this->start+index, this->cap);
@@ -509,10 +659,16 @@ elementBuffer<TYPE>::moveInsertBack(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::moveEraseFront(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::moveEraseFront(int index) {
     // erase a slot by moving elements from the front
     o_assert_dbg(this->buf && (index >= 0) && (index < this->size()));
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        this->buf[this->start + index].~TYPE();
+        relocate(&this->buf[this->start], &this->buf[this->start + 1], index);
+        this->start++;
+        return;
+    }
     for (int i = this->start + index; i > this->start; i--) {
         o_assert_dbg(((i-1) >= 0) && (i < this->cap));
         this->buf[i] = std::move(this->buf[i - 1]);
@@ -523,10 +679,17 @@ elementBuffer<TYPE>::moveEraseFront(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::moveEraseBack(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::moveEraseBack(int index) {
     // erase a slot by moving elements from the back
     o_assert_dbg(this->buf && (index >= 0) && (index < this->size()));
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        const int i = this->start + index;
+        this->buf[i].~TYPE();
+        relocate(&this->buf[i + 1], &this->buf[i], this->end - (i + 1));
+        this->end--;
+        return;
+    }
     for (int i = this->start + index; i < (this->end - 1); i++) {
         o_assert_dbg((i >= 0) && ((i+1) < this->cap));
         this->buf[i] = std::move(this->buf[i + 1]);
@@ -537,12 +700,48 @@ elementBuffer<TYPE>::moveEraseBack(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-elementBuffer<TYPE>::prepareInsert(int index, bool& outSlotConstructed) {
+template<class TYPE, class ALLOCATOR> bool
+elementBuffer<TYPE, ALLOCATOR>::overAligned() const {
+    return this->alignment > ORYOL_MAX_PLATFORM_ALIGN;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::alignFront() {
+    if (!this->overAligned() || (0 == this->start)) {
+        return;
+    }
+    const int size = this->size();
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        relocate(&this->buf[this->start], this->buf, size);
+    }
+    else {
+        // slots before the old start are unconstructed
+        for (int i = 0; i < size; i++) {
+            if (i < this->start) {
+                new(&this->buf[i]) TYPE(std::move(this->buf[this->start + i]));
+            }
+            else {
+                this->buf[i] = std::move(this->buf[this->start + i]);
+            }
+        }
+        for (int i = (size > this->start) ? size : this->start; i < this->end; i++) {
+            this->buf[i].~TYPE();
+        }
+    }
+    this->start = 0;
+    this->end = size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::prepareInsert(int index, bool& outSlotConstructed) {
 
     // this method will return a pointer to an empty, destructed slot!
 
-    outSlotConstructed = true;
+    // NOTE: the move-insert helpers leave a moved-from (constructed) object
+    // in the freed slot, except for trivially relocatable types
+    outSlotConstructed = !IsTriviallyRelocatable<TYPE>::value;
     const int size = this->size();
     if (index == size) {
         // special case insert at end of array
@@ -615,8 +814,8 @@ elementBuffer<TYPE>::prepareInsert(int index, bool& outSlotConstructed) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::insert(int index, const TYPE& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::insert(int index, const TYPE& elm) {
     bool slotConstructed = true;
     TYPE* ptr = this->prepareInsert(index, slotConstructed);
     if (slotConstructed) {
@@ -628,8 +827,8 @@ elementBuffer<TYPE>::insert(int index, const TYPE& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::insert(int index, TYPE&& elm) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::insert(int index, TYPE&& elm) {
     bool slotConstructed = true;
     TYPE* ptr = this->prepareInsert(index, slotConstructed);
     if (slotConstructed) {
@@ -641,8 +840,47 @@ elementBuffer<TYPE>::insert(int index, TYPE&& elm) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::erase(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::insertRange(int index, const TYPE* elms, int num) {
+    o_assert_dbg((index >= 0) && (index <= this->size()));
+    o_assert_dbg((num >= 0) && (num <= this->backSpare()));
+    if (0 == num) {
+        return;
+    }
+    o_assert_dbg(this->buf && elms);
+    o_assert_dbg(!overlaps(this->buf, elms, this->cap));
+    const int first = this->start + index;
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        // move the tail out of the way with one memmove, and copy into the gap
+        relocate(&this->buf[first], &this->buf[first + num], this->end - first);
+        copyConstruct(elms, &this->buf[first], num);
+    }
+    else {
+        // move the tail back, the part beyond the current end must be move-constructed
+        for (int i = this->end - 1; i >= first; i--) {
+            if ((i + num) >= this->end) {
+                new(&this->buf[i + num]) TYPE(std::move(this->buf[i]));
+            }
+            else {
+                this->buf[i + num] = std::move(this->buf[i]);
+            }
+        }
+        // copy into the gap, slots beyond the old end are unconstructed
+        for (int i = 0; i < num; i++) {
+            if ((first + i) < this->end) {
+                this->buf[first + i] = elms[i];
+            }
+            else {
+                new(&this->buf[first + i]) TYPE(elms[i]);
+            }
+        }
+    }
+    this->end += num;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::erase(int index) {
     const int size = this->size();
     o_assert_dbg(this->buf && (index >= 0) && (index < size));
     
@@ -651,14 +889,14 @@ elementBuffer<TYPE>::erase(int index) {
         o_assert_dbg((this->end > 0) && (this->end <= this->cap));
         this->buf[--this->end].~TYPE();
     }
-    else if (0 == index) {
+    else if ((0 == index) && !this->overAligned()) {
         // special case: first element
         o_assert_range_dbg(this->start, this->cap);
         this->buf[this->start++].~TYPE();
     }
     else {
         // move the smaller amount of elements to fill the gap
-        if (index < (size>>1)) {
+        if ((index < (size>>1)) && !this->overAligned()) {
             // move front elements
             this->moveEraseFront(index);
         }
@@ -670,12 +908,16 @@ elementBuffer<TYPE>::erase(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::eraseSwap(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::eraseSwap(int index) {
     const int size = this->size();
     o_assert_dbg(this->buf && (index >= 0) && (index < size));
     
-    if (0 == index) {
+    if (this->overAligned()) {
+        // over-aligned buffers have no room at the front
+        this->eraseSwapBack(index);
+    }
+    else if (0 == index) {
         // special case: first element
         o_assert_range_dbg(this->start, this->cap);
         this->buf[this->start++].~TYPE();
@@ -705,8 +947,8 @@ elementBuffer<TYPE>::eraseSwap(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::eraseSwapBack(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::eraseSwapBack(int index) {
     const int size = this->size();
     o_assert_dbg(this->buf && (index >= 0) && (index < size));
     if (index == (size - 1)) {
@@ -724,8 +966,8 @@ elementBuffer<TYPE>::eraseSwapBack(int index) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::eraseSwapFront(int index) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::eraseSwapFront(int index) {
     o_assert_dbg(this->buf && (index >= 0) && (index < this->size()));
     if (0 == index) {
         // special case: first element
@@ -739,15 +981,25 @@ elementBuffer<TYPE>::eraseSwapFront(int index) {
         this->buf[this->start + index] = std::move(this->buf[this->start]);
         this->buf[this->start++].~TYPE();
     }
+    this->alignFront();
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> void
-elementBuffer<TYPE>::eraseRange(int index, int num) {
+template<class TYPE, class ALLOCATOR> void
+elementBuffer<TYPE, ALLOCATOR>::eraseRange(int index, int num) {
     o_assert_dbg(this->buf && (index>=0) && ((index+num) <= this->size()) && (num >= 0));
     if (0 == num) {
         return;
     }
+    if (IsTriviallyRelocatable<TYPE>::value) {
+        const int first = this->start + index;
+        for (int i = first; i < (first + num); i++) {
+            this->buf[i].~TYPE();
+        }
+        relocate(&this->buf[first + num], &this->buf[first], this->end - (first + num));
+        this->end -= num;
+        return;
+    }
     int i = this->start + index;
     for (; i < (this->end - num); i++) {
         o_assert_range_dbg(i, this->cap);
@@ -763,8 +1015,8 @@ elementBuffer<TYPE>::eraseRange(int index, int num) {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE
-elementBuffer<TYPE>::popBack() {
+template<class TYPE, class ALLOCATOR> TYPE
+elementBuffer<TYPE, ALLOCATOR>::popBack() {
     o_assert_dbg(this->buf && (this->end > this->start));
     o_assert_dbg((this->end > 0) && (this->end <= this->cap));
     TYPE val(std::move(this->buf[--this->end]));
@@ -773,18 +1025,19 @@ elementBuffer<TYPE>::popBack() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE
-elementBuffer<TYPE>::popFront() {
+template<class TYPE, class ALLOCATOR> TYPE
+elementBuffer<TYPE, ALLOCATOR>::popFront() {
     o_assert_dbg(this->buf && (this->start < this->end));
     o_assert_range_dbg(this->start, this->cap);
     TYPE val(std::move(this->buf[this->start]));
     this->buf[this->start++].~TYPE();
+    this->alignFront();
     return val;
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-elementBuffer<TYPE>::_begin() {
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::_begin() {
     if (this->buf) {
         // NOTE: the returned pointer may point to invalid memory!
         return &this->buf[this->start];
@@ -795,8 +1048,8 @@ elementBuffer<TYPE>::_begin() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE*
-elementBuffer<TYPE>::_begin() const {
+template<class TYPE, class ALLOCATOR> const TYPE*
+elementBuffer<TYPE, ALLOCATOR>::_begin() const {
     if (this->buf) {
         // NOTE: the returned pointer may point to invalid memory!
         return &this->buf[this->start];
@@ -807,8 +1060,8 @@ elementBuffer<TYPE>::_begin() const {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> TYPE*
-elementBuffer<TYPE>::_end() {
+template<class TYPE, class ALLOCATOR> TYPE*
+elementBuffer<TYPE, ALLOCATOR>::_end() {
     if (this->buf) {
         // NOTE: the returned pointer may point to invalid memory!
         return &this->buf[this->end];
@@ -819,8 +1072,8 @@ elementBuffer<TYPE>::_end() {
 }
 
 //------------------------------------------------------------------------------
-template<class TYPE> const TYPE*
-elementBuffer<TYPE>::_end() const {
+template<class TYPE, class ALLOCATOR> const TYPE*
+elementBuffer<TYPE, ALLOCATOR>::_end() const {
     if (this->buf) {
         // NOTE: the returned pointer may point to invalid memory!
         return &this->buf[this->end];
@@ -0,0 +1,320 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::hashTable
+    @ingroup _priv
+    @brief open-addressing hash index used by HashMap and HashSet
+
+    Maps 32-bit hash values to element indices, the elements themselves
+    live in a separate, densely packed element buffer owned by the
+    container. Uses linear probing with robin-hood insertion and
+    backward-shift deletion, the hash table size is a power of 2 and
+    Fibonacci hashing is used to find the home slot of a hash value,
+    so that badly distributed hash values are spread over the whole table.
+    The full hash value is stored in each slot, so keys only need to
+    be compared if hashes match, and growing doesn't need to re-hash
+    the keys.
+
+    The max load factor is 7/8, use capacity() to get the max number
+    of elements before the table must grow.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+namespace _priv {
+
+class hashTable {
+public:
+    /// default constructor
+    hashTable();
+    /// copy constructor
+    hashTable(const hashTable& rhs);
+    /// move constructor
+    hashTable(hashTable&& rhs);
+    /// destructor
+    ~hashTable();
+
+    /// copy-assignment operator
+    void operator=(const hashTable& rhs);
+    /// move-assignment operator
+    void operator=(hashTable&& rhs);
+
+    /// max number of elements before the table must grow
+    int capacity() const;
+    /// make room for at least numElements elements
+    void reserve(int numElements);
+    /// double the number of slots
+    void grow();
+    /// remove all entries, keep capacity
+    void clear();
+    /// free all memory
+    void destroy();
+
+    /// find an element index, equals(index) is called to compare keys of matching hashes
+    template<class EQUALS> int find(uint32_t hash, const EQUALS& equals) const;
+    /// insert an element index
+    void insert(uint32_t hash, int index);
+    /// remove an element index
+    void erase(uint32_t hash, int index);
+    /// update the slot of an element which was moved to another index
+    void reindex(uint32_t hash, int oldIndex, int newIndex);
+
+    /// a hash table slot, maps a hash value to an element index
+    struct slot {
+        uint32_t hash;
+        uint32_t index;
+    };
+    /// index of unused slots
+    static const uint32_t emptySlot = 0xFFFFFFFF;
+    /// minimum number of slots
+    static const int minNumSlots = 8;
+
+    /// max number of elements for a number of slots
+    static int maxElements(int numSlots);
+    /// rebuild the table with a new number of slots
+    void rehash(int newNumSlots);
+    /// get the preferred slot for a hash value
+    uint32_t homeSlot(uint32_t hash) const;
+    /// get distance of a slot from its preferred slot
+    uint32_t probeDistance(uint32_t slotIndex) const;
+    /// find the slot which points to an element index
+    uint32_t findSlot(uint32_t hash, int index) const;
+
+    slot* slots;
+    int numSlots;
+    int shift;
+};
+
+//------------------------------------------------------------------------------
+inline
+hashTable::hashTable() :
+slots(nullptr),
+numSlots(0),
+shift(32) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline
+hashTable::hashTable(const hashTable& rhs) :
+slots(nullptr),
+numSlots(0),
+shift(32) {
+    *this = rhs;
+}
+
+//------------------------------------------------------------------------------
+inline
+hashTable::hashTable(hashTable&& rhs) :
+slots(nullptr),
+numSlots(0),
+shift(32) {
+    *this = std::move(rhs);
+}
+
+//------------------------------------------------------------------------------
+inline
+hashTable::~hashTable() {
+    this->destroy();
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::operator=(const hashTable& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        if (rhs.slots) {
+            const int numBytes = rhs.numSlots * sizeof(slot);
+            this->slots = (slot*) Memory::Alloc(numBytes);
+            Memory::Copy(rhs.slots, this->slots, numBytes);
+            this->numSlots = rhs.numSlots;
+            this->shift = rhs.shift;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::operator=(hashTable&& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->slots = rhs.slots;
+        this->numSlots = rhs.numSlots;
+        this->shift = rhs.shift;
+        rhs.slots = nullptr;
+        rhs.numSlots = 0;
+        rhs.shift = 32;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int
+hashTable::maxElements(int numSlots) {
+    return numSlots - (numSlots >> 3);
+}
+
+//------------------------------------------------------------------------------
+inline int
+hashTable::capacity() const {
+    return maxElements(this->numSlots);
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::reserve(int numElements) {
+    if (numElements > this->capacity()) {
+        int newNumSlots = this->numSlots > 0 ? this->numSlots : minNumSlots;
+        while (maxElements(newNumSlots) < numElements) {
+            newNumSlots <<= 1;
+        }
+        this->rehash(newNumSlots);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::grow() {
+    this->rehash(this->numSlots > 0 ? this->numSlots << 1 : minNumSlots);
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::clear() {
+    if (this->slots) {
+        Memory::Fill(this->slots, this->numSlots * sizeof(slot), 0xFF);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::destroy() {
+    if (this->slots) {
+        Memory::Free(this->slots);
+        this->slots = nullptr;
+    }
+    this->numSlots = 0;
+    this->shift = 32;
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::rehash(int newNumSlots) {
+    o_assert_dbg((newNumSlots >= minNumSlots) && (0 == (newNumSlots & (newNumSlots - 1))));
+
+    slot* oldSlots = this->slots;
+    const int oldNumSlots = this->numSlots;
+    this->slots = (slot*) Memory::Alloc(newNumSlots * sizeof(slot));
+    Memory::Fill(this->slots, newNumSlots * sizeof(slot), 0xFF);
+    this->numSlots = newNumSlots;
+    this->shift = 32;
+    for (int i = newNumSlots; i > 1; i >>= 1) {
+        this->shift--;
+    }
+    // the old slots have the hash values, no need to re-hash the keys
+    if (oldSlots) {
+        for (int i = 0; i < oldNumSlots; i++) {
+            if (emptySlot != oldSlots[i].index) {
+                this->insert(oldSlots[i].hash, oldSlots[i].index);
+            }
+        }
+        Memory::Free(oldSlots);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline uint32_t
+hashTable::homeSlot(uint32_t hash) const {
+    return uint32_t(uint64_t(hash * 2654435769U) >> this->shift);
+}
+
+//------------------------------------------------------------------------------
+inline uint32_t
+hashTable::probeDistance(uint32_t slotIndex) const {
+    return (slotIndex - this->homeSlot(this->slots[slotIndex].hash)) & (this->numSlots - 1);
+}
+
+//------------------------------------------------------------------------------
+template<class EQUALS> int
+hashTable::find(uint32_t hash, const EQUALS& equals) const {
+    if (nullptr == this->slots) {
+        return InvalidIndex;
+    }
+    const uint32_t mask = this->numSlots - 1;
+    uint32_t slotIndex = this->homeSlot(hash);
+    for (uint32_t dist = 0; ; dist++) {
+        const slot& s = this->slots[slotIndex];
+        // robin-hood invariant: the searched element can't be further away
+        // from its home slot than the element in the current slot
+        if ((emptySlot == s.index) || (dist > this->probeDistance(slotIndex))) {
+            return InvalidIndex;
+        }
+        if ((hash == s.hash) && equals(int(s.index))) {
+            return int(s.index);
+        }
+        slotIndex = (slotIndex + 1) & mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline uint32_t
+hashTable::findSlot(uint32_t hash, int index) const {
+    o_assert_dbg(this->slots);
+    const uint32_t mask = this->numSlots - 1;
+    uint32_t slotIndex = this->homeSlot(hash);
+    while (uint32_t(index) != this->slots[slotIndex].index) {
+        o_assert_dbg(emptySlot != this->slots[slotIndex].index);
+        slotIndex = (slotIndex + 1) & mask;
+    }
+    return slotIndex;
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::insert(uint32_t hash, int index) {
+    o_assert_dbg(this->slots);
+    const uint32_t mask = this->numSlots - 1;
+    slot cur = { hash, uint32_t(index) };
+    uint32_t slotIndex = this->homeSlot(hash);
+    for (uint32_t dist = 0; ; dist++) {
+        slot& s = this->slots[slotIndex];
+        if (emptySlot == s.index) {
+            s = cur;
+            return;
+        }
+        // robin-hood: take the slot from elements which are closer
+        // to their home slot, and continue with the displaced element
+        const uint32_t slotDist = this->probeDistance(slotIndex);
+        if (slotDist < dist) {
+            std::swap(s, cur);
+            dist = slotDist;
+        }
+        slotIndex = (slotIndex + 1) & mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::erase(uint32_t hash, int index) {
+    // backward-shift deletion: move following elements one slot back
+    // until an empty slot, or an element in its home slot is found
+    const uint32_t mask = this->numSlots - 1;
+    uint32_t slotIndex = this->findSlot(hash, index);
+    uint32_t next = (slotIndex + 1) & mask;
+    while ((emptySlot != this->slots[next].index) && (0 != this->probeDistance(next))) {
+        this->slots[slotIndex] = this->slots[next];
+        slotIndex = next;
+        next = (next + 1) & mask;
+    }
+    this->slots[slotIndex].index = emptySlot;
+}
+
+//------------------------------------------------------------------------------
+inline void
+hashTable::reindex(uint32_t hash, int oldIndex, int newIndex) {
+    this->slots[this->findSlot(hash, oldIndex)].index = uint32_t(newIndex);
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,75 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::queueWaiter
+    @ingroup _priv
+    @brief blocking wait helper for the lock-free queues
+
+    Lets threads sleep on a condition variable until a lock-free queue
+    operation succeeds. The non-blocking side only pays for a memory
+    fence and an atomic load as long as no thread is waiting.
+
+    On platforms without threads, waiting for an operation which can't
+    succeed is a fatal error.
+*/
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include <atomic>
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class queueWaiter {
+public:
+    /// wake up waiting threads, call after each successful queue operation
+    void notify();
+    /// block until tryOp() returns true (tryOp must not call notify())
+    template<class OP> void wait(const OP& tryOp);
+
+private:
+    #if ORYOL_HAS_THREADS
+    std::atomic<int> numWaiters{0};
+    std::mutex mutex;
+    std::condition_variable condVar;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+inline void
+queueWaiter::notify() {
+    #if ORYOL_HAS_THREADS
+    // the fence makes sure that either the waiting thread sees the
+    // queue modification, or we see the waiting thread
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->numWaiters.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->condVar.notify_all();
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class OP> void
+queueWaiter::wait(const OP& tryOp) {
+    if (tryOp()) {
+        return;
+    }
+    #if ORYOL_HAS_THREADS
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->numWaiters.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!tryOp()) {
+        this->condVar.wait(lock);
+    }
+    this->numWaiters.fetch_sub(1, std::memory_order_relaxed);
+    #else
+    o_error("queueWaiter::wait(): would block forever without threads!\n");
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
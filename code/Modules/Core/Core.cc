@@ -4,6 +4,9 @@
 #include "Pre.h"
 #include "Core.h"
 #include "Core/RunLoop.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Containers/BufferChain.h"
 #include "Core/Threading/ThreadLocalPtr.h"
 #include "Core/Trace.h"
 #include <thread>
@@ -20,6 +23,15 @@ namespace {
         #endif
     };
     _state* state = nullptr;
+
+    //--------------------------------------------------------------------------
+    void setupFrameArena() {
+        // the thread's frame arena is reset at the end of each frame
+        FrameArena::Setup();
+        threadPostRunLoop->Add([]() {
+            FrameArena::Reset();
+        });
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -28,10 +40,12 @@ Core::Setup() {
     o_assert_dbg(!IsValid());
     o_assert_dbg(nullptr == threadPreRunLoop);
     o_assert_dbg(nullptr == threadPostRunLoop);
+    o_memory_tag(MemoryTag::Core);
     state = Memory::New<_state>();
     state->mainThreadId = std::this_thread::get_id();
     threadPreRunLoop = Memory::New<RunLoop>();
     threadPostRunLoop = Memory::New<RunLoop>();
+    setupFrameArena();
 }
 
 //------------------------------------------------------------------------------
@@ -40,12 +54,16 @@ Core::Discard() {
     o_assert(IsValid());
     o_assert(threadPreRunLoop);
     o_assert(threadPostRunLoop);
+    o_memory_tag(MemoryTag::Core);
+    FrameArena::Discard();
     Memory::Delete<RunLoop>(threadPreRunLoop);
     Memory::Delete<RunLoop>(threadPostRunLoop);
     Memory::Delete(state);
     threadPreRunLoop = nullptr;
     threadPostRunLoop = nullptr;
     state = nullptr;
+    BufferChain::ReleasePool();
+    PoolAllocator::FlushThreadCache();
 
     // do NOT destroy the thread-local string atom table to
     // ensure that string atom data pointers still point to valid data!!!    
@@ -88,8 +106,10 @@ Core::EnterThread() {
     #if ORYOL_HAS_THREADS
     o_assert(nullptr == threadPreRunLoop);
     o_assert(nullptr == threadPostRunLoop);
+    o_memory_tag(MemoryTag::Core);
     threadPreRunLoop = Memory::New<RunLoop>();
     threadPostRunLoop = Memory::New<RunLoop>();
+    setupFrameArena();
     #endif
 }
 
@@ -99,10 +119,13 @@ Core::LeaveThread() {
     #if ORYOL_HAS_THREADS
     o_assert(threadPreRunLoop);
     o_assert(threadPostRunLoop);
+    o_memory_tag(MemoryTag::Core);
+    FrameArena::Discard();
     Memory::Delete<RunLoop>(threadPreRunLoop);
     Memory::Delete<RunLoop>(threadPostRunLoop);
     threadPreRunLoop = nullptr;
     threadPostRunLoop = nullptr;
+    PoolAllocator::FlushThreadCache();
 
     // do NOT destroy the thread-local string atom table to
     // ensure that string atom data pointers still point to valid data
@@ -0,0 +1,211 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @file Core/Hash.h
+    @brief default hash functions for the hashed Oryol containers
+
+    Hash<TYPE> is a function object which computes a 32-bit hash value
+    for a key, it is the default hasher of HashMap. Integer, enum
+    and pointer types are supported out of the box, other key types
+    (String, StringAtom, Id, ...) specialize the template in their
+    own header:
+
+    @code
+    namespace Oryol {
+    template<> struct Hash<MyType> {
+        uint32_t operator()(const MyType& val) const {
+            return HashBytes(&val.data, sizeof(val.data));
+        };
+    };
+    }
+    @endcode
+
+    Keys which compare equal must have the same hash value.
+
+    HashBytes64() is a fast 64-bit hash for byte ranges (like strings)
+    in the style of wyhash: it consumes 16 bytes per step and mixes
+    with 64x64->128 bit multiplications. HashBytes() returns the lower
+    32 bits of HashBytes64(). HashLiteral64() is the compile-time version
+    of HashBytes64() for string literals. The hash assumes a little-endian
+    platform.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include <cstring>
+#include <type_traits>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+/// mix the bits of a 64-bit integer into a 32-bit hash value (murmur3 finalizer)
+inline uint32_t
+HashInt(uint64_t val) {
+    val ^= val >> 33;
+    val *= 0xff51afd7ed558ccdULL;
+    val ^= val >> 33;
+    val *= 0xc4ceb9fe1a85ec53ULL;
+    val ^= val >> 33;
+    return uint32_t(val);
+}
+
+namespace _priv {
+
+// NOTE: the helper functions are single-expression C++11 constexpr
+// functions, so that HashLiteral64() can run at compile time
+
+/// hash secrets (from wyhash)
+constexpr uint64_t hashSecret0 = 0x2d358dccaa6c78a5ULL;
+constexpr uint64_t hashSecret1 = 0x8bb84b93962eacc9ULL;
+
+/// lower 64 bits of a 64x64 bit multiplication
+constexpr uint64_t hashMulLo(uint64_t a, uint64_t b) {
+    return a * b;
+}
+/// upper 64 bits of a 64x64 bit multiplication (with the 32x32 bit cross products)
+constexpr uint64_t hashMulHiCross(uint64_t a, uint64_t b, uint64_t cross) {
+    return (a >> 32) * (b >> 32) + (((a & 0xFFFFFFFF) * (b >> 32)) >> 32) + (cross >> 32);
+}
+constexpr uint64_t hashMulHi(uint64_t a, uint64_t b) {
+    return hashMulHiCross(a, b, (((a & 0xFFFFFFFF) * (b & 0xFFFFFFFF)) >> 32) + (((a & 0xFFFFFFFF) * (b >> 32)) & 0xFFFFFFFF) + (a >> 32) * (b & 0xFFFFFFFF));
+}
+/// mix two 64-bit values by xor-ing the halves of their 128-bit product
+inline uint64_t hashMix(uint64_t a, uint64_t b) {
+    #if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = (unsigned __int128)a * b;
+    return uint64_t(r) ^ uint64_t(r >> 64);
+    #else
+    return hashMulLo(a, b) ^ hashMulHi(a, b);
+    #endif
+}
+constexpr uint64_t constHashMix(uint64_t a, uint64_t b) {
+    return hashMulLo(a, b) ^ hashMulHi(a, b);
+}
+/// finish the hash from the last two 64-bit values
+inline uint64_t hashFinish(uint64_t a, uint64_t b, uint64_t len) {
+    #if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = (unsigned __int128)a * b;
+    return hashMix(uint64_t(r) ^ hashSecret0 ^ len, uint64_t(r >> 64) ^ hashSecret1);
+    #else
+    return hashMix(hashMulLo(a, b) ^ hashSecret0 ^ len, hashMulHi(a, b) ^ hashSecret1);
+    #endif
+}
+constexpr uint64_t constHashFinish(uint64_t a, uint64_t b, uint64_t len) {
+    return constHashMix(hashMulLo(a, b) ^ hashSecret0 ^ len, hashMulHi(a, b) ^ hashSecret1);
+}
+/// unaligned little-endian reads
+inline uint64_t hashRead64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+inline uint64_t hashRead32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+constexpr uint64_t constHashRead8(const char* p, uint64_t i) {
+    return uint64_t(uint8_t(p[i]));
+}
+constexpr uint64_t constHashRead32(const char* p) {
+    return constHashRead8(p, 0) | (constHashRead8(p, 1) << 8) | (constHashRead8(p, 2) << 16) | (constHashRead8(p, 3) << 24);
+}
+constexpr uint64_t constHashRead64(const char* p) {
+    return constHashRead32(p) | (constHashRead32(p + 4) << 32);
+}
+/// compile-time HashBytes64(), see there for the runtime version
+constexpr uint64_t constHashSmallA(const char* p, uint64_t len) {
+    return (len >= 4) ? ((constHashRead32(p) << 32) | constHashRead32(p + ((len >> 3) << 2))) :
+           (len > 0) ? ((constHashRead8(p, 0) << 16) | (constHashRead8(p, len >> 1) << 8) | constHashRead8(p, len - 1)) : 0;
+}
+constexpr uint64_t constHashSmallB(const char* p, uint64_t len) {
+    return (len >= 4) ? ((constHashRead32(p + len - 4) << 32) | constHashRead32(p + len - 4 - ((len >> 3) << 2))) : 0;
+}
+constexpr uint64_t constHashLoop(const char* p, uint64_t i, uint64_t seed, uint64_t len) {
+    return (i > 16) ?
+        constHashLoop(p + 16, i - 16, constHashMix(constHashRead64(p) ^ hashSecret1, constHashRead64(p + 8) ^ seed), len) :
+        constHashFinish(constHashRead64(p + i - 16) ^ hashSecret1, constHashRead64(p + i - 8) ^ seed, len);
+}
+constexpr uint64_t constHashBytes(const char* p, uint64_t len, uint64_t seed) {
+    return (len <= 16) ?
+        constHashFinish(constHashSmallA(p, len) ^ hashSecret1, constHashSmallB(p, len) ^ seed, len) :
+        constHashLoop(p, len, seed, len);
+}
+
+} // namespace _priv
+
+//------------------------------------------------------------------------------
+/// compute a 64-bit hash value for a range of bytes (wyhash-style, 16 bytes per step)
+inline uint64_t
+HashBytes64(const void* ptr, int64_t numBytes, uint64_t seed = 0) {
+    o_assert_dbg(numBytes >= 0);
+    const uint8_t* p = (const uint8_t*) ptr;
+    const uint64_t len = uint64_t(numBytes);
+    seed ^= _priv::hashMix(seed ^ _priv::hashSecret0, _priv::hashSecret1);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            // two overlapping 4-byte reads from each end
+            const uint64_t offset = (len >> 3) << 2;
+            a = (_priv::hashRead32(p) << 32) | _priv::hashRead32(p + offset);
+            b = (_priv::hashRead32(p + len - 4) << 32) | _priv::hashRead32(p + len - 4 - offset);
+        }
+        else if (len > 0) {
+            a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | uint64_t(p[len - 1]);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        uint64_t i = len;
+        while (i > 16) {
+            seed = _priv::hashMix(_priv::hashRead64(p) ^ _priv::hashSecret1, _priv::hashRead64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // the last 16 bytes, may overlap with the previous step
+        a = _priv::hashRead64(p + i - 16);
+        b = _priv::hashRead64(p + i - 8);
+    }
+    return _priv::hashFinish(a ^ _priv::hashSecret1, b ^ seed, len);
+}
+
+//------------------------------------------------------------------------------
+/// compute a 64-bit hash value for a string literal at compile time, same result as HashBytes64()
+template<int SIZE> constexpr uint64_t
+HashLiteral64(const char (&str)[SIZE], uint64_t seed = 0) {
+    return _priv::constHashBytes(str, SIZE - 1, seed ^ _priv::constHashMix(seed ^ _priv::hashSecret0, _priv::hashSecret1));
+}
+
+//------------------------------------------------------------------------------
+/// compute a 32-bit hash value for a range of bytes (lower bits of HashBytes64())
+inline uint32_t
+HashBytes(const void* ptr, int numBytes) {
+    return uint32_t(HashBytes64(ptr, numBytes));
+}
+
+//------------------------------------------------------------------------------
+/// combine two hash values
+inline uint32_t
+HashCombine(uint32_t h0, uint32_t h1) {
+    return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> struct Hash {
+    static_assert(std::is_integral<TYPE>::value || std::is_enum<TYPE>::value,
+        "Oryol::Hash: no hash function for this type, specialize Oryol::Hash<TYPE>");
+    uint32_t operator()(const TYPE& val) const {
+        return HashInt(uint64_t(val));
+    };
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE> struct Hash<TYPE*> {
+    uint32_t operator()(const TYPE* ptr) const {
+        return HashInt(uint64_t(uintptr_t(ptr)));
+    };
+};
+
+} // namespace Oryol
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//  FrameArena.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "FrameArena.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+
+namespace Oryol {
+
+namespace {
+
+// an overflow chunk, allocated when the main block is exhausted
+struct chunk {
+    chunk* next;
+};
+const int chunkHeaderSize = (sizeof(chunk) + ORYOL_MAX_PLATFORM_ALIGN - 1) & ~(ORYOL_MAX_PLATFORM_ALIGN - 1);
+
+struct arena {
+    uint8_t* buf = nullptr;
+    int capacity = 0;
+    int pos = 0;
+    int overflowBytes = 0;
+    chunk* overflow = nullptr;
+    int highWaterMark = 0;
+    int numOverflows = 0;
+};
+ORYOL_THREADLOCAL_PTR(arena) curArena = nullptr;
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void
+FrameArena::Setup(int capacity) {
+    o_assert(nullptr == curArena);
+    o_assert(capacity > 0);
+    arena* a = Memory::New<arena>();
+    a->capacity = Memory::RoundUp(capacity, ORYOL_MAX_PLATFORM_ALIGN);
+    a->buf = (uint8_t*) Memory::Alloc(a->capacity);
+    curArena = a;
+}
+
+//------------------------------------------------------------------------------
+void
+FrameArena::Discard() {
+    o_assert(curArena);
+    Reset();
+    arena* a = curArena;
+    if (a->highWaterMark > 0) {
+        Log::Dbg("FrameArena::Discard(): capacity=%d, high-water mark=%d, overflows=%d\n",
+            a->capacity, a->highWaterMark, a->numOverflows);
+    }
+    Memory::Free(a->buf);
+    Memory::Delete(a);
+    curArena = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+FrameArena::IsValid() {
+    return nullptr != curArena;
+}
+
+//------------------------------------------------------------------------------
+void*
+FrameArena::Alloc(int numBytes, int alignment) {
+    o_assert_dbg(curArena);
+    o_assert_dbg(numBytes > 0);
+    o_assert_dbg((alignment > 0) && (0 == (alignment & (alignment - 1))));
+    arena* a = curArena;
+    const int allocSize = Memory::RoundUp(numBytes, ORYOL_MAX_PLATFORM_ALIGN);
+    const int alignPad = alignment > ORYOL_MAX_PLATFORM_ALIGN ? alignment - ORYOL_MAX_PLATFORM_ALIGN : 0;
+    if (0 == alignPad) {
+        if ((a->pos + allocSize) <= a->capacity) {
+            void* ptr = a->buf + a->pos;
+            a->pos += allocSize;
+            return ptr;
+        }
+    }
+    else {
+        const intptr_t ptri = (intptr_t(a->buf + a->pos) + (alignment - 1)) & ~intptr_t(alignment - 1);
+        const int alignedPos = int(ptri - intptr_t(a->buf));
+        if ((alignedPos + allocSize) <= a->capacity) {
+            a->pos = alignedPos + allocSize;
+            return (void*) ptri;
+        }
+    }
+
+    // main block exhausted, fall back to a heap chunk
+    // which lives until the next Reset()
+    chunk* c = (chunk*) Memory::Alloc(chunkHeaderSize + allocSize + alignPad);
+    c->next = a->overflow;
+    a->overflow = c;
+    a->overflowBytes += allocSize + alignPad;
+    a->numOverflows++;
+    intptr_t ptri = intptr_t(c) + chunkHeaderSize;
+    ptri = (ptri + (alignment - 1)) & ~intptr_t(alignment - 1);
+    return (void*) ptri;
+}
+
+//------------------------------------------------------------------------------
+void
+FrameArena::Reset() {
+    o_assert_dbg(curArena);
+    arena* a = curArena;
+    const int usedBytes = a->pos + a->overflowBytes;
+    if (usedBytes > a->highWaterMark) {
+        a->highWaterMark = usedBytes;
+    }
+    if (a->overflow) {
+        // free overflow chunks, and grow the main block so that
+        // this frame's allocations would have fit
+        while (a->overflow) {
+            chunk* next = a->overflow->next;
+            Memory::Free(a->overflow);
+            a->overflow = next;
+        }
+        Memory::Free(a->buf);
+        a->capacity = usedBytes;
+        a->buf = (uint8_t*) Memory::Alloc(a->capacity);
+    }
+    #if ORYOL_ALLOCATOR_DEBUG || ORYOL_UNITTESTS
+    else {
+        // trash the released memory to catch stale pointers
+        Memory::Fill(a->buf, a->pos, ORYOL_MEMORY_DEBUG_BYTE);
+    }
+    #endif
+    a->pos = 0;
+    a->overflowBytes = 0;
+}
+
+//------------------------------------------------------------------------------
+FrameArena::Stats
+FrameArena::QueryStats() {
+    o_assert(curArena);
+    const arena* a = curArena;
+    Stats stats;
+    stats.Capacity = a->capacity;
+    stats.UsedBytes = a->pos + a->overflowBytes;
+    stats.HighWaterMark = stats.UsedBytes > a->highWaterMark ? stats.UsedBytes : a->highWaterMark;
+    stats.NumOverflows = a->numOverflows;
+    return stats;
+}
+
+} // namespace Oryol
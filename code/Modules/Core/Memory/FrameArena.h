@@ -0,0 +1,63 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::FrameArena
+    @ingroup Core
+    @brief per-thread linear allocator for transient per-frame memory
+
+    The FrameArena is a thread-local bump allocator for temporary
+    memory which only needs to live until the end of the current frame.
+    An allocation is a single pointer bump, and there is no free,
+    instead all memory is released at once when the arena is reset.
+
+    Core::Setup() and Core::EnterThread() create the current thread's
+    arena and add a callback to the thread's Core::PostRunLoop() which
+    resets the arena at the end of each frame.
+
+    If the arena runs out of space, allocations fall back to separate
+    heap chunks which are released on the next Reset(), the arena
+    then grows to the frame's high-water mark so that the next
+    frame fits. Use FrameArena::QueryStats() to size the
+    initial arena capacity (ORYOL_FRAME_ARENA_SIZE).
+
+    Array, Buffer and StringBuilder can be told to allocate from
+    the frame arena with their UseFrameArena() method.
+
+    NOTE: frame-arena memory must not be accessed after the end of
+    the frame, and it must not be handed to other threads!
+*/
+#include "Core/Types.h"
+#include "Core/Config.h"
+
+namespace Oryol {
+
+class FrameArena {
+public:
+    /// setup the current thread's frame arena (called by Core)
+    static void Setup(int capacity=ORYOL_FRAME_ARENA_SIZE);
+    /// discard the current thread's frame arena (called by Core)
+    static void Discard();
+    /// return true if the current thread has a frame arena
+    static bool IsValid();
+
+    /// allocate memory which is valid until the next Reset() (alignment must be power of 2)
+    static void* Alloc(int numBytes, int alignment=ORYOL_MAX_PLATFORM_ALIGN);
+    /// release all memory allocated in this frame (called from Core::PostRunLoop())
+    static void Reset();
+
+    /// frame arena statistics of the current thread
+    struct Stats {
+        /// size of the arena's main memory block
+        int Capacity = 0;
+        /// number of bytes allocated since the last Reset()
+        int UsedBytes = 0;
+        /// highest number of bytes allocated in a single frame
+        int HighWaterMark = 0;
+        /// number of allocations which didn't fit into the main block
+        int NumOverflows = 0;
+    };
+    /// query statistics of the current thread's frame arena
+    static Stats QueryStats();
+};
+
+} // namespace Oryol
@@ -0,0 +1,66 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HeapAllocator
+    @ingroup Core
+    @brief default allocator policy of the Oryol containers
+
+    Array, Map, Set, Queue and Buffer take an optional allocator policy
+    template parameter, which defaults to the HeapAllocator (allocation
+    through the global Memory functions). An allocator policy is a small
+    copyable class with the following methods:
+
+    @code
+    /// allocate numBytes with alignment (power of 2)
+    void* Alloc(int64_t numBytes, int alignment);
+    /// free memory, numBytes and alignment are the same as in Alloc()
+    void Free(void* ptr, int64_t numBytes, int alignment);
+    /// return true if memory with this alignment can be resized with ReAlloc()
+    bool CanReAlloc(int alignment) const;
+    /// resize memory, the content is preserved
+    void* ReAlloc(void* ptr, int64_t oldNumBytes, int64_t newNumBytes, int alignment);
+    @endcode
+
+    Policies may have state (e.g. a pointer to an arena, see
+    ArenaAllocator), a container stores its own copy of the policy
+    object, which is handed over to copies and moves of the container.
+
+    @see ArenaAllocator, LinearArena
+*/
+#include "Core/Types.h"
+#include "Core/Config.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+class HeapAllocator {
+public:
+    /// allocate memory through Memory::Alloc() or Memory::AllocAligned()
+    void* Alloc(int64_t numBytes, int alignment) {
+        if (alignment > ORYOL_MAX_PLATFORM_ALIGN) {
+            return Memory::AllocAligned(numBytes, alignment);
+        }
+        else {
+            return Memory::Alloc(numBytes);
+        }
+    };
+    /// free memory through Memory::Free() or Memory::FreeAligned()
+    void Free(void* ptr, int64_t /*numBytes*/, int alignment) {
+        if (alignment > ORYOL_MAX_PLATFORM_ALIGN) {
+            Memory::FreeAligned(ptr);
+        }
+        else {
+            Memory::Free(ptr);
+        }
+    };
+    /// over-aligned memory can't go through Memory::ReAlloc()
+    bool CanReAlloc(int alignment) const {
+        return alignment <= ORYOL_MAX_PLATFORM_ALIGN;
+    };
+    /// resize memory through Memory::ReAlloc()
+    void* ReAlloc(void* ptr, int64_t /*oldNumBytes*/, int64_t newNumBytes, int /*alignment*/) {
+        return Memory::ReAlloc(ptr, newNumBytes);
+    };
+};
+
+} // namespace Oryol
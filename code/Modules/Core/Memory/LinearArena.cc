@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+//  LinearArena.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "LinearArena.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+LinearArena::LinearArena() :
+buf(nullptr),
+capacity(0),
+pos(0),
+lastPos(0),
+highWaterMark(0),
+ownsBuffer(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+LinearArena::~LinearArena() {
+    if (this->IsValid()) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+LinearArena::Setup(int64_t capacity_) {
+    o_assert(!this->IsValid());
+    o_assert(capacity_ > 0);
+    this->Setup(Memory::Alloc(capacity_), capacity_);
+    this->ownsBuffer = true;
+}
+
+//------------------------------------------------------------------------------
+void
+LinearArena::Setup(void* ptr, int64_t capacity_) {
+    o_assert(!this->IsValid());
+    o_assert(ptr && (capacity_ > 0));
+    o_assert(Memory::IsAligned(ptr, ORYOL_MAX_PLATFORM_ALIGN));
+    this->buf = (uint8_t*) ptr;
+    this->capacity = capacity_;
+    this->pos = 0;
+    this->lastPos = 0;
+    this->highWaterMark = 0;
+    this->ownsBuffer = false;
+}
+
+//------------------------------------------------------------------------------
+void
+LinearArena::Discard() {
+    o_assert(this->IsValid());
+    if (this->ownsBuffer) {
+        Memory::Free(this->buf);
+    }
+    this->buf = nullptr;
+    this->capacity = 0;
+    this->pos = 0;
+    this->lastPos = 0;
+    this->ownsBuffer = false;
+}
+
+//------------------------------------------------------------------------------
+void*
+LinearArena::Alloc(int64_t numBytes, int alignment) {
+    o_assert_dbg(this->IsValid());
+    o_assert_dbg(numBytes > 0);
+    o_assert_dbg((alignment > 0) && (0 == (alignment & (alignment - 1))));
+    if (alignment < ORYOL_MAX_PLATFORM_ALIGN) {
+        alignment = ORYOL_MAX_PLATFORM_ALIGN;
+    }
+    const intptr_t ptri = (intptr_t(this->buf + this->pos) + (alignment - 1)) & ~intptr_t(alignment - 1);
+    const int64_t alignedPos = int64_t(ptri - intptr_t(this->buf));
+    const int64_t newPos = alignedPos + ((numBytes + (ORYOL_MAX_PLATFORM_ALIGN - 1)) & ~int64_t(ORYOL_MAX_PLATFORM_ALIGN - 1));
+    o_assert2(newPos <= this->capacity, "LinearArena: out of memory!\n");
+    this->lastPos = alignedPos;
+    this->pos = newPos;
+    if (newPos > this->highWaterMark) {
+        this->highWaterMark = newPos;
+    }
+    return this->buf + alignedPos;
+}
+
+//------------------------------------------------------------------------------
+void
+LinearArena::Free(void* ptr, int64_t /*numBytes*/) {
+    o_assert_dbg(this->IsValid());
+    o_assert_dbg(((uint8_t*)ptr >= this->buf) && ((uint8_t*)ptr < (this->buf + this->capacity)));
+    if ((uint8_t*)ptr == (this->buf + this->lastPos)) {
+        // the most recent allocation, rewind
+        this->pos = this->lastPos;
+    }
+}
+
+//------------------------------------------------------------------------------
+void*
+LinearArena::ReAlloc(void* ptr, int64_t oldNumBytes, int64_t newNumBytes, int alignment) {
+    o_assert_dbg(this->IsValid());
+    o_assert_dbg(ptr && (newNumBytes > 0));
+    if ((uint8_t*)ptr == (this->buf + this->lastPos)) {
+        // the most recent allocation, resize in place
+        const int64_t newPos = this->lastPos + ((newNumBytes + (ORYOL_MAX_PLATFORM_ALIGN - 1)) & ~int64_t(ORYOL_MAX_PLATFORM_ALIGN - 1));
+        o_assert2(newPos <= this->capacity, "LinearArena: out of memory!\n");
+        this->pos = newPos;
+        if (newPos > this->highWaterMark) {
+            this->highWaterMark = newPos;
+        }
+        return ptr;
+    }
+    else {
+        void* newPtr = this->Alloc(newNumBytes, alignment);
+        Memory::Copy(ptr, newPtr, oldNumBytes < newNumBytes ? oldNumBytes : newNumBytes);
+        return newPtr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+LinearArena::Reset() {
+    o_assert_dbg(this->IsValid());
+    this->pos = 0;
+    this->lastPos = 0;
+}
+
+} // namespace Oryol
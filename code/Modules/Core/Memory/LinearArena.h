@@ -0,0 +1,153 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::LinearArena
+    @ingroup Core
+    @brief linear allocator with a fixed memory budget
+
+    A LinearArena hands out memory from a single fixed-size block with
+    a pointer bump. It either allocates its block from the heap in
+    Setup(capacity), or works on a caller-provided block (e.g. a static
+    array or a slice of a bigger memory budget) with Setup(ptr, capacity).
+
+    Freeing or resizing the most recent allocation rewinds or extends it
+    in place, any other free is a no-op, all memory is released at once
+    with Reset(). Running out of the budget is a fatal error, use
+    UsedBytes() and HighWaterMark() to size the arena.
+
+    A LinearArena is not thread-safe, the idea is that each system
+    (or each worker thread) owns its arena, so allocations never contend
+    on a lock and the memory usage of the system is easy to measure.
+
+    Use ArenaAllocator as allocator policy to put container memory
+    into an arena:
+
+    @code
+    LinearArena arena;
+    arena.Setup(64 * 1024);
+    ArenaAllocator allocator(&arena);
+    Array<int, ArenaAllocator> array(allocator);
+    @endcode
+
+    The arena must outlive all containers which allocate from it.
+
+    @see ArenaAllocator, HeapAllocator, FrameArena
+*/
+#include "Core/Types.h"
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+class LinearArena {
+public:
+    /// default constructor
+    LinearArena();
+    /// destructor
+    ~LinearArena();
+
+    /// arenas can't be copied
+    LinearArena(const LinearArena& rhs) = delete;
+    /// arenas can't be copied
+    void operator=(const LinearArena& rhs) = delete;
+
+    /// setup with a heap-allocated block of capacity bytes
+    void Setup(int64_t capacity);
+    /// setup with a caller-owned block of memory (must be ORYOL_MAX_PLATFORM_ALIGN aligned)
+    void Setup(void* ptr, int64_t capacity);
+    /// discard the arena (frees the block if it was heap-allocated)
+    void Discard();
+    /// return true if the arena has been setup
+    bool IsValid() const;
+
+    /// allocate memory (alignment must be power of 2)
+    void* Alloc(int64_t numBytes, int alignment=ORYOL_MAX_PLATFORM_ALIGN);
+    /// free memory, only rewinds if this was the most recent allocation
+    void Free(void* ptr, int64_t numBytes);
+    /// resize memory, in place if this was the most recent allocation
+    void* ReAlloc(void* ptr, int64_t oldNumBytes, int64_t newNumBytes, int alignment=ORYOL_MAX_PLATFORM_ALIGN);
+    /// release all allocations
+    void Reset();
+
+    /// get capacity in bytes
+    int64_t Capacity() const;
+    /// get number of currently allocated bytes (including alignment padding)
+    int64_t UsedBytes() const;
+    /// get the highest number of allocated bytes since Setup()
+    int64_t HighWaterMark() const;
+
+private:
+    uint8_t* buf;
+    int64_t capacity;
+    int64_t pos;
+    int64_t lastPos;        // start of most recent allocation
+    int64_t highWaterMark;
+    bool ownsBuffer;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+LinearArena::IsValid() const {
+    return nullptr != this->buf;
+}
+
+//------------------------------------------------------------------------------
+inline int64_t
+LinearArena::Capacity() const {
+    return this->capacity;
+}
+
+//------------------------------------------------------------------------------
+inline int64_t
+LinearArena::UsedBytes() const {
+    return this->pos;
+}
+
+//------------------------------------------------------------------------------
+inline int64_t
+LinearArena::HighWaterMark() const {
+    return this->highWaterMark;
+}
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::ArenaAllocator
+    @ingroup Core
+    @brief allocator policy for containers which allocate from a LinearArena
+*/
+class ArenaAllocator {
+public:
+    /// default constructor, must be assigned an arena before allocating
+    ArenaAllocator() : arena(nullptr) { };
+    /// construct with arena
+    explicit ArenaAllocator(LinearArena* arena_) : arena(arena_) { };
+
+    /// get the arena
+    LinearArena* Arena() const {
+        return this->arena;
+    };
+    /// allocate from the arena
+    void* Alloc(int64_t numBytes, int alignment) {
+        o_assert_dbg(this->arena);
+        return this->arena->Alloc(numBytes, alignment);
+    };
+    /// free arena memory (rewinds the arena if most recent allocation)
+    void Free(void* ptr, int64_t numBytes, int /*alignment*/) {
+        o_assert_dbg(this->arena);
+        this->arena->Free(ptr, numBytes);
+    };
+    /// arena memory can always be resized
+    bool CanReAlloc(int /*alignment*/) const {
+        return true;
+    };
+    /// resize arena memory (in place if most recent allocation)
+    void* ReAlloc(void* ptr, int64_t oldNumBytes, int64_t newNumBytes, int alignment) {
+        o_assert_dbg(this->arena);
+        return this->arena->ReAlloc(ptr, oldNumBytes, newNumBytes, alignment);
+    };
+
+private:
+    LinearArena* arena;
+};
+
+} // namespace Oryol
@@ -5,16 +5,170 @@
 #include <cstdlib>
 #include <cstring>
 #include "Memory.h"
+#include "Core/Core.h"
+#include "Core/Assertion.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#if ORYOL_MEMORY_STATS
+#include <atomic>
+#if ORYOL_THREADLOCAL_PTHREAD
+#include <pthread.h>
+#endif
+#endif
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
 
 namespace Oryol {
-    
+
+namespace {
+
+// NOTE: the allocator is constant-initialized so that it can be
+// used from static initializers, nullptr callbacks mean 'use std::malloc etc'
+Memory::Allocator allocator;
+
+//------------------------------------------------------------------------------
+inline void*
+backendAlloc(int64_t numBytes) {
+    if (allocator.Alloc) {
+        return allocator.Alloc(allocator.UserData, numBytes);
+    }
+    else {
+        return std::malloc(size_t(numBytes));
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void*
+backendReAlloc(void* ptr, int64_t numBytes) {
+    if (allocator.ReAlloc) {
+        return allocator.ReAlloc(allocator.UserData, ptr, numBytes);
+    }
+    else {
+        return std::realloc(ptr, size_t(numBytes));
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+backendFree(void* ptr) {
+    if (allocator.Free) {
+        allocator.Free(allocator.UserData, ptr);
+    }
+    else {
+        std::free(ptr);
+    }
+}
+
+#if ORYOL_MEMORY_STATS
+// per-tag counters, updated from any thread
+struct tagCounters {
+    std::atomic<int64_t> liveBytes;
+    std::atomic<int64_t> peakBytes;
+    std::atomic<int64_t> numAllocs;
+    std::atomic<int64_t> numFrees;
+};
+tagCounters counters[MemoryTag::NumMemoryTags];
+
+// NOTE: ThreadLocalPtr allocates its pointer table through Memory::Alloc,
+// so on pthread-key platforms the current tag uses its own raw pthread key
+#if ORYOL_THREADLOCAL_PTHREAD
+pthread_once_t curCountersKeyOnce = PTHREAD_ONCE_INIT;
+pthread_key_t curCountersKey;
+
+//------------------------------------------------------------------------------
+void
+createCurCountersKey() {
+    pthread_key_create(&curCountersKey, nullptr);
+}
+
+//------------------------------------------------------------------------------
+tagCounters*
+getCurCounters() {
+    pthread_once(&curCountersKeyOnce, createCurCountersKey);
+    return (tagCounters*) pthread_getspecific(curCountersKey);
+}
+
+//------------------------------------------------------------------------------
+void
+setCurCounters(tagCounters* c) {
+    pthread_once(&curCountersKeyOnce, createCurCountersKey);
+    pthread_setspecific(curCountersKey, c);
+}
+#else
+ORYOL_THREADLOCAL_PTR(tagCounters) curCounters = nullptr;
+
+//------------------------------------------------------------------------------
+inline tagCounters*
+getCurCounters() {
+    return curCounters;
+}
+
+//------------------------------------------------------------------------------
+inline void
+setCurCounters(tagCounters* c) {
+    curCounters = c;
+}
+#endif
+
+// each allocation is prefixed with a header which remembers
+// the allocation size and tag, the header size keeps the
+// user pointer at ORYOL_MAX_PLATFORM_ALIGN alignment
+struct allocHeader {
+    int64_t numBytes;
+    int32_t tag;
+};
+const int headerSize = 16;
+static_assert(headerSize >= ORYOL_MAX_PLATFORM_ALIGN, "allocHeader size must be >= ORYOL_MAX_PLATFORM_ALIGN");
+static_assert(headerSize >= int(sizeof(allocHeader)), "allocHeader doesn't fit");
+
+//------------------------------------------------------------------------------
+MemoryTag::Code
+curTag() {
+    const tagCounters* c = getCurCounters();
+    return c ? MemoryTag::Code(c - counters) : MemoryTag::App;
+}
+
+//------------------------------------------------------------------------------
+void
+addLiveBytes(tagCounters& c, int64_t numBytes) {
+    const int64_t live = c.liveBytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    int64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while ((live > peak) && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        // empty
+    }
+}
+
 //------------------------------------------------------------------------------
 void*
-Memory::Alloc(int numBytes) {
-    void* ptr = std::malloc(numBytes);
+trackAlloc(void* rawPtr, int64_t numBytes) {
+    o_assert_dbg(rawPtr);
+    const MemoryTag::Code tag = curTag();
+    allocHeader* hdr = (allocHeader*) rawPtr;
+    hdr->numBytes = numBytes;
+    hdr->tag = tag;
+    tagCounters& c = counters[tag];
+    c.numAllocs.fetch_add(1, std::memory_order_relaxed);
+    addLiveBytes(c, numBytes);
+    return ((uint8_t*)rawPtr) + headerSize;
+}
+
+//------------------------------------------------------------------------------
+allocHeader*
+header(void* ptr) {
+    return (allocHeader*) (((uint8_t*)ptr) - headerSize);
+}
+#endif
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void*
+Memory::Alloc(int64_t numBytes) {
+    #if ORYOL_MEMORY_STATS
+    void* ptr = trackAlloc(backendAlloc(numBytes + headerSize), numBytes);
+    #else
+    void* ptr = backendAlloc(numBytes);
+    #endif
 #if ORYOL_ALLOCATOR_DEBUG || ORYOL_UNITTESTS
     Memory::Fill(ptr, numBytes, ORYOL_MEMORY_DEBUG_BYTE);
 #endif
@@ -23,39 +177,141 @@ Memory::Alloc(int numBytes) {
 
 //------------------------------------------------------------------------------
 void
-Memory::Fill(void* ptr, int numBytes, uint8_t value) {
-    std::memset(ptr, value, numBytes);
+Memory::Fill(void* ptr, int64_t numBytes, uint8_t value) {
+    std::memset(ptr, value, size_t(numBytes));
 }
 
 //------------------------------------------------------------------------------
 void*
-Memory::ReAlloc(void* ptr, int s) {
+Memory::ReAlloc(void* ptr, int64_t s) {
     /// @todo: HMM need to fix fill with debug pattern...
-    return std::realloc(ptr, s);
+    if (nullptr == ptr) {
+        return Memory::Alloc(s);
+    }
+    #if ORYOL_MEMORY_STATS
+    allocHeader* hdr = header(ptr);
+    const int64_t oldSize = hdr->numBytes;
+    const int tag = hdr->tag;
+    hdr = (allocHeader*) backendReAlloc(hdr, s + headerSize);
+    o_assert_dbg(hdr);
+    hdr->numBytes = s;
+    addLiveBytes(counters[tag], s - oldSize);
+    return ((uint8_t*)hdr) + headerSize;
+    #else
+    return backendReAlloc(ptr, s);
+    #endif
 }
 
 //------------------------------------------------------------------------------
 void
 Memory::Free(void* p) {
-    std::free(p);
+    if (nullptr == p) {
+        return;
+    }
+    #if ORYOL_MEMORY_STATS
+    allocHeader* hdr = header(p);
+    o_assert_range_dbg(hdr->tag, MemoryTag::NumMemoryTags);
+    tagCounters& c = counters[hdr->tag];
+    c.numFrees.fetch_add(1, std::memory_order_relaxed);
+    c.liveBytes.fetch_sub(hdr->numBytes, std::memory_order_relaxed);
+    backendFree(hdr);
+    #else
+    backendFree(p);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void*
+Memory::AllocAligned(int64_t numBytes, int alignment) {
+    o_assert_dbg((alignment > 0) && (0 == (alignment & (alignment - 1))));
+    // over-allocate, and store the original pointer in front of
+    // the aligned pointer so that FreeAligned() can find it
+    uint8_t* rawPtr = (uint8_t*) Memory::Alloc(numBytes + alignment + int(sizeof(void*)));
+    intptr_t ptri = (intptr_t)(rawPtr + sizeof(void*));
+    ptri = (ptri + (alignment - 1)) & ~intptr_t(alignment - 1);
+    void** ptr = (void**) ptri;
+    ptr[-1] = rawPtr;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::FreeAligned(void* ptr) {
+    if (nullptr == ptr) {
+        return;
+    }
+    Memory::Free(((void**)ptr)[-1]);
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Copy(const void* from, void* to, int64_t numBytes) {
+    std::memcpy(to, from, size_t(numBytes));
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Move(const void* from, void* to, int64_t numBytes) {
+    std::memmove(to, from, size_t(numBytes));
 }
 
 //------------------------------------------------------------------------------
 void
-Memory::Copy(const void* from, void* to, int numBytes) {
-    std::memcpy(to, from, numBytes);
+Memory::Clear(void* ptr, int64_t numBytes) {
+    std::memset(ptr, 0, size_t(numBytes));
 }
 
 //------------------------------------------------------------------------------
 void
-Memory::Move(const void* from, void* to, int numBytes) {
-    std::memmove(to, from, numBytes);
+Memory::SetAllocator(const Allocator& a) {
+    o_assert2(!Core::IsValid(), "Memory::SetAllocator() must be called before Core::Setup()!\n");
+    o_assert(a.Alloc && a.ReAlloc && a.Free);
+    allocator = a;
 }
 
 //------------------------------------------------------------------------------
 void
-Memory::Clear(void* ptr, int numBytes) {
-    std::memset(ptr, 0, numBytes);
+Memory::ResetAllocator() {
+    o_assert2(!Core::IsValid(), "Memory::ResetAllocator() must be called before Core::Setup()!\n");
+    allocator = Allocator();
+}
+
+//------------------------------------------------------------------------------
+Memory::Stats
+Memory::QueryStats(MemoryTag::Code tag) {
+    o_assert_range(tag, MemoryTag::NumMemoryTags);
+    Stats stats;
+    #if ORYOL_MEMORY_STATS
+    const tagCounters& c = counters[tag];
+    stats.LiveBytes = c.liveBytes.load(std::memory_order_relaxed);
+    stats.PeakBytes = c.peakBytes.load(std::memory_order_relaxed);
+    stats.NumAllocs = c.numAllocs.load(std::memory_order_relaxed);
+    stats.NumFrees = c.numFrees.load(std::memory_order_relaxed);
+    #endif
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+MemoryTag::Code
+Memory::SetTag(MemoryTag::Code tag) {
+    #if ORYOL_MEMORY_STATS
+    o_assert_range_dbg(tag, MemoryTag::NumMemoryTags);
+    const MemoryTag::Code prevTag = curTag();
+    setCurCounters((MemoryTag::App == tag) ? nullptr : &counters[tag]);
+    return prevTag;
+    #else
+    return MemoryTag::App;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+MemoryTag::Code
+Memory::GetTag() {
+    #if ORYOL_MEMORY_STATS
+    return curTag();
+    #else
+    return MemoryTag::App;
+    #endif
 }
 
 } // namespace Oryol
@@ -4,37 +4,57 @@
     @class Oryol::Memory
     @ingroup Core
     @brief Low-level memory management functions
-    
+
     Lowlevel memory allocation wrapper for Oryol. Standard memory alignment
     differs by platforms (e.g. platforms with SSE support return 16-byte
     aligned memory.
-    
-    @todo for now this simply calls malloc()/free(), may be more
-    advanced in the future.
+
+    By default, Alloc/ReAlloc/Free call into std::malloc/realloc/free,
+    a different allocator backend can be installed with
+    Memory::SetAllocator(). This must happen at the very start of the
+    program (before Core::Setup()), since memory must be freed
+    by the same backend it was allocated from.
+
+    Memory::AllocAligned() allocates memory with an alignment bigger
+    than ORYOL_MAX_PLATFORM_ALIGN (e.g. 32 bytes for AVX data, or 64 bytes
+    for cache-line aligned data), such memory must be freed with
+    Memory::FreeAligned().
+
+    If ORYOL_MEMORY_STATS is enabled, each allocation is tagged with
+    the current thread's MemoryTag (set with the o_memory_tag() macro),
+    and live-bytes, peak-bytes and alloc/free counters are tracked
+    per tag, use Memory::QueryStats() to read the counters.
 */
 #include "Core/Types.h"
 #include "Core/Config.h"
+#include "Core/Memory/MemoryTag.h"
 #include <new>
 #include <utility>
 
 namespace Oryol {
-    
+
 class Memory {
 public:
     /// allocate a raw chunk of memory
-    static void* Alloc(int numBytes);
+    static void* Alloc(int64_t numBytes);
     /// re-allocate a raw chunk of memory
-    static void* ReAlloc(void* ptr, int numBytes);
+    static void* ReAlloc(void* ptr, int64_t numBytes);
     /// free a raw chunk of memory
     static void Free(void* ptr);
+    /// allocate a raw chunk of memory with alignment (power of 2, can be > ORYOL_MAX_PLATFORM_ALIGN)
+    static void* AllocAligned(int64_t numBytes, int alignment);
+    /// free memory allocated with AllocAligned()
+    static void FreeAligned(void* ptr);
+    /// test if a pointer is aligned (alignment must be power of 2)
+    static bool IsAligned(const void* ptr, int alignment);
     /// fill range of memory with a byte value
-    static void Fill(void* ptr, int numBytes, uint8_t value);
+    static void Fill(void* ptr, int64_t numBytes, uint8_t value);
     /// copy a raw chunk of non-overlapping memory
-    static void Copy(const void* from, void* to, int numBytes);
+    static void Copy(const void* from, void* to, int64_t numBytes);
     /// move a raw chunk of potentially overlapping memory
-    static void Move(const void* from, void* to, int numBytes);
+    static void Move(const void* from, void* to, int64_t numBytes);
     /// fill a chunk of memory with zeros
-    static void Clear(void* ptr, int numBytes);
+    static void Clear(void* ptr, int64_t numBytes);
     /// align a pointer to size up to ORYOL_MAX_PLATFORM_ALIGN
     static void* Align(void* ptr, int byteSize);
     /// round-up a value to the next multiple of byteSize
@@ -49,6 +69,51 @@ public:
         ptr->~TYPE();
         Memory::Free(ptr);
     };
+
+    /// a pluggable allocator backend
+    struct Allocator {
+        /// allocate memory, must return ORYOL_MAX_PLATFORM_ALIGN aligned memory
+        void* (*Alloc)(void* userData, int64_t numBytes) = nullptr;
+        /// re-allocate memory (ptr is never nullptr)
+        void* (*ReAlloc)(void* userData, void* ptr, int64_t numBytes) = nullptr;
+        /// free memory (ptr is never nullptr)
+        void (*Free)(void* userData, void* ptr) = nullptr;
+        /// an optional user-data pointer handed to the callbacks
+        void* UserData = nullptr;
+    };
+    /// install an allocator backend (call before Core::Setup!)
+    static void SetAllocator(const Allocator& allocator);
+    /// restore the default allocator backend (std::malloc/realloc/free)
+    static void ResetAllocator();
+
+    /// per-tag memory statistics (only updated if ORYOL_MEMORY_STATS)
+    struct Stats {
+        /// currently allocated number of bytes
+        int64_t LiveBytes = 0;
+        /// highest number of allocated bytes
+        int64_t PeakBytes = 0;
+        /// number of allocations
+        int64_t NumAllocs = 0;
+        /// number of frees
+        int64_t NumFrees = 0;
+    };
+    /// query memory statistics for a tag
+    static Stats QueryStats(MemoryTag::Code tag);
+    /// set the current thread's memory tag, return previous tag
+    static MemoryTag::Code SetTag(MemoryTag::Code tag);
+    /// get the current thread's memory tag
+    static MemoryTag::Code GetTag();
+
+    /// scoped helper to set the current thread's memory tag (see o_memory_tag)
+    class TagScope {
+    public:
+        /// constructor, sets new tag
+        TagScope(MemoryTag::Code tag) : prevTag(Memory::SetTag(tag)) { };
+        /// destructor, restores previous tag
+        ~TagScope() { Memory::SetTag(this->prevTag); };
+    private:
+        MemoryTag::Code prevTag;
+    };
 };
 
 //------------------------------------------------------------------------------
@@ -60,10 +125,23 @@ Memory::Align(void* ptr, int byteSize) {
     return (void*) ptri;
 };
 
+//------------------------------------------------------------------------------
+inline bool
+Memory::IsAligned(const void* ptr, int alignment) {
+    return 0 == (((intptr_t)ptr) & (alignment - 1));
+}
+
 //------------------------------------------------------------------------------
 inline int
 Memory::RoundUp(int val, int roundTo) {
     return (val + (roundTo - 1)) & ~(roundTo - 1);
 }
-    
-} // namespace oryol
\ No newline at end of file
+
+} // namespace oryol
+
+/// tag all allocations of the current thread until end of scope
+#if ORYOL_MEMORY_STATS
+#define o_memory_tag(tag) Oryol::Memory::TagScope __oryol_memory_tag_scope(tag)
+#else
+#define o_memory_tag(tag) ((void)0)
+#endif
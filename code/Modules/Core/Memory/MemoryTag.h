@@ -0,0 +1,47 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MemoryTag
+    @ingroup Core
+    @brief tags for per-module memory accounting
+
+    Allocations are attributed to the current thread's memory tag,
+    which is set with the o_memory_tag() macro. Allocations outside
+    of a tagged scope (e.g. application code) are attributed to the
+    App tag.
+
+    @see Memory
+*/
+
+namespace Oryol {
+
+class MemoryTag {
+public:
+    /// tag codes
+    enum Code {
+        App = 0,    ///< untagged allocations (application code)
+        Core,       ///< Core module
+        IO,         ///< IO module (and filesystem modules)
+        Gfx,        ///< Gfx module
+        Resource,   ///< Resource module
+        Assets,     ///< Assets module
+
+        NumMemoryTags,
+        InvalidMemoryTag,
+    };
+
+    /// convert memory tag to string
+    static const char* ToString(Code c) {
+        switch (c) {
+            case App:       return "App";
+            case Core:      return "Core";
+            case IO:        return "IO";
+            case Gfx:       return "Gfx";
+            case Resource:  return "Resource";
+            case Assets:    return "Assets";
+            default:        return "InvalidMemoryTag";
+        }
+    }
+};
+
+} // namespace Oryol
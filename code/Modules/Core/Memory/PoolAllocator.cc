@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+//  PoolAllocator.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "PoolAllocator.h"
+#include "Core/Assertion.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#if ORYOL_WINDOWS
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+namespace Oryol {
+
+namespace {
+
+const int granularity = ORYOL_MAX_PLATFORM_ALIGN;
+const int numSizeClasses = PoolAllocator::MaxPoolSize / granularity;
+// max number of free objects per size class in a thread's cache
+const int maxCached = 64;
+// number of objects moved between a thread's cache and the shared pool
+const int transferBatch = maxCached / 2;
+
+struct node {
+    node* next;
+};
+static_assert(sizeof(node) <= granularity, "PoolAllocator: free-list node too big");
+
+// the shared free lists, one per size class
+struct sizeClass {
+    #if ORYOL_HAS_THREADS
+    std::mutex lock;
+    #endif
+    node* freeList = nullptr;
+};
+sizeClass sizeClasses[numSizeClasses];
+
+// per-thread free lists, one per size class
+struct threadCache {
+    node* freeList[numSizeClasses] = { };
+    int num[numSizeClasses] = { };
+};
+ORYOL_THREADLOCAL_PTR(threadCache) curCache = nullptr;
+
+void flushCache(threadCache* cache);
+
+// threads which exit without calling FlushThreadCache() (e.g. a plain
+// std::thread releasing pooled objects), hand back their cache in a
+// thread-exit callback, the cache pointer is also stored in an OS
+// thread-local slot which has a destructor callback
+#if ORYOL_HAS_THREADS
+#if ORYOL_WINDOWS
+DWORD exitSlot = FLS_OUT_OF_INDEXES;
+std::once_flag exitSlotOnce;
+
+//------------------------------------------------------------------------------
+void WINAPI
+onThreadExit(void* ptr) {
+    if (ptr) {
+        flushCache((threadCache*) ptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+setExitCallback(threadCache* cache) {
+    std::call_once(exitSlotOnce, [] {
+        exitSlot = FlsAlloc(onThreadExit);
+    });
+    if (FLS_OUT_OF_INDEXES != exitSlot) {
+        FlsSetValue(exitSlot, cache);
+    }
+}
+#else
+pthread_once_t exitKeyOnce = PTHREAD_ONCE_INIT;
+pthread_key_t exitKey;
+
+//------------------------------------------------------------------------------
+void
+onThreadExit(void* ptr) {
+    flushCache((threadCache*) ptr);
+}
+
+//------------------------------------------------------------------------------
+void
+createExitKey() {
+    pthread_key_create(&exitKey, onThreadExit);
+}
+
+//------------------------------------------------------------------------------
+void
+setExitCallback(threadCache* cache) {
+    pthread_once(&exitKeyOnce, createExitKey);
+    pthread_setspecific(exitKey, cache);
+}
+#endif
+#else
+//------------------------------------------------------------------------------
+inline void
+setExitCallback(threadCache* /*cache*/) {
+    // empty
+}
+#endif
+
+//------------------------------------------------------------------------------
+inline int
+sizeClassIndex(int numBytes) {
+    return ((numBytes + (granularity - 1)) / granularity) - 1;
+}
+
+//------------------------------------------------------------------------------
+inline threadCache*
+getThreadCache() {
+    threadCache* cache = curCache;
+    if (nullptr == cache) {
+        o_memory_tag(MemoryTag::Core);
+        cache = Memory::New<threadCache>();
+        curCache = cache;
+        setExitCallback(cache);
+    }
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+void
+release(threadCache* cache, int sc, int num) {
+    if (0 == num) {
+        return;
+    }
+    o_assert_dbg(num <= cache->num[sc]);
+    node* first = cache->freeList[sc];
+    node* last = first;
+    for (int i = 1; i < num; i++) {
+        last = last->next;
+    }
+    cache->freeList[sc] = last->next;
+    cache->num[sc] -= num;
+
+    sizeClass& shared = sizeClasses[sc];
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(shared.lock);
+    #endif
+    last->next = shared.freeList;
+    shared.freeList = first;
+}
+
+//------------------------------------------------------------------------------
+void
+refill(threadCache* cache, int sc, int numPerChunk) {
+    o_assert_dbg(nullptr == cache->freeList[sc]);
+
+    // first try to grab a batch of objects from the shared free list
+    sizeClass& shared = sizeClasses[sc];
+    {
+        #if ORYOL_HAS_THREADS
+        std::lock_guard<std::mutex> lock(shared.lock);
+        #endif
+        if (shared.freeList) {
+            node* first = shared.freeList;
+            node* last = first;
+            int num = 1;
+            while (last->next && (num < transferBatch)) {
+                last = last->next;
+                num++;
+            }
+            shared.freeList = last->next;
+            last->next = nullptr;
+            cache->freeList[sc] = first;
+            cache->num[sc] = num;
+            return;
+        }
+    }
+
+    // shared free list is empty, allocate a new chunk of objects,
+    // the thread's cache gets a batch of those, the rest goes to
+    // the shared free list
+    o_memory_tag(MemoryTag::Core);
+    const int elmSize = (sc + 1) * granularity;
+    uint8_t* chunk = (uint8_t*) Memory::Alloc(elmSize * numPerChunk);
+    node* head = nullptr;
+    for (int i = numPerChunk - 1; i >= 0; i--) {
+        node* n = (node*) (chunk + i * elmSize);
+        n->next = head;
+        head = n;
+    }
+    cache->freeList[sc] = head;
+    cache->num[sc] = numPerChunk;
+    if (numPerChunk > transferBatch) {
+        release(cache, sc, numPerChunk - transferBatch);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+flushCache(threadCache* cache) {
+    for (int sc = 0; sc < numSizeClasses; sc++) {
+        release(cache, sc, cache->num[sc]);
+    }
+    if (curCache == cache) {
+        curCache = nullptr;
+    }
+    o_memory_tag(MemoryTag::Core);
+    Memory::Delete(cache);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void*
+PoolAllocator::Alloc(int numBytes, int numPerChunk) {
+    o_assert_dbg((numBytes > 0) && (numPerChunk > 0));
+    if (numBytes > MaxPoolSize) {
+        return Memory::Alloc(numBytes);
+    }
+    const int sc = sizeClassIndex(numBytes);
+    threadCache* cache = getThreadCache();
+    if (nullptr == cache->freeList[sc]) {
+        refill(cache, sc, numPerChunk);
+    }
+    node* n = cache->freeList[sc];
+    cache->freeList[sc] = n->next;
+    cache->num[sc]--;
+    #if ORYOL_ALLOCATOR_DEBUG || ORYOL_UNITTESTS
+    Memory::Fill(n, numBytes, ORYOL_MEMORY_DEBUG_BYTE);
+    #endif
+    return n;
+}
+
+//------------------------------------------------------------------------------
+void
+PoolAllocator::Free(void* ptr, int numBytes) {
+    if (nullptr == ptr) {
+        return;
+    }
+    if (numBytes > MaxPoolSize) {
+        Memory::Free(ptr);
+        return;
+    }
+    const int sc = sizeClassIndex(numBytes);
+    threadCache* cache = getThreadCache();
+    node* n = (node*) ptr;
+    n->next = cache->freeList[sc];
+    cache->freeList[sc] = n;
+    if (++cache->num[sc] > maxCached) {
+        release(cache, sc, transferBatch);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+PoolAllocator::FlushThreadCache() {
+    threadCache* cache = curCache;
+    if (cache) {
+        setExitCallback(nullptr);
+        flushCache(cache);
+    }
+}
+
+} // namespace Oryol
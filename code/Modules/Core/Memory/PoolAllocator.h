@@ -0,0 +1,58 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::PoolAllocator
+    @ingroup Core
+    @brief thread-aware small-object allocator with size-class free lists
+
+    The PoolAllocator hands out memory for small objects from free lists,
+    one per size class (object sizes rounded up to ORYOL_MAX_PLATFORM_ALIGN,
+    up to PoolAllocator::MaxPoolSize bytes, larger objects go through
+    Memory::Alloc).
+
+    Each thread has a small cache of free objects per size class, so that
+    allocation and freeing usually doesn't need to lock. If a thread's
+    cache runs empty it is refilled from the shared free list, or from
+    a new chunk of objects, and if it overflows (e.g. because objects
+    are created on one thread and released on another), half of the
+    cached objects are handed back to the shared free list.
+
+    Core::LeaveThread() and Core::Discard() flush the current thread's
+    cache back to the shared free lists, threads which exit without
+    doing this flush their cache in a thread-exit callback.
+
+    Pool memory is never returned to the allocator backend.
+
+    The OryolClassPoolAllocDecl() macro uses the PoolAllocator for
+    the Create() method of RefCounted classes.
+*/
+#include "Core/Types.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+class PoolAllocator {
+public:
+    /// objects larger than this are allocated through Memory::Alloc
+    static const int MaxPoolSize = 1024;
+
+    /// allocate memory for an object, numPerChunk objects are allocated at once if pool is empty
+    static void* Alloc(int numBytes, int numPerChunk);
+    /// free object memory, numBytes must be the same as in Alloc()
+    static void Free(void* ptr, int numBytes);
+    /// return free objects cached by the current thread to the shared pools
+    static void FlushThreadCache();
+
+    /// create a new object from the pool
+    template<class TYPE, int NUMPERCHUNK, typename... ARGS> static TYPE* New(ARGS&&... args) {
+        TYPE* ptr = (TYPE*) PoolAllocator::Alloc(sizeof(TYPE), NUMPERCHUNK);
+        return new(ptr) TYPE(std::forward<ARGS>(args)...);
+    };
+    /// destroy an object created with PoolAllocator::New()
+    template<class TYPE> static void Delete(TYPE* ptr) {
+        ptr->~TYPE();
+        PoolAllocator::Free(ptr, sizeof(TYPE));
+    };
+};
+
+} // namespace Oryol
@@ -13,6 +13,7 @@
 #include <type_traits>
 #include "Core/Types.h"
 #include "Core/Assertion.h"
+#include "Core/TypeTraits.h"
 
 namespace Oryol {
 
@@ -194,4 +195,7 @@ private:
     };
 };
 
+/// Ptr only holds a pointer and can be relocated with a memory copy
+template<class T> struct IsTriviallyRelocatable<Ptr<T>> : std::true_type { };
+
 } // namespace oryol
@@ -8,7 +8,7 @@
 
 namespace Oryol {
 
-const char* String::emptyString = "";
+static_assert(sizeof(String) == String::MaxLocalLength + 2, "String: unexpected object size");
 
 //------------------------------------------------------------------------------
 String::String(const StringAtom& str) {
@@ -22,16 +22,13 @@ String::String(const char* str) {
         this->create(str, int(std::strlen(str)));
     }
     else {
-        this->data = nullptr;
-        this->strPtr = nullptr;
+        this->setEmpty();
     }
 }
 
 //------------------------------------------------------------------------------
-String::String() :
-data(nullptr),
-strPtr(nullptr) {
-    // empty
+String::String() {
+    this->setEmpty();
 }
 
 //------------------------------------------------------------------------------
@@ -89,26 +86,55 @@ String::AsStringAtom() const {
     return StringAtom(this->AsCStr());;
 }
 
+//------------------------------------------------------------------------------
+void
+String::setEmpty() {
+    this->local[0] = 0;
+    this->local[localSize - 1] = 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+String::isLocal() const {
+    return heapTag != uint8_t(this->local[localSize - 1]);
+}
+
+//------------------------------------------------------------------------------
+bool
+String::sharesData(const String& rhs) const {
+    return !this->isLocal() && !rhs.isLocal() && (this->heap.data == rhs.heap.data);
+}
+
+//------------------------------------------------------------------------------
+void
+String::copy(const String& rhs) {
+    // copies the local characters, or the pointers to the shared data
+    Memory::Copy(rhs.local, this->local, localSize);
+    if (!this->isLocal()) {
+        this->addRef();
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 String::destroy() {
-    o_assert(0 != this->data);
-    o_assert(0 == this->data->refCount);
-    this->data->~StringData();
-    Memory::Free(this->data);
-    this->data = nullptr;
-    this->strPtr = nullptr;
+    o_assert(!this->isLocal());
+    o_assert(0 == this->heap.data->refCount);
+    this->heap.data->~StringData();
+    Memory::Free(this->heap.data);
+    this->setEmpty();
 }
 
 //------------------------------------------------------------------------------
 void
 String::alloc(int len) {
-    o_assert(len > 0);
-    this->data = (StringData*) Memory::Alloc(sizeof(StringData) + len + 1);
-    new(this->data) StringData();
+    o_assert(len > MaxLocalLength);
+    this->heap.data = (StringData*) Memory::Alloc(sizeof(StringData) + len + 1);
+    new(this->heap.data) StringData();
+    this->local[localSize - 1] = char(heapTag);
     this->addRef();
-    this->data->length = len;
-    this->strPtr = (const char*) &(this->data[1]);
+    this->heap.data->length = len;
+    this->heap.strPtr = (const char*) &(this->heap.data[1]);
 }
 
 //------------------------------------------------------------------------------
@@ -116,43 +142,50 @@ void
 String::create(const char* ptr, int len) {
     o_assert(0 != ptr);
     if ((ptr[0] != 0) && (len > 0)) {
-        this->alloc(len);
-        Memory::Copy(ptr, (void*)this->strPtr, len);
-        ((char*)this->strPtr)[len] = 0;
+        char* dst;
+        if (len <= MaxLocalLength) {
+            // short string, store in the String object
+            dst = this->local;
+            this->local[localSize - 1] = char(len);
+        }
+        else {
+            this->alloc(len);
+            dst = (char*) this->heap.strPtr;
+        }
+        Memory::Copy(ptr, dst, len);
+        dst[len] = 0;
     }
     else {
-        // empty string, don't bother to allocate storage for this
-        this->data = nullptr;
-        this->strPtr = nullptr;
+        // empty string
+        this->setEmpty();
     }
 }
 
 //------------------------------------------------------------------------------
 void
 String::addRef() {
-    o_assert(nullptr != this->data);
+    o_assert(!this->isLocal());
     #if ORYOL_HAS_ATOMIC
-    this->data->refCount.fetch_add(1, std::memory_order_relaxed);
+    this->heap.data->refCount.fetch_add(1, std::memory_order_relaxed);
     #else
-    this->data->refCount++;
+    this->heap.data->refCount++;
     #endif
 }
 
 //------------------------------------------------------------------------------
 void
 String::release() {
-    if (nullptr != this->data) {
+    if (!this->isLocal()) {
         #if ORYOL_HAS_ATOMIC
-        if (1 == this->data->refCount.fetch_sub(1, std::memory_order_relaxed)) {
+        if (1 == this->heap.data->refCount.fetch_sub(1, std::memory_order_relaxed)) {
         #else
-        if (1 == this->data->refCount--) {
+        if (1 == this->heap.data->refCount--) {
         #endif
             // no more owners, destroy the shared string data
             this->destroy();
         }
-        this->data = nullptr;
-        this->strPtr = nullptr;
     }
+    this->setEmpty();
 }
 
 //------------------------------------------------------------------------------
@@ -173,19 +206,13 @@ String::Assign(const String& rhs, int startIndex, int endIndex) {
     
 //------------------------------------------------------------------------------
 String::String(const String& rhs) {
-    this->data = rhs.data;
-    this->strPtr = rhs.strPtr;
-    if (nullptr != this->data) {
-        this->addRef();
-    }
+    this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
 String::String(String&& rhs) {
-    this->data = rhs.data;
-    this->strPtr = rhs.strPtr;
-    rhs.data = 0;
-    rhs.strPtr = 0;
+    Memory::Copy(rhs.local, this->local, localSize);
+    rhs.setEmpty();
 }
 
 //------------------------------------------------------------------------------
@@ -207,11 +234,7 @@ void
 String::operator=(const String& rhs) {
     if (this != &rhs) {
         this->release();
-        this->data = rhs.data;
-        this->strPtr = rhs.strPtr;
-        if (nullptr != this->data) {
-            this->addRef();
-        }
+        this->copy(rhs);
     }
 }
 
@@ -220,22 +243,17 @@ void
 String::operator=(String&& rhs) {
     if (this != &rhs) {
         this->release();
-        this->data = rhs.data;
-        this->strPtr = rhs.strPtr;
-        rhs.data = 0;
-        rhs.strPtr = 0;
+        Memory::Copy(rhs.local, this->local, localSize);
+        rhs.setEmpty();
     }
 }
 
 //------------------------------------------------------------------------------
 bool
 String::operator==(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (this->sharesData(rhs)) {
         return true;
     }
-    else if ((nullptr == this->data) || (nullptr == rhs.data)) {
-        return false;
-    }
     else {
         return std::strcmp(this->AsCStr(), rhs.AsCStr()) == 0;
     }
@@ -250,7 +268,7 @@ String::operator!=(const String& rhs) const {
 //------------------------------------------------------------------------------
 bool
 String::operator<(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (this->sharesData(rhs)) {
         return false;
     }
     else {
@@ -261,7 +279,7 @@ String::operator<(const String& rhs) const {
 //------------------------------------------------------------------------------
 bool
 String::operator>(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (this->sharesData(rhs)) {
         return false;
     }
     else {
@@ -272,7 +290,7 @@ String::operator>(const String& rhs) const {
 //------------------------------------------------------------------------------
 bool
 String::operator<=(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (this->sharesData(rhs)) {
         return true;
     }
     else {
@@ -283,7 +301,7 @@ String::operator<=(const String& rhs) const {
 //------------------------------------------------------------------------------
 bool
 String::operator>=(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (this->sharesData(rhs)) {
         return true;
     }
     else {
@@ -294,22 +312,22 @@ String::operator>=(const String& rhs) const {
 //------------------------------------------------------------------------------
 int
 String::Length() const {
-    if (nullptr == this->data) {
-        return 0;
+    if (this->isLocal()) {
+        return uint8_t(this->local[localSize - 1]);
     }
     else {
-        return this->data->length;
+        return this->heap.data->length;
     }
 }
 
 //------------------------------------------------------------------------------
 const char*
 String::AsCStr() const {
-    if (nullptr == this->strPtr) {
-        return emptyString;
+    if (this->isLocal()) {
+        return this->local;
     }
     else {
-        return this->strPtr;
+        return this->heap.strPtr;
     }
 }
 
@@ -334,19 +352,20 @@ String::Clear() {
 //------------------------------------------------------------------------------
 int
 String::RefCount() const {
-    if (nullptr == this->data) {
-        return 0;
+    if (this->isLocal()) {
+        return this->Empty() ? 0 : 1;
     }
     else {
-        return this->data->refCount;
+        return this->heap.data->refCount;
     }
 }
 
 //------------------------------------------------------------------------------
 char
 String::Back() const {
-    if (this->strPtr) {
-        return this->strPtr[this->data->length - 1];
+    const int len = this->Length();
+    if (len > 0) {
+        return this->AsCStr()[len - 1];
     }
     else {
         return 0;
@@ -356,12 +375,7 @@ String::Back() const {
 //------------------------------------------------------------------------------
 char
 String::Front() const {
-    if (this->strPtr) {
-        return this->strPtr[0];
-    }
-    else {
-        return 0;
-    }
+    return this->AsCStr()[0];
 }
 
 //------------------------------------------------------------------------------
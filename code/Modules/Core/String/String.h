@@ -11,6 +11,11 @@
     only a pointer to the original string data is copied, and a 
     refcount is maintained. The last String pointing to the string
     data frees the string data.
+
+    Short strings (up to String::MaxLocalLength bytes) are stored
+    inside the String object itself, creating, copying and destroying
+    them never allocates and doesn't touch a refcount. Such strings are
+    not shared, each copy has its own character data.
     
     To manipulate string data, use the StringUtil class.
     
@@ -30,6 +35,8 @@
 #endif
 #include "Core/Types.h"
 #include "Core/Assertion.h"
+#include "Core/TypeTraits.h"
+#include "Core/Hash.h"
 
 namespace Oryol {
 
@@ -37,15 +44,18 @@ class StringAtom;
 
 class String {
 public:
+    /// max length of strings which are stored inside the String object
+    static const int MaxLocalLength = 22;
+
     /// default constructor
     String();
-    /// construct from C string (allocates!)
+    /// construct from C string (allocates for long strings!)
     String(const char* cstr);
     /// construct from raw byte sequence, endIndex can be EndOfString
     String(const char* ptr, int startIndex, int endIndex);
     /// construct from substring of other string, endIndex can be EndOfString
     String(const String& rhs, int startIndex, int endIndex);
-    /// construct from StringAtom (allocates!)
+    /// construct from StringAtom (allocates for long strings!)
     String(const StringAtom& str);
     
     /// copy constructor (does not allocate)
@@ -56,9 +66,9 @@ public:
     /// destructor
     ~String();
     
-    /// assign from C string (allocates!)
+    /// assign from C string (allocates for long strings!)
     void operator=(const char* cstr);
-    /// assign from StringAtom (allocates!)
+    /// assign from StringAtom (allocates for long strings!)
     void operator=(const StringAtom& str);
     /// copy-assign from other String (does not allocate)
     void operator=(const String& rhs);
@@ -99,7 +109,7 @@ public:
     bool Empty() const;
     /// clear content
     void Clear();
-    /// get the refcount of this string
+    /// get the refcount of this string (short strings are never shared, and return 1)
     int RefCount() const;
     
 private:
@@ -113,7 +123,17 @@ private:
         int length;
     };
     
-    /// create new string data block, numBytes does not include the terminating 0
+    /// pointers to the shared string data of long strings
+    struct heapString {
+        StringData* data;
+        const char* strPtr;     // direct pointer to string data, necessary to see something in the debugger
+    };
+    /// size of the String object, the last byte is the local string length or heapTag
+    static const int localSize = MaxLocalLength + 2;
+    /// the value of the last byte if the string data is on the heap
+    static const uint8_t heapTag = 0xFF;
+
+    /// create new string data, numBytes does not include the terminating 0
     void create(const char* ptr, int len);
     /// private alloc function for len
     void alloc(int len);
@@ -123,10 +143,30 @@ private:
     void addRef();
     /// decrement refcount, call destroy if 0
     void release();
-    
-    StringData* data;
-    const char* strPtr;     // direct pointer to string data, necessary to see something in the debugger
-    static const char* emptyString;
+    /// set to the empty string (does not release)
+    void setEmpty();
+    /// return true if the string is stored in the String object
+    bool isLocal() const;
+    /// return true if both strings point to the same shared string data
+    bool sharesData(const String& rhs) const;
+    /// copy from other string, shares the string data of long strings (does not release)
+    void copy(const String& rhs);
+
+    union {
+        heapString heap;
+        char local[localSize];
+    };
+};
+
+/// String holds inline characters or a pointer to shared data (never a pointer
+/// to itself) and can be relocated with a memory copy
+template<> struct IsTriviallyRelocatable<String> : std::true_type { };
+
+/// hash function for String keys
+template<> struct Hash<String> {
+    uint32_t operator()(const String& str) const {
+        return HashBytes(str.AsCStr(), str.Length());
+    };
 };
 
 //------------------------------------------------------------------------------
@@ -6,12 +6,25 @@
     @brief immutable, unique strings for fast comparison
     
     A unique string, relatively slow on creation, but fast for comparison.
-    String atoms are stored in thread-local stringAtomTables and comparison
-    is fastest in the creator thread.
+    String atoms are stored in a single process-wide table, so atoms
+    created on any thread compare (and copy) with a simple pointer
+    operation everywhere. Lookups in the table are lock-free, adding a
+    new string only locks one of the table's shards.
+
+    For string literals, use the o_atom() macro instead of constructing
+    a StringAtom: the hash is computed at compile time, and the string
+    is interned only once, on first use, into a function-local static
+    StringAtom, which is returned by reference:
+
+    @code
+    setup.AddTexture(o_atom("tex"), ...);
+    @endcode
     
     @see String
 */
 #include "Core/Types.h"
+#include "Core/TypeTraits.h"
+#include "Core/Hash.h"
 #include "Core/String/stringAtomTable.h"
 
 namespace Oryol {
@@ -28,7 +41,9 @@ public:
     StringAtom(const char* str);
     /// construct from raw string (slow)
     StringAtom(const unsigned char* str);
-    /// copy-constructor (fast if rhs was created in same thread)
+    /// construct from raw string with precomputed hash (see o_atom())
+    StringAtom(const char* str, uint64_t hash);
+    /// copy-constructor
     StringAtom(const StringAtom& rhs);
     /// move-constructor
     StringAtom(StringAtom&& rhs);
@@ -76,19 +91,38 @@ public:
     int Length() const;
     /// get contained C-string (static lifetime)
     const char* AsCStr() const;
+    /// get the string's hash value (FAST)
+    uint32_t HashValue() const;
     /// get String (slow because string object must be constructed)
     String AsString() const;
 
 private:
-    /// copy content
-    void copy(const StringAtom& rhs);
     /// setup from C string
     void setupFromCString(const char* str);
+    /// setup from C string with precomputed hash
+    void setupFromCString(const char* str, uint64_t hash);
     
     const stringAtomBuffer::Header* data;
     static const char* emptyString;
 };
 
+/// StringAtom from a non-empty string literal, hashed at compile time and interned on first use
+#define o_atom(str) ([]() -> const Oryol::StringAtom& {\
+    static_assert(sizeof(str) > 1, "o_atom() needs a non-empty string literal");\
+    static const Oryol::StringAtom atom(str, std::integral_constant<uint64_t, Oryol::HashLiteral64(str)>::value);\
+    return atom;\
+}())
+
+/// StringAtom only holds a pointer and can be relocated with a memory copy
+template<> struct IsTriviallyRelocatable<StringAtom> : std::true_type { };
+
+/// hash function for StringAtom keys
+template<> struct Hash<StringAtom> {
+    uint32_t operator()(const StringAtom& atom) const {
+        return atom.HashValue();
+    };
+};
+
 //------------------------------------------------------------------------------
 inline void
 StringAtom::Clear() {
@@ -116,14 +150,15 @@ StringAtom::StringAtom(const unsigned char* rhs) {
 
 //------------------------------------------------------------------------------
 inline
-StringAtom::StringAtom(const StringAtom& rhs) {
-    this->copy(rhs);
+StringAtom::StringAtom(const StringAtom& rhs) :
+data(rhs.data) {
+    // empty
 }
 
 //------------------------------------------------------------------------------
 inline
-StringAtom::StringAtom(StringAtom&& rhs) {
-    this->copy(rhs);
+StringAtom::StringAtom(StringAtom&& rhs) :
+data(rhs.data) {
     rhs.data = nullptr;
 }
 
@@ -136,18 +171,14 @@ StringAtom::~StringAtom() {
 //------------------------------------------------------------------------------
 inline void
 StringAtom::operator=(const StringAtom& rhs) {
-    if (&rhs != this) {
-        this->Clear();
-        this->copy(rhs);
-    }
+    this->data = rhs.data;
 }
 
 //------------------------------------------------------------------------------
 inline void
 StringAtom::operator=(StringAtom&& rhs) {
     if (&rhs != this) {
-        this->Clear();
-        this->copy(rhs);
+        this->data = rhs.data;
         rhs.data = nullptr;
     }
 }
@@ -166,19 +197,21 @@ StringAtom::operator=(const unsigned char* rhs) {
     this->setupFromCString((const char*)rhs);
 }
 
+//------------------------------------------------------------------------------
+inline bool
+StringAtom::operator==(const StringAtom& rhs) const {
+    return this->data == rhs.data;
+}
+
 //------------------------------------------------------------------------------
 inline bool
 StringAtom::operator!=(const StringAtom& rhs) const {
-    return !operator==(rhs);
+    return this->data != rhs.data;
 }
 
 //------------------------------------------------------------------------------
 inline bool
 StringAtom::operator<(const StringAtom& rhs) const {
-    if (rhs.data && this->data) {
-        // it is forbidden to compare string from different threads!
-        o_assert(this->data->table == rhs.data->table);
-    }
     return this->data < rhs.data;
 }
 
@@ -228,4 +261,15 @@ StringAtom::AsCStr() const {
     }
 }
 
+//------------------------------------------------------------------------------
+inline uint32_t
+StringAtom::HashValue() const {
+    if (nullptr != this->data) {
+        return uint32_t(this->data->hash);
+    }
+    else {
+        return 0;
+    }
+}
+
 } // namespace Oryol
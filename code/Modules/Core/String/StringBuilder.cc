@@ -6,6 +6,8 @@
 #include <cstdio>
 #include "StringBuilder.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/FrameArena.h"
+#include "numberConverter.h"
 
 #if ORYOL_WINDOWS
 #define o_strtok strtok_s
@@ -19,7 +21,8 @@ namespace Oryol {
 StringBuilder::StringBuilder() :
 buffer(0),
 capacity(0),
-size(0) {
+size(0),
+frameArena(false) {
     // empty
 }
 
@@ -61,7 +64,7 @@ StringBuilder() {
 
 //------------------------------------------------------------------------------
 StringBuilder::~StringBuilder() {
-    if (0 != this->buffer) {
+    if ((0 != this->buffer) && !this->frameArena) {
         Memory::Free(this->buffer);
     }
     this->buffer = 0;
@@ -81,7 +84,13 @@ StringBuilder::ensureRoom(int numBytes) {
         // need to make room
         int growBy = (numBytes < minGrowSize) ? minGrowSize : numBytes;
         const int newCapacity = this->capacity + growBy;
-        char* newBuffer = (char*) Memory::Alloc(newCapacity);
+        char* newBuffer = nullptr;
+        if (this->frameArena) {
+            newBuffer = (char*) FrameArena::Alloc(newCapacity);
+        }
+        else {
+            newBuffer = (char*) Memory::Alloc(newCapacity);
+        }
         if (this->buffer) {
             // copy over old content and free old buffer
             #if ORYOL_WINDOWS
@@ -90,7 +99,9 @@ StringBuilder::ensureRoom(int numBytes) {
             #else
             std::strcpy(newBuffer, this->buffer);
             #endif
-            Memory::Free(this->buffer);
+            if (!this->frameArena) {
+                Memory::Free(this->buffer);
+            }
             this->buffer = 0;
         }
         else {
@@ -101,6 +112,20 @@ StringBuilder::ensureRoom(int numBytes) {
     }
 }
 
+//------------------------------------------------------------------------------
+void
+StringBuilder::UseFrameArena() {
+    o_assert_dbg(0 == this->buffer);
+    o_assert_dbg(FrameArena::IsValid());
+    this->frameArena = true;
+}
+
+//------------------------------------------------------------------------------
+bool
+StringBuilder::IsFrameArena() const {
+    return this->frameArena;
+}
+
 //------------------------------------------------------------------------------
 void
 StringBuilder::Reserve(int numBytes) {
@@ -272,6 +297,39 @@ StringBuilder::Append(char delim, std::initializer_list<String> list) {
     this->PopBack();
 }
 
+//------------------------------------------------------------------------------
+void
+StringBuilder::AppendInt(int64_t val) {
+    this->ensureRoom(numberConverter::MaxIntChars);
+    this->size += numberConverter::IntToChars(val, this->buffer + this->size);
+    this->buffer[this->size] = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+StringBuilder::AppendUInt(uint64_t val) {
+    this->ensureRoom(numberConverter::MaxIntChars);
+    this->size += numberConverter::UIntToChars(val, this->buffer + this->size);
+    this->buffer[this->size] = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+StringBuilder::AppendFloat(float val) {
+    this->ensureRoom(numberConverter::MaxFloatChars);
+    this->size += numberConverter::FloatToChars(val, this->buffer + this->size);
+    this->buffer[this->size] = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+StringBuilder::AppendFloat(float val, int numDecimals) {
+    o_assert_range(numDecimals, numberConverter::MaxDecimals + 1);
+    this->ensureRoom(numberConverter::MaxFixedChars);
+    this->size += numberConverter::FloatToCharsFixed(val, numDecimals, this->buffer + this->size);
+    this->buffer[this->size] = 0;
+}
+
 //------------------------------------------------------------------------------
 void
 StringBuilder::Set(char delim, std::initializer_list<String> list) {
@@ -8,6 +8,11 @@
     Use the StringBuilder methods to build, manipulate and inspect
     string data. Internally a StringBuilder object has a dynamic
     buffer which grows as needed, but never shrinks.
+
+    Call UseFrameArena() on an empty StringBuilder to allocate the
+    buffer from the thread's FrameArena (for transient per-frame
+    strings), the StringBuilder must not be used after the end
+    of the frame.
 */
 #include "Core/Types.h"
 #include "Core/String/String.h"
@@ -34,6 +39,10 @@ public:
     /// destructor
     ~StringBuilder();
     
+    /// allocate from the thread's FrameArena (buffer must not have been allocated yet)
+    void UseFrameArena();
+    /// return true if the buffer is allocated from the FrameArena
+    bool IsFrameArena() const;
     /// reserve space (numBytes excludes the terminating 0 byte)
     void Reserve(int numBytes);
     /// get capacity
@@ -85,6 +94,14 @@ public:
     void Append(std::initializer_list<String> list);
     /// append a list of strings with delimiter
     void Append(char delim, std::initializer_list<String> list);
+    /// append a signed integer (faster than AppendFormat("%d"))
+    void AppendInt(int64_t val);
+    /// append an unsigned integer
+    void AppendUInt(uint64_t val);
+    /// append the shortest string which parses back to the same float
+    void AppendFloat(float val);
+    /// append a float with a fixed number of decimals (0..9), same result as AppendFormat("%.*f")
+    void AppendFloat(float val, int numDecimals);
     
     /// substitute all occurrences of a string, return number of substitutions
     int SubstituteAll(const char* match, const char* subst);
@@ -160,6 +177,7 @@ private:
     char* buffer;
     int capacity;
     int size;
+    bool frameArena;
 };
     
 } // namespace Oryol
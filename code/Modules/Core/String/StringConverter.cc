@@ -5,7 +5,7 @@
 #include "Core/Assertion.h"
 #include "StringConverter.h"
 #include "ConvertUTF.h"
-#include <cstdlib>
+#include "numberConverter.h"
 #include <cstring>
 #include <cwchar>
 
@@ -185,56 +185,70 @@ StringConverter::UTF8ToWide(const String& src) {
 template<> int8_t
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (int8_t) std::atoi(str);
+    return (int8_t) numberConverter::ParseInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> uint8_t
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (uint8_t) std::atoi(str);
+    return (uint8_t) numberConverter::ParseInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> int16_t
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (int16_t) std::atoi(str);
+    return (int16_t) numberConverter::ParseInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> uint16_t
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (uint16_t) std::atoi(str);
+    return (uint16_t) numberConverter::ParseInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> int
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (int) std::atoi(str);
+    return (int) numberConverter::ParseInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> uint32_t
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (uint32_t) std::atoi(str);
+    return (uint32_t) numberConverter::ParseInt(str);
+}
+
+//------------------------------------------------------------------------------
+template<> int64_t
+StringConverter::FromString(const char* str) {
+    o_assert_dbg(str);
+    return numberConverter::ParseInt(str);
+}
+
+//------------------------------------------------------------------------------
+template<> uint64_t
+StringConverter::FromString(const char* str) {
+    o_assert_dbg(str);
+    return numberConverter::ParseUInt(str);
 }
 
 //------------------------------------------------------------------------------
 template<> float
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return (float) std::atof(str);
+    return numberConverter::ParseFloat(str);
 }
 
 //------------------------------------------------------------------------------
 template<> double
 StringConverter::FromString(const char* str) {
     o_assert_dbg(str);
-    return std::atof(str);
+    return numberConverter::ParseDouble(str);
 }
 
 } // namespace Oryol
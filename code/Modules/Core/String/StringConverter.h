@@ -8,6 +8,10 @@
     and from and to simple types (int, float, ...). Please note that
     wchar_t is 2 bytes (UTF-16) on Windows, but 4 bytes (UTF-32) 
     on other UNIX-like platforms!
+
+    FromString() for ints and floats doesn't depend on the locale (rare
+    inputs fall back to strtod() in the "C" locale), and is much faster
+    than std::atoi()/std::atof() for common inputs.
 */
 #include "Core/Types.h"
 #include "Core/Containers/Array.h"
@@ -25,7 +29,7 @@ public:
     template<class TYPE> static TYPE FromString(const String& str);
     /// convert a string to simple type
     template<class TYPE> static TYPE FromString(const StringAtom& str);
-    // (NOTE: 'ToString' methods should go into StringBuilder as Append<TYPE>()
+    // (NOTE: 'ToString' methods are in StringBuilder: AppendInt(), AppendUInt(), AppendFloat())
     
     /// convert raw UTF8 string range to raw wide string
     static int UTF8ToWide(const unsigned char* src, int srcNumBytes, wchar_t* dst, int dstMaxBytes);
@@ -0,0 +1,738 @@
+//------------------------------------------------------------------------------
+//  numberConverter.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "numberConverter.h"
+#include "Core/Assertion.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#if ORYOL_WINDOWS
+#include <locale.h>
+#elif ORYOL_OSX
+#include <xlocale.h>
+#elif ORYOL_LINUX
+#include <locale.h>
+#endif
+
+namespace Oryol {
+
+namespace {
+
+/// the 2-digit strings for 00..99
+const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/// exactly representable powers of 10
+const double pow10Double[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const float pow10Float[11] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+const uint64_t pow10UInt[numberConverter::MaxDecimals + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+/// Ryu tables for floats: 5^-i and 5^i with 59 and 61 significant bits
+const int floatPow5InvBitCount = 59;
+const uint64_t floatPow5InvSplit[31] = {
+    576460752303423489ULL, 461168601842738791ULL, 368934881474191033ULL,
+    295147905179352826ULL, 472236648286964522ULL, 377789318629571618ULL,
+    302231454903657294ULL, 483570327845851670ULL, 386856262276681336ULL,
+    309485009821345069ULL, 495176015714152110ULL, 396140812571321688ULL,
+    316912650057057351ULL, 507060240091291761ULL, 405648192073033409ULL,
+    324518553658426727ULL, 519229685853482763ULL, 415383748682786211ULL,
+    332306998946228969ULL, 531691198313966350ULL, 425352958651173080ULL,
+    340282366920938464ULL, 544451787073501542ULL, 435561429658801234ULL,
+    348449143727040987ULL, 557518629963265579ULL, 446014903970612463ULL,
+    356811923176489971ULL, 570899077082383953ULL, 456719261665907162ULL,
+    365375409332725730ULL,
+};
+const int floatPow5BitCount = 61;
+const uint64_t floatPow5Split[48] = {
+    1152921504606846976ULL, 1441151880758558720ULL, 1801439850948198400ULL,
+    2251799813685248000ULL, 1407374883553280000ULL, 1759218604441600000ULL,
+    2199023255552000000ULL, 1374389534720000000ULL, 1717986918400000000ULL,
+    2147483648000000000ULL, 1342177280000000000ULL, 1677721600000000000ULL,
+    2097152000000000000ULL, 1310720000000000000ULL, 1638400000000000000ULL,
+    2048000000000000000ULL, 1280000000000000000ULL, 1600000000000000000ULL,
+    2000000000000000000ULL, 1250000000000000000ULL, 1562500000000000000ULL,
+    1953125000000000000ULL, 1220703125000000000ULL, 1525878906250000000ULL,
+    1907348632812500000ULL, 1192092895507812500ULL, 1490116119384765625ULL,
+    1862645149230957031ULL, 1164153218269348144ULL, 1455191522836685180ULL,
+    1818989403545856475ULL, 2273736754432320594ULL, 1421085471520200371ULL,
+    1776356839400250464ULL, 2220446049250313080ULL, 1387778780781445675ULL,
+    1734723475976807094ULL, 2168404344971008868ULL, 1355252715606880542ULL,
+    1694065894508600678ULL, 2117582368135750847ULL, 1323488980084844279ULL,
+    1654361225106055349ULL, 2067951531382569187ULL, 1292469707114105741ULL,
+    1615587133892632177ULL, 2019483917365790221ULL, 1262177448353618888ULL,
+};
+
+//------------------------------------------------------------------------------
+inline bool
+isDigit(char c) {
+    return (c >= '0') && (c <= '9');
+}
+
+//------------------------------------------------------------------------------
+inline bool
+isSpace(char c) {
+    return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
+//------------------------------------------------------------------------------
+/// number of bits of 5^e (for 0 <= e <= 3528)
+inline int32_t
+pow5Bits(int32_t e) {
+    return int32_t(((uint32_t(e) * 1217359) >> 19) + 1);
+}
+
+//------------------------------------------------------------------------------
+/// floor(log10(2^e)) (for 0 <= e <= 1650)
+inline uint32_t
+log10Pow2(int32_t e) {
+    return (uint32_t(e) * 78913) >> 18;
+}
+
+//------------------------------------------------------------------------------
+/// floor(log10(5^e)) (for 0 <= e <= 2620)
+inline uint32_t
+log10Pow5(int32_t e) {
+    return (uint32_t(e) * 732923) >> 20;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+multipleOfPowerOf5(uint32_t val, uint32_t p) {
+    uint32_t count = 0;
+    while ((val > 0) && (0 == (val % 5))) {
+        val /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+multipleOfPowerOf2(uint32_t val, uint32_t p) {
+    return 0 == (val & ((1u << p) - 1));
+}
+
+//------------------------------------------------------------------------------
+inline uint32_t
+mulShift(uint32_t m, uint64_t factor, int32_t shift) {
+    o_assert_dbg(shift > 32);
+    const uint64_t bits0 = uint64_t(m) * uint32_t(factor);
+    const uint64_t bits1 = uint64_t(m) * uint32_t(factor >> 32);
+    const uint64_t sum = (bits0 >> 32) + bits1;
+    return uint32_t(sum >> (shift - 32));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Compute the shortest decimal mantissa and exponent for the bits
+    of a finite, non-zero float (Ryu, see https://github.com/ulfjack/ryu).
+*/
+uint32_t
+shortestDecimal(uint32_t ieeeMantissa, uint32_t ieeeExponent, int32_t& outExp10) {
+    int32_t e2;
+    uint32_t m2;
+    if (0 == ieeeExponent) {
+        e2 = 1 - 127 - 23 - 2;
+        m2 = ieeeMantissa;
+    }
+    else {
+        e2 = int32_t(ieeeExponent) - 127 - 23 - 2;
+        m2 = (1u << 23) | ieeeMantissa;
+    }
+    const bool acceptBounds = 0 == (m2 & 1);
+
+    // the interval of valid decimal representations
+    const uint32_t mv = 4 * m2;
+    const uint32_t mp = 4 * m2 + 2;
+    const uint32_t mmShift = ((0 != ieeeMantissa) || (ieeeExponent <= 1)) ? 1 : 0;
+    const uint32_t mm = 4 * m2 - 1 - mmShift;
+
+    // convert to a decimal power base
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    uint32_t lastRemovedDigit = 0;
+    if (e2 >= 0) {
+        const uint32_t q = log10Pow2(e2);
+        e10 = int32_t(q);
+        const int32_t k = floatPow5InvBitCount + pow5Bits(int32_t(q)) - 1;
+        const int32_t i = -e2 + int32_t(q) + k;
+        vr = mulShift(mv, floatPow5InvSplit[q], i);
+        vp = mulShift(mp, floatPow5InvSplit[q], i);
+        vm = mulShift(mm, floatPow5InvSplit[q], i);
+        if ((q != 0) && (((vp - 1) / 10) <= (vm / 10))) {
+            // need to know one removed digit even if not looping below
+            const int32_t l = floatPow5InvBitCount + pow5Bits(int32_t(q - 1)) - 1;
+            lastRemovedDigit = mulShift(mv, floatPow5InvSplit[q - 1], -e2 + int32_t(q) - 1 + l) % 10;
+        }
+        if (q <= 9) {
+            // only one of mp, mv and mm can be a multiple of 5, if any
+            if (0 == (mv % 5)) {
+                vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+            }
+            else if (acceptBounds) {
+                vmIsTrailingZeros = multipleOfPowerOf5(mm, q);
+            }
+            else {
+                vp -= multipleOfPowerOf5(mp, q) ? 1 : 0;
+            }
+        }
+    }
+    else {
+        const uint32_t q = log10Pow5(-e2);
+        e10 = int32_t(q) + e2;
+        const int32_t i = -e2 - int32_t(q);
+        const int32_t k = pow5Bits(i) - floatPow5BitCount;
+        int32_t j = int32_t(q) - k;
+        vr = mulShift(mv, floatPow5Split[i], j);
+        vp = mulShift(mp, floatPow5Split[i], j);
+        vm = mulShift(mm, floatPow5Split[i], j);
+        if ((q != 0) && (((vp - 1) / 10) <= (vm / 10))) {
+            j = int32_t(q) - 1 - (pow5Bits(i + 1) - floatPow5BitCount);
+            lastRemovedDigit = mulShift(mv, floatPow5Split[i + 1], j) % 10;
+        }
+        if (q <= 1) {
+            // mv has at least q trailing 0 bits, mm and mp too (or mp is odd)
+            vrIsTrailingZeros = true;
+            if (acceptBounds) {
+                vmIsTrailingZeros = 1 == mmShift;
+            }
+            else {
+                --vp;
+            }
+        }
+        else if (q < 31) {
+            vrIsTrailingZeros = multipleOfPowerOf2(mv, q - 1);
+        }
+    }
+
+    // find the shortest decimal representation in the interval
+    int32_t removed = 0;
+    uint32_t output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        // general case, which happens rarely
+        while ((vp / 10) > (vm / 10)) {
+            vmIsTrailingZeros &= 0 == (vm % 10);
+            vrIsTrailingZeros &= 0 == lastRemovedDigit;
+            lastRemovedDigit = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vmIsTrailingZeros) {
+            while (0 == (vm % 10)) {
+                vrIsTrailingZeros &= 0 == lastRemovedDigit;
+                lastRemovedDigit = vr % 10;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vrIsTrailingZeros && (5 == lastRemovedDigit) && (0 == (vr % 2))) {
+            // round to even if the exact number is .....50..0
+            lastRemovedDigit = 4;
+        }
+        // take vr + 1 if vr is outside the bounds or need to round up
+        output = vr + ((((vr == vm) && (!acceptBounds || !vmIsTrailingZeros)) || (lastRemovedDigit >= 5)) ? 1 : 0);
+    }
+    else {
+        // common case
+        while ((vp / 10) > (vm / 10)) {
+            lastRemovedDigit = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (((vr == vm) || (lastRemovedDigit >= 5)) ? 1 : 0);
+    }
+    outExp10 = e10 + removed;
+    return output;
+}
+
+//------------------------------------------------------------------------------
+/// write nan or inf, or return 0 if the float is finite
+int
+nonFiniteToChars(uint32_t bits, char* dst) {
+    if (0xFF != ((bits >> 23) & 0xFF)) {
+        return 0;
+    }
+    else if (0 != (bits & ((1u << 23) - 1))) {
+        std::memcpy(dst, "nan", 3);
+        return 3;
+    }
+    else if (0 != (bits >> 31)) {
+        std::memcpy(dst, "-inf", 4);
+        return 4;
+    }
+    else {
+        std::memcpy(dst, "inf", 3);
+        return 3;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// write a big integer-valued float (m2 * 2^e2) exactly
+int
+bigIntToChars(uint32_t m2, int32_t e2, char* dst) {
+    o_assert_dbg((e2 >= 0) && (e2 <= 104));
+    uint32_t limbs[5] = { 0, 0, 0, 0, 0 };
+    const uint64_t shifted = uint64_t(m2) << (e2 % 32);
+    limbs[e2 / 32] = uint32_t(shifted);
+    limbs[(e2 / 32) + 1] = uint32_t(shifted >> 32);
+
+    // split into base 10^9 chunks, least significant first
+    uint32_t chunks[5];
+    int numChunks = 0;
+    int numLimbs = 5;
+    while (numLimbs > 0) {
+        uint64_t rem = 0;
+        for (int i = numLimbs - 1; i >= 0; i--) {
+            const uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = uint32_t(cur / 1000000000);
+            rem = cur % 1000000000;
+        }
+        chunks[numChunks++] = uint32_t(rem);
+        while ((numLimbs > 0) && (0 == limbs[numLimbs - 1])) {
+            numLimbs--;
+        }
+    }
+    char* p = dst + numberConverter::UIntToChars(chunks[numChunks - 1], dst);
+    for (int i = numChunks - 2; i >= 0; i--) {
+        uint32_t chunk = chunks[i];
+        for (int j = 8; j >= 0; j--) {
+            p[j] = char('0' + (chunk % 10));
+            chunk /= 10;
+        }
+        p += 9;
+    }
+    return int(p - dst);
+}
+
+// the slow-path fallback to the C runtime parses in the "C" locale, so
+// that the result doesn't depend on the current locale's decimal point,
+// the Android and emscripten C runtimes always use '.', the "C" locale
+// object is created once and never freed
+#if ORYOL_ANDROID || ORYOL_EMSCRIPTEN
+//------------------------------------------------------------------------------
+double
+cStrToDouble(const char* str) {
+    return std::strtod(str, nullptr);
+}
+
+//------------------------------------------------------------------------------
+float
+cStrToFloat(const char* str) {
+    return std::strtof(str, nullptr);
+}
+#elif ORYOL_WINDOWS
+//------------------------------------------------------------------------------
+_locale_t
+cLocale() {
+    static _locale_t loc = _create_locale(LC_NUMERIC, "C");
+    return loc;
+}
+
+//------------------------------------------------------------------------------
+double
+cStrToDouble(const char* str) {
+    return _strtod_l(str, nullptr, cLocale());
+}
+
+//------------------------------------------------------------------------------
+float
+cStrToFloat(const char* str) {
+    return _strtof_l(str, nullptr, cLocale());
+}
+#else
+//------------------------------------------------------------------------------
+locale_t
+cLocale() {
+    static locale_t loc = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+    return loc;
+}
+
+//------------------------------------------------------------------------------
+double
+cStrToDouble(const char* str) {
+    return strtod_l(str, nullptr, cLocale());
+}
+
+//------------------------------------------------------------------------------
+float
+cStrToFloat(const char* str) {
+    return strtof_l(str, nullptr, cLocale());
+}
+#endif
+
+//------------------------------------------------------------------------------
+/// a parsed decimal number, mantissa * 10^exp10
+struct decimal {
+    uint64_t mantissa = 0;
+    int exp10 = 0;
+    bool negative = false;
+};
+
+//------------------------------------------------------------------------------
+/**
+    Parse a decimal number, returns false if this needs to be handled
+    by the C runtime (no digits, hex-floats, more than 19 significant digits).
+*/
+bool
+parseDecimal(const char* str, decimal& out) {
+    const char* p = str;
+    while (isSpace(*p)) {
+        p++;
+    }
+    if ('-' == *p) {
+        out.negative = true;
+        p++;
+    }
+    else if ('+' == *p) {
+        p++;
+    }
+    if (('0' == p[0]) && (('x' == p[1]) || ('X' == p[1]))) {
+        return false;
+    }
+    const int maxDigits = 19;
+    int numDigits = 0;
+    bool anyDigits = false;
+    while (isDigit(*p)) {
+        anyDigits = true;
+        if (numDigits < maxDigits) {
+            out.mantissa = out.mantissa * 10 + uint64_t(*p - '0');
+            numDigits += (0 != out.mantissa) ? 1 : 0;
+        }
+        else if ('0' == *p) {
+            out.exp10++;
+        }
+        else {
+            return false;
+        }
+        p++;
+    }
+    if ('.' == *p) {
+        p++;
+        while (isDigit(*p)) {
+            anyDigits = true;
+            if (numDigits < maxDigits) {
+                out.mantissa = out.mantissa * 10 + uint64_t(*p - '0');
+                numDigits += (0 != out.mantissa) ? 1 : 0;
+                out.exp10--;
+            }
+            else if ('0' != *p) {
+                return false;
+            }
+            p++;
+        }
+    }
+    if (!anyDigits) {
+        return false;
+    }
+    if (('e' == *p) || ('E' == *p)) {
+        // an exponent without digits is not part of the number
+        const char* e = p + 1;
+        bool negExp = false;
+        if ('-' == *e) {
+            negExp = true;
+            e++;
+        }
+        else if ('+' == *e) {
+            e++;
+        }
+        if (isDigit(*e)) {
+            int exp10 = 0;
+            while (isDigit(*e)) {
+                if (exp10 < 10000) {
+                    exp10 = exp10 * 10 + (*e - '0');
+                }
+                e++;
+            }
+            out.exp10 += negExp ? -exp10 : exp10;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int
+numberConverter::UIntToChars(uint64_t val, char* dst) {
+    // write backwards into a temp buffer, 2 digits at a time
+    char buf[MaxIntChars];
+    char* p = buf + MaxIntChars;
+    while (val >= 100) {
+        const uint32_t pair = uint32_t(val % 100);
+        val /= 100;
+        p -= 2;
+        std::memcpy(p, &digitPairs[pair * 2], 2);
+    }
+    if (val >= 10) {
+        p -= 2;
+        std::memcpy(p, &digitPairs[val * 2], 2);
+    }
+    else {
+        *--p = char('0' + val);
+    }
+    const int len = int((buf + MaxIntChars) - p);
+    std::memcpy(dst, p, len);
+    return len;
+}
+
+//------------------------------------------------------------------------------
+int
+numberConverter::IntToChars(int64_t val, char* dst) {
+    if (val < 0) {
+        dst[0] = '-';
+        return 1 + UIntToChars(0 - uint64_t(val), dst + 1);
+    }
+    else {
+        return UIntToChars(uint64_t(val), dst);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Writes the float in fixed notation if the decimal exponent is
+    between -7 and 21 (like JavaScript's Number.toString()), otherwise
+    in scientific notation (e.g. 1.5e+30).
+*/
+int
+numberConverter::FloatToChars(float val, char* dst) {
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    int len = nonFiniteToChars(bits, dst);
+    if (len > 0) {
+        return len;
+    }
+    char* p = dst;
+    if (0 != (bits >> 31)) {
+        *p++ = '-';
+    }
+    const uint32_t ieeeMantissa = bits & ((1u << 23) - 1);
+    const uint32_t ieeeExponent = (bits >> 23) & 0xFF;
+    if ((0 == ieeeExponent) && (0 == ieeeMantissa)) {
+        *p++ = '0';
+        return int(p - dst);
+    }
+
+    int32_t exp10 = 0;
+    uint32_t output = shortestDecimal(ieeeMantissa, ieeeExponent, exp10);
+    while (0 == (output % 10)) {
+        output /= 10;
+        exp10++;
+    }
+    char digits[MaxIntChars];
+    const int numDigits = UIntToChars(output, digits);
+    const int sciExp = exp10 + numDigits - 1;
+    if ((sciExp > -7) && (sciExp < 21)) {
+        if (exp10 >= 0) {
+            // an integer
+            std::memcpy(p, digits, numDigits);
+            p += numDigits;
+            for (int i = 0; i < exp10; i++) {
+                *p++ = '0';
+            }
+        }
+        else if (sciExp >= 0) {
+            // decimal point within the digits
+            std::memcpy(p, digits, sciExp + 1);
+            p += sciExp + 1;
+            *p++ = '.';
+            std::memcpy(p, digits + sciExp + 1, numDigits - (sciExp + 1));
+            p += numDigits - (sciExp + 1);
+        }
+        else {
+            // leading zeros
+            *p++ = '0';
+            *p++ = '.';
+            for (int i = 0; i < (-sciExp - 1); i++) {
+                *p++ = '0';
+            }
+            std::memcpy(p, digits, numDigits);
+            p += numDigits;
+        }
+    }
+    else {
+        *p++ = digits[0];
+        if (numDigits > 1) {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, numDigits - 1);
+            p += numDigits - 1;
+        }
+        *p++ = 'e';
+        *p++ = (sciExp < 0) ? '-' : '+';
+        p += UIntToChars(uint64_t(sciExp < 0 ? -sciExp : sciExp), p);
+    }
+    return int(p - dst);
+}
+
+//------------------------------------------------------------------------------
+int
+numberConverter::FloatToCharsFixed(float val, int numDecimals, char* dst) {
+    o_assert_dbg((numDecimals >= 0) && (numDecimals <= MaxDecimals));
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    int len = nonFiniteToChars(bits, dst);
+    if (len > 0) {
+        return len;
+    }
+    char* p = dst;
+    if (0 != (bits >> 31)) {
+        *p++ = '-';
+    }
+    // a float has 24 significant bits, and 10^9 = 2^9 * 5^9 with 5^9 < 2^21,
+    // so the scaled value is exact in a double and can be rounded like printf()
+    const double scaled = std::fabs(double(val)) * pow10Double[numDecimals];
+    uint64_t fraction = 0;
+    if (scaled < 9007199254740992.0) {
+        const uint64_t rounded = uint64_t(std::nearbyint(scaled));
+        p += UIntToChars(rounded / pow10UInt[numDecimals], p);
+        fraction = rounded % pow10UInt[numDecimals];
+    }
+    else {
+        // above 2^53 / 10^9 > 2^23 all floats are integers
+        const uint32_t ieeeExponent = (bits >> 23) & 0xFF;
+        const uint32_t m2 = (1u << 23) | (bits & ((1u << 23) - 1));
+        p += bigIntToChars(m2, int32_t(ieeeExponent) - 127 - 23, p);
+    }
+    if (numDecimals > 0) {
+        *p++ = '.';
+        for (int i = numDecimals - 1; i >= 0; i--) {
+            p[i] = char('0' + (fraction % 10));
+            fraction /= 10;
+        }
+        p += numDecimals;
+    }
+    return int(p - dst);
+}
+
+//------------------------------------------------------------------------------
+int64_t
+numberConverter::ParseInt(const char* str) {
+    o_assert_dbg(str);
+    const char* p = str;
+    while (isSpace(*p)) {
+        p++;
+    }
+    bool negative = false;
+    if ('-' == *p) {
+        negative = true;
+        p++;
+    }
+    else if ('+' == *p) {
+        p++;
+    }
+    const uint64_t limit = negative ? (uint64_t(INT64_MAX) + 1) : uint64_t(INT64_MAX);
+    uint64_t val = 0;
+    while (isDigit(*p)) {
+        const uint64_t digit = uint64_t(*p++ - '0');
+        if (val > ((limit - digit) / 10)) {
+            val = limit;
+            break;
+        }
+        val = val * 10 + digit;
+    }
+    return negative ? int64_t(0 - val) : int64_t(val);
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+numberConverter::ParseUInt(const char* str) {
+    o_assert_dbg(str);
+    const char* p = str;
+    while (isSpace(*p)) {
+        p++;
+    }
+    bool negative = false;
+    if ('-' == *p) {
+        negative = true;
+        p++;
+    }
+    else if ('+' == *p) {
+        p++;
+    }
+    uint64_t val = 0;
+    while (isDigit(*p)) {
+        const uint64_t digit = uint64_t(*p++ - '0');
+        if (val > ((UINT64_MAX - digit) / 10)) {
+            return UINT64_MAX;
+        }
+        val = val * 10 + digit;
+    }
+    return negative ? (0 - val) : val;
+}
+
+//------------------------------------------------------------------------------
+double
+numberConverter::ParseDouble(const char* str) {
+    o_assert_dbg(str);
+    decimal dec;
+    if (parseDecimal(str, dec)) {
+        if (0 == dec.mantissa) {
+            return dec.negative ? -0.0 : 0.0;
+        }
+        // mantissa and power of 10 are exact, so a single multiply or divide is correctly rounded
+        if ((dec.mantissa <= (1ULL << 53)) && (dec.exp10 >= -22) && (dec.exp10 <= 22)) {
+            double val = double(dec.mantissa);
+            val = (dec.exp10 < 0) ? (val / pow10Double[-dec.exp10]) : (val * pow10Double[dec.exp10]);
+            return dec.negative ? -val : val;
+        }
+    }
+    return cStrToDouble(str);
+}
+
+//------------------------------------------------------------------------------
+float
+numberConverter::ParseFloat(const char* str) {
+    o_assert_dbg(str);
+    decimal dec;
+    if (parseDecimal(str, dec)) {
+        if (0 == dec.mantissa) {
+            return dec.negative ? -0.0f : 0.0f;
+        }
+        if ((dec.mantissa <= (1ULL << 24)) && (dec.exp10 >= -10) && (dec.exp10 <= 10)) {
+            float val = float(dec.mantissa);
+            val = (dec.exp10 < 0) ? (val / pow10Float[-dec.exp10]) : (val * pow10Float[dec.exp10]);
+            return dec.negative ? -val : val;
+        }
+        if ((dec.mantissa <= (1ULL << 53)) && (dec.exp10 >= -22) && (dec.exp10 <= 22)) {
+            // the correctly rounded double also rounds to the correct float,
+            // unless it is exactly halfway between 2 floats
+            double val = double(dec.mantissa);
+            val = (dec.exp10 < 0) ? (val / pow10Double[-dec.exp10]) : (val * pow10Double[dec.exp10]);
+            const float fval = float(val);
+            if (!std::isinf(fval)) {
+                const float other = std::nextafter(fval, (val > double(fval)) ? HUGE_VALF : -HUGE_VALF);
+                if (val != ((double(fval) + double(other)) * 0.5)) {
+                    return dec.negative ? -fval : fval;
+                }
+            }
+        }
+    }
+    return cStrToFloat(str);
+}
+
+} // namespace Oryol
@@ -0,0 +1,55 @@
+#pragma once
+//------------------------------------------------------------------------------
+/*
+    private class, do not use
+
+    Locale-independent conversion between numbers and strings for
+    StringBuilder and StringConverter, mostly without going through
+    the C runtime's printf/strtod functions:
+
+    - integers are written 2 digits at a time from a digit-pair table
+    - floats are written as the shortest string which parses back to
+      the same float (Ryu algorithm by Ulf Adams, see
+      https://github.com/ulfjack/ryu), or with a fixed number of decimals
+    - parsing has a fast path for the common cases, only very long
+      mantissas, big exponents, hex-floats and inf/nan fall back to
+      strtod() in the "C" locale (strtod_l() or _strtod_l())
+
+    The ToChars functions write to a caller-provided buffer and don't
+    write a terminating 0, they return the number of chars written.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class numberConverter {
+public:
+    /// max number of chars written by IntToChars() and UIntToChars()
+    static const int MaxIntChars = 20;
+    /// max number of chars written by FloatToChars()
+    static const int MaxFloatChars = 24;
+    /// max number of decimals for FloatToCharsFixed()
+    static const int MaxDecimals = 9;
+    /// max number of chars written by FloatToCharsFixed()
+    static const int MaxFixedChars = 40 + MaxDecimals + 2;
+
+    /// write an unsigned integer
+    static int UIntToChars(uint64_t val, char* dst);
+    /// write a signed integer
+    static int IntToChars(int64_t val, char* dst);
+    /// write the shortest representation of a float which parses back to the same value
+    static int FloatToChars(float val, char* dst);
+    /// write a float with a fixed number of decimals (same result as printf's "%.*f")
+    static int FloatToCharsFixed(float val, int numDecimals, char* dst);
+
+    /// parse a signed integer (like std::atoi(), but saturates on overflow)
+    static int64_t ParseInt(const char* str);
+    /// parse an unsigned integer (like std::strtoull())
+    static uint64_t ParseUInt(const char* str);
+    /// parse a double (like std::atof())
+    static double ParseDouble(const char* str);
+    /// parse a float (like std::strtof())
+    static float ParseFloat(const char* str);
+};
+
+} // namespace Oryol
@@ -20,54 +20,50 @@ stringAtomBuffer::~stringAtomBuffer() {
     }
     this->chunks.Clear();
     this->curPointer = 0;
+    this->endPointer = 0;
 }
     
 //------------------------------------------------------------------------------
 void
-stringAtomBuffer::allocChunk() {
+stringAtomBuffer::allocChunk(int minSize) {
     // need to turn off leak detection for the string atom system, since
     // string atom buffer are never released
-    int8_t* newChunk = (int8_t*) Memory::Alloc(this->chunkSize);
+    const int size = (minSize > this->chunkSize) ? minSize : this->chunkSize;
+    int8_t* newChunk = (int8_t*) Memory::Alloc(size);
     this->chunks.Add(newChunk);
     this->curPointer = newChunk;
+    this->endPointer = newChunk + size;
 }
 
 //------------------------------------------------------------------------------
 const stringAtomBuffer::Header*
-stringAtomBuffer::AddString(stringAtomTable* table, int32_t hash, const char* str) {
-    o_assert(nullptr != table);
+stringAtomBuffer::AddString(uint64_t hash, const char* str) {
     o_assert(nullptr != str);
     
-    // no chunks allocated yet?
-    if (0 == this->curPointer) {
-        this->allocChunk();
-    }
-    
     // compute length of new entry (header + string len + 0 terminator byte)
     const int strLen = int(std::strlen(str));
-    size_t requiredSize = strLen + sizeof(Header) + 1;
-    o_assert(requiredSize < this->chunkSize);
+    const int requiredSize = strLen + int(sizeof(Header)) + 1;
     
-    // check if there's enough room in the current chunk
-    if ((this->curPointer + requiredSize) >= (this->chunks.Back() + this->chunkSize)) {
-        this->allocChunk();
+    // check if there's enough room in the current chunk, very long
+    // strings get a chunk of their own
+    if ((this->curPointer + requiredSize) > this->endPointer) {
+        this->allocChunk(requiredSize);
     }
     
     // copy over data
     Header* head = (Header*) this->curPointer;
-    head->table = table;
     head->hash = hash;
     head->length = strLen;
     head->str  = (char*) this->curPointer + sizeof(Header);
-    #if ORYOL_WINDOWS
-    errno_t res = strcpy_s((char*)head->str, strLen + 1, str);
-    o_assert(0 == res);
-    #else
-    std::strcpy((char*)head->str, str);
-    #endif
+    Memory::Copy(str, (char*)head->str, strLen + 1);
 
     // set curPointer to the next aligned position
-    this->curPointer = (int8_t*) Memory::Align(this->curPointer + requiredSize, sizeof(Header));
+    // (not Memory::Align(), which clamps to ORYOL_MAX_PLATFORM_ALIGN, the 64-bit hash needs 8)
+    const intptr_t align = intptr_t(alignof(Header));
+    this->curPointer = (int8_t*) ((intptr_t(this->curPointer) + requiredSize + (align - 1)) & ~(align - 1));
+    if (this->curPointer > this->endPointer) {
+        this->curPointer = this->endPointer;
+    }
     
     return head;
 }
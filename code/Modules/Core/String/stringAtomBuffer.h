@@ -3,26 +3,24 @@
 /*
     private class, do not use
     
-    A growable buffer for raw string data for the StringAtom system.
+    An append-only buffer for raw string data for the StringAtom system,
+    strings never move once they have been added.
 */
 #include "Core/Types.h"
 #include "Core/Containers/Array.h"
 
 namespace Oryol {
 
-class stringAtomTable;
-
 class stringAtomBuffer {
 public:
     // header data for a single entry (string data starts at end of header)
     struct Header {
         // default constructor
-        Header() : table(0), hash(0), length(0), str(0) { };
+        Header() : hash(0), length(0), str(0) { };
         /// constructor
-        Header(const stringAtomTable* t, int32_t hsh, int len, const char* s) : table(t), hash(hsh), length(len), str(s) { };
+        Header(uint64_t hsh, int len, const char* s) : hash(hsh), length(len), str(s) { };
     
-        const stringAtomTable* table;
-        int32_t hash;
+        uint64_t hash;
         int length;
         const char* str;
     };
@@ -30,13 +28,14 @@ public:
     /// destructor
     ~stringAtomBuffer();
     /// add a new string to the buffer, return pointer to start of header
-    const Header* AddString(stringAtomTable* table, int32_t hash, const char* str);
-    /// allocate a new chunk
-    void allocChunk();
+    const Header* AddString(uint64_t hash, const char* str);
+    /// allocate a new chunk of at least minSize bytes
+    void allocChunk(int minSize);
 
-    static const int chunkSize = (1<<14);    // careful with this: each thread has its own stringbuffer!
+    static const int chunkSize = (1<<13);    // careful with this: each table shard has its own stringbuffer!
     Array<int8_t*> chunks;
-    int8_t* curPointer = 0;        // this is always aligned to min(sizeof(header), ORYOL_MAX_PLATFORM_ALIGN)
+    int8_t* curPointer = 0;        // this is always aligned to alignof(Header)
+    int8_t* endPointer = 0;        // one-past-end of the current chunk
 };
     
 } // namespace Oryol
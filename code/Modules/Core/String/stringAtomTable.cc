@@ -4,126 +4,160 @@
 #include "Pre.h"
 #include <cstring>
 #include "stringAtomTable.h"
+#include "Core/Memory/Memory.h"
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
 
 namespace Oryol {
 
-ORYOL_THREADLOCAL_PTR(stringAtomTable) stringAtomTable::ptr = nullptr;
+#if ORYOL_HAS_THREADS
+#define SCOPED_LOCK(s) std::lock_guard<std::mutex> lock(s.lock)
+#else
+#define SCOPED_LOCK(s)
+#endif
 
 //------------------------------------------------------------------------------
 stringAtomTable*
-stringAtomTable::threadLocalPtr() {
-    // NOTE: this object can never be released, even if a thread is left
-    // since StringAtom object can move to other threads, thus memory
-    // leak detectors will complain about these allocations on program
-    // exit
-    if (!ptr) {
+stringAtomTable::Instance() {
+    // NOTE: this object is never released, since StringAtom objects
+    // may live in static objects which are destroyed after any cleanup
+    // code would run, thus memory leak detectors will complain about
+    // these allocations on program exit
+    static stringAtomTable* ptr = [] {
+        o_memory_tag(MemoryTag::Core);
         #if ORYOL_USE_VLD
         VLDDisable();
         #endif
-        ptr = Memory::New<stringAtomTable>();
+        stringAtomTable* table = Memory::New<stringAtomTable>();
         #if ORYOL_USE_VLD
         VLDEnable();
         #endif
-    }
+        return table;
+    }();
     return ptr;
 }
 
 //------------------------------------------------------------------------------
-const stringAtomBuffer::Header*
-stringAtomTable::Find(int32_t hash, const char* str) const {
-    
-    // need to create a temp object for searching in the set
-    stringAtomBuffer::Header dummyHead(this, hash, 0, str);
-    Entry dummyEntry(&dummyHead);
-    auto ptr = this->table.Find(dummyEntry);
-    if (nullptr == ptr) {
-        return nullptr;
-    }
-    else {
-        o_assert(nullptr != ptr->header);
-        return ptr->header;
+int
+stringAtomTable::shardIndex(uint64_t hash) {
+    // the slot index uses the low 32 bits of the hash, so use the high bits here
+    return int(hash >> 32) & (NumShards - 1);
+}
+
+//------------------------------------------------------------------------------
+stringAtomTable::slotArray*
+stringAtomTable::allocSlotArray(int capacity) {
+    o_assert_dbg((capacity > 0) && (0 == (capacity & (capacity - 1))));
+    slotArray* arr = (slotArray*) Memory::Alloc(sizeof(slotArray) + capacity * sizeof(std::atomic<const stringAtomBuffer::Header*>));
+    arr->capacity = capacity;
+    arr->prev = nullptr;
+    arr->slots = (std::atomic<const stringAtomBuffer::Header*>*) (arr + 1);
+    for (int i = 0; i < capacity; i++) {
+        new(&arr->slots[i]) std::atomic<const stringAtomBuffer::Header*>(nullptr);
     }
+    return arr;
 }
 
 //------------------------------------------------------------------------------
 const stringAtomBuffer::Header*
-stringAtomTable::Add(int32_t hash, const char* str) {
-    
-    #if ORYOL_DEBUG
-    o_assert(nullptr == this->Find(hash, str));
-    #endif    
-    #if ORYOL_USE_VLD
-    VLDDisable();
-    #endif
-
-    // add new string to the string buffer
-    const stringAtomBuffer::Header* newHeader = this->buffer.AddString(this, hash, str);
-    o_assert(nullptr != newHeader);
-    
-    // add new entry to our lookup table
-    this->table.Add(Entry(newHeader));
-
-    #if ORYOL_USE_VLD
-    VLDEnable();
-    #endif
-    return newHeader;
+stringAtomTable::find(const slotArray* arr, uint64_t hash, const char* str) {
+    const uint32_t mask = uint32_t(arr->capacity - 1);
+    uint32_t index = uint32_t(hash) & mask;
+    for (;;) {
+        const stringAtomBuffer::Header* header = arr->slots[index].load(std::memory_order_acquire);
+        if (nullptr == header) {
+            return nullptr;
+        }
+        if ((header->hash == hash) && (0 == std::strcmp(header->str, str))) {
+            return header;
+        }
+        index = (index + 1) & mask;
+    }
 }
 
 //------------------------------------------------------------------------------
-int32_t
-stringAtomTable::HashForString(const char* str) {
+void
+stringAtomTable::insert(slotArray* arr, const stringAtomBuffer::Header* header) {
+    const uint32_t mask = uint32_t(arr->capacity - 1);
+    uint32_t index = uint32_t(header->hash) & mask;
+    while (nullptr != arr->slots[index].load(std::memory_order_relaxed)) {
+        index = (index + 1) & mask;
+    }
+    // the release-store makes the header and string data visible to readers
+    arr->slots[index].store(header, std::memory_order_release);
+}
 
-    // see here: http://eternallyconfuzzled.com/tuts/algorithms/jsw_tut_hashing.aspx
-    const char* p = str;
-    uint32_t h = 0;
-    char c;
-    while (0 != (c = *p++))
-    {
-        h += c;
-        h += (h << 10);
-        h ^= (h >> 6);
+//------------------------------------------------------------------------------
+const stringAtomBuffer::Header*
+stringAtomTable::Find(uint64_t hash, const char* str) const {
+    const slotArray* arr = this->shards[shardIndex(hash)].slots.load(std::memory_order_acquire);
+    if (nullptr == arr) {
+        return nullptr;
     }
-    h += (h << 3);
-    h ^= (h >> 11);
-    h += (h << 15);
-    return h;
+    return find(arr, hash, str);
 }
 
 //------------------------------------------------------------------------------
-bool
-stringAtomTable::Entry::operator==(const Entry& rhs) const {
+const stringAtomBuffer::Header*
+stringAtomTable::FindOrAdd(uint64_t hash, const char* str) {
 
-    #if ORYOL_DEBUG
-    o_assert(this->header != 0 && rhs.header != 0);
-    o_assert(this->header->hash != 0 && rhs.header->hash != 0);
-    o_assert(this->header->str != 0 && rhs.header->str != 0);
-    #endif
-    
-    if (this->header->hash != rhs.header->hash) {
-        // if hashes differ, the entries are definitely not equal
-        return false;
+    // fast path: the string already exists
+    const stringAtomBuffer::Header* header = this->Find(hash, str);
+    if (nullptr != header) {
+        return header;
+    }
+
+    // slow path: another thread might have added the string in
+    // the meantime, so need to check again under the lock
+    shard& s = this->shards[shardIndex(hash)];
+    SCOPED_LOCK(s);
+    slotArray* arr = s.slots.load(std::memory_order_relaxed);
+    if (nullptr != arr) {
+        header = find(arr, hash, str);
+        if (nullptr != header) {
+            return header;
+        }
     }
-    else {
-        // if hashes are identical, need to do a strcmp
-        return (0 == std::strcmp(this->header->str, rhs.header->str));
+
+    o_memory_tag(MemoryTag::Core);
+    #if ORYOL_USE_VLD
+    VLDDisable();
+    #endif
+
+    // grow the slot array if more than half full, readers which
+    // still probe the old array will find new strings under the lock
+    if ((nullptr == arr) || (((s.size + 1) * 2) > arr->capacity)) {
+        slotArray* newArr = allocSlotArray(arr ? arr->capacity * 2 : InitialCapacity);
+        if (arr) {
+            for (int i = 0; i < arr->capacity; i++) {
+                const stringAtomBuffer::Header* h = arr->slots[i].load(std::memory_order_relaxed);
+                if (h) {
+                    insert(newArr, h);
+                }
+            }
+        }
+        newArr->prev = arr;
+        s.slots.store(newArr, std::memory_order_release);
+        arr = newArr;
     }
+
+    // add new string to the string buffer and lookup table
+    header = s.buffer.AddString(hash, str);
+    o_assert(nullptr != header);
+    insert(arr, header);
+    s.size++;
+
+    #if ORYOL_USE_VLD
+    VLDEnable();
+    #endif
+    return header;
 }
 
 //------------------------------------------------------------------------------
-bool
-stringAtomTable::Entry::operator<(const Entry& rhs) const {
-        
-    #if ORYOL_DEBUG
-    o_assert(this->header != 0 && rhs.header != 0);
-    o_assert(this->header->hash != 0 && rhs.header->hash != 0);
-    o_assert(this->header->str != 0 && rhs.header->str != 0);
-    #endif
-    return std::strcmp(this->header->str, rhs.header->str) < 0;
+uint64_t
+stringAtomTable::HashForString(const char* str) {
+    return HashBytes64(str, int64_t(std::strlen(str)));
 }
 
 } // namespace Oryol
-
-
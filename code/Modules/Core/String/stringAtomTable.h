@@ -3,50 +3,70 @@
 /*
     private class, do not use
     
-    A thread-local StringAtom table.
+    The process-wide StringAtom table.
+
+    The table is split into shards (selected by the top bits of the
+    string hash), each shard has an open-addressing hash table of
+    header pointers, an append-only string buffer, and a lock which
+    is only taken when a new string is added. Lookups don't take
+    any locks: the slot array of a shard is published with an atomic
+    pointer, and slots are filled with atomic stores after the string
+    data has been written. When a shard grows, the old slot array is
+    kept alive (readers may still be probing it) and is never freed,
+    like the string data itself.
 */
+#include <atomic>
 #include "Core/Types.h"
+#include "Core/Hash.h"
 #include "Core/String/stringAtomBuffer.h"
-#include "Core/Containers/HashSet.h"
-#include "Core/Threading/ThreadLocalPtr.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
 
 namespace Oryol {
 
 class stringAtomTable {
 public:
-    /// access to thread-local stringAtomTable (created on demand)
-    static stringAtomTable* threadLocalPtr();
-    /// compute hash value for string
-    static int32_t HashForString(const char* str);
-    /// find a matching buffer header in the table
-    const stringAtomBuffer::Header* Find(int32_t hash, const char* str) const;
-    /// add a string to the atom table
-    const stringAtomBuffer::Header* Add(int32_t hash, const char* str);
-    
-    static ORYOL_THREADLOCAL_PTR(stringAtomTable) ptr;
+    /// access to the process-wide stringAtomTable (created on demand)
+    static stringAtomTable* Instance();
+    /// compute hash value for string (HashBytes64(), or HashLiteral64() at compile time)
+    static uint64_t HashForString(const char* str);
+    /// find a matching buffer header in the table (lock-free)
+    const stringAtomBuffer::Header* Find(uint64_t hash, const char* str) const;
+    /// find a matching buffer header, or add the string to the table
+    const stringAtomBuffer::Header* FindOrAdd(uint64_t hash, const char* str);
+
+    /// number of shards (must be 2^N)
+    static const int NumShards = 8;
+    /// initial number of slots per shard (must be 2^N)
+    static const int InitialCapacity = 256;
 
-    /// a bucket entry
-    struct Entry {
-        /// default constructor
-        Entry() : header(0) { };
-        /// constructor with header ptr
-        Entry(const stringAtomBuffer::Header* h) : header(h) { };
-        /// equality operator
-        bool operator==(const Entry& rhs) const;
-        /// less-then operator
-        bool operator<(const Entry& rhs) const;
-        
-        const stringAtomBuffer::Header* header;
+private:
+    /// a published array of slots, grows by replacing the whole array
+    struct slotArray {
+        int capacity;
+        slotArray* prev;
+        std::atomic<const stringAtomBuffer::Header*>* slots;
     };
-    
-    /// hash function for bucket entry
-    struct Hasher {
-        int32_t operator()(const Entry& e) const {
-            return e.header->hash;
-        };
+    /// a table shard
+    struct shard {
+        std::atomic<slotArray*> slots{nullptr};
+        int size = 0;
+        stringAtomBuffer buffer;
+        #if ORYOL_HAS_THREADS
+        std::mutex lock;
+        #endif
     };
-    stringAtomBuffer buffer;
-    HashSet<Entry, Hasher, 1024> table;
+    /// get shard index for a hash
+    static int shardIndex(uint64_t hash);
+    /// probe a slot array for a string
+    static const stringAtomBuffer::Header* find(const slotArray* arr, uint64_t hash, const char* str);
+    /// insert a header into a slot array (shard must be locked)
+    static void insert(slotArray* arr, const stringAtomBuffer::Header* header);
+    /// allocate a new, empty slot array
+    static slotArray* allocSlotArray(int capacity);
+
+    shard shards[NumShards];
 };
 
 } // namespace Oryol
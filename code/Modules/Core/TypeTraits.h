@@ -0,0 +1,31 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @file Core/TypeTraits.h
+    @brief type traits used by the Oryol containers
+
+    IsTriviallyRelocatable<TYPE>::value is true if objects of TYPE can be
+    moved to a different memory location with a plain memory copy (without
+    calling the move-constructor and destructor). The container classes
+    use memmove() and realloc() for such types when growing, inserting
+    and erasing.
+
+    By default this is the case for all trivially copyable types. Types
+    which are not trivially copyable, but don't keep pointers into
+    themselves (for instance smart pointers) can be declared as trivially
+    relocatable by specializing the IsTriviallyRelocatable template:
+
+    @code
+    namespace Oryol {
+    template<> struct IsTriviallyRelocatable<MyType> : std::true_type { };
+    }
+    @endcode
+*/
+#include <type_traits>
+
+namespace Oryol {
+
+template<class TYPE> struct IsTriviallyRelocatable :
+    std::integral_constant<bool, std::is_trivially_copyable<TYPE>::value> { };
+
+} // namespace Oryol
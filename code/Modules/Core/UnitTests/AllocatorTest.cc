@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+//  AllocatorTest.cc
+//  Test LinearArena and container allocator policies.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Memory/LinearArena.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/Set.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/String/String.h"
+
+using namespace Oryol;
+
+namespace {
+
+// a stateful allocator policy which counts the bytes of a 'heap'
+struct countingHeap {
+    int64_t liveBytes = 0;
+    int numAllocs = 0;
+    int numFrees = 0;
+};
+class CountingAllocator {
+public:
+    CountingAllocator() : heap(nullptr) { };
+    explicit CountingAllocator(countingHeap* heap_) : heap(heap_) { };
+    void* Alloc(int64_t numBytes, int alignment) {
+        this->heap->liveBytes += numBytes;
+        this->heap->numAllocs++;
+        return HeapAllocator().Alloc(numBytes, alignment);
+    };
+    void Free(void* ptr, int64_t numBytes, int alignment) {
+        this->heap->liveBytes -= numBytes;
+        this->heap->numFrees++;
+        HeapAllocator().Free(ptr, numBytes, alignment);
+    };
+    bool CanReAlloc(int alignment) const {
+        return HeapAllocator().CanReAlloc(alignment);
+    };
+    void* ReAlloc(void* ptr, int64_t oldNumBytes, int64_t newNumBytes, int alignment) {
+        this->heap->liveBytes += newNumBytes - oldNumBytes;
+        return HeapAllocator().ReAlloc(ptr, oldNumBytes, newNumBytes, alignment);
+    };
+    countingHeap* heap;
+};
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+TEST(LinearArenaTest) {
+    LinearArena arena;
+    CHECK(!arena.IsValid());
+    arena.Setup(4096);
+    CHECK(arena.IsValid());
+    CHECK(arena.Capacity() == 4096);
+    CHECK(arena.UsedBytes() == 0);
+
+    // allocations are aligned and consecutive
+    uint8_t* p0 = (uint8_t*) arena.Alloc(3);
+    uint8_t* p1 = (uint8_t*) arena.Alloc(100);
+    CHECK(Memory::IsAligned(p0, ORYOL_MAX_PLATFORM_ALIGN));
+    CHECK(p1 == p0 + ORYOL_MAX_PLATFORM_ALIGN);
+    CHECK(arena.UsedBytes() == ORYOL_MAX_PLATFORM_ALIGN + Memory::RoundUp(100, ORYOL_MAX_PLATFORM_ALIGN));
+    uint8_t* p2 = (uint8_t*) arena.Alloc(16, 64);
+    CHECK(Memory::IsAligned(p2, 64));
+
+    // freeing the most recent allocation rewinds, others are no-ops
+    const int64_t used = arena.UsedBytes();
+    arena.Free(p0, 3);
+    CHECK(arena.UsedBytes() == used);
+    arena.Free(p2, 16);
+    CHECK(arena.UsedBytes() < used);
+
+    // resizing the most recent allocation happens in place
+    Memory::Fill(p1, 100, 0x33);
+    uint8_t* p3 = (uint8_t*) arena.Alloc(32);
+    p3 = (uint8_t*) arena.ReAlloc(p3, 32, 1000);
+    uint8_t* p4 = (uint8_t*) arena.ReAlloc(p1, 100, 200);
+    CHECK(p4 != p1);
+    CHECK((p4[0] == 0x33) && (p4[99] == 0x33));
+    const int64_t hwm = arena.HighWaterMark();
+    CHECK(hwm == arena.UsedBytes());
+    arena.Reset();
+    CHECK(arena.UsedBytes() == 0);
+    CHECK(arena.HighWaterMark() == hwm);
+    CHECK(arena.Alloc(8) == p0);
+    arena.Discard();
+    CHECK(!arena.IsValid());
+
+    // a caller-provided fixed block
+    alignas(ORYOL_MAX_PLATFORM_ALIGN) static uint8_t block[1024];
+    arena.Setup(block, sizeof(block));
+    CHECK(arena.Alloc(8) == block);
+    arena.Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(ArenaAllocatorTest) {
+    LinearArena arena;
+    arena.Setup(64 * 1024);
+    ArenaAllocator allocator(&arena);
+    {
+        // a trivially relocatable array grows in place
+        Array<int, ArenaAllocator> array(allocator);
+        CHECK(array.GetAllocator().Arena() == &arena);
+        for (int i = 0; i < 1000; i++) {
+            array.Add(i);
+        }
+        CHECK(array.Size() == 1000);
+        CHECK(array[999] == 999);
+        CHECK(arena.UsedBytes() == Memory::RoundUp(array.Capacity() * sizeof(int), ORYOL_MAX_PLATFORM_ALIGN));
+
+        // copies inherit the allocator
+        Array<int, ArenaAllocator> copy(array);
+        CHECK(copy.GetAllocator().Arena() == &arena);
+        CHECK(copy[500] == 500);
+
+        // non-trivial element types
+        Array<String, ArenaAllocator> strings;
+        strings.SetAllocator(allocator);
+        for (int i = 0; i < 100; i++) {
+            strings.Add("Bla");
+        }
+        CHECK(strings[99] == "Bla");
+
+        Map<int, int, ArenaAllocator> map(allocator);
+        map.Add(3, 4);
+        map.Add(1, 2);
+        CHECK(map[1] == 2);
+        CHECK(map.GetAllocator().Arena() == &arena);
+
+        Set<int, ArenaAllocator> set(allocator);
+        set.Add(5);
+        set.Add(2);
+        CHECK(set.Contains(2) && set.Contains(5));
+
+        Queue<int, ArenaAllocator> queue(allocator);
+        for (int i = 0; i < 100; i++) {
+            queue.Enqueue(i);
+        }
+        CHECK(queue.Dequeue() == 0);
+        CHECK(queue.Size() == 99);
+
+        const int64_t usedBeforeBuffer = arena.UsedBytes();
+        BasicBuffer<ArenaAllocator> buf(allocator);
+        const uint8_t bytes[] = { 1, 2, 3, 4 };
+        for (int i = 0; i < 256; i++) {
+            buf.Add(bytes, sizeof(bytes));
+        }
+        CHECK(buf.Size() == 1024);
+        CHECK(buf.Data()[1023] == 4);
+        // the buffer was the most recent allocation, so it grew in place
+        CHECK(arena.UsedBytes() == usedBeforeBuffer + 1024);
+    }
+    // memory came from the arena, not from the heap
+    CHECK(arena.HighWaterMark() > 0);
+    arena.Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(StatefulAllocatorTest) {
+    countingHeap heap;
+    CountingAllocator allocator(&heap);
+    {
+        Array<int, CountingAllocator> array(allocator);
+        array.Reserve(16);
+        CHECK(heap.numAllocs == 1);
+        CHECK(heap.liveBytes == 16 * int64_t(sizeof(int)));
+        for (int i = 0; i < 100; i++) {
+            array.Add(i);
+        }
+        CHECK(heap.liveBytes == array.Capacity() * int64_t(sizeof(int)));
+
+        // a moved-to array frees through the same heap
+        Array<int, CountingAllocator> array1(std::move(array));
+        CHECK(array1.GetAllocator().heap == &heap);
+
+        Queue<String, CountingAllocator> queue(allocator);
+        queue.Enqueue("Hello");
+        queue.Enqueue("World");
+        CHECK(queue.Dequeue() == "Hello");
+
+        BasicBuffer<CountingAllocator> buf(allocator);
+        const int64_t liveBytes = heap.liveBytes;
+        buf.Add(100);
+        CHECK(heap.liveBytes == liveBytes + 100);
+    }
+    CHECK(heap.liveBytes == 0);
+    CHECK(heap.numFrees > 0);
+
+    // over-aligned memory goes through the policy too
+    {
+        Array<float, CountingAllocator> array(allocator);
+        array.SetAlignment(64);
+        for (int i = 0; i < 100; i++) {
+            array.Add(float(i));
+        }
+        CHECK(Memory::IsAligned(&array[0], 64));
+        CHECK(heap.liveBytes == array.Capacity() * int64_t(sizeof(float)));
+    }
+    CHECK(heap.liveBytes == 0);
+}
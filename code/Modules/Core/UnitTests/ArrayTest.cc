@@ -392,5 +392,154 @@ TEST(ArrayTest) {
     CHECK(array8.Capacity() == 128);
     CHECK(array8.GetMinGrow() == 0);
     CHECK(array8.GetMaxGrow() == 0);
+
+    // aligned element storage
+    const int alignments[] = { 16, 32, 64, 4096 };
+    for (int alignment : alignments) {
+        Array<float> array9;
+        CHECK(array9.GetAlignment() == ORYOL_MAX_PLATFORM_ALIGN);
+        array9.SetAlignment(alignment);
+        CHECK(array9.GetAlignment() == alignment);
+        for (int i = 0; i < 1000; i++) {
+            array9.Add(float(i));
+            CHECK(Memory::IsAligned(array9.begin(), alignment));
+        }
+        CHECK(array9[999] == 999.0f);
+        // copies keep the alignment
+        Array<float> array10(array9);
+        CHECK(array10.GetAlignment() == alignment);
+        CHECK(Memory::IsAligned(array10.begin(), alignment));
+        Array<float> array11;
+        array11 = array9;
+        CHECK(Memory::IsAligned(array11.begin(), alignment));
+        Array<float> array12(std::move(array9));
+        CHECK(array12.GetAlignment() == alignment);
+        CHECK(Memory::IsAligned(array12.begin(), alignment));
+        array12.Trim();
+        CHECK(Memory::IsAligned(array12.begin(), alignment));
+        if (alignment > ORYOL_MAX_PLATFORM_ALIGN) {
+            // erasing and inserting at the front keeps begin() aligned
+            array12.Erase(0);
+            CHECK(Memory::IsAligned(array12.begin(), alignment));
+            CHECK((array12.Size() == 999) && (array12[0] == 1.0f) && (array12[998] == 999.0f));
+            CHECK(array12.PopFront() == 1.0f);
+            CHECK(Memory::IsAligned(array12.begin(), alignment));
+            array12.EraseSwapFront(5);
+            array12.EraseSwap(0);
+            array12.Erase(3);
+            CHECK(Memory::IsAligned(array12.begin(), alignment));
+            array12.Insert(0, -1.0f);
+            CHECK(Memory::IsAligned(array12.begin(), alignment));
+            CHECK((array12[0] == -1.0f) && (array12[1] == 999.0f) && (array12[2] == 4.0f) && (array12[4] == 2.0f));
+            Array<String> array13;
+            array13.SetAlignment(alignment);
+            array13.Add("A");
+            array13.Add("B");
+            array13.Add("C");
+            array13.Erase(0);
+            CHECK(Memory::IsAligned(array13.begin(), alignment));
+            CHECK((array13.Size() == 2) && (array13[0] == "B") && (array13[1] == "C"));
+            CHECK(array13.PopFront() == "B");
+            CHECK((array13.Size() == 1) && (array13[0] == "C"));
+            CHECK(Memory::IsAligned(array13.begin(), alignment));
+        }
+    }
 }
 
+//------------------------------------------------------------------------------
+TEST(ArrayBulkTest) {
+    // trivially copyable elements
+    const int ints[] = { 5, 6, 7, 8, 9 };
+    Array<int> array0;
+    array0.AddBulk(Slice<const int>(ints, 5));
+    CHECK(array0.Size() == 5);
+    CHECK(array0.Capacity() == ORYOL_CONTAINER_DEFAULT_MIN_GROW);
+    array0.AddBulk(Slice<const int>(ints, 5, 1, 2));
+    CHECK(array0.Size() == 7);
+    CHECK((array0[0] == 5) && (array0[4] == 9) && (array0[5] == 6) && (array0[6] == 7));
+    array0.InsertBulk(0, Slice<const int>(ints, 5, 3, 2));
+    CHECK(array0.Size() == 9);
+    CHECK((array0[0] == 8) && (array0[1] == 9) && (array0[2] == 5) && (array0[8] == 7));
+    array0.InsertBulk(4, Slice<const int>(ints, 5));
+    array0.InsertBulk(array0.Size(), Slice<const int>(ints, 5, 0, 1));
+    const int expected0[] = { 8, 9, 5, 6, 5, 6, 7, 8, 9, 7, 8, 9, 6, 7, 5 };
+    CHECK(array0.Size() == 15);
+    bool equal = true;
+    for (int i = 0; i < 15; i++) {
+        equal &= array0[i] == expected0[i];
+    }
+    CHECK(equal);
+
+    // an empty slice is a no-op
+    array0.AddBulk(Slice<const int>());
+    array0.InsertBulk(3, Slice<const int>());
+    CHECK(array0.Size() == 15);
+
+    // grow only once for a big range, a read/write slice converts to read-only
+    Array<int> array1;
+    array1.Add(1);
+    array1.AddBulk(array0.MakeSlice());
+    array1.AddBulk(array0.MakeSlice());
+    CHECK(array1.Size() == 31);
+    Array<int> array2;
+    for (int i = 0; i < 1000; i++) {
+        array2.Add(i);
+    }
+    array1.AddBulk(array2.MakeSlice());
+    CHECK(array1.Size() == 1031);
+    CHECK(array1.Capacity() == 1031);
+    CHECK((array1[30] == 5) && (array1[31] == 0) && (array1[1030] == 999));
+
+    // non-trivial elements, insert with the tail crossing the old end
+    const String strs[] = { "A", "B", "C" };
+    Array<String> array3({ "X", "Y", "Z", "W" });
+    array3.InsertBulk(3, Slice<const String>(strs, 3));
+    CHECK(array3.Size() == 7);
+    CHECK(array3[2] == "Z");
+    CHECK(array3[3] == "A");
+    CHECK(array3[5] == "C");
+    CHECK(array3[6] == "W");
+    array3.InsertBulk(1, Slice<const String>(strs, 3, 1, 2));
+    CHECK(array3.Size() == 9);
+    CHECK(array3[0] == "X");
+    CHECK(array3[1] == "B");
+    CHECK(array3[2] == "C");
+    CHECK(array3[3] == "Y");
+    CHECK(array3[8] == "W");
+    array3.AddBulk(Slice<const String>(strs, 3));
+    CHECK(array3.Size() == 12);
+    CHECK(array3[11] == "C");
+    // insert into an array with spare room at the front
+    array3.Erase(0);
+    array3.Erase(0);
+    array3.InsertBulk(2, Slice<const String>(strs, 3));
+    CHECK(array3.Size() == 13);
+    CHECK(array3[0] == "C");
+    CHECK(array3[1] == "Y");
+    CHECK(array3[2] == "A");
+    CHECK(array3[5] == "Z");
+
+    // a slice of the array itself, with and without growing
+    Array<int> array4;
+    for (int i = 0; i < 16; i++) {
+        array4.Add(i);
+    }
+    CHECK(array4.Capacity() == 16);
+    array4.AddBulk(array4.MakeSlice());
+    CHECK(array4.Size() == 32);
+    CHECK((array4[15] == 15) && (array4[16] == 0) && (array4[31] == 15));
+    array4.Reserve(16);
+    array4.AddBulk(array4.MakeSlice(4, 8));
+    CHECK(array4.Size() == 40);
+    CHECK((array4[32] == 4) && (array4[39] == 11));
+    array4.InsertBulk(2, array4.MakeSlice(0, 4));
+    CHECK(array4.Size() == 44);
+    CHECK((array4[1] == 1) && (array4[2] == 0) && (array4[5] == 3) && (array4[6] == 2));
+    Array<String> array5({ "A", "B", "C" });
+    array5.AddBulk(array5.MakeSlice());
+    array5.AddBulk(array5.MakeSlice(1, 2));
+    array5.InsertBulk(1, array5.MakeSlice(0, 3));
+    CHECK(array5.Size() == 11);
+    CHECK((array5[0] == "A") && (array5[1] == "A") && (array5[3] == "C") && (array5[4] == "B"));
+    CHECK((array5[9] == "B") && (array5[10] == "C"));
+}
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//  BitSetTest.cc
+//  Test BitSet class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/BitSet.h"
+
+using namespace std;
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(BitSetTest) {
+    BitSet bits;
+    CHECK(bits.Empty());
+    CHECK(bits.Size() == 0);
+    CHECK(bits.Count() == 0);
+    CHECK(!bits.Any());
+    CHECK(bits.FindFirstSet() == InvalidIndex);
+    CHECK(bits.FindFirstClear() == InvalidIndex);
+    CHECK(bits.FindLastSet() == InvalidIndex);
+
+    bits.Resize(200);
+    CHECK(!bits.Empty());
+    CHECK(bits.Size() == 200);
+    CHECK(bits.Count() == 0);
+    CHECK(bits.FindFirstClear() == 0);
+    bits.Set(0);
+    bits.Set(63);
+    bits.Set(64);
+    bits.Set(199);
+    CHECK(bits.Test(0));
+    CHECK(!bits.Test(1));
+    CHECK(bits.Test(63));
+    CHECK(bits.Test(64));
+    CHECK(bits.Test(199));
+    CHECK(bits.Count() == 4);
+    CHECK(bits.Any());
+    CHECK(bits.FindFirstSet() == 0);
+    CHECK(bits.FindFirstSet(1) == 63);
+    CHECK(bits.FindFirstSet(64) == 64);
+    CHECK(bits.FindFirstSet(65) == 199);
+    CHECK(bits.FindFirstSet(200) == InvalidIndex);
+    CHECK(bits.FindFirstClear() == 1);
+    CHECK(bits.FindFirstClear(63) == 65);
+    CHECK(bits.FindLastSet() == 199);
+    bits.Reset(199);
+    CHECK(bits.FindLastSet() == 64);
+    bits.Flip(64);
+    bits.Flip(65);
+    CHECK(!bits.Test(64));
+    CHECK(bits.Test(65));
+    CHECK(bits.Count() == 3);
+
+    // iterate over set bits
+    int sum = 0;
+    for (int i = bits.FindFirstSet(); InvalidIndex != i; i = bits.FindFirstSet(i + 1)) {
+        sum += i;
+    }
+    CHECK(sum == 0 + 63 + 65);
+
+    // ranges
+    bits.ResetAll();
+    CHECK(!bits.Any());
+    bits.SetRange(10, 150);
+    CHECK(bits.Count() == 150);
+    CHECK(bits.FindFirstSet() == 10);
+    CHECK(bits.FindLastSet() == 159);
+    CHECK(bits.FindFirstClear(10) == 160);
+    bits.ResetRange(60, 10);
+    CHECK(bits.Count() == 140);
+    CHECK(bits.FindFirstClear(10) == 60);
+    CHECK(bits.FindFirstSet(60) == 70);
+    bits.SetRange(5, 0);
+    CHECK(bits.Count() == 140);
+    bits.SetAll();
+    CHECK(bits.Count() == 200);
+    CHECK(bits.FindFirstClear() == InvalidIndex);
+
+    // shrink and grow, new bits must be cleared
+    bits.Resize(70);
+    CHECK(bits.Count() == 70);
+    CHECK(bits.FindLastSet() == 69);
+    bits.Resize(130);
+    CHECK(bits.Count() == 70);
+    CHECK(bits.FindFirstClear() == 70);
+    CHECK(!bits.Test(129));
+
+    // copy
+    BitSet bits1(bits);
+    CHECK(bits1.Size() == 130);
+    CHECK(bits1.Count() == 70);
+    bits1.Reset(0);
+    CHECK(bits.Test(0));
+    CHECK(!bits1.Test(0));
+}
+
+//------------------------------------------------------------------------------
+TEST(BitSetScanTest) {
+    // iterating the set bits of a big, sparse BitSet must visit the
+    // same slots as a bool array scan (timed in CoreBenchmarks)
+    const int numSlots = 1<<16;
+    Array<bool> flags;
+    BitSet bits(numSlots);
+    for (int i = 0; i < numSlots; i++) {
+        const bool used = 0 == (i % 97);
+        flags.Add(used);
+        if (used) {
+            bits.Set(i);
+        }
+    }
+    int i = bits.FindFirstSet();
+    bool same = true;
+    for (int slot = 0; slot < numSlots; slot++) {
+        if (flags[slot]) {
+            same &= slot == i;
+            i = bits.FindFirstSet(i + 1);
+        }
+    }
+    CHECK(same);
+    CHECK(InvalidIndex == i);
+}
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//  BufferChainTest.cc
+//  Test BufferChain class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/BufferChain.h"
+
+using namespace std;
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(BufferChainTest) {
+    const int segSize = BufferChain::SegmentCapacity;
+    BufferChain::ReleasePool();
+
+    BufferChain chain;
+    CHECK(chain.Empty());
+    CHECK(chain.Size() == 0);
+    CHECK(chain.NumSegments() == 0);
+
+    // add data in odd-sized pieces, crossing segment boundaries
+    const int pieceSize = 1000;
+    uint8_t piece[pieceSize];
+    int numBytes = 0;
+    while (numBytes < (2 * segSize + 500)) {
+        for (int i = 0; i < pieceSize; i++) {
+            piece[i] = uint8_t(numBytes + i);
+        }
+        chain.Add(piece, pieceSize);
+        numBytes += pieceSize;
+    }
+    CHECK(chain.Size() == numBytes);
+    CHECK(chain.NumSegments() == 3);
+    CHECK(chain.SegmentSize(0) == segSize);
+    CHECK(chain.SegmentSize(1) == segSize);
+    CHECK(chain.SegmentSize(2) == numBytes - 2 * segSize);
+
+    // iterate over segments
+    bool contentOk = true;
+    int offset = 0;
+    for (int seg = 0; seg < chain.NumSegments(); seg++) {
+        const uint8_t* data = chain.SegmentData(seg);
+        for (int i = 0; i < chain.SegmentSize(seg); i++) {
+            contentOk &= data[i] == uint8_t(offset++);
+        }
+    }
+    CHECK(contentOk);
+    CHECK(offset == numBytes);
+
+    // gather a range across a segment boundary
+    uint8_t dst[256];
+    CHECK(chain.CopyTo(segSize - 100, dst, 256) == 256);
+    contentOk = true;
+    for (int i = 0; i < 256; i++) {
+        contentOk &= dst[i] == uint8_t(segSize - 100 + i);
+    }
+    CHECK(contentOk);
+    CHECK(chain.CopyTo(numBytes - 10, dst, 256) == 10);
+    CHECK(chain.CopyTo(numBytes, dst, 256) == 0);
+
+    // trim back into the second segment
+    chain.Trim(numBytes - (segSize + 10));
+    CHECK(chain.Size() == segSize + 10);
+    CHECK(chain.NumSegments() == 2);
+    CHECK(BufferChain::NumPooledSegments() == 1);
+
+    // move
+    BufferChain chain1(std::move(chain));
+    CHECK(chain.Empty());
+    CHECK(chain.NumSegments() == 0);
+    CHECK(chain1.Size() == segSize + 10);
+
+    // flatten
+    Buffer buf = chain1.Flatten();
+    CHECK(chain1.Empty());
+    CHECK(buf.Size() == segSize + 10);
+    contentOk = true;
+    for (int i = 0; i < buf.Size(); i++) {
+        contentOk &= buf.Data()[i] == uint8_t(i);
+    }
+    CHECK(contentOk);
+    CHECK(BufferChain::NumPooledSegments() == 3);
+
+    // read directly into the chain, segments come from the pool
+    BufferChain chain2;
+    int remaining = segSize + 20;
+    while (remaining > 0) {
+        int num = 0;
+        uint8_t* ptr = chain2.AddSpace(remaining, num);
+        CHECK(num > 0);
+        Memory::Fill(ptr, num, 0xAB);
+        remaining -= num;
+    }
+    CHECK(chain2.Size() == segSize + 20);
+    CHECK(chain2.NumSegments() == 2);
+    CHECK(BufferChain::NumPooledSegments() == 1);
+    chain2.Clear();
+    CHECK(chain2.Empty());
+    CHECK(BufferChain::NumPooledSegments() == 3);
+    BufferChain::ReleasePool();
+    CHECK(BufferChain::NumPooledSegments() == 0);
+}
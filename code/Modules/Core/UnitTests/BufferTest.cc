@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/Containers/Buffer.h"
+#include "Core/Containers/Array.h"
 #include <cstring>
 
 using namespace Oryol;
@@ -110,4 +111,51 @@ TEST(BufferTest) {
     buf4.Add((const uint8_t*)str, int(std::strlen(str))+1);
     CHECK(6 == buf4.Remove(0, 6));
     CHECK(std::strcmp((const char*)buf4.Data(), "wonderful world!") == 0);
+
+    // aligned buffer start
+    const int alignments[] = { 16, 32, 64, 4096 };
+    for (int alignment : alignments) {
+        Buffer buf5;
+        CHECK(buf5.GetAlignment() == ORYOL_MAX_PLATFORM_ALIGN);
+        buf5.SetAlignment(alignment);
+        CHECK(buf5.GetAlignment() == alignment);
+        for (int i = 0; i < 64; i++) {
+            buf5.Add((const uint8_t*)str, int(std::strlen(str)));
+            CHECK(Memory::IsAligned(buf5.Data(), alignment));
+        }
+        Buffer buf6(std::move(buf5));
+        CHECK(buf6.GetAlignment() == alignment);
+        CHECK(Memory::IsAligned(buf6.Data(), alignment));
+        CHECK(std::strncmp((const char*)buf6.Data(), str, std::strlen(str)) == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BufferBulkTest) {
+    const uint16_t indices[] = { 0, 1, 2, 2, 1, 3 };
+    Buffer buf;
+    buf.AddBulk(Slice<const uint16_t>(indices, 6));
+    CHECK(buf.Size() == 12);
+    CHECK(((const uint16_t*)buf.Data())[5] == 3);
+    Array<float> floats({ 1.0f, 2.0f });
+    buf.AddBulk<float>(floats.MakeSlice());
+    CHECK(buf.Size() == 20);
+    CHECK(((const float*)(buf.Data() + 12))[1] == 2.0f);
+
+    Buffer buf1;
+    buf1.Add((const uint8_t*)"Helloworld", 10);
+    buf1.InsertBulk(5, (const uint8_t*)", ", 2);
+    buf1.InsertBulk(0, (const uint8_t*)">", 1);
+    buf1.InsertBulk(buf1.Size(), (const uint8_t*)"!", 1);
+    CHECK(buf1.Size() == 14);
+    CHECK(std::strncmp((const char*)buf1.Data(), ">Hello, world!", 14) == 0);
+
+    // append from the buffer itself, which grows it
+    Buffer buf2;
+    buf2.Add((const uint8_t*)"abcd", 4);
+    for (int i = 0; i < 10; i++) {
+        buf2.Add(buf2.Data(), buf2.Size());
+    }
+    CHECK(buf2.Size() == 4096);
+    CHECK(std::strncmp((const char*)buf2.Data() + 4092, "abcd", 4) == 0);
 }
@@ -38,6 +38,18 @@ private:
     int val;
 };
 
+// same class, but with pool allocator
+class PoolTestClass : public RefCounted {
+    OryolClassPoolAllocDecl(PoolTestClass, 256);
+public:
+    PoolTestClass() : val(0) { };
+    PoolTestClass(int v) : val(v) { };
+    void Set(int i) { this->val = i; };
+    int Get() const { return this->val; };
+private:
+    int val;
+};
+
 TEST(CreateShared) {
 
     auto ptr0 = TestClass::Create();
@@ -69,6 +81,55 @@ TEST(CreateShared) {
     CHECK(ptr0->GetRefCount() == 1);
 }
 
+TEST(CreatePooled) {
+
+    auto ptr0 = PoolTestClass::Create(1);
+    auto ptr1 = PoolTestClass::Create(2);
+    CHECK(ptr0->Get() == 1);
+    CHECK(ptr1->Get() == 2);
+    CHECK(ptr0 != ptr1);
+    CHECK(ptr0->GetRefCount() == 1);
+
+    // released objects are reused
+    PoolTestClass* raw = ptr1.get();
+    ptr1.invalidate();
+    auto ptr2 = PoolTestClass::Create(3);
+    CHECK(ptr2.get() == raw);
+    CHECK(ptr2->Get() == 3);
+
+    // objects created on one thread and released on another
+    #if ORYOL_HAS_THREADS
+    const int numObjects = 10000;
+    Array<Ptr<PoolTestClass>> objs;
+    for (int i = 0; i < numObjects; i++) {
+        objs.Add(PoolTestClass::Create(i));
+    }
+    std::thread releaseThread([&objs]() {
+        objs.Clear();
+        PoolAllocator::FlushThreadCache();
+    });
+    releaseThread.join();
+    CHECK(objs.Empty());
+    for (int i = 0; i < numObjects; i++) {
+        objs.Add(PoolTestClass::Create(i));
+    }
+    for (int i = 0; i < numObjects; i++) {
+        CHECK(objs[i]->Get() == i);
+    }
+
+    // a thread which exits without flushing hands back its cache on exit
+    #if ORYOL_MEMORY_STATS
+    const int64_t numFrees = Memory::QueryStats(MemoryTag::Core).NumFrees;
+    std::thread exitThread([&objs]() {
+        objs.Clear();
+    });
+    exitThread.join();
+    CHECK(objs.Empty());
+    CHECK(Memory::QueryStats(MemoryTag::Core).NumFrees == numFrees + 1);
+    #endif
+    #endif
+}
+
 TEST(CreatePtrBenchmark) {
 
     for (int i = 0; i < 3; i++) {
@@ -90,6 +151,44 @@ TEST(CreatePtrBenchmark) {
         Log::Info("run %d: %dx Ptr<TestClass> created: %f sec\n", i, numOuterLoop * maxLiveObjects, dur.count());
     }
 
+    for (int i = 0; i < 3; i++) {
+        chrono::time_point<chrono::system_clock> start, end;
+        start = chrono::system_clock::now();
+
+        const int maxLiveObjects = 65535;
+        const int numObjects = 1000000;
+        const int numOuterLoop = numObjects / maxLiveObjects;
+        for (int j = 0; j < numOuterLoop; j++) {
+            Array<Ptr<PoolTestClass>> objs;
+            objs.Reserve(maxLiveObjects);
+            for (int k = 0; k < maxLiveObjects; k++) {
+                objs.Add(PoolTestClass::Create());
+            }
+        }
+        end = chrono::system_clock::now();
+        chrono::duration<double> dur = end - start;
+        Log::Info("run %d: %dx Ptr<PoolTestClass> created: %f sec\n", i, numOuterLoop * maxLiveObjects, dur.count());
+    }
+
+    // create/release churn with few live objects (typical for IO messages)
+    for (int i = 0; i < 3; i++) {
+        const int numObjects = 1000000;
+        chrono::time_point<chrono::system_clock> start, end;
+        start = chrono::system_clock::now();
+        for (int j = 0; j < numObjects; j++) {
+            Ptr<TestClass> obj = TestClass::Create(j);
+        }
+        end = chrono::system_clock::now();
+        chrono::duration<double> heapDur = end - start;
+        start = chrono::system_clock::now();
+        for (int j = 0; j < numObjects; j++) {
+            Ptr<PoolTestClass> obj = PoolTestClass::Create(j);
+        }
+        end = chrono::system_clock::now();
+        chrono::duration<double> poolDur = end - start;
+        Log::Info("run %d: %dx create/release: heap %f sec, pool %f sec\n", i, numObjects, heapDur.count(), poolDur.count());
+    }
+
     for (int i = 0; i < 3; i++) {
         chrono::time_point<chrono::system_clock> start, end;
         start = chrono::system_clock::now();
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+//  FlatLookupMapTest.cc
+//  Test FlatLookupMap class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/FlatLookupMap.h"
+#include "Core/String/String.h"
+
+using namespace std;
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(FlatLookupMapTest) {
+    FlatLookupMap<int, int> empty;
+    CHECK(empty.Empty());
+    CHECK(empty.Size() == 0);
+    CHECK(!empty.Contains(1));
+    CHECK(empty.Find(1) == nullptr);
+
+    // all sizes up to a few complete tree levels
+    for (int num = 1; num < 70; num++) {
+        Map<int, int> map;
+        for (int i = 0; i < num; i++) {
+            map.Add(i * 2, i * 3);
+        }
+        FlatLookupMap<int, int> flat;
+        flat.Build(map);
+        CHECK(flat.Size() == num);
+        CHECK(!flat.Empty());
+        bool allFound = true;
+        for (int i = 0; i < num; i++) {
+            const int index = flat.FindIndex(i * 2);
+            allFound &= (InvalidIndex != index) && (flat.KeyAtIndex(index) == i * 2) && (flat.ValueAtIndex(index) == i * 3);
+            allFound &= !flat.Contains(i * 2 + 1);
+        }
+        CHECK(allFound);
+        CHECK(!flat.Contains(-1));
+        CHECK(!flat.Contains(num * 2));
+    }
+
+    // bulk mode with string keys
+    FlatLookupMap<String, int> strMap;
+    strMap.BeginBulk();
+    strMap.AddBulk("root:", 1);
+    strMap.AddBulk("res:", 2);
+    strMap.AddBulk("cwd:", 3);
+    strMap.AddBulk("http:", 4);
+    strMap.AddBulk("abc:", 5);
+    strMap.EndBulk();
+    CHECK(strMap.Size() == 5);
+    CHECK(strMap["root:"] == 1);
+    CHECK(strMap["res:"] == 2);
+    CHECK(strMap["cwd:"] == 3);
+    CHECK(strMap["http:"] == 4);
+    CHECK(strMap["abc:"] == 5);
+    CHECK(*strMap.Find("http:") == 4);
+    CHECK(strMap.Find("bla:") == nullptr);
+    CHECK(!strMap.Contains("zzz:"));
+    CHECK(!strMap.Contains("a:"));
+
+    // rebuild replaces content
+    strMap.BeginBulk();
+    strMap.AddBulk("bla:", 6);
+    strMap.EndBulk();
+    CHECK(strMap.Size() == 1);
+    CHECK(strMap["bla:"] == 6);
+    CHECK(!strMap.Contains("root:"));
+    strMap.Clear();
+    CHECK(strMap.Empty());
+}
+
+//------------------------------------------------------------------------------
+TEST(FlatLookupMapMissTest) {
+    // FindIndex() must agree with Map for hits and misses (2 out of 3 keys
+    // are missing), the lookup speed is timed in CoreBenchmarks
+    const int sizes[] = { 1, 7, 1000 };
+    for (int size : sizes) {
+        Map<int, int> map;
+        map.BeginBulk();
+        for (int i = 0; i < size; i++) {
+            map.AddBulk(i * 3, i);
+        }
+        map.EndBulk();
+        FlatLookupMap<int, int> flat;
+        flat.Build(map);
+        bool same = true;
+        for (int key = -1; key <= size * 3; key++) {
+            const int mapIndex = map.FindIndex(key);
+            const int flatIndex = flat.FindIndex(key);
+            same &= (InvalidIndex == mapIndex) == (InvalidIndex == flatIndex);
+            if ((InvalidIndex != mapIndex) && (InvalidIndex != flatIndex)) {
+                same &= map.ValueAtIndex(mapIndex) == flat.ValueAtIndex(flatIndex);
+            }
+        }
+        CHECK(same);
+    }
+}
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//  FrameArenaTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/String/StringBuilder.h"
+
+using namespace std;
+using namespace Oryol;
+
+TEST(FrameArenaTest) {
+    CHECK(!FrameArena::IsValid());
+    Core::Setup();
+    CHECK(FrameArena::IsValid());
+
+    FrameArena::Stats stats = FrameArena::QueryStats();
+    CHECK(stats.Capacity == ORYOL_FRAME_ARENA_SIZE);
+    CHECK(stats.UsedBytes == 0);
+    CHECK(stats.HighWaterMark == 0);
+    CHECK(stats.NumOverflows == 0);
+
+    // allocations are aligned and consecutive
+    uint8_t* p0 = (uint8_t*) FrameArena::Alloc(3);
+    uint8_t* p1 = (uint8_t*) FrameArena::Alloc(100);
+    CHECK((((intptr_t)p0) & (ORYOL_MAX_PLATFORM_ALIGN - 1)) == 0);
+    CHECK((((intptr_t)p1) & (ORYOL_MAX_PLATFORM_ALIGN - 1)) == 0);
+    CHECK(p1 == p0 + ORYOL_MAX_PLATFORM_ALIGN);
+    stats = FrameArena::QueryStats();
+    CHECK(stats.UsedBytes == Memory::RoundUp(3, ORYOL_MAX_PLATFORM_ALIGN) + Memory::RoundUp(100, ORYOL_MAX_PLATFORM_ALIGN));
+    const int firstFrameBytes = stats.UsedBytes;
+
+    // running the post-runloop resets the arena
+    Core::PostRunLoop()->Run();
+    stats = FrameArena::QueryStats();
+    CHECK(stats.UsedBytes == 0);
+    CHECK(stats.HighWaterMark == firstFrameBytes);
+    CHECK(FrameArena::Alloc(16) == p0);
+    Core::PostRunLoop()->Run();
+
+    // overflow falls back to the heap, and grows the arena on reset
+    void* big = FrameArena::Alloc(ORYOL_FRAME_ARENA_SIZE - 64);
+    void* ovf = FrameArena::Alloc(256);
+    CHECK(big == p0);
+    CHECK(ovf != nullptr);
+    stats = FrameArena::QueryStats();
+    CHECK(stats.NumOverflows == 1);
+    CHECK(stats.UsedBytes == ORYOL_FRAME_ARENA_SIZE - 64 + 256);
+    Memory::Fill(ovf, 256, 0x12);
+    Core::PostRunLoop()->Run();
+    stats = FrameArena::QueryStats();
+    CHECK(stats.UsedBytes == 0);
+    CHECK(stats.HighWaterMark == ORYOL_FRAME_ARENA_SIZE - 64 + 256);
+    CHECK(stats.Capacity == stats.HighWaterMark);
+
+    // over-aligned allocations, also in overflow chunks
+    const int alignments[] = { 16, 32, 64, 4096 };
+    for (int alignment : alignments) {
+        for (int i = 0; i < 4; i++) {
+            void* ptr = FrameArena::Alloc(7, alignment);
+            CHECK(Memory::IsAligned(ptr, alignment));
+        }
+        void* bigOvf = FrameArena::Alloc(ORYOL_FRAME_ARENA_SIZE * 2, alignment);
+        CHECK(Memory::IsAligned(bigOvf, alignment));
+        Memory::Fill(bigOvf, ORYOL_FRAME_ARENA_SIZE * 2, 0x34);
+    }
+    Core::PostRunLoop()->Run();
+    {
+        Array<float> arr;
+        arr.UseFrameArena();
+        arr.SetAlignment(64);
+        for (int i = 0; i < 100; i++) {
+            arr.Add(float(i));
+            CHECK(Memory::IsAligned(arr.begin(), 64));
+        }
+    }
+    Core::PostRunLoop()->Run();
+
+    // opt-in frame arena allocation for Array
+    {
+        Array<int> arr;
+        arr.UseFrameArena();
+        CHECK(arr.IsFrameArena());
+        for (int i = 0; i < 1000; i++) {
+            arr.Add(i);
+        }
+        CHECK(FrameArena::QueryStats().UsedBytes > 0);
+        for (int i = 0; i < 1000; i++) {
+            CHECK(arr[i] == i);
+        }
+        // a copy is allocated from the heap, a move keeps the arena memory
+        Array<int> copy(arr);
+        CHECK(!copy.IsFrameArena());
+        CHECK(copy.Size() == 1000);
+        Array<int> moved(std::move(arr));
+        CHECK(moved.IsFrameArena());
+        CHECK(!arr.IsFrameArena());
+        CHECK(moved[999] == 999);
+    }
+    // ...Buffer
+    {
+        Buffer buf;
+        buf.UseFrameArena();
+        CHECK(buf.IsFrameArena());
+        const uint8_t bytes[4] = { 1, 2, 3, 4 };
+        for (int i = 0; i < 100; i++) {
+            buf.Add(bytes, sizeof(bytes));
+        }
+        CHECK(buf.Size() == 400);
+        CHECK(buf.Data()[399] == 4);
+    }
+    // ...and StringBuilder
+    {
+        StringBuilder strBuilder;
+        strBuilder.UseFrameArena();
+        CHECK(strBuilder.IsFrameArena());
+        for (int i = 0; i < 100; i++) {
+            strBuilder.AppendFormat(32, "%d,", i);
+        }
+        String str = strBuilder.GetString();
+        CHECK(str.Length() == strBuilder.Length());
+        CHECK(str.Back() == ',');
+    }
+    Core::PostRunLoop()->Run();
+    CHECK(FrameArena::QueryStats().UsedBytes == 0);
+
+    Core::Discard();
+    CHECK(!FrameArena::IsValid());
+}
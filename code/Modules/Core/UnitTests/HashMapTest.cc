@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+//  HashMapTest.cc
+//  Test HashMap functionality.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/ArrayMap.h"
+#include "Core/String/String.h"
+#include "Core/String/StringAtom.h"
+
+using namespace std;
+using namespace Oryol;
+
+// a bad hash function which puts all keys into the same slot
+struct CollidingHasher {
+    uint32_t operator()(int val) const {
+        return 12345;
+    };
+};
+
+// generate a shuffled sequence of unique keys
+static void
+shuffledKeys(int* keys, int num) {
+    for (int i = 0; i < num; i++) {
+        keys[i] = i * 7;
+    }
+    uint32_t rnd = 12345;
+    for (int i = num - 1; i > 0; i--) {
+        rnd = rnd * 1103515245 + 12345;
+        std::swap(keys[i], keys[(rnd >> 8) % (i + 1)]);
+    }
+}
+
+TEST(HashMapTest) {
+
+    // test simple insertion of unique elements
+    HashMap<int, int> map;
+    CHECK(map.Size() == 0);
+    CHECK(map.Empty());
+    CHECK(map.Capacity() == 0);
+    CHECK(!map.Contains(1));
+    CHECK(map.Find(1) == nullptr);
+    CHECK(map.FindIndex(1) == InvalidIndex);
+    map.Add(0, 0);
+    map.Add(3, 3);
+    map.Add(8, 8);
+    map.Add(6, 6);
+    map.Add(4, 4);
+    map.Add(1, 1);
+    map.Add(2, 2);
+    map.Add(7, 7);
+    map.Add(5, 5);
+    CHECK(map.Size() == 9);
+    CHECK(map.Capacity() >= 9);
+    CHECK(!map.Empty());
+    CHECK(map.Contains(4));
+    CHECK(!map.Contains(11));
+    for (int i = 0; i < 9; i++) {
+        CHECK(map[i] == i);
+        CHECK(*map.Find(i) == i);
+    }
+    // elements are in insertion order
+    CHECK(map.KeyAtIndex(0) == 0);
+    CHECK(map.KeyAtIndex(1) == 3);
+    CHECK(map.ValueAtIndex(2) == 8);
+    CHECK(map.FindIndex(6) == 3);
+    map[6] = 60;
+    CHECK(map.ValueAtIndex(3) == 60);
+    map[6] = 6;
+
+    // AddUnique
+    CHECK(!map.AddUnique(3, 33));
+    CHECK(map[3] == 3);
+    CHECK(map.AddUnique(9, 9));
+    CHECK(map.Size() == 10);
+    CHECK(map[9] == 9);
+
+    // copy construct
+    HashMap<int, int> map1(map);
+    CHECK(map1.Size() == 10);
+    for (int i = 0; i < 10; i++) {
+        CHECK(map1[i] == i);
+        CHECK(map1.KeyAtIndex(i) == map.KeyAtIndex(i));
+    }
+
+    // copy-assign
+    HashMap<int, int> map2;
+    map2.Add(100, 100);
+    map2 = map;
+    CHECK(map2.Size() == 10);
+    CHECK(!map2.Contains(100));
+    for (int i = 0; i < 10; i++) {
+        CHECK(map2[i] == i);
+    }
+
+    // move-construct and move-assign
+    HashMap<int, int> map3(std::move(map1));
+    CHECK(map1.Empty());
+    CHECK(map1.Capacity() == 0);
+    CHECK(!map1.Contains(1));
+    CHECK(map3.Size() == 10);
+    map1 = std::move(map3);
+    CHECK(map3.Empty());
+    CHECK(map1.Size() == 10);
+    for (int i = 0; i < 10; i++) {
+        CHECK(map1[i] == i);
+    }
+    map1.Add(11, 11);
+    CHECK(map1[11] == 11);
+
+    // erase, the last element is moved into the hole
+    map.Erase(3);
+    CHECK(map.Size() == 9);
+    CHECK(!map.Contains(3));
+    CHECK(map.KeyAtIndex(1) == 9);
+    CHECK(map.FindIndex(9) == 1);
+    map.Erase(3);
+    CHECK(map.Size() == 9);
+    map.Erase(9);
+    CHECK(map.Size() == 8);
+    map.EraseIndex(0);
+    CHECK(map.Size() == 7);
+    CHECK(!map.Contains(0));
+    for (int i = 1; i < 9; i++) {
+        if (i != 3) {
+            CHECK(map[i] == i);
+            CHECK(map.ValueAtIndex(map.FindIndex(i)) == i);
+        }
+    }
+    int sum = 0;
+    for (const auto& kvp : map) {
+        CHECK(kvp.key == kvp.value);
+        sum += kvp.value;
+    }
+    CHECK(sum == 1 + 2 + 4 + 5 + 6 + 7 + 8);
+
+    // clear keeps capacity
+    const int capacity = map.Capacity();
+    map.Clear();
+    CHECK(map.Empty());
+    CHECK(map.Capacity() == capacity);
+    CHECK(!map.Contains(1));
+    map.Add(1, 1);
+    CHECK(map[1] == 1);
+
+    // reserve
+    HashMap<int, int> map4;
+    map4.Reserve(1000);
+    const int reservedCapacity = map4.Capacity();
+    CHECK(reservedCapacity >= 1000);
+    for (int i = 0; i < 1000; i++) {
+        map4.Add(i, i);
+    }
+    CHECK(map4.Capacity() == reservedCapacity);
+
+    // initializer list
+    HashMap<int, int> map5({ { 1, 2 }, { 3, 4 }, { 5, 6 } });
+    CHECK(map5.Size() == 3);
+    CHECK(map5[1] == 2);
+    CHECK(map5[3] == 4);
+    CHECK(map5[5] == 6);
+
+    // String and StringAtom keys
+    HashMap<String, int> strMap;
+    strMap.Add("Bla", 1);
+    strMap.Add("Blub", 2);
+    strMap.Add(String("Blob"), 3);
+    CHECK(strMap.Size() == 3);
+    CHECK(strMap["Bla"] == 1);
+    CHECK(strMap["Blub"] == 2);
+    CHECK(strMap["Blob"] == 3);
+    CHECK(!strMap.Contains("Blab"));
+    HashMap<StringAtom, int> atomMap;
+    atomMap.Add("Bla", 1);
+    atomMap.Add("Blub", 2);
+    CHECK(atomMap[StringAtom("Bla")] == 1);
+    CHECK(atomMap[StringAtom("Blub")] == 2);
+    CHECK(!atomMap.Contains(StringAtom("Blob")));
+}
+
+//------------------------------------------------------------------------------
+TEST(HashMapManyElementsTest) {
+    const int num = 10000;
+    int* keys = (int*) Memory::Alloc(num * sizeof(int));
+    shuffledKeys(keys, num);
+
+    // add many elements, the map grows
+    HashMap<int, int> map;
+    for (int i = 0; i < num; i++) {
+        map.Add(keys[i], i);
+    }
+    CHECK(map.Size() == num);
+    bool allFound = true;
+    for (int i = 0; i < num; i++) {
+        allFound &= map.Contains(keys[i]) && (map[keys[i]] == i);
+        allFound &= !map.Contains(keys[i] + 1);
+    }
+    CHECK(allFound);
+
+    // erase every other element
+    for (int i = 0; i < num; i += 2) {
+        map.Erase(keys[i]);
+    }
+    CHECK(map.Size() == num / 2);
+    allFound = true;
+    for (int i = 0; i < num; i++) {
+        if (i & 1) {
+            allFound &= (map[keys[i]] == i);
+            allFound &= (map.KeyAtIndex(map.FindIndex(keys[i])) == keys[i]);
+        }
+        else {
+            allFound &= !map.Contains(keys[i]);
+        }
+    }
+    CHECK(allFound);
+
+    // ...and add them again
+    for (int i = 0; i < num; i += 2) {
+        CHECK(map.AddUnique(keys[i], i));
+    }
+    CHECK(map.Size() == num);
+    allFound = true;
+    for (int i = 0; i < num; i++) {
+        allFound &= (map[keys[i]] == i);
+    }
+    CHECK(allFound);
+
+    // a hasher with only collisions still works (slowly)
+    HashMap<int, int, CollidingHasher> badMap;
+    for (int i = 0; i < 100; i++) {
+        badMap.Add(keys[i], i);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        badMap.Erase(keys[i]);
+    }
+    for (int i = 0; i < 100; i++) {
+        if ((i % 3) == 0) {
+            CHECK(!badMap.Contains(keys[i]));
+        }
+        else {
+            CHECK(badMap[keys[i]] == i);
+        }
+    }
+    Memory::Free(keys);
+}
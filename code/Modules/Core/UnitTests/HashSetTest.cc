@@ -137,3 +137,62 @@ TEST(HashSetTest) {
     CHECK(hashSet4.Size() == 0);
     CHECK(!hashSet4.Contains(10));
 }
+
+TEST(HashSetGrowTest) {
+
+    // default hash function, the hash set grows dynamically
+    const int num = 10000;
+    HashSet<int> hashSet;
+    CHECK(hashSet.Capacity() == 0);
+    for (int i = 0; i < num; i++) {
+        hashSet.Add(i * 3);
+    }
+    CHECK(hashSet.Size() == num);
+    CHECK(hashSet.Capacity() >= num);
+    bool allFound = true;
+    for (int i = 0; i < num; i++) {
+        allFound &= hashSet.Contains(i * 3);
+        allFound &= !hashSet.Contains(i * 3 + 1);
+        allFound &= (*hashSet.Find(i * 3) == i * 3);
+    }
+    CHECK(allFound);
+
+    // erase every other element
+    for (int i = 0; i < num; i += 2) {
+        hashSet.Erase(i * 3);
+    }
+    hashSet.Erase(-1);
+    CHECK(hashSet.Size() == num / 2);
+    allFound = true;
+    for (int i = 0; i < num; i++) {
+        allFound &= (hashSet.Contains(i * 3) == ((i & 1) != 0));
+    }
+    CHECK(allFound);
+    int count = 0;
+    for (int val : hashSet) {
+        CHECK((val % 6) == 3);
+        count++;
+    }
+    CHECK(count == num / 2);
+
+    // clear keeps capacity
+    const int capacity = hashSet.Capacity();
+    hashSet.Clear();
+    CHECK(hashSet.Empty());
+    CHECK(hashSet.Capacity() == capacity);
+    CHECK(!hashSet.Contains(3));
+
+    // initial capacity and reserve
+    HashSet<int, IntHasher, 100> hashSet1;
+    CHECK(hashSet1.Capacity() == 0);
+    hashSet1.Add(1);
+    CHECK(hashSet1.Capacity() >= 100);
+    HashSet<int> hashSet2;
+    hashSet2.Reserve(1000);
+    const int reserved = hashSet2.Capacity();
+    CHECK(reserved >= 1000);
+    for (int i = 0; i < 1000; i++) {
+        hashSet2.Add(i);
+    }
+    CHECK(hashSet2.Capacity() == reserved);
+}
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+//  HashTest.cc
+//  Test the Core hash functions.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Hash.h"
+#include "Core/String/String.h"
+#include "Core/String/StringAtom.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Sort.h"
+#include "Core/Log.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+using namespace Oryol;
+
+namespace {
+
+// the previous StringAtom hash (one-at-a-time), for comparison
+uint32_t oneAtATime(const char* str, int len) {
+    uint32_t h = 0;
+    for (int i = 0; i < len; i++) {
+        h += uint32_t(str[i]);
+        h += (h << 10);
+        h ^= (h >> 6);
+    }
+    h += (h << 3);
+    h ^= (h >> 11);
+    h += (h << 15);
+    return h;
+}
+
+// the previous container hash (FNV-1a), for comparison
+uint32_t fnv1a(const char* str, int len) {
+    uint32_t h = 2166136261U;
+    for (int i = 0; i < len; i++) {
+        h ^= uint8_t(str[i]);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+// build a corpus of asset paths from the asset names used by the samples
+Array<String> assetPaths() {
+    static const char* prefixes[] = {
+        "res:", "tex:", "data:", "http://floooh.github.io/oryol/data/"
+    };
+    static const char* dirs[] = {
+        "", "textures/", "textures/characters/", "textures/environment/lok/",
+        "meshes/", "shaders/", "audio/music/", "levels/level_01/props/"
+    };
+    static const char* names[] = {
+        "lok_dxt1.dds", "lok_dxt3.dds", "lok_dxt5.dds", "lok_abgr1555.dds",
+        "lok_abgr4.dds", "lok_argb1555.dds", "lok_argb4.dds", "lok_bgr565.dds",
+        "lok_bgr8.dds", "lok_bgra8.dds", "lok_bpp2.pvr", "lok_bpp4.pvr",
+        "lok_etc2.ktx", "lok_rgb565.dds", "lok_rgb8.dds", "lok_rgba8.dds",
+        "romechurch_bpp2.pvr", "romechurch_dxt1.dds", "blablabla.xxx",
+        "dragon.omsh", "tiger.orb", "cube.n3"
+    };
+    Array<String> paths;
+    char buf[256];
+    for (const char* prefix : prefixes) {
+        for (const char* dir : dirs) {
+            for (const char* name : names) {
+                for (int variant = 0; variant < 150; variant++) {
+                    std::snprintf(buf, sizeof(buf), "%s%s%d/%s", prefix, dir, variant, name);
+                    paths.Add(buf);
+                }
+            }
+        }
+    }
+    return paths;
+}
+
+// count the number of equal neighbours in a sorted array
+template<class TYPE> int numCollisions(Array<TYPE>& hashes) {
+    Sort::Auto(hashes.begin(), hashes.end());
+    int num = 0;
+    for (int i = 1; i < hashes.Size(); i++) {
+        if (hashes[i] == hashes[i - 1]) {
+            num++;
+        }
+    }
+    return num;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+TEST(HashBytes64Test) {
+    // the portable 128-bit multiplication is correct
+    CHECK(_priv::hashMulHi(0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL) == 0xFFFFFFFFFFFFFFFEULL);
+    CHECK(_priv::hashMulHi(1ULL << 32, 1ULL << 32) == 1);
+    CHECK(_priv::hashMulHi(0x123456789ABCDEF0ULL, 3) == 0);
+    CHECK(_priv::hashMulLo(0x123456789ABCDEF0ULL, 3) == 0x369D0369D0369CD0ULL);
+    #if defined(__SIZEOF_INT128__)
+    uint64_t a = 0x2d358dccaa6c78a5ULL, b = 0x8bb84b93962eacc9ULL;
+    bool mulOk = true;
+    for (int i = 0; i < 1000; i++) {
+        const unsigned __int128 r = (unsigned __int128)a * b;
+        mulOk &= _priv::hashMulHi(a, b) == uint64_t(r >> 64);
+        mulOk &= _priv::constHashMix(a, b) == _priv::hashMix(a, b);
+        a = _priv::hashMix(a, i);
+        b = _priv::hashMix(b, a);
+    }
+    CHECK(mulOk);
+    #endif
+
+    // the compile-time hash matches the runtime hash for all code paths
+    static_assert(HashLiteral64("abc") != HashLiteral64("abd"), "HashLiteral64() must be constexpr");
+    #define CHECK_LITERAL(str) CHECK(HashLiteral64(str) == HashBytes64(str, sizeof(str) - 1))
+    CHECK_LITERAL("");
+    CHECK_LITERAL("a");
+    CHECK_LITERAL("ab");
+    CHECK_LITERAL("abc");
+    CHECK_LITERAL("abcd");
+    CHECK_LITERAL("abcdefg");
+    CHECK_LITERAL("abcdefgh");
+    CHECK_LITERAL("abcdefghi");
+    CHECK_LITERAL("abcdefghijklmno");
+    CHECK_LITERAL("abcdefghijklmnop");
+    CHECK_LITERAL("abcdefghijklmnopq");
+    CHECK_LITERAL("abcdefghijklmnopqrstuvwxyz01234");
+    CHECK_LITERAL("abcdefghijklmnopqrstuvwxyz012345");
+    CHECK_LITERAL("abcdefghijklmnopqrstuvwxyz0123456");
+    CHECK_LITERAL("http://floooh.github.io/oryol/data/textures/characters/lok_dxt1.dds");
+    CHECK_LITERAL("\xe4\xf6\xfc\xff\x80");
+    #undef CHECK_LITERAL
+    CHECK(HashLiteral64("abc", 123) == HashBytes64("abc", 3, 123));
+    CHECK(HashLiteral64("abcdefghijklmnopqrstuvwxyz", 123) == HashBytes64("abcdefghijklmnopqrstuvwxyz", 26, 123));
+
+    // the seed changes the hash, the 32-bit hash is the lower half
+    const char* str = "tex:lok_dxt1.dds";
+    const int len = int(std::strlen(str));
+    CHECK(HashBytes64(str, len) != HashBytes64(str, len, 1));
+    CHECK(HashBytes(str, len) == uint32_t(HashBytes64(str, len)));
+    CHECK(Hash<String>()(String(str)) == HashBytes(str, len));
+    CHECK(Hash<StringAtom>()(StringAtom(str)) == HashBytes(str, len));
+
+    // the hash doesn't depend on the alignment of the data
+    char buf[128];
+    bool alignOk = true;
+    for (int offset = 0; offset < 16; offset++) {
+        for (int n = 0; n < 100; n++) {
+            for (int i = 0; i < n; i++) {
+                buf[offset + i] = char('A' + ((i * 7) % 26));
+            }
+            char ref[128];
+            Memory::Copy(&buf[offset], ref, n);
+            alignOk &= HashBytes64(&buf[offset], n) == HashBytes64(ref, n);
+        }
+    }
+    CHECK(alignOk);
+
+    // flipping a single bit changes about half of the hash bits
+    char data[64];
+    for (int i = 0; i < 64; i++) {
+        data[i] = char(i * 13);
+    }
+    for (int len = 1; len <= 64; len += 7) {
+        const uint64_t h0 = HashBytes64(data, len);
+        int minBits = 64, maxBits = 0;
+        for (int bit = 0; bit < len * 8; bit++) {
+            data[bit >> 3] ^= char(1 << (bit & 7));
+            const uint64_t diff = h0 ^ HashBytes64(data, len);
+            data[bit >> 3] ^= char(1 << (bit & 7));
+            int numBits = 0;
+            for (int i = 0; i < 64; i++) {
+                numBits += int((diff >> i) & 1);
+            }
+            minBits = numBits < minBits ? numBits : minBits;
+            maxBits = numBits > maxBits ? numBits : maxBits;
+        }
+        CHECK(minBits >= 12);
+        CHECK(maxBits <= 52);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(HashCollisionTest) {
+    Array<String> paths = assetPaths();
+    Array<uint64_t> hashes64;
+    Array<uint32_t> hashes32, hashesOAT, hashesFNV;
+    for (const String& path : paths) {
+        const uint64_t h = HashBytes64(path.AsCStr(), path.Length());
+        hashes64.Add(h);
+        hashes32.Add(uint32_t(h));
+        hashesOAT.Add(oneAtATime(path.AsCStr(), path.Length()));
+        hashesFNV.Add(fnv1a(path.AsCStr(), path.Length()));
+    }
+    // no collisions at all in the full 64-bit hash
+    CHECK(numCollisions(hashes64) == 0);
+    // the expected number of 32-bit collisions is n^2 / 2^33
+    const int num32 = numCollisions(hashes32);
+    const double expected = (double(paths.Size()) * double(paths.Size())) / 8589934592.0;
+    CHECK(num32 < 10);
+    Log::Info("%d asset paths, 32-bit collisions (expected %.1f): HashBytes %d, one-at-a-time %d, FNV-1a %d\n",
+        paths.Size(), expected, num32, numCollisions(hashesOAT), numCollisions(hashesFNV));
+}
@@ -5,6 +5,7 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/Containers/Map.h"
+#include "Core/Containers/Array.h"
 #include "Core/String/String.h"
 
 using namespace Oryol;
@@ -164,3 +165,57 @@ TEST(MapTest) {
     CHECK(map_il["Wittiness Level"] == "Not very high");
     CHECK(map_il["Test Effectiveness"] == "Pretty Meh");
 }
+
+//------------------------------------------------------------------------------
+TEST(MapBulkTest) {
+    // add parallel keys/values to an empty map
+    const int keys0[] = { 5, 1, 4, 2, 3 };
+    const String values0[] = { "five", "one", "four", "two", "three" };
+    Map<int, String> map;
+    map.AddBulk(Slice<const int>(keys0, 5), Slice<const String>(values0, 5));
+    CHECK(map.Size() == 5);
+    for (int i = 0; i < 5; i++) {
+        CHECK(map.KeyAtIndex(i) == i + 1);
+    }
+    CHECK(map[4] == "four");
+
+    // merge into a map with existing elements
+    const int keys1[] = { 9, 0, 3, 7 };
+    const String values1[] = { "nine", "zero", "three", "seven" };
+    map.AddBulk(Slice<const int>(keys1, 4), Slice<const String>(values1, 4));
+    CHECK(map.Size() == 9);
+    const int expected[] = { 0, 1, 2, 3, 3, 4, 5, 7, 9 };
+    bool sorted = true;
+    for (int i = 0; i < 9; i++) {
+        sorted &= map.KeyAtIndex(i) == expected[i];
+    }
+    CHECK(sorted);
+    CHECK(map.FindDuplicate(0) == 3);
+    CHECK(map[9] == "nine");
+    CHECK(map[0] == "zero");
+
+    // key/value pairs
+    const KeyValuePair<int, String> kvps[] = { { 8, "eight" }, { 6, "six" } };
+    map.AddBulk(Slice<const KeyValuePair<int, String>>(kvps, 2));
+    CHECK(map.Size() == 11);
+    CHECK(map.KeyAtIndex(8) == 7);
+    CHECK(map[6] == "six");
+    CHECK(map[8] == "eight");
+
+    // in bulk mode, sorting only happens in EndBulk()
+    Map<int, int> map1;
+    Array<int> keys2, values2;
+    for (int i = 0; i < 1000; i++) {
+        keys2.Add(999 - i);
+        values2.Add(i);
+    }
+    map1.BeginBulk();
+    map1.AddBulk(keys2.MakeSlice(0, 500), values2.MakeSlice(0, 500));
+    map1.AddBulk(keys2.MakeSlice(500), values2.MakeSlice(500));
+    map1.EndBulk();
+    CHECK(map1.Size() == 1000);
+    CHECK(map1.KeyAtIndex(0) == 0);
+    CHECK(map1.KeyAtIndex(999) == 999);
+    CHECK(map1[0] == 999);
+    CHECK(map1[999] == 0);
+}
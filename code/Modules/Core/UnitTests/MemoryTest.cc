@@ -5,7 +5,10 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
 #include "Core/Assertion.h"
+#include "Core/Core.h"
+#include <cstdlib>
 
 using namespace Oryol;
 
@@ -75,4 +78,117 @@ TEST(Memory) {
     CHECK((intptr_t(ptr) & (ORYOL_MAX_PLATFORM_ALIGN - 1)) == 0);
 }
 
+//------------------------------------------------------------------------------
+TEST(MemoryAligned) {
+    const int alignments[] = { 16, 32, 64, 4096 };
+    for (int alignment : alignments) {
+        uint8_t* ptrs[8];
+        for (int i = 0; i < 8; i++) {
+            const int numBytes = 1 + i * 37;
+            ptrs[i] = (uint8_t*) Memory::AllocAligned(numBytes, alignment);
+            CHECK(nullptr != ptrs[i]);
+            CHECK(Memory::IsAligned(ptrs[i], alignment));
+            CHECK((intptr_t(ptrs[i]) & (alignment - 1)) == 0);
+            // all bytes must be usable
+            Memory::Fill(ptrs[i], numBytes, uint8_t(i));
+        }
+        for (int i = 0; i < 8; i++) {
+            Memory::FreeAligned(ptrs[i]);
+        }
+    }
+    Memory::FreeAligned(nullptr);
+
+    CHECK(Memory::IsAligned((void*)0x1000, 4096));
+    CHECK(!Memory::IsAligned((void*)0x1020, 64));
+    CHECK(Memory::IsAligned((void*)0x1020, 32));
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_MEMORY_STATS
+TEST(MemoryStats) {
+
+    // Core module counters must balance after Setup/Discard (Discard also
+    // frees the thread's pool allocator cache, which earlier tests created)
+    PoolAllocator::FlushThreadCache();
+    const Memory::Stats before = Memory::QueryStats(MemoryTag::Core);
+    Core::Setup();
+    const Memory::Stats during = Memory::QueryStats(MemoryTag::Core);
+    CHECK(during.LiveBytes > before.LiveBytes);
+    CHECK(during.NumAllocs > before.NumAllocs);
+    CHECK(during.PeakBytes >= during.LiveBytes);
+    Core::Discard();
+    const Memory::Stats after = Memory::QueryStats(MemoryTag::Core);
+    CHECK(after.LiveBytes == before.LiveBytes);
+    CHECK((after.NumAllocs - before.NumAllocs) == (after.NumFrees - before.NumFrees));
+    CHECK(after.PeakBytes >= during.LiveBytes);
+
+    // allocations are attributed to the current tag
+    CHECK(Memory::GetTag() == MemoryTag::App);
+    void* ptr = nullptr;
+    const Memory::Stats gfx0 = Memory::QueryStats(MemoryTag::Gfx);
+    {
+        o_memory_tag(MemoryTag::Gfx);
+        CHECK(Memory::GetTag() == MemoryTag::Gfx);
+        ptr = Memory::Alloc(100);
+    }
+    CHECK(Memory::GetTag() == MemoryTag::App);
+    const Memory::Stats gfx1 = Memory::QueryStats(MemoryTag::Gfx);
+    CHECK(gfx1.LiveBytes == (gfx0.LiveBytes + 100));
+    CHECK(gfx1.NumAllocs == (gfx0.NumAllocs + 1));
 
+    // ReAlloc and Free go to the original tag
+    {
+        o_memory_tag(MemoryTag::IO);
+        ptr = Memory::ReAlloc(ptr, 200);
+    }
+    CHECK(Memory::QueryStats(MemoryTag::Gfx).LiveBytes == (gfx0.LiveBytes + 200));
+    Memory::Free(ptr);
+    const Memory::Stats gfx2 = Memory::QueryStats(MemoryTag::Gfx);
+    CHECK(gfx2.LiveBytes == gfx0.LiveBytes);
+    CHECK(gfx2.NumFrees == (gfx0.NumFrees + 1));
+    CHECK(gfx2.PeakBytes >= (gfx0.LiveBytes + 200));
+}
+#endif
+
+//------------------------------------------------------------------------------
+static int numTestAllocs = 0;
+static int numTestReAllocs = 0;
+static int numTestFrees = 0;
+
+TEST(MemoryAllocator) {
+
+    Memory::Allocator allocator;
+    allocator.Alloc = [](void* userData, int64_t numBytes) -> void* {
+        (*(int*)userData)++;
+        numTestAllocs++;
+        return std::malloc(numBytes);
+    };
+    allocator.ReAlloc = [](void* userData, void* ptr, int64_t numBytes) -> void* {
+        numTestReAllocs++;
+        return std::realloc(ptr, numBytes);
+    };
+    allocator.Free = [](void* userData, void* ptr) {
+        numTestFrees++;
+        std::free(ptr);
+    };
+    int userCounter = 0;
+    allocator.UserData = &userCounter;
+    Memory::SetAllocator(allocator);
+
+    void* p0 = Memory::Alloc(32);
+    void* p1 = Memory::Alloc(64);
+    CHECK(numTestAllocs == 2);
+    CHECK(userCounter == 2);
+    p1 = Memory::ReAlloc(p1, 128);
+    CHECK(numTestReAllocs == 1);
+    Memory::Free(p0);
+    Memory::Free(p1);
+    Memory::Free(nullptr);
+    CHECK(numTestFrees == 2);
+
+    Memory::ResetAllocator();
+    void* p2 = Memory::Alloc(32);
+    Memory::Free(p2);
+    CHECK(numTestAllocs == 2);
+    CHECK(numTestFrees == 2);
+}
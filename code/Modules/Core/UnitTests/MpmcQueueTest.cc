@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//  MpmcQueueTest.cc
+//  Test multi-producer/multi-consumer queue.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/MpmcQueue.h"
+#include <thread>
+#include <atomic>
+
+using namespace std;
+using namespace Oryol;
+
+static const int numProducers = 4;
+static const int numConsumers = 4;
+static const int numPerProducer = 250000;
+
+// counts live objects to check that all elements are destroyed
+static int numLive = 0;
+struct mpmcTestObj {
+    mpmcTestObj() : val(0) { numLive++; };
+    mpmcTestObj(int v) : val(v) { numLive++; };
+    mpmcTestObj(const mpmcTestObj& rhs) : val(rhs.val) { numLive++; };
+    ~mpmcTestObj() { numLive--; };
+    void operator=(const mpmcTestObj& rhs) { val = rhs.val; };
+    int val;
+};
+
+TEST(MpmcQueueTest) {
+    {
+        MpmcQueue<mpmcTestObj> queue(6);
+        CHECK(queue.Capacity() == 8);
+        CHECK(queue.Empty());
+        CHECK(numLive == 0);
+        mpmcTestObj obj;
+        CHECK(!queue.TryDequeue(obj));
+        int enqueued = 0;
+        int dequeued = 0;
+        for (int round = 0; round < 5; round++) {
+            while (queue.TryEnqueue(mpmcTestObj(enqueued))) {
+                enqueued++;
+            }
+            CHECK(queue.Size() == 8);
+            CHECK(numLive == 9);
+            for (int i = 0; i < 6; i++) {
+                CHECK(queue.TryDequeue(obj));
+                CHECK(obj.val == dequeued++);
+            }
+            CHECK(queue.Size() == 2);
+        }
+    }
+    // destructor destroys remaining elements
+    CHECK(numLive == 0);
+}
+
+TEST(MpmcQueueStress) {
+    // several producers and consumers, values encode producer and sequence number,
+    // each consumer must see the values of each producer in order
+    MpmcQueue<int> queue(256);
+    std::atomic<int> numDequeued(0);
+    std::atomic<int64_t> sum(0);
+    std::atomic<int> numOrderErrors(0);
+    std::thread producers[numProducers];
+    std::thread consumers[numConsumers];
+    for (int c = 0; c < numConsumers; c++) {
+        consumers[c] = std::thread([&]() {
+            int lastSeq[numProducers];
+            for (int p = 0; p < numProducers; p++) {
+                lastSeq[p] = -1;
+            }
+            int64_t localSum = 0;
+            int val = 0;
+            while (numDequeued.load() < numProducers * numPerProducer) {
+                if (queue.TryDequeue(val)) {
+                    const int p = val >> 24;
+                    const int seq = val & 0xFFFFFF;
+                    if (seq <= lastSeq[p]) {
+                        numOrderErrors++;
+                    }
+                    lastSeq[p] = seq;
+                    localSum += seq;
+                    numDequeued++;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += localSum;
+        });
+    }
+    for (int p = 0; p < numProducers; p++) {
+        producers[p] = std::thread([&queue, p]() {
+            for (int i = 0; i < numPerProducer; i++) {
+                queue.WaitEnqueue((p << 24) | i);
+            }
+        });
+    }
+    for (int p = 0; p < numProducers; p++) {
+        producers[p].join();
+    }
+    for (int c = 0; c < numConsumers; c++) {
+        consumers[c].join();
+    }
+    CHECK(numDequeued == numProducers * numPerProducer);
+    CHECK(sum == numProducers * ((int64_t(numPerProducer) * (numPerProducer - 1)) / 2));
+    CHECK(numOrderErrors == 0);
+    CHECK(queue.Empty());
+
+    // blocking dequeue with several consumers
+    std::atomic<int> numReceived(0);
+    for (int c = 0; c < numConsumers; c++) {
+        consumers[c] = std::thread([&queue, &numReceived]() {
+            int val = 0;
+            do {
+                queue.WaitDequeue(val);
+                numReceived++;
+            }
+            while (val >= 0);
+        });
+    }
+    for (int p = 0; p < numProducers; p++) {
+        producers[p] = std::thread([&queue]() {
+            for (int i = 0; i < 10000; i++) {
+                queue.WaitEnqueue(int(i));
+            }
+        });
+    }
+    for (int p = 0; p < numProducers; p++) {
+        producers[p].join();
+    }
+    // one stop-value per consumer
+    for (int c = 0; c < numConsumers; c++) {
+        queue.WaitEnqueue(-1);
+    }
+    for (int c = 0; c < numConsumers; c++) {
+        consumers[c].join();
+    }
+    CHECK(numReceived == numProducers * 10000 + numConsumers);
+}
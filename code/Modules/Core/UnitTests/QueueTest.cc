@@ -6,7 +6,10 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/Containers/Queue.h"
 #include "Core/String/StringAtom.h"
+#include "Core/String/String.h"
+#include <cstdio>
 
+using namespace std;
 using namespace Oryol;
 
 TEST(QueueTest) {
@@ -88,4 +91,76 @@ TEST(QueueTest) {
     CHECK(queue3.GetMinGrow() == 0);
     CHECK(queue3.GetMaxGrow() == 0);
 }
-    
+
+TEST(QueueWrapAroundTest) {
+    // non-power-of-2 capacities are rounded up
+    Queue<String> queue;
+    queue.SetFixedCapacity(5);
+    CHECK(queue.Capacity() == 8);
+    CHECK(queue.SpareEnqueue() == 8);
+
+    // push elements through the queue so that they wrap around the buffer end
+    char buf[16];
+    int enqueued = 0;
+    int dequeued = 0;
+    for (int round = 0; round < 10; round++) {
+        while (queue.SpareEnqueue() > 0) {
+            snprintf(buf, sizeof(buf), "%d", enqueued++);
+            queue.Enqueue(String(buf));
+        }
+        CHECK(queue.Size() == 8);
+        snprintf(buf, sizeof(buf), "%d", enqueued - 1);
+        CHECK(queue.Back() == buf);
+        for (int i = 0; i < 3; i++) {
+            snprintf(buf, sizeof(buf), "%d", dequeued++);
+            CHECK(queue.Front() == buf);
+            CHECK(queue.Dequeue() == buf);
+        }
+        CHECK(queue.Size() == 5);
+        CHECK(queue.Capacity() == 8);
+    }
+
+    // copy a wrapped-around queue
+    Queue<String> queue1(queue);
+    CHECK(queue1.Size() == 5);
+    for (int i = 0; i < 5; i++) {
+        snprintf(buf, sizeof(buf), "%d", dequeued + i);
+        CHECK(queue1.Dequeue() == buf);
+    }
+    CHECK(queue1.Empty());
+
+    // grow a wrapped-around queue
+    queue.SetAllocStrategy(4, 16);
+    for (int i = 0; i < 8; i++) {
+        snprintf(buf, sizeof(buf), "%d", enqueued++);
+        queue.Enqueue(String(buf));
+    }
+    CHECK(queue.Size() == 13);
+    CHECK(queue.Capacity() == 16);
+    while (!queue.Empty()) {
+        snprintf(buf, sizeof(buf), "%d", dequeued++);
+        CHECK(queue.Dequeue() == buf);
+    }
+    CHECK(dequeued == enqueued);
+    queue.Clear();
+    CHECK(queue.Empty());
+}
+
+TEST(QueueChurnTest) {
+    // steady-state dequeue/enqueue on a half-full fixed-capacity queue,
+    // like the free-slot queue of a resource pool (timed in CoreBenchmarks)
+    const int capacity = 1024;
+    Queue<int> queue;
+    queue.SetFixedCapacity(capacity);
+    for (int i = 0; i < capacity / 2; i++) {
+        queue.Enqueue(i);
+    }
+    bool inOrder = true;
+    for (int i = 0; i < capacity * 4; i++) {
+        inOrder &= queue.Dequeue() == i;
+        queue.Enqueue(capacity / 2 + i);
+    }
+    CHECK(inOrder);
+    CHECK(queue.Size() == capacity / 2);
+    CHECK(queue.Capacity() == capacity);
+}
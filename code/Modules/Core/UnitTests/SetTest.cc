@@ -5,6 +5,7 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/Containers/Set.h"
+#include "Core/String/String.h"
 
 using namespace Oryol;
 
@@ -92,3 +93,36 @@ TEST(SetTest) {
     CHECK(set2.ValueAtIndex(1) == 1);
     CHECK(set2.ValueAtIndex(2) == 2);
 }
+
+//------------------------------------------------------------------------------
+TEST(SetBulkTest) {
+    const int vals0[] = { 7, 3, 5, 1 };
+    Set<int> set;
+    set.AddBulk(Slice<const int>(vals0, 4));
+    CHECK(set.Size() == 4);
+    CHECK((set.ValueAtIndex(0) == 1) && (set.ValueAtIndex(3) == 7));
+
+    // merged into existing values
+    const int vals1[] = { 6, 0, 8, 2 };
+    set.AddBulk(Slice<const int>(vals1, 4));
+    CHECK(set.Size() == 8);
+    bool sorted = true;
+    const int expected[] = { 0, 1, 2, 3, 5, 6, 7, 8 };
+    for (int i = 0; i < 8; i++) {
+        sorted &= set.ValueAtIndex(i) == expected[i];
+    }
+    CHECK(sorted);
+    CHECK(set.Contains(5));
+    CHECK(!set.Contains(4));
+
+    // bulk mode
+    Set<String> set1;
+    const String strs[] = { "C", "A", "B" };
+    set1.BeginBulk();
+    set1.AddBulk(Slice<const String>(strs, 3));
+    set1.AddBulk("D");
+    set1.EndBulk();
+    CHECK(set1.Size() == 4);
+    CHECK(set1.ValueAtIndex(0) == "A");
+    CHECK(set1.ValueAtIndex(3) == "D");
+}
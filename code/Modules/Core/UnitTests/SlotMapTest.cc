@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+//  SlotMapTest.cc
+//  Test SlotMap class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SlotMap.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/String/String.h"
+
+using namespace Oryol;
+
+TEST(SlotMapTest) {
+    SlotHandle invalid;
+    CHECK(!invalid.IsValid());
+
+    SlotMap<String> map;
+    CHECK(map.Empty());
+    CHECK(map.Size() == 0);
+    CHECK(!map.Contains(invalid));
+    CHECK(nullptr == map.Lookup(invalid));
+
+    // add elements
+    SlotHandle h0 = map.Add(String("zero"));
+    SlotHandle h1 = map.Add(String("one"));
+    const String two("two");
+    SlotHandle h2 = map.Add(two);
+    CHECK(h0.IsValid() && h1.IsValid() && h2.IsValid());
+    CHECK(h0 != h1);
+    CHECK(map.Size() == 3);
+    CHECK(map.NumSlots() == 3);
+    CHECK(map.Contains(h0) && map.Contains(h1) && map.Contains(h2));
+    CHECK(map[h0] == "zero");
+    CHECK(map[h1] == "one");
+    CHECK(*map.Lookup(h2) == "two");
+
+    // erase from the middle, the last element is swapped in
+    map.Erase(h1);
+    CHECK(map.Size() == 2);
+    CHECK(!map.Contains(h1));
+    CHECK(nullptr == map.Lookup(h1));
+    CHECK(map[h0] == "zero");
+    CHECK(map[h2] == "two");
+    CHECK(map.ValueAtIndex(1) == "two");
+    CHECK(map.HandleAtIndex(1) == h2);
+    // erasing a stale handle does nothing
+    map.Erase(h1);
+    CHECK(map.Size() == 2);
+
+    // a new element reuses the slot, but with a new generation
+    SlotHandle h3 = map.Add(String("three"));
+    CHECK(h3.Index == h1.Index);
+    CHECK(h3.Generation != h1.Generation);
+    CHECK(!map.Contains(h1));
+    CHECK(map[h3] == "three");
+    CHECK(map.NumSlots() == 3);
+
+    // dense iteration
+    int num = 0;
+    for (const String& str : map) {
+        CHECK(!str.Empty());
+        num++;
+    }
+    CHECK(num == 3);
+    for (int i = 0; i < map.Size(); i++) {
+        CHECK(map[map.HandleAtIndex(i)] == map.ValueAtIndex(i));
+    }
+
+    // clear invalidates all handles
+    map.Clear();
+    CHECK(map.Empty());
+    CHECK(!map.Contains(h0));
+    CHECK(!map.Contains(h2));
+    CHECK(!map.Contains(h3));
+    SlotHandle h4 = map.Add(String("four"));
+    CHECK(map.NumSlots() == 3);
+    CHECK(map[h4] == "four");
+
+    // handles can be used as hash keys
+    HashMap<SlotHandle, int> handleMap;
+    handleMap.Add(h4, 4);
+    CHECK(handleMap[h4] == 4);
+    CHECK(!handleMap.Contains(h3));
+}
+
+TEST(SlotMapGrowTest) {
+    // handles stay valid while the slot map grows
+    const int num = 10000;
+    SlotMap<int> map;
+    Array<SlotHandle> handles;
+    for (int i = 0; i < num; i++) {
+        handles.Add(map.Add(i));
+    }
+    CHECK(map.Size() == num);
+    for (int i = 0; i < num; i++) {
+        CHECK(map[handles[i]] == i);
+    }
+    // erase every other element, the remaining handles stay valid
+    for (int i = 0; i < num; i += 2) {
+        map.Erase(handles[i]);
+    }
+    CHECK(map.Size() == num / 2);
+    int numFailed = 0;
+    for (int i = 0; i < num; i++) {
+        if (map.Contains(handles[i]) != ((i & 1) == 1)) {
+            numFailed++;
+        }
+        else if ((i & 1) && (map[handles[i]] != i)) {
+            numFailed++;
+        }
+    }
+    CHECK(numFailed == 0);
+    // refill, slots are reused
+    map.Reserve(num / 2);
+    for (int i = 0; i < num / 2; i++) {
+        map.Add(-i);
+    }
+    CHECK(map.Size() == num);
+    CHECK(map.NumSlots() == num);
+    int sum = 0;
+    for (int val : map) {
+        sum += val;
+    }
+    // odd values 1..num-1 plus negative values 0..-(num/2-1)
+    CHECK(sum == (num / 2) * (num / 2) - ((num / 2) * (num / 2 - 1)) / 2);
+}
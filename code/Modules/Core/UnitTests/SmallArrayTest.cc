@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+//  SmallArrayTest.cc
+//  Test SmallArray class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SmallArray.h"
+#include "Core/Containers/Array.h"
+#include "Core/String/String.h"
+#include <cstdio>
+
+using namespace std;
+using namespace Oryol;
+
+// counts live objects to check that all elements are destroyed
+static int numLiveObjs = 0;
+struct smallTestObj {
+    smallTestObj() : val(0) { numLiveObjs++; };
+    smallTestObj(int v) : val(v) { numLiveObjs++; };
+    smallTestObj(const smallTestObj& rhs) : val(rhs.val) { numLiveObjs++; };
+    smallTestObj(smallTestObj&& rhs) : val(rhs.val) { rhs.val = -1; numLiveObjs++; };
+    ~smallTestObj() { numLiveObjs--; };
+    void operator=(const smallTestObj& rhs) { val = rhs.val; };
+    void operator=(smallTestObj&& rhs) { val = rhs.val; rhs.val = -1; };
+    bool operator==(const smallTestObj& rhs) const { return val == rhs.val; };
+    int val;
+};
+
+TEST(SmallArrayTest) {
+    {
+        SmallArray<smallTestObj, 4> arr;
+        CHECK(arr.Empty());
+        CHECK(arr.Size() == 0);
+        CHECK(arr.Capacity() == 4);
+        CHECK(arr.Spare() == 4);
+        CHECK(arr.IsInline());
+
+        // stays inline up to N elements
+        for (int i = 0; i < 4; i++) {
+            CHECK(arr.Add(i).val == i);
+        }
+        CHECK(arr.IsInline());
+        CHECK(arr.Size() == 4);
+        CHECK(arr.Spare() == 0);
+        CHECK(numLiveObjs == 4);
+
+        // spills to the heap
+        arr.Add(4);
+        CHECK(!arr.IsInline());
+        CHECK(arr.Size() == 5);
+        CHECK(arr.Capacity() > 4);
+        CHECK(numLiveObjs == 5);
+        for (int i = 0; i < 5; i++) {
+            CHECK(arr[i].val == i);
+        }
+        CHECK(arr.Front().val == 0);
+        CHECK(arr.Back().val == 4);
+
+        // insert and erase
+        arr.Insert(0, smallTestObj(10));
+        arr.Insert(3, smallTestObj(11));
+        arr.Insert(arr.Size(), smallTestObj(12));
+        CHECK(arr.Size() == 8);
+        const int expected0[] = { 10, 0, 1, 11, 2, 3, 4, 12 };
+        for (int i = 0; i < 8; i++) {
+            CHECK(arr[i].val == expected0[i]);
+        }
+        arr.Erase(3);
+        arr.EraseRange(0, 2);
+        CHECK(arr.Size() == 5);
+        const int expected1[] = { 1, 2, 3, 4, 12 };
+        for (int i = 0; i < 5; i++) {
+            CHECK(arr[i].val == expected1[i]);
+        }
+        arr.EraseSwapBack(0);
+        CHECK(arr[0].val == 12);
+        arr.EraseSwapFront(2);
+        CHECK(arr.Size() == 3);
+        CHECK(arr[0].val == 2);
+        CHECK(arr[1].val == 12);
+        CHECK(arr[2].val == 4);
+        CHECK(arr.PopBack().val == 4);
+        CHECK(arr.PopFront().val == 2);
+        CHECK(arr.Size() == 1);
+        CHECK(numLiveObjs == 1);
+        CHECK(arr.FindIndexLinear(12) == 0);
+        CHECK(arr.FindIndexLinear(13) == InvalidIndex);
+
+        // trim moves back to inline storage
+        arr.Trim();
+        CHECK(arr.IsInline());
+        CHECK(arr.Capacity() == 4);
+        CHECK(arr[0].val == 12);
+
+        // iterate
+        arr.Add(13);
+        int sum = 0;
+        for (const auto& obj : arr) {
+            sum += obj.val;
+        }
+        CHECK(sum == 25);
+        arr.Clear();
+        CHECK(arr.Empty());
+        CHECK(numLiveObjs == 0);
+        arr.Add(1);
+    }
+    CHECK(numLiveObjs == 0);
+}
+
+TEST(SmallArrayCopyMoveTest) {
+    char buf[16];
+    SmallArray<String, 2> inl;
+    inl.Add("one");
+    inl.Add("two");
+    SmallArray<String, 2> heap = { "a", "b", "c", "d" };
+    CHECK(heap.Size() == 4);
+    CHECK(!heap.IsInline());
+
+    // copy-construct
+    SmallArray<String, 2> inl1(inl);
+    CHECK(inl1.IsInline());
+    CHECK(inl1.Size() == 2);
+    CHECK(inl1[0] == "one");
+    CHECK(inl1[1] == "two");
+    SmallArray<String, 2> heap1(heap);
+    CHECK(!heap1.IsInline());
+    CHECK(heap1.Size() == 4);
+    CHECK(heap1.Capacity() == 4);
+    CHECK(heap1[3] == "d");
+
+    // move-construct
+    SmallArray<String, 2> inl2(std::move(inl1));
+    CHECK(inl1.Empty());
+    CHECK(inl2.IsInline());
+    CHECK(inl2[1] == "two");
+    const String* heapPtr = heap1.begin();
+    SmallArray<String, 2> heap2(std::move(heap1));
+    CHECK(heap1.Empty());
+    CHECK(heap1.IsInline());
+    CHECK(heap2.begin() == heapPtr);
+    CHECK(heap2[0] == "a");
+
+    // copy- and move-assign between inline and heap arrays
+    inl2 = heap2;
+    CHECK(!inl2.IsInline());
+    CHECK(inl2.Size() == 4);
+    CHECK(inl2[2] == "c");
+    heap2 = inl;
+    CHECK(heap2.IsInline());
+    CHECK(heap2.Size() == 2);
+    CHECK(heap2[0] == "one");
+    heap2 = std::move(inl2);
+    CHECK(inl2.Empty());
+    CHECK(heap2.Size() == 4);
+    CHECK(heap2[3] == "d");
+
+    // add many elements
+    SmallArray<String, 2> many;
+    for (int i = 0; i < 1000; i++) {
+        snprintf(buf, sizeof(buf), "%d", i);
+        many.Add(String(buf));
+    }
+    CHECK(many.Size() == 1000);
+    CHECK(many[999] == "999");
+}
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//  SoaArrayTest.cc
+//  Test SoaArray class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SoaArray.h"
+#include "Core/Containers/Array.h"
+#include "Core/String/String.h"
+
+using namespace std;
+using namespace Oryol;
+
+TEST(SoaArrayTest) {
+    SoaArray<int, String, float> arr;
+    CHECK((SoaArray<int, String, float>::NumColumns == 3));
+    CHECK(arr.Empty());
+    CHECK(arr.Size() == 0);
+    CHECK(arr.Capacity() == 0);
+    CHECK(arr.Column<0>().Empty());
+
+    // add rows
+    CHECK(arr.Add(0, "zero", 0.0f) == 0);
+    CHECK(arr.Add(1, "one", 1.0f) == 1);
+    CHECK(arr.Add(2, "two", 2.0f) == 2);
+    CHECK(arr.AddDefault() == 3);
+    CHECK(arr.Size() == 4);
+    CHECK(arr.Get<0>(1) == 1);
+    CHECK(arr.Get<1>(1) == "one");
+    CHECK(arr.Get<2>(2) == 2.0f);
+    CHECK(arr.Get<1>(3).Empty());
+    arr.Get<0>(3) = 3;
+    arr.Get<1>(3) = "three";
+    arr.Get<2>(3) = 3.0f;
+
+    // columns are aligned
+    CHECK(Memory::IsAligned(arr.Data<0>(), ORYOL_CACHE_LINE_SIZE));
+    CHECK(Memory::IsAligned(arr.Data<1>(), ORYOL_CACHE_LINE_SIZE));
+    CHECK(Memory::IsAligned(arr.Data<2>(), ORYOL_CACHE_LINE_SIZE));
+
+    // column slices
+    Slice<int> ints = arr.Column<0>();
+    CHECK(ints.Size() == 4);
+    int sum = 0;
+    for (int i : ints) {
+        sum += i;
+    }
+    CHECK(sum == 6);
+    Slice<float> floats = arr.Column<2>();
+    for (float& f : floats) {
+        f *= 2.0f;
+    }
+    CHECK(arr.Get<2>(3) == 6.0f);
+
+    // grow
+    for (int i = 4; i < 100; i++) {
+        arr.Add(i, String("x"), float(i));
+    }
+    CHECK(arr.Size() == 100);
+    CHECK(arr.Capacity() >= 100);
+    CHECK(arr.Get<1>(3) == "three");
+    CHECK(arr.Get<1>(99) == "x");
+
+    // erase keeps order, EraseSwap swaps in the last row
+    arr.Erase(0);
+    CHECK(arr.Size() == 99);
+    CHECK(arr.Get<0>(0) == 1);
+    CHECK(arr.Get<1>(0) == "one");
+    CHECK(arr.Get<0>(98) == 99);
+    arr.EraseSwap(0);
+    CHECK(arr.Size() == 98);
+    CHECK(arr.Get<0>(0) == 99);
+    CHECK(arr.Get<1>(0) == "x");
+    CHECK(arr.Get<0>(1) == 2);
+    CHECK(arr.Get<1>(1) == "two");
+    arr.EraseSwap(97);
+    CHECK(arr.Size() == 97);
+
+    // copy and move
+    SoaArray<int, String, float> arr1(arr);
+    CHECK(arr1.Size() == 97);
+    CHECK(arr1.Get<1>(1) == "two");
+    CHECK(arr1.Data<1>() != arr.Data<1>());
+    SoaArray<int, String, float> arr2(std::move(arr1));
+    CHECK(arr1.Empty());
+    CHECK(arr2.Size() == 97);
+    CHECK(arr2.Get<1>(2) == "three");
+    arr1 = arr2;
+    CHECK(arr1.Size() == 97);
+    arr2 = std::move(arr);
+    CHECK(arr.Empty());
+    CHECK(arr2.Get<0>(0) == 99);
+
+    arr2.Clear();
+    CHECK(arr2.Empty());
+    CHECK(arr2.Capacity() >= 97);
+}
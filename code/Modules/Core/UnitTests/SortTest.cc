@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//  SortTest.cc
+//  Test radix and parallel sort, and the bulk sorting in Array, Map and Set.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/Sort.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/Set.h"
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+using namespace Oryol;
+
+// simple deterministic pseudo-random number generator
+static uint32_t sortTestSeed = 12345;
+static uint32_t sortTestRand() {
+    sortTestSeed = sortTestSeed * 1664525 + 1013904223;
+    return sortTestSeed;
+}
+
+template<class TYPE> static bool isSorted(const Array<TYPE>& arr) {
+    for (int i = 1; i < arr.Size(); i++) {
+        if (arr[i] < arr[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+TEST(SortRadixIntTest) {
+    Array<int32_t> signedArr;
+    Array<uint32_t> unsignedArr;
+    Array<int64_t> int64Arr;
+    Array<int16_t> int16Arr;
+    for (int i = 0; i < 10000; i++) {
+        const uint32_t r = sortTestRand();
+        signedArr.Add(int32_t(r));
+        unsignedArr.Add(r);
+        int64Arr.Add(int64_t(int32_t(r)) * (int64_t(1) << 24) + i);
+        int16Arr.Add(int16_t(r >> 16));
+    }
+    signedArr.Add(0x7FFFFFFF);
+    signedArr.Add(-0x7FFFFFFF - 1);
+    Array<int32_t> refArr = signedArr;
+    std::sort(refArr.begin(), refArr.end());
+    Sort::Radix(signedArr.begin(), signedArr.end());
+    CHECK(signedArr.Size() == refArr.Size());
+    bool same = true;
+    for (int i = 0; i < refArr.Size(); i++) {
+        same &= refArr[i] == signedArr[i];
+    }
+    CHECK(same);
+    CHECK(signedArr.Front() == -0x7FFFFFFF - 1);
+    CHECK(signedArr.Back() == 0x7FFFFFFF);
+
+    Sort::Radix(unsignedArr.begin(), unsignedArr.end());
+    CHECK(isSorted(unsignedArr));
+    Sort::Radix(int64Arr.begin(), int64Arr.end());
+    CHECK(isSorted(int64Arr));
+    Sort::Radix(int16Arr.begin(), int16Arr.end());
+    CHECK(isSorted(int16Arr));
+
+    // small key range (most passes are skipped)
+    Array<uint32_t> smallRange;
+    for (int i = 0; i < 1000; i++) {
+        smallRange.Add(sortTestRand() & 0xFF);
+    }
+    Sort::Radix(smallRange.begin(), smallRange.end());
+    CHECK(isSorted(smallRange));
+
+    // empty and single-element ranges
+    Array<int> emptyArr;
+    Sort::Radix(emptyArr.begin(), emptyArr.end());
+    CHECK(emptyArr.Empty());
+    int single = 5;
+    Sort::Radix(&single, &single + 1);
+    CHECK(single == 5);
+}
+
+//------------------------------------------------------------------------------
+TEST(SortRadixFloatTest) {
+    Array<float> floatArr;
+    Array<double> doubleArr;
+    for (int i = 0; i < 10000; i++) {
+        const float f = (float(sortTestRand() & 0xFFFFFF) - float(0x800000)) * 0.001f;
+        floatArr.Add(f);
+        doubleArr.Add(double(f) * 1000.0);
+    }
+    floatArr.Add(-0.0f);
+    floatArr.Add(0.0f);
+    floatArr.Add(1.0e30f);
+    floatArr.Add(-1.0e30f);
+    Sort::Radix(floatArr.begin(), floatArr.end());
+    CHECK(isSorted(floatArr));
+    CHECK(floatArr.Front() == -1.0e30f);
+    CHECK(floatArr.Back() == 1.0e30f);
+    Sort::Radix(doubleArr.begin(), doubleArr.end());
+    CHECK(isSorted(doubleArr));
+}
+
+//------------------------------------------------------------------------------
+TEST(SortRadixKeyIndexTest) {
+    // sort key/index pairs, radix sort must be stable
+    Array<KeyValuePair<uint16_t, int>> pairs;
+    for (int i = 0; i < 5000; i++) {
+        pairs.Add(KeyValuePair<uint16_t, int>(uint16_t(sortTestRand() % 100), i));
+    }
+    Sort::Radix(pairs.begin(), pairs.end());
+    bool stable = true;
+    for (int i = 1; i < pairs.Size(); i++) {
+        CHECK(pairs[i - 1].Key() <= pairs[i].Key());
+        if (pairs[i - 1].Key() == pairs[i].Key()) {
+            stable &= pairs[i - 1].Value() < pairs[i].Value();
+        }
+    }
+    CHECK(stable);
+}
+
+//------------------------------------------------------------------------------
+TEST(SortParallelTest) {
+    Array<int> arr;
+    for (int i = 0; i < 100000; i++) {
+        arr.Add(int(sortTestRand() % 50000));
+    }
+    Sort::Parallel(arr.begin(), arr.end(), std::less<int>(), 4);
+    CHECK(isSorted(arr));
+
+    // custom less (descending order)
+    Sort::Parallel(arr.begin(), arr.end(), std::greater<int>(), 4);
+    bool descending = true;
+    for (int i = 1; i < arr.Size(); i++) {
+        descending &= arr[i - 1] >= arr[i];
+    }
+    CHECK(descending);
+
+    // number of items not divisible by number of threads
+    Array<int> oddArr;
+    for (int i = 0; i < 40001; i++) {
+        oddArr.Add(int(sortTestRand()));
+    }
+    Sort::Parallel(oddArr.begin(), oddArr.end(), std::less<int>(), 3);
+    CHECK(isSorted(oddArr));
+
+    // more threads than the maximum number of chunks
+    Array<int> bigArr;
+    for (int i = 0; i < 600000; i++) {
+        bigArr.Add(int(sortTestRand()));
+    }
+    Sort::Parallel(bigArr.begin(), bigArr.end(), std::less<int>(), 256);
+    CHECK(isSorted(bigArr));
+}
+
+//------------------------------------------------------------------------------
+TEST(SortAutoTest) {
+    // Array::Sort() with radix-sortable and non-radix-sortable types
+    Array<int> intArr;
+    Array<uint64_t> wideArr;
+    for (int i = 0; i < 1000; i++) {
+        intArr.Add(int(sortTestRand()));
+        wideArr.Add((uint64_t(sortTestRand()) << 32) | sortTestRand());
+    }
+    intArr.Sort();
+    CHECK(isSorted(intArr));
+    wideArr.Sort();
+    CHECK(isSorted(wideArr));
+    Array<int> smallArr({ 3, 1, 2 });
+    smallArr.Sort();
+    CHECK(smallArr[0] == 1);
+    CHECK(smallArr[1] == 2);
+    CHECK(smallArr[2] == 3);
+
+    // Map bulk mode
+    Map<int, int> map;
+    map.BeginBulk();
+    for (int i = 0; i < 1000; i++) {
+        const int key = (i * 7919) % 1000;
+        map.AddBulk(key, key * 2);
+    }
+    map.EndBulk();
+    CHECK(map.Size() == 1000);
+    CHECK(InvalidIndex == map.FindDuplicate(0));
+    for (int i = 0; i < 1000; i++) {
+        CHECK(map.KeyAtIndex(i) == i);
+        CHECK(map.ValueAtIndex(i) == i * 2);
+    }
+    CHECK(map[500] == 1000);
+
+    // Set bulk mode
+    Set<int> set;
+    set.BeginBulk();
+    for (int i = 0; i < 1000; i++) {
+        set.AddBulk(999 - i);
+    }
+    set.EndBulk();
+    CHECK(set.Size() == 1000);
+    for (int i = 0; i < 1000; i++) {
+        CHECK(set.ValueAtIndex(i) == i);
+    }
+    CHECK(set.Contains(123));
+    CHECK(!set.Contains(1000));
+    set.Add(1000);
+    CHECK(set.Size() == 1001);
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//  SpscQueueTest.cc
+//  Test single-producer/single-consumer queue.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SpscQueue.h"
+#include "Core/String/String.h"
+#include <cstdio>
+#include <thread>
+
+using namespace std;
+using namespace Oryol;
+
+TEST(SpscQueueTest) {
+    SpscQueue<String> queue(5);
+    CHECK(queue.Capacity() == 8);
+    CHECK(queue.Size() == 0);
+    CHECK(queue.Empty());
+    String str;
+    CHECK(!queue.TryDequeue(str));
+
+    // fill up, and wrap around a couple of times
+    int enqueued = 0;
+    int dequeued = 0;
+    char buf[16];
+    for (int round = 0; round < 5; round++) {
+        while (true) {
+            snprintf(buf, sizeof(buf), "%d", enqueued);
+            if (!queue.TryEnqueue(String(buf))) {
+                break;
+            }
+            enqueued++;
+        }
+        CHECK(queue.Size() == 8);
+        CHECK(!queue.Empty());
+        for (int i = 0; i < 5; i++) {
+            CHECK(queue.TryDequeue(str));
+            snprintf(buf, sizeof(buf), "%d", dequeued++);
+            CHECK(str == buf);
+        }
+        CHECK(queue.Size() == 3);
+    }
+    // the destructor must destroy the remaining elements
+}
+
+TEST(SpscQueueThreaded) {
+    const int num = 1000000;
+    SpscQueue<int> queue(1024);
+    int64_t sum = 0;
+    bool inOrder = true;
+    std::thread consumer([&queue, &sum, &inOrder]() {
+        for (int i = 0; i < num; i++) {
+            int val = 0;
+            queue.WaitDequeue(val);
+            inOrder &= (val == i);
+            sum += val;
+        }
+    });
+    for (int i = 0; i < num; i++) {
+        queue.WaitEnqueue(int(i));
+    }
+    consumer.join();
+    CHECK(inOrder);
+    CHECK(sum == (int64_t(num) * (num - 1)) / 2);
+    CHECK(queue.Empty());
+}
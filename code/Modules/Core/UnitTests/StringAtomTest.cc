@@ -7,10 +7,13 @@
 #include "Core/String/StringAtom.h"
 #include "Core/String/String.h"
 #include "Core/Core.h"
+#include "Core/Containers/Array.h"
 
 #include <cstring>
+#include <cstdio>
 #include <thread>
 #include <array>
+#include <chrono>
 
 using namespace std;
 using namespace Oryol;
@@ -56,33 +59,105 @@ TEST(StringAtomSingleThreaded) {
 }
 
 #if ORYOL_HAS_THREADS
-// must use reference, the copy would fail since there is no thread-local
-// string-atom table yet
-static void threadFunc(const StringAtom& a0) {
+static void threadFunc(const StringAtom& a0, StringAtom& outAtom) {
     
     Oryol::Core::EnterThread();
     
-    // transfer into a thread-local string atom
+    // atoms from other threads are the same as atoms created in this thread
     StringAtom a1(a0);
-    StringAtom a2(a0);
+    StringAtom a2("BLOB");
     CHECK(a0 == a1);
     CHECK(a1 == a2);
+    CHECK(a0.AsCStr() == a2.AsCStr());
     CHECK(a1.AsString() == "BLOB");
     CHECK(a0.AsString() == "BLOB");
     CHECK(a2.AsString() == "BLOB");
+    outAtom = "BLOB_THREAD";
     
     Oryol::Core::LeaveThread();
 }
 
-// test string atom transfer into other thread
+// test string atoms crossing thread boundaries
 TEST(StringAtomMultiThreaded) {
     
     StringAtom atom0("BLOB");
-    std::thread t1(threadFunc, std::ref(atom0));
+    StringAtom atom1;
+    std::thread t1(threadFunc, std::ref(atom0), std::ref(atom1));
     t1.join();
+    StringAtom atom2("BLOB_THREAD");
+    CHECK(atom1 == atom2);
+    CHECK(atom1.AsCStr() == atom2.AsCStr());
+    CHECK(!(atom1 < atom2) && !(atom2 < atom1));
+}
+
+// test interning the same strings on many threads at once
+TEST(StringAtomMultiThreadedIntern) {
+
+    const int numThreads = 4;
+    const int numStrings = 20000;
+    for (int run = 0; run < 3; run++) {
+        std::array<Array<StringAtom>, numThreads> atoms;
+        std::array<std::thread, numThreads> threads;
+        for (int t = 0; t < numThreads; t++) {
+            threads[t] = std::thread([&atoms, t, run] {
+                char str[32];
+                atoms[t].Reserve(numStrings);
+                // each thread interns the same strings in a different order
+                for (int i = 0; i < numStrings; i++) {
+                    const int index = (i * 7 + t * (numStrings / numThreads)) % numStrings;
+                    snprintf(str, sizeof(str), "intern_%d_%d", run, index);
+                    atoms[t].Add(str);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // every thread must have gotten the same unique string for each index
+        bool allSame = true;
+        for (int t = 0; t < numThreads; t++) {
+            for (int i = 0; i < numStrings; i++) {
+                const int index = (i * 7 + t * (numStrings / numThreads)) % numStrings;
+                const int i0 = (index * 17143) % numStrings;  // 17143 is the inverse of 7 mod 20000
+                allSame &= atoms[t][i].AsCStr() == atoms[0][i0].AsCStr();
+            }
+        }
+        CHECK(allSame);
+    }
 }
 #endif
 
+// helper for the o_atom() tests, returns the same static atom on each call
+static const StringAtom& getLiteralAtom() {
+    return o_atom("literal_atom");
+}
+
+// test compile-time hashed string atom literals
+TEST(StringAtomLiteral) {
+    // the compile-time hash matches the runtime hash
+    static_assert(HashLiteral64("ABC") == HashLiteral64("ABC"), "HashLiteral64() must be constexpr");
+    CHECK(HashLiteral64("ABC") == stringAtomTable::HashForString("ABC"));
+    CHECK(HashLiteral64("a") == stringAtomTable::HashForString("a"));
+    CHECK(HashLiteral64("Some longer string with spaces!") == stringAtomTable::HashForString("Some longer string with spaces!"));
+    CHECK(HashLiteral64("\xe4\xf6\xfc") == stringAtomTable::HashForString("\xe4\xf6\xfc"));
+    CHECK(HashLiteral64("") == stringAtomTable::HashForString(""));
+
+    // literal atoms are the same as runtime-created atoms
+    const StringAtom& atom0 = o_atom("ABC");
+    StringAtom atom1("ABC");
+    CHECK(atom0 == atom1);
+    CHECK(atom0.AsCStr() == atom1.AsCStr());
+    CHECK(atom0 == "ABC");
+    CHECK(o_atom("DEF") != atom0);
+    CHECK(o_atom("DEF") == StringAtom("DEF"));
+
+    // the same call site always returns the same object
+    const StringAtom* ptr = &getLiteralAtom();
+    CHECK(&getLiteralAtom() == ptr);
+    CHECK(getLiteralAtom() == "literal_atom");
+}
+
 // test string atom creation performance
 TEST(StringAtomPerformance) {
 
@@ -109,4 +184,28 @@ TEST(StringAtomPerformance) {
         chrono::duration<double> dur = end - start;
         Log::Info("run %d: %dx StringAtoms created: %f sec\n", i, numStringAtoms, dur.count());
     }
-}
\ No newline at end of file
+}
+
+// test that the atom table keeps working while it grows to many unique atoms
+TEST(StringAtomTableScaling) {
+
+    const int numBatches = 4;
+    const int batchSize = 50000;
+    char str[32];
+    for (int batch = 0; batch < numBatches; batch++) {
+        for (int i = 0; i < batchSize; i++) {
+            snprintf(str, sizeof(str), "scaling_%d", batch * batchSize + i);
+            StringAtom atom(str);
+        }
+    }
+
+    // all atoms can be found again
+    bool allFound = true;
+    for (int i = 0; i < numBatches * batchSize; i += 97) {
+        snprintf(str, sizeof(str), "scaling_%d", i);
+        StringAtom atom0(str);
+        StringAtom atom1(str);
+        allFound &= (atom0 == atom1) && (atom0.AsCStr() == atom1.AsCStr()) && (0 == std::strcmp(atom0.AsCStr(), str));
+    }
+    CHECK(allFound);
+}
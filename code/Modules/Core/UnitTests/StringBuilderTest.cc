@@ -4,7 +4,12 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/String/StringBuilder.h"
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
+using namespace std;
 using namespace Oryol;
 
 TEST(StringBuilderTest) {
@@ -215,3 +220,117 @@ TEST(StringBuilderTest) {
     CHECK(builder.GetString() == "One: 1, Two: 2, Three: 3 Bla: 46");
 }
 
+//------------------------------------------------------------------------------
+TEST(StringBuilderNumberTest) {
+    StringBuilder builder;
+
+    // integers
+    builder.AppendInt(0);
+    builder.Append(' ');
+    builder.AppendInt(-7);
+    builder.Append(' ');
+    builder.AppendInt(1234567890);
+    builder.Append(' ');
+    builder.AppendInt(INT64_MIN);
+    builder.Append(' ');
+    builder.AppendUInt(UINT64_MAX);
+    CHECK(builder.GetString() == "0 -7 1234567890 -9223372036854775808 18446744073709551615");
+    char buf[64];
+    bool intOk = true;
+    for (int64_t i = -100000; i < 100000; i += 7) {
+        builder.Clear();
+        builder.AppendInt(i * 1000003);
+        snprintf(buf, sizeof(buf), "%lld", (long long) (i * 1000003));
+        intOk &= builder.GetString() == buf;
+    }
+    CHECK(intOk);
+
+    // shortest float strings
+    #define CHECK_FLOAT(val, str) builder.Clear(); builder.AppendFloat(val); CHECK(builder.GetString() == str)
+    CHECK_FLOAT(0.0f, "0");
+    CHECK_FLOAT(-0.0f, "-0");
+    CHECK_FLOAT(1.0f, "1");
+    CHECK_FLOAT(-1.5f, "-1.5");
+    CHECK_FLOAT(0.1f, "0.1");
+    CHECK_FLOAT(0.3f, "0.3");
+    CHECK_FLOAT(3.14159f, "3.14159");
+    CHECK_FLOAT(100.0f, "100");
+    CHECK_FLOAT(0.001f, "0.001");
+    CHECK_FLOAT(1e-7f, "1e-7");
+    CHECK_FLOAT(1.5e-6f, "0.0000015");
+    CHECK_FLOAT(123456789.0f, "123456790");
+    CHECK_FLOAT(16777216.0f, "16777216");
+    CHECK_FLOAT(1e20f, "100000000000000000000");
+    CHECK_FLOAT(1e21f, "1e+21");
+    CHECK_FLOAT(FLT_MAX, "3.4028235e+38");
+    CHECK_FLOAT(FLT_MIN, "1.1754944e-38");
+    CHECK_FLOAT(1e-45f, "1e-45");
+    CHECK_FLOAT(HUGE_VALF, "inf");
+    CHECK_FLOAT(-HUGE_VALF, "-inf");
+    CHECK_FLOAT(nanf(""), "nan");
+    #undef CHECK_FLOAT
+
+    // the shortest string parses back to the same float, and has no more
+    // significant digits than the shortest round-tripping "%.*e"
+    bool roundTripOk = true;
+    bool shortestOk = true;
+    for (uint32_t bits = 1; bits < 0x7F800000; bits += 65537) {
+        float val;
+        memcpy(&val, &bits, sizeof(val));
+        builder.Clear();
+        builder.AppendFloat(val);
+        roundTripOk &= strtof(builder.AsCStr(), nullptr) == val;
+        int precision = 1;
+        for (; precision < 9; precision++) {
+            snprintf(buf, sizeof(buf), "%.*e", precision - 1, val);
+            if (strtof(buf, nullptr) == val) {
+                break;
+            }
+        }
+        // count significant digits, without leading and trailing zeros
+        int numDigits = 0;
+        int numTrailingZeros = 0;
+        for (const char* p = builder.AsCStr(); *p && ('e' != *p); p++) {
+            if ((*p >= '1') && (*p <= '9')) {
+                numDigits++;
+                numTrailingZeros = 0;
+            }
+            else if ((numDigits > 0) && ('0' == *p)) {
+                numDigits++;
+                numTrailingZeros++;
+            }
+        }
+        shortestOk &= (numDigits - numTrailingZeros) <= precision;
+    }
+    CHECK(roundTripOk);
+    CHECK(shortestOk);
+
+    // fixed decimals are identical to printf
+    bool fixedOk = true;
+    const float fixedVals[] = { 0.0f, -0.0f, 0.5f, 1.5f, 2.5f, -2.5f, 0.125f, 0.045f, 1.005f, 3.14159f,
+        99.995f, 123456.78f, 16777216.0f, 1e10f, -1e20f, FLT_MAX, FLT_MIN, 1e-45f };
+    for (float val : fixedVals) {
+        for (int numDecimals = 0; numDecimals <= 9; numDecimals++) {
+            builder.Clear();
+            builder.AppendFloat(val, numDecimals);
+            snprintf(buf, sizeof(buf), "%.*f", numDecimals, val);
+            fixedOk &= builder.GetString() == buf;
+        }
+    }
+    for (uint32_t bits = 0; bits < 0x7F800000; bits += 100003) {
+        float val;
+        memcpy(&val, &bits, sizeof(val));
+        builder.Clear();
+        builder.AppendFloat(val, bits % 10);
+        snprintf(buf, sizeof(buf), "%.*f", int(bits % 10), val);
+        fixedOk &= builder.GetString() == buf;
+    }
+    CHECK(fixedOk);
+
+    // appends to existing content
+    builder.Set("fps: ");
+    builder.AppendFloat(59.94f, 1);
+    builder.Append(", frame: ");
+    builder.AppendInt(1024);
+    CHECK(builder.GetString() == "fps: 59.9, frame: 1024");
+}
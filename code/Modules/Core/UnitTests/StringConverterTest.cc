@@ -4,7 +4,14 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/String/StringConverter.h"
+#include "Core/Log.h"
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
+using namespace std;
 using namespace Oryol;
 
 TEST(StringConverterTest_UTF8) {
@@ -96,3 +103,79 @@ TEST(StringConverterTest_FromString) {
     f64 = StringConverter::FromString<double>(StringAtom("6.28"));
     CHECK_CLOSE(f64, 6.28, 0.0000000001);
 }
+
+//------------------------------------------------------------------------------
+TEST(StringConverterTest_Numbers) {
+
+    // 64-bit integers, whitespace, signs and overflow
+    CHECK(StringConverter::FromString<int64_t>("  -9223372036854775808") == INT64_MIN);
+    CHECK(StringConverter::FromString<int64_t>("9223372036854775807") == INT64_MAX);
+    CHECK(StringConverter::FromString<int64_t>("9223372036854775808") == INT64_MAX);
+    CHECK(StringConverter::FromString<int64_t>("-99999999999999999999") == INT64_MIN);
+    CHECK(StringConverter::FromString<int64_t>("+12abc") == 12);
+    CHECK(StringConverter::FromString<int64_t>("abc") == 0);
+    CHECK(StringConverter::FromString<uint64_t>("18446744073709551615") == UINT64_MAX);
+    CHECK(StringConverter::FromString<uint64_t>("18446744073709551616") == UINT64_MAX);
+    CHECK(StringConverter::FromString<uint64_t>("\t\n1234567890123") == 1234567890123ULL);
+    CHECK(StringConverter::FromString<int>("-2147483648") == INT32_MIN);
+    CHECK(StringConverter::FromString<uint32_t>("4294967295") == UINT32_MAX);
+
+    // floats and doubles must be bit-identical to the C runtime functions,
+    // this covers the fast paths and the fallbacks
+    static const char* strs[] = {
+        "0", "-0", "0.0", "1", "-1", "3.14", "6.28", ".5", "-.5e3", "5.", "1e", "1e+", "1e-",
+        "2.5e-3x", "  42.125", "+7", "1e10", "1e11", "1E-10", "1e22", "1e23", "1e-22", "1e-23",
+        "16777216", "16777217", "16777219", "9007199254740993", "123456789012345678",
+        "1234567890123456789012", "0.000000000000000000001234", "3.4028235e38", "3.5e38",
+        "1e39", "1e-45", "1e-46", "1.17549435e-38", "4.9406564584124654e-324",
+        "1.7976931348623157e308", "1e309", "0.1", "0.2", "0.3", "1.00000005960464477539",
+        "inf", "-infinity", "nan", "0x1.8p1", "-0X10", "abc", "", "-", ".", "e5",
+        "00000000000000000000000000001.5", "1.000000000000000000000000000",
+    };
+    for (const char* str : strs) {
+        const float f = StringConverter::FromString<float>(str);
+        const float fRef = strtof(str, nullptr);
+        const double d = StringConverter::FromString<double>(str);
+        const double dRef = strtod(str, nullptr);
+        const bool sameFloat = (f != f) ? (fRef != fRef) : (0 == memcmp(&f, &fRef, sizeof(f)));
+        const bool sameDouble = (d != d) ? (dRef != dRef) : (0 == memcmp(&d, &dRef, sizeof(d)));
+        CHECK(sameFloat);
+        CHECK(sameDouble);
+        if (!sameFloat || !sameDouble) {
+            Log::Info("mismatch for '%s': %.9g vs %.9g, %.17g vs %.17g\n", str, f, fRef, d, dRef);
+        }
+    }
+
+    // float parsing is correctly rounded for every float's shortest string
+    char buf[64];
+    bool roundTripOk = true;
+    for (uint32_t bits = 0; bits < 0x7F800000; bits += 4099) {
+        float val;
+        memcpy(&val, &bits, sizeof(val));
+        snprintf(buf, sizeof(buf), "%.9g", val);
+        roundTripOk &= StringConverter::FromString<float>(buf) == val;
+        snprintf(buf, sizeof(buf), "%.7g", val);
+        roundTripOk &= StringConverter::FromString<float>(buf) == strtof(buf, nullptr);
+    }
+    CHECK(roundTripOk);
+}
+
+//------------------------------------------------------------------------------
+TEST(StringConverterTest_Locale) {
+    // parsing doesn't depend on the current locale's decimal point, the
+    // test only runs if a locale with a ',' decimal point is installed
+    const std::string savedLocale = setlocale(LC_NUMERIC, nullptr);
+    static const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "German" };
+    for (const char* loc : locales) {
+        if (setlocale(LC_NUMERIC, loc) && (',' == localeconv()->decimal_point[0])) {
+            // fast path and C runtime fallback (big exponent, hex-float)
+            CHECK(StringConverter::FromString<double>("2.5") == 2.5);
+            CHECK(StringConverter::FromString<double>("1.5e30") == 1.5e30);
+            CHECK(StringConverter::FromString<double>("0x1.8p1") == 3.0);
+            CHECK(StringConverter::FromString<float>("1.5e30") == 1.5e30f);
+            CHECK(StringConverter::FromString<float>("0x1.8p1") == 3.0f);
+            break;
+        }
+    }
+    setlocale(LC_NUMERIC, savedLocale.c_str());
+}
@@ -6,6 +6,9 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/String/String.h"
 #include "Core/String/StringAtom.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Containers/Array.h"
+#include "Core/Memory/Memory.h"
 
 #include <cstring>
 
@@ -64,13 +67,13 @@ TEST(StringTest) {
     CHECK(str4 == blob);
     CHECK(str4 == "Blob");
     
-    // copy-assignment
+    // copy-assignment (short strings are copied)
     str0 = str2;
     CHECK(str0 == "Bla");
     CHECK(str0 == str2);
-    CHECK(str0.RefCount() == 2);
-    CHECK(str2.RefCount() == 2);
-    CHECK(str0.AsCStr() == str2.AsCStr());  // tests for identical pointers!
+    CHECK(str0.RefCount() == 1);
+    CHECK(str2.RefCount() == 1);
+    CHECK(str0.AsCStr() != str2.AsCStr());
     str2.Clear();
     CHECK(str0 == "Bla");
     CHECK(str2.Empty());
@@ -78,6 +81,25 @@ TEST(StringTest) {
     CHECK(str2.RefCount() == 0);
     str0.Clear();
     CHECK(str0.Empty());
+
+    // copy-assignment (long strings are shared)
+    const char* longStr = "A string which is too long to be stored locally";
+    String str5(longStr);
+    CHECK(str5.Length() == int(std::strlen(longStr)));
+    CHECK(str5.RefCount() == 1);
+    str0 = str5;
+    CHECK(str0 == longStr);
+    CHECK(str0 == str5);
+    CHECK(str0.RefCount() == 2);
+    CHECK(str5.RefCount() == 2);
+    CHECK(str0.AsCStr() == str5.AsCStr());  // tests for identical pointers!
+    str5.Clear();
+    CHECK(str0 == longStr);
+    CHECK(str5.Empty());
+    CHECK(str0.RefCount() == 1);
+    CHECK(str5.RefCount() == 0);
+    str0.Clear();
+    CHECK(str0.Empty());
     
     // move-assignment
     str2 = std::move(str3);
@@ -151,3 +173,101 @@ TEST(StringTest) {
     CHECK(nullString.AsCStr() != nullptr);
     CHECK(nullString.AsCStr()[0] == 0);    
 }
+
+TEST(StringLocalTest) {
+    #if ORYOL_MEMORY_STATS
+    const int64_t numAllocs = Memory::QueryStats(MemoryTag::App).NumAllocs;
+    #endif
+
+    // strings up to MaxLocalLength are stored in the String object
+    const char* maxLocal = "0123456789012345678901";
+    CHECK(int(std::strlen(maxLocal)) == String::MaxLocalLength);
+    String str0(maxLocal);
+    CHECK(str0.Length() == String::MaxLocalLength);
+    CHECK(str0 == maxLocal);
+    CHECK(str0.AsCStr() >= (const char*)&str0);
+    CHECK(str0.AsCStr() < (const char*)(&str0 + 1));
+    CHECK(str0.Front() == '0');
+    CHECK(str0.Back() == '1');
+    String str1(str0);
+    String str2(std::move(str1));
+    CHECK(str1.Empty());
+    CHECK(str2 == maxLocal);
+    str1 = str2;
+    CHECK(str1 == str2);
+    str1 = "Bla";
+    CHECK(str1.Length() == 3);
+    CHECK(str1 == "Bla");
+    str1 = std::move(str2);
+    CHECK(str1 == maxLocal);
+    CHECK(str2.Empty());
+    String sub(str0, 2, 5);
+    CHECK(sub == "234");
+    CHECK(String(maxLocal, 20, EndOfString) == "01");
+    CHECK(str0 < String("1"));
+    CHECK(String("0") <= str0);
+    CHECK(!(str0 > str0));
+    #if ORYOL_MEMORY_STATS
+    CHECK(Memory::QueryStats(MemoryTag::App).NumAllocs == numAllocs);
+    #endif
+
+    // longer strings go to the heap
+    const char* minHeap = "01234567890123456789012";
+    String str3(minHeap);
+    CHECK(str3.Length() == String::MaxLocalLength + 1);
+    CHECK(str3 == minHeap);
+    CHECK(str3.Back() == '2');
+    CHECK(str3 != str0);
+    CHECK(str3 > str0);
+    #if ORYOL_MEMORY_STATS
+    CHECK(Memory::QueryStats(MemoryTag::App).NumAllocs == numAllocs + 1);
+    #endif
+
+    // move between local and heap strings
+    str3 = std::move(str0);
+    CHECK(str3 == maxLocal);
+    CHECK(str0.Empty());
+    str0 = minHeap;
+    str3 = str0;
+    CHECK(str3.RefCount() == 2);
+    str0 = maxLocal;
+    CHECK(str3.RefCount() == 1);
+    CHECK(str3 == minHeap);
+
+    // strings with 0 bytes in the middle
+    String zero("ab\0cd", 0, 5);
+    CHECK(zero.Length() == 5);
+    CHECK(zero.AsCStr()[3] == 'c');
+
+    // relocating with a memory copy keeps the content intact
+    Array<String> array;
+    for (int i = 0; i < 100; i++) {
+        array.Add((i & 1) ? maxLocal : minHeap);
+    }
+    bool contentOk = true;
+    for (int i = 0; i < 100; i++) {
+        contentOk &= array[i] == ((i & 1) ? maxLocal : minHeap);
+    }
+    CHECK(contentOk);
+    CHECK(array[0].RefCount() == 1);
+}
+
+// formatting short log message fields into Strings doesn't allocate (timed in CoreBenchmarks)
+#if ORYOL_MEMORY_STATS
+TEST(StringFormatNoAlloc) {
+    const char* names[] = { "frame", "draw calls", "triangles", "tex binds" };
+    StringBuilder builder;
+    builder.Reserve(64);
+    const int64_t numAllocs = Memory::QueryStats(MemoryTag::App).NumAllocs;
+    int len = 0;
+    for (int i = 0; i < 1000; i++) {
+        builder.Format(64, "%s: %d", names[i & 3], i);
+        String field = builder.GetString();
+        String copy = field;
+        String name(names[i & 3]);
+        len += copy.Length() + name.Length();
+    }
+    CHECK(len > 0);
+    CHECK(Memory::QueryStats(MemoryTag::App).NumAllocs == numAllocs);
+}
+#endif
@@ -592,3 +592,85 @@ TEST(elementBufferTest) {
     CHECK(buf6[6] == 12);
     CHECK(TestMemory(buf6));
 }
+
+//------------------------------------------------------------------------------
+// a non-trivial type which is declared trivially relocatable, counts live objects
+static int numLiveRelocs = 0;
+class _reloc {
+public:
+    _reloc() : value(0) { numLiveRelocs++; };
+    _reloc(int val) : value(val) { numLiveRelocs++; };
+    _reloc(const _reloc& rhs) : value(rhs.value) { numLiveRelocs++; };
+    _reloc(_reloc&& rhs) : value(rhs.value) { numLiveRelocs++; };
+    ~_reloc() { numLiveRelocs--; };
+    void operator=(const _reloc& rhs) { this->value = rhs.value; };
+    void operator=(_reloc&& rhs) { this->value = rhs.value; };
+    int value;
+};
+namespace Oryol {
+template<> struct IsTriviallyRelocatable<_reloc> : std::true_type { };
+}
+
+TEST(elementBufferRelocatableTest) {
+    static_assert(IsTriviallyRelocatable<int>::value, "int must be trivially relocatable");
+    static_assert(!IsTriviallyRelocatable<_test>::value, "_test must not be trivially relocatable");
+    {
+        elementBuffer<_reloc> buf;
+        buf.alloc(4, 2);
+        for (int i = 0; i < 64; i++) {
+            if (0 == buf.backSpare()) {
+                buf.alloc(buf.capacity() * 2, buf.frontSpare());
+            }
+            buf.pushBack(_reloc(i));
+        }
+        CHECK(numLiveRelocs == 64);
+        // insert at front and in the middle, moving towards front and back
+        buf.insert(0, _reloc(100));
+        buf.insert(10, _reloc(101));
+        buf.insert(50, _reloc(102));
+        CHECK(numLiveRelocs == 67);
+        CHECK(buf.size() == 67);
+        CHECK(buf[0].value == 100);
+        CHECK(buf[1].value == 0);
+        CHECK(buf[10].value == 101);
+        CHECK(buf[11].value == 9);
+        CHECK(buf[50].value == 102);
+        CHECK(buf[51].value == 48);
+        CHECK(buf[66].value == 63);
+        // erase from front half, back half and a range
+        buf.erase(10);
+        buf.erase(49);
+        CHECK(numLiveRelocs == 65);
+        CHECK(buf[10].value == 9);
+        CHECK(buf[49].value == 48);
+        buf.eraseRange(1, 10);
+        CHECK(numLiveRelocs == 55);
+        CHECK(buf[0].value == 100);
+        CHECK(buf[1].value == 10);
+        CHECK(buf[54].value == 63);
+        // shrink
+        buf.alloc(buf.size(), 0);
+        CHECK(buf.capacity() == 55);
+        CHECK(buf[0].value == 100);
+        CHECK(buf[54].value == 63);
+        CHECK(numLiveRelocs == 55);
+    }
+    CHECK(numLiveRelocs == 0);
+}
+
+//------------------------------------------------------------------------------
+// same layout, but the first one is trivially relocatable and the second isn't
+struct _vec4 {
+    float x, y, z, w;
+};
+struct _vec4Slow {
+    _vec4Slow() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) { };
+    _vec4Slow(const _vec4Slow& rhs) : x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w) { };
+    _vec4Slow(_vec4Slow&& rhs) : x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w) { };
+    void operator=(const _vec4Slow& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; w = rhs.w; };
+    void operator=(_vec4Slow&& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; w = rhs.w; };
+    float x, y, z, w;
+};
+
+static_assert(IsTriviallyRelocatable<_vec4>::value, "_vec4 must be trivially relocatable");
+static_assert(!IsTriviallyRelocatable<_vec4Slow>::value, "_vec4Slow must not be trivially relocatable");
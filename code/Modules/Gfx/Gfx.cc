@@ -31,6 +31,7 @@ namespace {
 void
 Gfx::Setup(const class GfxSetup& setup) {
     o_assert_dbg(!IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     state = Memory::New<_state>();
     state->gfxSetup = setup;
 
@@ -58,6 +59,7 @@ void
 Gfx::Discard() {
     o_assert_dbg(IsValid());
     o_assert_dbg(!state->inPass);
+    o_memory_tag(MemoryTag::Gfx);
     state->resourceContainer.GarbageCollect();
     state->resourceContainer.Destroy(ResourceLabel::All);
     Core::PreRunLoop()->Remove(state->runLoopId);
@@ -274,6 +276,7 @@ Gfx::PopResourceLabel() {
 Id
 Gfx::LoadResource(const Ptr<ResourceLoader>& loader) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     return state->resourceContainer.Load(loader);
 }
 
@@ -309,6 +312,7 @@ Gfx::QueryResourcePoolInfo(GfxResourceType::Code resType) {
 void
 Gfx::DestroyResources(ResourceLabel label) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     return state->resourceContainer.DestroyDeferred(label);
 }
 
@@ -340,6 +344,7 @@ Gfx::ApplyScissorRect(int x, int y, int width, int height, bool originTopLeft) {
 //------------------------------------------------------------------------------
 void
 Gfx::CommitFrame() {
+    o_memory_tag(MemoryTag::Gfx);
     o_trace_scoped(Gfx_CommitFrame);
     o_assert_dbg(IsValid());
     o_assert_dbg(!state->inPass);
@@ -641,6 +646,7 @@ Gfx::validateShaderSetup(const ShaderSetup& setup) {
 template<> Id
 Gfx::CreateResource(const TextureSetup& setup, const void* data, int size) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     #if ORYOL_DEBUG
     validateTextureSetup(setup, data, size);
     #endif
@@ -651,6 +657,7 @@ Gfx::CreateResource(const TextureSetup& setup, const void* data, int size) {
 template<> Id
 Gfx::CreateResource(const MeshSetup& setup, const void* data, int size) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     #if ORYOL_DEBUG
     validateMeshSetup(setup, data, size);
     #endif
@@ -661,6 +668,7 @@ Gfx::CreateResource(const MeshSetup& setup, const void* data, int size) {
 template<> Id
 Gfx::CreateResource(const ShaderSetup& setup, const void* data, int size) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     #if ORYOL_DEBUG
     validateShaderSetup(setup);
     #endif
@@ -671,6 +679,7 @@ Gfx::CreateResource(const ShaderSetup& setup, const void* data, int size) {
 template<> Id
 Gfx::CreateResource(const PipelineSetup& setup, const void* data, int size) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     #if ORYOL_DEBUG
     validatePipelineSetup(setup);
     #endif
@@ -681,6 +690,7 @@ Gfx::CreateResource(const PipelineSetup& setup, const void* data, int size) {
 template<> Id
 Gfx::CreateResource(const PassSetup& setup, const void* data, int size) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::Gfx);
     #if ORYOL_DEBUG
     validatePassSetup(setup);
     #endif
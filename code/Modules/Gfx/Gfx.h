@@ -164,7 +164,7 @@ template<class SETUP> inline Id
 Gfx::CreateResource(const SETUP& setup, const Buffer& data) {
     o_assert_dbg(IsValid());
     o_assert_dbg(!data.Empty());
-    return CreateResource(setup, data.Data(), data.Size());
+    return CreateResource(setup, data.Data(), int(data.Size()));
 }
 
 //------------------------------------------------------------------------------
@@ -279,7 +279,7 @@ gfxResourceContainer::Load(const Ptr<ResourceLoader>& loader) {
 void
 gfxResourceContainer::DestroyDeferred(const ResourceLabel& label) {
     o_assert_dbg(this->IsValid());
-    Array<Id> ids = this->registry.Remove(label);
+    SmallArray<Id, 16> ids = this->registry.Remove(label);
     if (ids.Size() > 0) {
         this->destroyQueue.Reserve(ids.Size());
         for (const Id& id : ids) {
@@ -372,7 +372,7 @@ gfxResourceContainer::destroyResource(const Id& id) {
 void
 gfxResourceContainer::Destroy(const ResourceLabel& label) {
     o_assert_dbg(this->IsValid());
-    Array<Id> ids = this->registry.Remove(label);
+    SmallArray<Id, 16> ids = this->registry.Remove(label);
     for (const Id& id : ids) {
         this->destroyResource(id);
     }
@@ -4,7 +4,7 @@
 #include "Pre.h"
 #include "curlURLLoader.h"
 #include "Core/String/StringConverter.h"
-#include "Core/Containers/Buffer.h"
+#include "Core/Containers/BufferChain.h"
 #include "curl/curl.h"
 #include <mutex>
 
@@ -86,11 +86,12 @@ curlURLLoader::discardCurlSession() {
 //------------------------------------------------------------------------------
 size_t
 curlURLLoader::curlWriteDataCallback(char* ptr, size_t size, size_t nmemb, void* userData) {
-    // userData is expected to point to a Buffer object
+    // userData is expected to point to a BufferChain object, appending
+    // to a chain never copies the data which has already been received
     int bytesToWrite = (int) (size * nmemb);
     if (bytesToWrite > 0) {
-        Buffer* buf = (Buffer*) userData;
-        buf->Add((const uint8_t*)ptr, bytesToWrite);
+        BufferChain* chain = (BufferChain*) userData;
+        chain->Add((const uint8_t*)ptr, bytesToWrite);
         return bytesToWrite;
     }
     else {
@@ -141,10 +142,15 @@ curlURLLoader::doRequestInternal(const Ptr<IORead>& req) {
     curl_easy_setopt(this->curlSession, CURLOPT_HTTPHEADER, requestHeaders);
 
     // prepare the HTTPResponse and the response-body stream
-    curl_easy_setopt(this->curlSession, CURLOPT_WRITEDATA, &(req->Data));
+    BufferChain responseBody;
+    curl_easy_setopt(this->curlSession, CURLOPT_WRITEDATA, &responseBody);
 
-    // perform the request
+    // perform the request, and copy the received data into the request's
+    // data buffer in one go
     CURLcode performResult = curl_easy_perform(this->curlSession);
+    if (!responseBody.Empty()) {
+        req->Data = responseBody.Flatten();
+    }
 
     // query the http code
     long curlHttpCode = 0;
@@ -31,6 +31,7 @@ namespace {
 void
 IO::Setup(const IOSetup& setup) {
     o_assert(!IsValid());
+    o_memory_tag(MemoryTag::IO);
 
     state = Memory::New<_state>();
     ioPointers ptrs;
@@ -55,6 +56,7 @@ IO::Setup(const IOSetup& setup) {
 void
 IO::Discard() {
     o_assert(IsValid());
+    o_memory_tag(MemoryTag::IO);
     Core::PreRunLoop()->Remove(state->runLoopId);
     state->router.discard();
     Memory::Delete(state);
@@ -66,6 +68,7 @@ void
 IO::doWork() {
     o_assert_dbg(IsValid());
     o_assert_dbg(Core::IsMainThread());
+    o_memory_tag(MemoryTag::IO);
     state->router.doWork();
     state->loadQueue.update();
 }
@@ -80,6 +83,7 @@ IO::IsValid() {
 void
 IO::SetAssign(const String& assign, const String& path) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     state->assignReg.SetAssign(assign, path);
 }
 
@@ -107,6 +111,7 @@ IO::ResolveAssigns(const String& str) {
 void
 IO::RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystemBase>()> fsCreator) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
 
     bool newFileSystem = !state->schemeReg.IsFileSystemRegistered(scheme);
     state->schemeReg.RegisterFileSystem(scheme, fsCreator);
@@ -128,6 +133,7 @@ IO::RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystemBas
 void
 IO::UnregisterFileSystem(const StringAtom& scheme) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     state->schemeReg.UnregisterFileSystem(scheme);
 }
 
@@ -142,6 +148,7 @@ IO::IsFileSystemRegistered(const StringAtom& scheme) {
 void
 IO::Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     state->loadQueue.add(url, onSuccess, onFailed);
 }
 
@@ -149,6 +156,7 @@ IO::Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed) {
 void
 IO::LoadGroup(const Array<URL>& urls, LoadGroupSuccessFunc onSuccess, LoadFailedFunc onFailed) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     state->loadQueue.addGroup(urls, onSuccess, onFailed);
 }
 
@@ -163,6 +171,7 @@ IO::NumPendingLoads() {
 Ptr<IORead>
 IO::LoadFile(const URL& url) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     Ptr<IORead> ioReq = IORead::Create();
     ioReq->Url = url;
     state->router.put(ioReq);
@@ -173,6 +182,7 @@ IO::LoadFile(const URL& url) {
 Ptr<IOWrite>
 IO::WriteFile(const URL& url, const Buffer& data) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     Ptr<IOWrite> ioReq = IOWrite::Create();
     ioReq->Url = url;
     ioReq->Data.Add(data.Data(), data.Size());
@@ -184,6 +194,7 @@ IO::WriteFile(const URL& url, const Buffer& data) {
 void
 IO::Put(const Ptr<IORequest>& ioReq) {
     o_assert_dbg(IsValid());
+    o_memory_tag(MemoryTag::IO);
     state->router.put(ioReq);
 }
 
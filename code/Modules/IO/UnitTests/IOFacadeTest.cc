@@ -35,6 +35,9 @@ public:
 // try to find out which of the IO tests hangs in travis-ci
 #if !ORYOL_EMSCRIPTEN && !ORYOL_UNITTESTS_HEADLESS
 TEST(IOFacadeTest) {
+    #if ORYOL_MEMORY_STATS
+    const Memory::Stats ioStats = Memory::QueryStats(MemoryTag::IO);
+    #endif
     Core::Setup();
     IO::Setup(IOSetup());
     
@@ -69,7 +72,13 @@ TEST(IOFacadeTest) {
 
     // FIXME: dynamically add/remove/replace filesystems, ...
     
+    msg.invalidate();
     IO::Discard();
     Core::Discard();
+
+    // all memory allocated by the IO module must have been freed
+    #if ORYOL_MEMORY_STATS
+    CHECK(Memory::QueryStats(MemoryTag::IO).LiveBytes == ioStats.LiveBytes);
+    #endif
 }
 #endif
@@ -5,8 +5,10 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "IO/IOTypes.h"
+#include "Core/Memory/Memory.h"
 #include <cstring>
 
+using namespace std;
 using namespace Oryol;
 
 TEST(URLTest) {
@@ -98,3 +100,23 @@ TEST(URLTest) {
     CHECK(url3.Fragment() == "frag");
     CHECK(url3.PathToEnd() == "bla.txt?key0=val0&key1=val1#frag");
 }
+
+// getting the short parts of a URL doesn't allocate
+#if ORYOL_MEMORY_STATS
+TEST(URLCrackNoAlloc) {
+    const char* urls[] = {
+        "http://floooh.github.io/oryol/data/lok_dxt1.dds",
+        "http://www.flohofwoe.net:8000/bla/blub/blob.txt#frag",
+        "file:///home/user/projects/oryol/data/tex/lok_rgba8.dds",
+        "http://localhost/index.html"
+    };
+    for (const char* str : urls) {
+        URL url(str);
+        const int64_t numAllocs = Memory::QueryStats(MemoryTag::App).NumAllocs;
+        int len = url.Scheme().Length() + url.Host().Length() + url.Port().Length();
+        len += url.Fragment().Length();
+        CHECK(len > 0);
+        CHECK(Memory::QueryStats(MemoryTag::App).NumAllocs == numAllocs);
+    }
+}
+#endif
@@ -37,8 +37,8 @@ class IORequest : public _priv::ioMsg {
     OryolTypeDecl(IORequest, _priv::ioMsg);
 public:
     URL Url;
-    int StartOffset = 0;
-    int EndOffset = EndOfFile;
+    int64_t StartOffset = 0;
+    int64_t EndOffset = EndOfFile;
     Buffer Data;
     IOStatus::Code Status = IOStatus::InvalidIOStatus;
     String ErrorDesc;
@@ -46,7 +46,7 @@ public:
 
 //------------------------------------------------------------------------------
 class IORead : public IORequest {
-    OryolClassDecl(IORead);
+    OryolClassPoolAllocDecl(IORead, 32);
     OryolTypeDecl(IORead, IORequest);
 public:
     bool CacheReadEnabled = false;
@@ -55,7 +55,7 @@ public:
 
 //------------------------------------------------------------------------------
 class IOWrite : public IORequest {
-    OryolClassDecl(IOWrite);
+    OryolClassPoolAllocDecl(IOWrite, 32);
     OryolTypeDecl(IOWrite, IORequest);
 };
 
@@ -4,13 +4,14 @@
 #include "Pre.h"
 #include "ioWorker.h"
 #include "IO/private/schemeRegistry.h"
+#include "Core/Memory/PoolAllocator.h"
 
 namespace Oryol {
 namespace _priv {
 
 //------------------------------------------------------------------------------
 ioWorker::ioWorker() :
-threadStopRequested(false) {
+msgQueue(MsgQueueCapacity) {
     // empty
 }
 
@@ -30,9 +31,9 @@ ioWorker::start(const ioPointers& ptrs) {
 void
 ioWorker::stop() {
     o_assert(this->threadStartRequested);
-    this->threadStopRequested = true;
     #if ORYOL_HAS_THREADS
-        this->transferCondVar.notify_one();
+        // an invalid message pointer tells the worker thread to quit
+        this->msgQueue.WaitEnqueue(Ptr<ioMsg>());
         this->thread.join();
     #endif
     this->threadStopped = true;
@@ -44,37 +45,31 @@ ioWorker::put(const Ptr<ioMsg>& msg) {
     o_assert(this->isSendThread());
     o_assert(this->threadStartRequested);
     o_assert(!this->threadStopped);
-    this->writeQueue.Enqueue(msg);
+    // keep message order, only bypass the write queue if it is empty
+    if (!this->writeQueue.Empty() || !this->msgQueue.TryEnqueue(msg)) {
+        this->writeQueue.Enqueue(msg);
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 ioWorker::doWork() {
-    // move messages to transfer queue and wake up thread if work needs to be done
+    // move parked messages to the message queue, this wakes up the thread
     o_assert(this->isSendThread());
     o_assert(this->threadStartRequested);
     o_assert(!this->threadStopped);
-    if (!this->writeQueue.Empty()) {
-        this->moveWriteToTransferQueue();
-    }
-    o_assert_dbg(this->writeQueue.Empty());
-
     #if ORYOL_HAS_THREADS
-    {
-        std::lock_guard<std::mutex> lock(this->transferMutex);
-        if (!this->transferQueue.Empty()) {
-            this->transferCondVar.notify_one();
-        }
-    }
-    #endif
-
-    #if !ORYOL_HAS_THREADS
-        // if platform has no threads, pump the message queue right
-        // FIXME: we could do without all those queue transfers here!
-        this->moveTransferToReadQueue();
-        while (!this->readQueue.Empty()) {
-            this->onMsg(std::move(this->readQueue.Dequeue()));
+        this->moveWriteToMsgQueue();
+    #else
+        // if platform has no threads, pump the message queue right here
+        Ptr<ioMsg> msg;
+        do {
+            this->moveWriteToMsgQueue();
+            while (this->msgQueue.TryDequeue(msg)) {
+                this->onMsg(msg);
+            }
         }
+        while (!this->writeQueue.Empty());
     #endif
 }
 
@@ -82,25 +77,23 @@ ioWorker::doWork() {
 #if ORYOL_HAS_THREADS
 void
 ioWorker::threadFunc(ioWorker* self) {
+    o_memory_tag(MemoryTag::IO);
     self->workThreadId = std::this_thread::get_id();
 
-    // the message processing loop waits for messages to arrive,
-    // moves them from the transfer queue, processes them then goes back to sleep
-    while (!self->threadStopRequested) {
-
-        // wait for messages to arrive, and if so, transfer to read queue
-        {
-            std::unique_lock<std::mutex> lock(self->transferMutex);
-            self->transferCondVar.wait(lock);
-            self->moveTransferToReadQueue();
-            lock.unlock();
-        }
-
-        // now process the messages, this happens without locking
-        while (!self->readQueue.Empty()) {
-            self->onMsg(std::move(self->readQueue.Dequeue()));
+    // the message processing loop sleeps until messages arrive and
+    // processes them, an invalid message pointer stops the thread
+    Ptr<ioMsg> msg;
+    for (;;) {
+        self->msgQueue.WaitDequeue(msg);
+        if (!msg) {
+            break;
         }
+        self->onMsg(msg);
+        msg = nullptr;
     }
+
+    // hand pooled IO messages released on this thread back to the shared pool
+    PoolAllocator::FlushThreadCache();
 }
 #endif
 
@@ -126,33 +119,17 @@ ioWorker::isWorkerThread() {
 
 //------------------------------------------------------------------------------
 void
-ioWorker::moveWriteToTransferQueue() {
+ioWorker::moveWriteToMsgQueue() {
     o_assert(this->isSendThread());
-    // if the transfer queue is empty, we can do a very fast complete move
-    {
-        #if ORYOL_HAS_THREADS
-        std::lock_guard<std::mutex> lock(this->transferMutex);
-        #endif
-        if (this->transferQueue.Empty()) {
-            this->transferQueue = std::move(this->writeQueue);
-        }
-        else {
-            // otherwise move messages one by one
-            while (!this->writeQueue.Empty()) {
-                this->transferQueue.Enqueue(this->writeQueue.Dequeue());
-            }
+    // move as many messages as fit, the rest stays parked until next frame
+    while (!this->writeQueue.Empty()) {
+        if (!this->msgQueue.TryEnqueue(this->writeQueue.Front())) {
+            break;
         }
+        this->writeQueue.Dequeue();
     }
 }
 
-//------------------------------------------------------------------------------
-void
-ioWorker::moveTransferToReadQueue() {
-    o_assert(this->isWorkerThread());
-    o_assert(this->readQueue.Empty());
-    this->readQueue = std::move(this->transferQueue);
-}
-
 //------------------------------------------------------------------------------
 Ptr<FileSystemBase>
 ioWorker::fileSystemForURL(const URL& url) {
@@ -5,25 +5,23 @@
     @ingroup IO
     @brief worker thread to forward IO requests to filesystem implementations
     
-    An ioWorker is basically a message queue with a thread behind it. To
-    remove granular locking it is pumped by the runloop. Once per
-    runloop-frame, messages from the main thread will be moved to a
-    'transfer queue', and the worker thread will be signaled. The 
-    worker thread wakes up, moves the messages from the transfer queue
-    to a read-queue, processes them and goes back to sleep.
+    An ioWorker is basically a message queue with a thread behind it.
+    Messages from the main thread are pushed into a lock-free
+    single-producer/single-consumer queue, the worker thread sleeps
+    until messages arrive, processes them and goes back to sleep.
+    If the queue is full, messages are parked in a write-queue
+    which is drained by the runloop once per frame.
 */
 #include "Core/Config.h"
 #include "Core/Containers/Queue.h"
+#include "Core/Containers/SpscQueue.h"
 #include "Core/Containers/Map.h"
 #include "Core/String/StringAtom.h"
 #include "IO/private/ioPointers.h"
 #include "IO/private/ioRequests.h"
 #include "IO/FileSystemBase.h"
 #if ORYOL_HAS_THREADS
-#include <atomic>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #endif
 
 namespace Oryol {
@@ -39,7 +37,7 @@ public:
     void stop();
     /// put an io message into the internal message queue
     void put(const Ptr<ioMsg>& msg);
-    /// do work on the main thread, this moves queued messages to transfer queue
+    /// do work on the main thread, this moves parked messages to the message queue
     void doWork();
 
     /// lookup filesystem for URL
@@ -56,29 +54,20 @@ public:
     bool isSendThread();
     /// test if we are on the worker-thread
     bool isWorkerThread();
-    /// move messages from the write queue to the transfer queue
-    void moveWriteToTransferQueue();
-    /// move messages from transfer queue to read queue
-    void moveTransferToReadQueue();
+    /// move parked messages from the write queue to the message queue
+    void moveWriteToMsgQueue();
 
     ioPointers pointers;
     Map<StringAtom, Ptr<FileSystemBase>> fileSystems;
 
-    Queue<Ptr<ioMsg>> writeQueue;     // written by sender thread
-    Queue<Ptr<ioMsg>> transferQueue;  // written by sender, read by worker thread (locked)
-    Queue<Ptr<ioMsg>> readQueue;      // read by worker thread
+    static const int MsgQueueCapacity = 256;
+    Queue<Ptr<ioMsg>> writeQueue;     // overflow messages, written by sender thread
+    SpscQueue<Ptr<ioMsg>> msgQueue;   // written by sender, read by worker thread (lock-free)
 
     #if ORYOL_HAS_THREADS
     std::thread::id sendThreadId;
     std::thread::id workThreadId;
     std::thread thread;
-    std::mutex transferMutex;
-    std::condition_variable transferCondVar;
-    #endif
-    #if ORYOL_HAS_ATOMIC
-    std::atomic<bool> threadStopRequested;
-    #else
-    bool threadStopRequested;
     #endif
     bool threadStartRequested = false;
     bool threadStopped = false;
@@ -10,6 +10,7 @@
 #include "Core/Types.h"
 #include "Core/String/StringAtom.h"
 #include "Core/Containers/Array.h"
+#include "Core/Containers/SmallArray.h"
 #include "Core/Containers/Buffer.h"
 #include "IO/IOTypes.h"
 #include "IO/private/ioRequests.h"
@@ -57,7 +58,7 @@ public:
     };
     Array<item> items;
     struct groupItem {
-        Array<Ptr<IORead>> ioRequests;
+        SmallArray<Ptr<IORead>, 4> ioRequests;
         groupSuccessFunc onSuccess;
         failFunc onFail;
     };
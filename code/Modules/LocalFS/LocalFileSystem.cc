@@ -44,12 +44,12 @@ LocalFileSystem::onRead(const Ptr<IORead>& msg) {
     if (msg->Url.HasPath()) {
         fsWrapper::handle h = fsWrapper::openRead(msg->Url.Path().AsCStr());
         if (fsWrapper::invalidHandle != h) {
-            const int startOffset = msg->StartOffset;
-            const int endOffset = msg->EndOffset;
+            const int64_t startOffset = msg->StartOffset;
+            const int64_t endOffset = msg->EndOffset;
             if (startOffset > 0) {
                 fsWrapper::seek(h, startOffset);
             }
-            int size;
+            int64_t size;
             if (endOffset == EndOfFile) {
                 size = fsWrapper::size(h) - startOffset;
             }
@@ -58,7 +58,7 @@ LocalFileSystem::onRead(const Ptr<IORead>& msg) {
             }
             if (size > 0) {
                 uint8_t* ptr = msg->Data.Add(size);
-                int bytesRead = fsWrapper::read(h, ptr, size);
+                int64_t bytesRead = fsWrapper::read(h, ptr, size);
                 if (bytesRead != size) {
                     msg->Status = IOStatus::DownloadError;
                     msg->ErrorDesc = "Fewer bytes read then expected";
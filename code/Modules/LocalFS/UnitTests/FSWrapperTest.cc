@@ -6,6 +6,7 @@
 #include "LocalFS/private/fsWrapper.h"
 #include "Core/String/StringBuilder.h"
 #include <string.h>
+#include <stdio.h>
 
 using namespace Oryol;
 using namespace _priv;
@@ -63,3 +64,32 @@ TEST(FSWrapperTest) {
     CHECK(readStr == "World\n");
     fsWrapper::close(hs);
 }
+
+#if !ORYOL_WINDOWS
+TEST(FSWrapperLargeFileTest) {
+    // write a sparse file with a few bytes beyond the 4 GByte boundary
+    StringBuilder strBuilder;
+    strBuilder.Format(4096, "%s/large.bin", fsWrapper::getCwd().AsCStr());
+    const int64_t offset = (int64_t(5) << 30) + 3;
+    const char* str = "Far Away";
+    const int len = int(strlen(str));
+
+    const fsWrapper::handle hw = fsWrapper::openWrite(strBuilder.AsCStr());
+    CHECK(hw != fsWrapper::invalidHandle);
+    CHECK(fsWrapper::seek(hw, offset));
+    CHECK(fsWrapper::write(hw, str, len) == len);
+    fsWrapper::close(hw);
+
+    char buf[64];
+    Memory::Clear(buf, sizeof(buf));
+    const fsWrapper::handle hr = fsWrapper::openRead(strBuilder.AsCStr());
+    CHECK(hr != fsWrapper::invalidHandle);
+    CHECK(fsWrapper::size(hr) == offset + len);
+    CHECK(fsWrapper::seek(hr, offset + 4));
+    CHECK(fsWrapper::read(hr, buf, sizeof(buf)) == 4);
+    String readStr(buf, 0, 4);
+    CHECK(readStr == "Away");
+    fsWrapper::close(hr);
+    remove(strBuilder.AsCStr());
+}
+#endif
@@ -9,6 +9,8 @@
 #include "LocalFS/LocalFileSystem.h"
 #include "LocalFS/private/fsWrapper.h"
 #include <thread>
+#include <string.h>
+#include <stdio.h>
 
 using namespace Oryol;
 
@@ -84,6 +86,38 @@ TEST(LocalFileSystemTest) {
     readStr.Assign((const char*)read->Data.Data(), 0, read->Data.Size());
     CHECK(readStr == "World");
 
+    #if !ORYOL_WINDOWS
+    // read from beyond the 4 GByte boundary of a sparse file
+    strBuilder.Format(4096, "%slarge.bin", _priv::fsWrapper::getExecutableDir().AsCStr());
+    const int64_t largeOffset = (int64_t(5) << 30) + 3;
+    const char* far = "Far Away";
+    _priv::fsWrapper::handle hw = _priv::fsWrapper::openWrite(strBuilder.AsCStr());
+    CHECK(hw != _priv::fsWrapper::invalidHandle);
+    CHECK(_priv::fsWrapper::seek(hw, largeOffset));
+    CHECK(_priv::fsWrapper::write(hw, far, int64_t(strlen(far))) == int64_t(strlen(far)));
+    _priv::fsWrapper::close(hw);
+    read = IORead::Create();
+    read->Url = "root:large.bin";
+    read->StartOffset = largeOffset + 4;
+    IO::Put(read);
+    wait(read);
+    CHECK(read->Status == IOStatus::OK);
+    CHECK(read->Data.Size() == 4);
+    readStr.Assign((const char*)read->Data.Data(), 0, int(read->Data.Size()));
+    CHECK(readStr == "Away");
+    read = IORead::Create();
+    read->Url = "root:large.bin";
+    read->StartOffset = largeOffset;
+    read->EndOffset = largeOffset + 3;
+    IO::Put(read);
+    wait(read);
+    CHECK(read->Status == IOStatus::OK);
+    CHECK(read->Data.Size() == 3);
+    readStr.Assign((const char*)read->Data.Data(), 0, int(read->Data.Size()));
+    CHECK(readStr == "Far");
+    remove(strBuilder.AsCStr());
+    #endif
+
     IO::Discard();
     Core::Discard();
 }
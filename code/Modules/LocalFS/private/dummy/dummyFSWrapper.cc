@@ -20,25 +20,25 @@ dummyFSWrapper::openWrite(const char* path) {
 }
 
 //------------------------------------------------------------------------------
-int
-dummyFSWrapper::write(handle f, const void* ptr, int numBytes) {
+int64_t
+dummyFSWrapper::write(handle f, const void* ptr, int64_t numBytes) {
     return 0;
 }
 
 //------------------------------------------------------------------------------
-int
-dummyFSWrapper::read(handle f, void* ptr, int numBytes) {
+int64_t
+dummyFSWrapper::read(handle f, void* ptr, int64_t numBytes) {
     return 0;
 }
 
 //------------------------------------------------------------------------------
 bool
-dummyFSWrapper::seek(handle f, int offset) {
+dummyFSWrapper::seek(handle f, int64_t offset) {
     return true;
 }
 
 //------------------------------------------------------------------------------
-int
+int64_t
 dummyFSWrapper::size(handle f) {
     return 0;
 }
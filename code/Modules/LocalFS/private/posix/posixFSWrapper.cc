@@ -1,15 +1,26 @@
 //------------------------------------------------------------------------------
 //  posixFSWrapper.cc
 //------------------------------------------------------------------------------
+// 64-bit off_t for fseeko/ftello on 32-bit glibc, must come before any system header
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
 #include "Pre.h"
 #include "posixFSWrapper.h"
 #include "Core/String/StringBuilder.h"
 #include <stdio.h>
+#include <stdint.h>
 #include "LocalFS/private/whereami/whereami.h"
 #if ORYOL_WINDOWS
 #include <direct.h>
+#define fseek64 _fseeki64
+#define ftell64 _ftelli64
 #else
 #include <unistd.h>
+#include <sys/types.h>
+#define fseek64 fseeko
+#define ftell64 ftello
+static_assert(sizeof(off_t) == 8, "posixFSWrapper: off_t must be 64 bits (_FILE_OFFSET_BITS=64)");
 #endif
 
 namespace Oryol {
@@ -17,6 +28,14 @@ namespace _priv {
 
 const posixFSWrapper::handle posixFSWrapper::invalidHandle = nullptr;
 
+//------------------------------------------------------------------------------
+/// clamp a 64-bit byte count to size_t (results in a short read/write on 32-bit platforms)
+static size_t
+clampSize(int64_t numBytes) {
+    o_assert_dbg(numBytes >= 0);
+    return (uint64_t(numBytes) > uint64_t(SIZE_MAX)) ? SIZE_MAX : size_t(numBytes);
+}
+
 //------------------------------------------------------------------------------
 posixFSWrapper::handle
 posixFSWrapper::openRead(const char* path) {
@@ -32,38 +51,38 @@ posixFSWrapper::openWrite(const char* path) {
 }
 
 //------------------------------------------------------------------------------
-int
-posixFSWrapper::write(handle h, const void* ptr, int numBytes) {
+int64_t
+posixFSWrapper::write(handle h, const void* ptr, int64_t numBytes) {
     o_assert_dbg(invalidHandle != h);
     o_assert_dbg(ptr);
-    return (int) fwrite(ptr, 1, numBytes, (FILE*)h);
+    return (int64_t) fwrite(ptr, 1, clampSize(numBytes), (FILE*)h);
 }
 
 //------------------------------------------------------------------------------
-int
-posixFSWrapper::read(handle h, void* ptr, int numBytes) {
+int64_t
+posixFSWrapper::read(handle h, void* ptr, int64_t numBytes) {
     o_assert_dbg(invalidHandle != h);
     o_assert_dbg(ptr);
-    return (int) fread(ptr, 1, numBytes, (FILE*)h);
+    return (int64_t) fread(ptr, 1, clampSize(numBytes), (FILE*)h);
 }
 
 //------------------------------------------------------------------------------
 bool
-posixFSWrapper::seek(handle h, int offset) {
+posixFSWrapper::seek(handle h, int64_t offset) {
     o_assert_dbg(invalidHandle != h);
-    return 0 == fseek((FILE*)h, offset, SEEK_SET);
+    return 0 == fseek64((FILE*)h, offset, SEEK_SET);
 }
 
 //------------------------------------------------------------------------------
-int
+int64_t
 posixFSWrapper::size(handle h) {
     o_assert_dbg(invalidHandle != h);
     FILE* fp = (FILE*) h;
-    long off = ftell(fp);
-    fseek(fp, 0, SEEK_END);
-    long size = ftell(fp);
-    fseek(fp, off, SEEK_SET);
-    return (int) size;
+    int64_t off = ftell64(fp);
+    fseek64(fp, 0, SEEK_END);
+    int64_t size = ftell64(fp);
+    fseek64(fp, off, SEEK_SET);
+    return size;
 }
 
 //------------------------------------------------------------------------------
@@ -23,13 +23,13 @@ public:
     /// open file for writing
     static handle openWrite(const char* path);
     /// write to file, return number of bytes actually written
-    static int write(handle f, const void* ptr, int numBytes);
+    static int64_t write(handle f, const void* ptr, int64_t numBytes);
     /// read from file, return number of bytes actually read
-    static int read(handle f, void* ptr, int numBytes);
-    /// seek from start of file
-    static bool seek(handle f, int offset);
-    /// get file size
-    static int size(handle f);
+    static int64_t read(handle f, void* ptr, int64_t numBytes);
+    /// seek from start of file (64-bit offset)
+    static bool seek(handle f, int64_t offset);
+    /// get file size (64-bit)
+    static int64_t size(handle f);
     /// close file
     static void close(handle f);
     
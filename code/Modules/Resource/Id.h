@@ -11,6 +11,8 @@
     Resource identifiers are abstract handles to a resource object.
 */
 #include "Core/Types.h"
+#include "Core/TypeTraits.h"
+#include "Core/Hash.h"
 
 namespace Oryol {
     
@@ -70,6 +72,16 @@ private:
     static const uint64_t invalidId = 0xFFFFFFFFFFFFFFFF;
 };
 
+/// Id is plain-old-data with a user-provided copy constructor
+template<> struct IsTriviallyRelocatable<Id> : std::true_type { };
+
+/// hash function for Id keys
+template<> struct Hash<Id> {
+    uint32_t operator()(const Id& id) const {
+        return HashInt(id.Value);
+    };
+};
+
 //------------------------------------------------------------------------------
 inline Id
 Id::InvalidId() {
@@ -139,4 +139,11 @@ Locator::Signature() const {
     return this->signature;
 }
 
+/// hash function for Locator keys
+template<> struct Hash<Locator> {
+    uint32_t operator()(const Locator& loc) const {
+        return HashCombine(loc.Location().HashValue(), loc.Signature());
+    };
+};
+
 } // namespace Oryol
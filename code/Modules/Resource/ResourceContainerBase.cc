@@ -17,6 +17,7 @@ ResourceContainerBase::~ResourceContainerBase() {
 void
 ResourceContainerBase::Setup(int labelStackCapacity, int registryCapacity) {
     o_assert_dbg(!this->valid);
+    o_memory_tag(MemoryTag::Resource);
     this->labelStack.Reserve(labelStackCapacity);
     this->registry.Setup(registryCapacity);
     this->valid = true;
@@ -28,6 +29,7 @@ void
 ResourceContainerBase::Discard() {
     o_assert_dbg(this->valid);
     o_assert_dbg(this->labelStack.Size() == 1);
+    o_memory_tag(MemoryTag::Resource);
     this->PopLabel();
     this->registry.Discard();
     this->valid = false;
@@ -11,7 +11,7 @@
     to wrap their different resource types.
 */
 #include "Core/Types.h"
-#include "Core/Containers/Array.h"
+#include "Core/Containers/SmallArray.h"
 #include "Resource/ResourceRegistry.h"
 #include "Resource/ResourceLabel.h"
 
@@ -39,7 +39,7 @@ public:
     /// lookup a resource Id by Locator
     Id Lookup(const Locator& locator) const;
     
-    Array<ResourceLabel> labelStack;
+    SmallArray<ResourceLabel, 8> labelStack;
     ResourceRegistry registry;
     uint32_t curLabelCount = 0;
     bool valid = false;
@@ -4,10 +4,14 @@
     @class Oryol::ResourcePool
     @ingroup Resource
     @brief generic resource pool
-    @todo ResourcePool description
+
+    A ResourcePool has a fixed number of resource slots. Allocated
+    slots are tracked in a BitSet, so allocating (lowest free slot
+    first), freeing, counting and iterating the used slots work on
+    64 slots at a time.
 */
-#include "Core/Containers/Queue.h"
 #include "Core/Containers/Array.h"
+#include "Core/Containers/BitSet.h"
 #include "Resource/Id.h"
 #include "Resource/ResourceInfo.h"
 #include "Resource/ResourcePoolInfo.h"
@@ -71,7 +75,7 @@ public:
     Id::TypeT resourceType = 0xFF;
     
     Array<RESOURCE> slots;
-    Queue<uint16_t> freeSlots;
+    BitSet allocatedSlots;
 };
     
 //------------------------------------------------------------------------------
@@ -86,21 +90,18 @@ ResourcePool<RESOURCE>::Setup(Id::TypeT resType, int poolSize) {
     o_assert_dbg(!this->isValid);
     o_assert_dbg(Id::InvalidType != resType);
     o_assert_dbg(poolSize > 0);
+    o_memory_tag(MemoryTag::Resource);
     
     this->resourceType = resType;
+    o_assert_dbg(poolSize <= MaxNumPoolResources);
     this->slots.SetFixedCapacity(poolSize);
-    this->freeSlots.SetFixedCapacity(poolSize);
     this->LastAllocSlot = 0;
     
     // setup empty slots
     for (int i = 0; i < poolSize; i++) {
         this->slots.Add();
     }
-    
-    // setup free slots queue
-    for (uint16_t i = 0; i < poolSize; i++) {
-        this->freeSlots.Enqueue(i);
-    }
+    this->allocatedSlots.Resize(poolSize);
     
     this->isValid = true;
 }
@@ -109,12 +110,13 @@ ResourcePool<RESOURCE>::Setup(Id::TypeT resType, int poolSize) {
 template<class RESOURCE> void
 ResourcePool<RESOURCE>::Discard() {
     o_assert_dbg(this->isValid);
+    o_memory_tag(MemoryTag::Resource);
     // make sure that all resources had been freed (or should we do this here?)
-    o_assert_dbg(this->freeSlots.Size() == this->slots.Size());
+    o_assert_dbg(!this->allocatedSlots.Any());
     this->isValid = false;
     this->LastAllocSlot = 0;    
     this->slots.Clear();
-    this->freeSlots.Clear();
+    this->allocatedSlots.Resize(0);
 }
 
 //------------------------------------------------------------------------------
@@ -135,7 +137,10 @@ template<class RESOURCE> Id
 ResourcePool<RESOURCE>::AllocId() {
     o_assert_dbg(this->isValid);
     o_assert_dbg(Id::InvalidType != this->resourceType);
-    Id newId(this->uniqueCounter++, this->freeSlots.Dequeue(), this->resourceType);
+    const int slotIndex = this->allocatedSlots.FindFirstClear();
+    o_assert(InvalidIndex != slotIndex); // "ResourcePool: no free slots!"
+    this->allocatedSlots.Set(slotIndex);
+    Id newId(this->uniqueCounter++, Id::SlotIndexT(slotIndex), this->resourceType);
     #if ORYOL_DEBUG
         const auto& slot = this->slots[newId.SlotIndex];
         o_assert_dbg(ResourceState::Initial == slot.State);
@@ -153,11 +158,11 @@ ResourcePool<RESOURCE>::FreeId(const Id& id) {
     o_assert_dbg(!this->slots[id.SlotIndex].Id.IsValid());
     o_assert_dbg(ResourceState::Initial == this->slots[id.SlotIndex].State);
     o_assert_dbg(id.SlotIndex <= this->LastAllocSlot);
-    // find the next highest 'last alloc slot' 
-    while ((this->LastAllocSlot > 0) && !this->slots[this->LastAllocSlot].Id.IsValid()) {
-        this->LastAllocSlot--;
-    }
-    this->freeSlots.Enqueue(id.SlotIndex);
+    o_assert_dbg(this->allocatedSlots.Test(id.SlotIndex));
+    this->allocatedSlots.Reset(id.SlotIndex);
+    // find the next highest 'last alloc slot'
+    const int lastSlot = this->allocatedSlots.FindLastSet();
+    this->LastAllocSlot = (InvalidIndex != lastSlot) ? Id::SlotIndexT(lastSlot) : 0;
 }
 
 //------------------------------------------------------------------------------
@@ -288,7 +293,10 @@ ResourcePool<RESOURCE>::QueryPoolInfo() const {
     poolInfo.NumSlots = this->GetNumSlots();
     poolInfo.NumUsedSlots = this->GetNumUsedSlots();
     poolInfo.NumFreeSlots = this->GetNumFreeSlots();
-    for (const auto& slot : this->slots) {
+    // free slots are always in the initial state, only look at allocated slots
+    poolInfo.NumSlotsByState[ResourceState::Initial] = poolInfo.NumFreeSlots;
+    for (int i = this->allocatedSlots.FindFirstSet(); InvalidIndex != i; i = this->allocatedSlots.FindFirstSet(i + 1)) {
+        const auto& slot = this->slots[i];
         if (ResourceState::InvalidState != slot.State) {
             poolInfo.NumSlotsByState[slot.State]++;
         }
@@ -305,13 +313,13 @@ ResourcePool<RESOURCE>::GetNumSlots() const {
 //------------------------------------------------------------------------------
 template<class RESOURCE> int
 ResourcePool<RESOURCE>::GetNumUsedSlots() const {
-    return this->slots.Size() - this->freeSlots.Size();
+    return this->allocatedSlots.Count();
 }
 
 //------------------------------------------------------------------------------
 template<class RESOURCE> int
 ResourcePool<RESOURCE>::GetNumFreeSlots() const {
-    return this->freeSlots.Size();
+    return this->slots.Size() - this->allocatedSlots.Count();
 }
 
 } // namespace Oryol
@@ -46,6 +46,7 @@ ResourceRegistry::Add(const Locator& loc, Id id, ResourceLabel label) {
     o_assert_dbg(this->isValid);
     o_assert_dbg(id.IsValid());
     o_assert(!this->idIndexMap.Contains(id));
+    o_memory_tag(MemoryTag::Resource);
     
     this->entries.Add(loc, id, label);
     if (loc.IsShared()) {
@@ -101,11 +102,10 @@ ResourceRegistry::Lookup(const Locator& loc) const {
 }
 
 //------------------------------------------------------------------------------
-Array<Id>
+SmallArray<Id, 16>
 ResourceRegistry::Remove(ResourceLabel label) {
     o_assert_dbg(this->isValid);
-    Array<Id> removed;
-    removed.Reserve(this->entries.Size() < 256 ? this->entries.Size() : 256);
+    SmallArray<Id, 16> removed;
     
     // for each entry where id.label matches label (from behind
     // because matching entries will be removed)
@@ -127,17 +127,10 @@ ResourceRegistry::Remove(ResourceLabel label) {
             // fixup the index maps (see elementBuffer)
             const int swappedIndex = this->entries.Size();
             if (entryIndex != swappedIndex) {
-                for (auto& elm : this->idIndexMap) {
-                    if (swappedIndex == elm.value) {
-                        elm.value = entryIndex;
-                        break;
-                    }
-                }
-                for (auto& elm : this->locatorIndexMap) {
-                    if (swappedIndex == elm.value) {
-                        elm.value = entryIndex;
-                        break;
-                    }
+                const Entry& swappedEntry = this->entries[entryIndex];
+                this->idIndexMap[swappedEntry.id] = entryIndex;
+                if (swappedEntry.locator.IsShared()) {
+                    this->locatorIndexMap[swappedEntry.locator] = entryIndex;
                 }
             }
             
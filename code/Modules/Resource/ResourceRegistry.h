@@ -9,7 +9,8 @@
 #include "Resource/Locator.h"
 #include "Resource/ResourceLabel.h"
 #include "Core/Containers/Array.h"
-#include "Core/Containers/Map.h"
+#include "Core/Containers/SmallArray.h"
+#include "Core/Containers/HashMap.h"
 
 namespace Oryol {
     
@@ -30,7 +31,7 @@ public:
     /// lookup resource Id by locator
     Id Lookup(const Locator& loc) const;
     /// remove all resource matching label from registry, returns removed Ids
-    Array<Id> Remove(ResourceLabel label);
+    SmallArray<Id, 16> Remove(ResourceLabel label);
     
     /// check if resource is in registry
     bool Contains(Id id) const;
@@ -67,7 +68,7 @@ public:
     
     bool isValid = false;
     Array<Entry> entries;
-    Map<Locator, int> locatorIndexMap;
-    Map<Id, int> idIndexMap;
+    HashMap<Locator, int> locatorIndexMap;
+    HashMap<Id, int> idIndexMap;
 };
 } // namespace Oryol
@@ -78,6 +78,26 @@ TEST(ResourcePoolTest) {
     CHECK(resourcePool.QueryState(resId1) == ResourceState::InvalidState);
     CHECK(resourcePool.LastAllocSlot == 0);
 
+    // freed slots are reused lowest-first
+    Id resId2 = resourcePool.AllocId();
+    Id resId3 = resourcePool.AllocId();
+    CHECK(resId2.SlotIndex == 0);
+    CHECK(resId3.SlotIndex == 1);
+    CHECK(resId2 != resId);
+    resourcePool.Assign(resId2, ResourceState::Valid);
+    resourcePool.Assign(resId3, ResourceState::Pending);
+    CHECK(resourcePool.LastAllocSlot == 1);
+    CHECK(resourcePool.Lookup(resId) == nullptr);
+    const ResourcePoolInfo poolInfo1 = resourcePool.QueryPoolInfo();
+    CHECK(poolInfo1.NumUsedSlots == 2);
+    CHECK(poolInfo1.NumSlotsByState[ResourceState::Valid] == 1);
+    CHECK(poolInfo1.NumSlotsByState[ResourceState::Pending] == 1);
+    CHECK(poolInfo1.NumSlotsByState[ResourceState::Initial] == 254);
+    resourcePool.Unassign(resId3);
+    CHECK(resourcePool.LastAllocSlot == 0);
+    resourcePool.Unassign(resId2);
+    CHECK(resourcePool.GetNumUsedSlots() == 0);
+
     resourcePool.Discard();
     CHECK(!resourcePool.IsValid());
 }
@@ -16,7 +16,7 @@ TEST(ResourceRegistryTest) {
     const Id blaId(1, 1, 1);
     const Id blaSigId(2, 2, 1);
     const Id blobId(4, 4, 1);
-    Array<Id> removed;
+    SmallArray<Id, 16> removed;
 
     ResourceRegistry reg;
     CHECK(!reg.IsValid());
@@ -613,7 +613,7 @@ def writeInputVertexLayout(f, vs, slang) :
 def writeProgramSource(f, shdLib, prog, slangs) :
     # write the Setup() function
     f.write('Oryol::ShaderSetup ' + prog.name + '::Setup() {\n')
-    f.write('    Oryol::ShaderSetup setup("' + prog.name + '");\n')
+    f.write('    Oryol::ShaderSetup setup(o_atom("' + prog.name + '"));\n')
     vs = shdLib.vertexShaders[prog.vs]
     fs = shdLib.fragmentShaders[prog.fs]
     vsInputLayout = writeInputVertexLayout(f, vs, slangs[0])
@@ -647,11 +647,11 @@ def writeProgramSource(f, shdLib, prog, slangs) :
             ub_size = ub['size']
             if 'glsl' in slang:
                 ub_size = roundup(ub_size, 16)
-            f.write('    setup.AddUniformBlock("{}", "{}", {}, {}, {}::_bindShaderStage, {}::_bindSlotIndex);\n'.format(
+            f.write('    setup.AddUniformBlock(o_atom("{}"), o_atom("{}"), {}, {}, {}::_bindShaderStage, {}::_bindSlotIndex);\n'.format(
                 ub['type'], ub['name'], getUniformBlockTypeHash(ub), ub_size, ub['type'], ub['type']))
         # add textures layouts to setup objects
         for tex in refl['textures']:
-            f.write('    setup.AddTexture("{}", {}, Oryol::ShaderStage::{}, {});\n'.format(tex['name'], texOryolType[tex['type']], stage, tex['slot']))
+            f.write('    setup.AddTexture(o_atom("{}"), {}, Oryol::ShaderStage::{}, {});\n'.format(tex['name'], texOryolType[tex['type']], stage, tex['slot']))
     f.write('    return setup;\n')
     f.write('}\n')
 
@@ -12,8 +12,10 @@ endif()
 option(FIPS_UNITTESTS "Enable unit tests" OFF)
 option(FIPS_UNITTESTS_HEADLESS "If enabled don't run tests which require a display" OFF)
 option(ORYOL_SAMPLES "Build Oryol samples" ON)
+option(ORYOL_BENCHMARKS "Build Oryol benchmark apps" OFF)
 set(ORYOL_SAMPLE_URL "http://floooh.github.com/oryol/data/" CACHE STRING "Sample data URL")
 option(ORYOL_DEBUG_SHADERS "Enable/disable debug info for shaders" OFF)
+option(ORYOL_MEMORY_STATS "Enable per-module memory accounting" OFF)
 if (FIPS_MACOS OR FIPS_LINUX OR FIPS_ANDROID)
     option(ORYOL_USE_LIBCURL "Use libcurl instead of native APIs" ON)
 else() 
@@ -173,6 +175,9 @@ endif()
 if (FIPS_ALLOCATOR_DEBUG)
     add_definitions(-DORYOL_ALLOCATOR_DEBUG=1)
 endif()
+if (ORYOL_MEMORY_STATS OR FIPS_UNITTESTS)
+    add_definitions(-DORYOL_MEMORY_STATS=1)
+endif()
 if (FIPS_UNITTESTS)
     add_definitions(-DORYOL_UNITTESTS=1)
     if (FIPS_UNITTESTS_HEADLESS)
@@ -0,0 +1,48 @@
+# compare the JSON output of two CoreBenchmarks runs
+
+import json
+from mod import log
+
+#-------------------------------------------------------------------------------
+def load(path) :
+    with open(path, 'r') as f :
+        data = json.load(f)
+    results = {}
+    for res in data['results'] :
+        key = (res['group'], res['container'], res['op'], res['type'], res['n'])
+        results[key] = res
+    return results
+
+#-------------------------------------------------------------------------------
+def run(fips_dir, proj_dir, args) :
+    if len(args) < 2 :
+        log.error("expected two benchmark result files!")
+    threshold = float(args[2]) if len(args) > 2 else 5.0
+    old = load(args[0])
+    new = load(args[1])
+    num_slower = 0
+    for key in sorted(new.keys()) :
+        if key not in old :
+            continue
+        old_ns = old[key]['median_ns']
+        new_ns = new[key]['median_ns']
+        change = ((new_ns - old_ns) / old_ns) * 100.0 if old_ns > 0.0 else 0.0
+        if change > threshold :
+            color = log.RED
+            num_slower += 1
+        elif change < -threshold :
+            color = log.GREEN
+        else :
+            color = log.DEF
+        log.info('{}{:<10} {:<20} {:<12} {:<7} n={:<8} {:>14.1f} => {:>14.1f} ns ({:+.1f}%){}'.format(
+            color, key[0], key[1], key[2], key[3], key[4], old_ns, new_ns, change, log.DEF))
+    if num_slower > 0 :
+        log.warn('{} benchmarks are more than {}% slower'.format(num_slower, threshold))
+
+#-------------------------------------------------------------------------------
+def help() :
+    log.info(log.YELLOW +
+             'fips benchdiff [old.json] [new.json] [threshold]\n' +
+             log.DEF +
+             '    compare the median times of two CoreBenchmarks runs,\n'
+             '    highlight changes above threshold percent (default: 5)')